@@ -382,7 +382,7 @@ protected:
 
   friend class WorkspaceHistory; // Allow workspace history loading to adjust
                                  // g_execCount
-  static size_t
+  static std::atomic<size_t>
       g_execCount; ///< Counter to keep track of algorithm execution order
 
   virtual void setOtherProperties(IAlgorithm *alg,
@@ -390,6 +390,12 @@ protected:
                                   const std::string &propertyValue,
                                   int periodNum);
 
+  /// Whether the base processGroups() may execute the algorithm on all the
+  /// members of the groups at the same time. Override to return true only if
+  /// the executions are independent of each other, e.g. they do not read or
+  /// write the same workspaces in the ADS.
+  virtual bool processGroupsInParallel() const { return false; }
+
   /// All the WorkspaceProperties that are Input or InOut. Set in execute()
   std::vector<IWorkspaceProperty *> m_inputWorkspaceProps;
   /// Pointer to the history for the algorithm being executed
@@ -432,6 +438,10 @@ private:
   bool executeAsyncImpl(const Poco::Void &i);
 
   bool doCallProcessGroups(Mantid::Types::Core::DateAndTime &start_time);
+  boost::shared_ptr<Algorithm>
+  createGroupMemberAlgorithm(const size_t entry,
+                             std::vector<std::string> &outputWSNames);
+  void executeGroupMember(Algorithm &alg, const size_t entry);
 
   // Report that the algorithm has completed.
   void reportCompleted(const double &duration,
@@ -502,6 +512,11 @@ private:
 
   /// (MPI) communicator used when executing the algorithm.
   std::unique_ptr<Parallel::Communicator> m_communicator;
+
+  /// Index of the AlgorithmProfiler entry of the running execution
+  size_t m_profileIndex;
+  /// Index of the AlgorithmProfiler entry of the parent algorithm, if any
+  size_t m_profileParent;
 };
 
 /// Typedef for a shared pointer to an Algorithm
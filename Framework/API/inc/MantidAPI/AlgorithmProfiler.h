@@ -0,0 +1,149 @@
+#ifndef MANTID_API_ALGORITHMPROFILER_H_
+#define MANTID_API_ALGORITHMPROFILER_H_
+
+#include "MantidAPI/DllConfig.h"
+#include "MantidKernel/SingletonHolder.h"
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+
+/** AlgorithmProfilerImpl : Records the time and memory used by every
+  execution of an algorithm, including the child algorithms, as a tree.
+
+  When enabled, with the algorithms.profiling.enabled key of the
+  ConfigService or setEnabled(), Algorithm::execute() records for each
+  execution the wall clock time, the CPU time of the thread executing it, the
+  share of the wall clock time that thread was running and the increase of
+  the peak resident memory of the process. The CPU time of the threads it
+  starts, such as those of OpenMP loops, is not included. The records can be
+  saved as a Chrome trace, to be opened in chrome://tracing, or as collapsed
+  stacks for flame graph tools. If algorithms.profiling.filename is set, the
+  records are saved to that file when the framework shuts down. At most
+  algorithms.profiling.maxentries executions are recorded until the records
+  are cleared.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_API_DLL AlgorithmProfilerImpl {
+public:
+  /// Index of the parent of a top level algorithm
+  static constexpr size_t NO_PARENT = std::numeric_limits<size_t>::max();
+  /// Number of entries kept if algorithms.profiling.maxentries is not set
+  static constexpr size_t DEFAULT_MAX_ENTRIES = 100000;
+
+  /// What was recorded for one execution of an algorithm
+  struct Entry {
+    std::string name;
+    int version;
+    /// Index of the entry of the parent algorithm, or NO_PARENT
+    size_t parent;
+    /// Number of the thread the algorithm was executed on, from 0
+    int thread;
+    /// Start time in seconds since the profiler was created or cleared
+    double start;
+    /// Wall clock time in seconds
+    double wallTime;
+    /// CPU time of the thread executing the algorithm in seconds
+    double cpuTime;
+    /// Increase of the peak resident memory of the process in kiB
+    double peakRSSDelta;
+    /// False until the execution has finished
+    bool finished;
+  };
+
+  /// Whether executions are being recorded
+  bool isEnabled() const { return m_enabled; }
+  void setEnabled(const bool enabled);
+  void setMaxEntries(const size_t maxEntries);
+
+  size_t start(const std::string &name, const int version,
+               const size_t parent);
+  void stop(const size_t index);
+
+  std::vector<Entry> entries() const;
+  void clear();
+
+  std::string chromeTrace() const;
+  std::string collapsedStacks() const;
+  void save(const std::string &filename) const;
+  void shutdown();
+
+private:
+  friend struct Mantid::Kernel::CreateUsingNew<AlgorithmProfilerImpl>;
+
+  AlgorithmProfilerImpl();
+  ~AlgorithmProfilerImpl() = default;
+  AlgorithmProfilerImpl(const AlgorithmProfilerImpl &) = delete;
+  AlgorithmProfilerImpl &operator=(const AlgorithmProfilerImpl &) = delete;
+
+  /// Values at the start of an execution, to compute the differences
+  struct Start {
+    std::chrono::steady_clock::time_point wallTime;
+    double cpuTime;
+    size_t peakRSS;
+  };
+
+  /// Whether executions are being recorded
+  std::atomic<bool> m_enabled;
+  /// The file the entries are saved to on shutdown, if any
+  std::string m_filename;
+  /// Origin of the start times of the entries
+  std::chrono::steady_clock::time_point m_origin;
+  /// Index given to the first entry, that is the number of entries cleared
+  size_t m_first;
+  /// The entries, in the order the executions started
+  std::vector<Entry> m_entries;
+  /// The values at the start of each entry
+  std::vector<Start> m_starts;
+  /// Number of entries kept until the next clear
+  size_t m_maxEntries;
+  /// Whether executions were not recorded because of m_maxEntries
+  bool m_truncated;
+  /// Numbers given to the threads
+  std::map<std::thread::id, int> m_threads;
+  /// Mutex for the entries
+  mutable std::mutex m_mutex;
+};
+
+using AlgorithmProfiler =
+    Mantid::Kernel::SingletonHolder<AlgorithmProfilerImpl>;
+
+} // namespace API
+} // namespace Mantid
+
+namespace Mantid {
+namespace Kernel {
+EXTERN_MANTID_API template class MANTID_API_DLL
+    Mantid::Kernel::SingletonHolder<Mantid::API::AlgorithmProfilerImpl>;
+}
+}
+
+#endif /* MANTID_API_ALGORITHMPROFILER_H_ */
@@ -3,6 +3,8 @@
 #include "MantidKernel/System.h"
 #include "MantidKernel/DiskBuffer.h"
 
+#include <functional>
+
 namespace Mantid {
 namespace API {
 
@@ -67,6 +69,20 @@ public:
   virtual void loadBlock(std::vector<double> & /* Block */,
                          const uint64_t /*blockPosition*/,
                          const size_t /*BlockSize*/) const = 0;
+  /** Pass a known size float data block at the specified file position to
+   * visit without copying it, if the data are kept in memory in this format.
+   * visit must not save blocks with this class.
+   * @return false if the block has to be loaded with loadBlock instead */
+  virtual bool viewBlock(
+      const uint64_t /*blockPosition*/, const size_t /*BlockSize*/,
+      const std::function<void(const float *, size_t)> & /*visit*/) const {
+    return false;
+  }
+  virtual bool viewBlock(
+      const uint64_t /*blockPosition*/, const size_t /*BlockSize*/,
+      const std::function<void(const double *, size_t)> & /*visit*/) const {
+    return false;
+  }
 
   /** flush the IO buffers */
   virtual void flushData() const = 0;
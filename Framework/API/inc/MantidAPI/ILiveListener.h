@@ -134,6 +134,13 @@ public:
   /// Returns the run number of the current run
   virtual int runNumber() const = 0;
 
+  /// Number of events buffered since the last extraction, 0 if the listener
+  /// does not count them
+  virtual size_t bufferedEvents() const { return 0; }
+  /// Number of events received that could not be buffered, 0 if the listener
+  /// does not count them
+  virtual size_t droppedEvents() const { return 0; }
+
   /** Sets a list of spectra to be extracted.
    * @param specList :: A vector with spectra indices.
    */
@@ -2,6 +2,12 @@
 #define MANTID_API_LIVELISTENER_H_
 
 #include "MantidAPI/ILiveListener.h"
+#include "MantidAPI/MatrixWorkspace_fwd.h"
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <vector>
 
 namespace Mantid {
 namespace API {
@@ -9,6 +15,11 @@ namespace API {
   Base implementation for common behaviour of all live listener classes. It
   implements the ILiveListener interface.
 
+  Listeners that accumulate data in buffer workspaces can let this class
+  prepare empty spare buffers in the background, so that extractData() only
+  has to swap pointers while the network thread is held. It also counts the
+  events buffered since the last extraction and the events dropped.
+
   Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
   National Laboratory & European Spallation Source
 
@@ -36,9 +47,37 @@ public:
   void setSpectra(const std::vector<specnum_t> &specList) override;
   void setAlgorithm(const class IAlgorithm &callingAlgorithm) override;
 
+  /// Number of events buffered since the last extraction
+  size_t bufferedEvents() const override { return m_bufferedEvents; }
+  /// Number of events received that could not be buffered
+  size_t droppedEvents() const override { return m_droppedEvents; }
+
 protected:
+  void initSpareBuffers(const std::vector<MatrixWorkspace_sptr> &buffers);
+  std::vector<MatrixWorkspace_sptr> takeSpareBuffers();
+
+  /// Adds to the number of events buffered since the last extraction
+  void countBufferedEvents(size_t count) { m_bufferedEvents += count; }
+  /// Adds to the number of events dropped
+  void countDroppedEvents(size_t count) { m_droppedEvents += count; }
+  /// Returns the number of events buffered since the last extraction and
+  /// starts counting again from zero
+  size_t resetBufferedEvents() { return m_bufferedEvents.exchange(0); }
+
   /// Indicates receipt of a reset signal from the DAS.
   bool m_dataReset = false;
+
+private:
+  /// Empty copies of the buffers the spare buffers are created from
+  std::vector<MatrixWorkspace_const_sptr> m_bufferPrototypes;
+  /// Spare buffers being created in the background
+  std::future<std::vector<MatrixWorkspace_sptr>> m_spareBuffers;
+  /// Protects m_bufferPrototypes and m_spareBuffers
+  std::mutex m_spareBuffersMutex;
+  /// Number of events buffered since the last extraction
+  std::atomic<size_t> m_bufferedEvents{0};
+  /// Number of events received that could not be buffered
+  std::atomic<size_t> m_droppedEvents{0};
 };
 
 } // namespace API
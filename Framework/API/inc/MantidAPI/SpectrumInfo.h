@@ -7,6 +7,8 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include <atomic>
+#include <mutex>
 #include <vector>
 
 namespace Mantid {
@@ -86,6 +88,12 @@ public:
   bool hasDetectors(const size_t index) const;
   bool hasUniqueDetector(const size_t index) const;
 
+  boost::shared_ptr<const std::vector<double>> l2s() const;
+  boost::shared_ptr<const std::vector<double>> twoThetas() const;
+  boost::shared_ptr<const std::vector<double>> azimuths() const;
+  boost::shared_ptr<const std::vector<double>> difcs() const;
+  boost::shared_ptr<const std::vector<double>> solidAngles() const;
+
   void setMasked(const size_t index, bool masked);
 
   // This is likely to be deprecated/removed with the introduction of
@@ -102,6 +110,21 @@ public:
   friend class ExperimentInfo;
 
 private:
+  /// An array of a quantity derived from the geometry, for all spectra
+  struct GeometryArray {
+    /// Geometry revision the values were computed for
+    size_t revision{0};
+    /// Revision of the spectrum definitions the values were computed for
+    size_t spectrumDefinitionRevision{0};
+    boost::shared_ptr<const std::vector<double>> values;
+  };
+  template <class Compute>
+  boost::shared_ptr<const std::vector<double>>
+  geometryArray(GeometryArray &array, const Compute &compute) const;
+  void averageOverDetectors(const std::vector<double> &detectorValues,
+                            std::vector<double> &values) const;
+  void invalidateGeometryArrays();
+
   const Geometry::IDetector &getDetector(const size_t index) const;
   const SpectrumDefinition &
   checkAndGetSpectrumDefinition(const size_t index) const;
@@ -112,6 +135,15 @@ private:
   mutable std::vector<boost::shared_ptr<const Geometry::IDetector>>
       m_lastDetector;
   mutable std::vector<size_t> m_lastIndex;
+
+  /// Changes whenever a spectrum definition is invalidated
+  std::atomic<size_t> m_spectrumDefinitionRevision{0};
+  mutable GeometryArray m_l2s;
+  mutable GeometryArray m_twoThetas;
+  mutable GeometryArray m_azimuths;
+  mutable GeometryArray m_difcs;
+  mutable GeometryArray m_solidAngles;
+  mutable std::mutex m_geometryArrayMutex;
 };
 
 } // namespace API
@@ -1,6 +1,7 @@
 #include "MantidAPI/Algorithm.h"
 #include "MantidAPI/AlgorithmHistory.h"
 #include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/AlgorithmProfiler.h"
 #include "MantidAPI/AlgorithmProxy.h"
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/DeprecatedAlgorithm.h"
@@ -11,8 +12,10 @@
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/EmptyValues.h"
+#include "MantidKernel/FunctionTask.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Strings.h"
+#include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/UsageService.h"
 
@@ -57,6 +60,28 @@ public:
 private:
   const std::string &m_value;
 };
+
+/// Records an execution with the AlgorithmProfiler, if it is enabled, for
+/// the lifetime of the object
+class ProfiledExecution {
+public:
+  ProfiledExecution(const Algorithm &alg, size_t &index, const size_t parent)
+      : m_index(index) {
+    auto &profiler = AlgorithmProfiler::Instance();
+    m_index = profiler.isEnabled()
+                  ? profiler.start(alg.name(), alg.version(), parent)
+                  : AlgorithmProfilerImpl::NO_PARENT;
+  }
+  ~ProfiledExecution() {
+    if (m_index != AlgorithmProfilerImpl::NO_PARENT) {
+      AlgorithmProfiler::Instance().stop(m_index);
+      m_index = AlgorithmProfilerImpl::NO_PARENT;
+    }
+  }
+
+private:
+  size_t &m_index;
+};
 } // namespace
 
 // Doxygen can't handle member specialization at the moment:
@@ -83,7 +108,7 @@ template MANTID_API_DLL bool Algorithm::isEmpty<std::size_t>(const std::size_t);
 //=============================================================================================
 
 /// Initialize static algorithm counter
-size_t Algorithm::g_execCount = 0;
+std::atomic<size_t> Algorithm::g_execCount{0};
 
 /// Constructor
 Algorithm::Algorithm()
@@ -96,7 +121,9 @@ Algorithm::Algorithm()
       m_isAlgStartupLoggingEnabled(true), m_startChildProgress(0.),
       m_endChildProgress(0.), m_algorithmID(this), m_singleGroup(-1),
       m_groupsHaveSimilarNames(false),
-      m_communicator(Kernel::make_unique<Parallel::Communicator>()) {}
+      m_communicator(Kernel::make_unique<Parallel::Communicator>()),
+      m_profileIndex(AlgorithmProfilerImpl::NO_PARENT),
+      m_profileParent(AlgorithmProfilerImpl::NO_PARENT) {}
 
 /// Virtual destructor
 Algorithm::~Algorithm() {
@@ -437,6 +464,7 @@ void Algorithm::unlockWorkspaces() {
  *  @return true if executed successfully.
  */
 bool Algorithm::execute() {
+  ProfiledExecution profile(*this, m_profileIndex, m_profileParent);
   Timer timer;
   AlgorithmManager::Instance().notifyAlgorithmStarting(this->getAlgorithmID());
   {
@@ -780,6 +808,7 @@ void Algorithm::setupAsChildAlgorithm(Algorithm_sptr alg,
   // set as a child
   alg->setChild(true);
   alg->setLogging(enableLogging);
+  alg->m_profileParent = m_profileIndex;
 
   // Initialise the Child Algorithm
   try {
@@ -1306,7 +1335,8 @@ bool Algorithm::doCallProcessGroups(
  *
  * This should be called after checkGroups(), which sets up required members.
  * It goes through each member of the group(s), creates and sets an algorithm
- * for each and executes them one by one.
+ * for each and executes them one by one, or all at the same time if
+ * processGroupsInParallel() is true.
  *
  * If there are several group input workspaces, then the member of each group
  * is executed pair-wise.
@@ -1330,116 +1360,10 @@ bool Algorithm::processGroups() {
     }
   }
 
-  double progress_proportion = 1.0 / static_cast<double>(m_groupSize);
-  // Go through each entry in the input group(s)
-  for (size_t entry = 0; entry < m_groupSize; entry++) {
-    // use create Child Algorithm that look like this one
-    Algorithm_sptr alg_sptr = this->createChildAlgorithm(
-        this->name(), progress_proportion * static_cast<double>(entry),
-        progress_proportion * (1 + static_cast<double>(entry)),
-        this->isLogging(), this->version());
-    // Don't make the new algorithm a child so that it's workspaces are stored
-    // correctly
-    alg_sptr->setChild(false);
-
-    alg_sptr->setRethrows(true);
-
-    IAlgorithm *alg = alg_sptr.get();
-    // Set all non-workspace properties
-    this->copyNonWorkspaceProperties(alg, int(entry) + 1);
-
-    std::string outputBaseName;
-
-    // ---------- Set all the input workspaces ----------------------------
-    for (size_t iwp = 0; iwp < m_groups.size(); iwp++) {
-      std::vector<Workspace_sptr> &thisGroup = m_groups[iwp];
-      if (!thisGroup.empty()) {
-        // By default (for a single group) point to the first/only workspace
-        Workspace_sptr ws = thisGroup[0];
-
-        if ((m_singleGroup == int(iwp)) || m_singleGroup < 0) {
-          // Either: this is the single group
-          // OR: all inputs are groups
-          // ... so get then entry^th workspace in this group
-          ws = thisGroup[entry];
-        }
-        // Append the names together
-        if (!outputBaseName.empty())
-          outputBaseName += "_";
-        outputBaseName += ws->getName();
-
-        // Set the property using the name of that workspace
-        if (Property *prop =
-                dynamic_cast<Property *>(m_inputWorkspaceProps[iwp])) {
-          if (ws->getName().empty()) {
-            alg->setProperty(prop->name(), ws);
-          } else {
-            alg->setPropertyValue(prop->name(), ws->getName());
-          }
-        } else {
-          throw std::logic_error("Found a Workspace property which doesn't "
-                                 "inherit from Property.");
-        }
-      } // not an empty (i.e. optional) input
-    }   // for each InputWorkspace property
-
-    std::vector<std::string> outputWSNames(m_pureOutputWorkspaceProps.size());
-    // ---------- Set all the output workspaces ----------------------------
-    for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
-      if (Property *prop =
-              dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp])) {
-        // Default name = "in1_in2_out"
-        const std::string inName = prop->value();
-        if (inName.empty())
-          continue;
-        std::string outName;
-        if (m_groupsHaveSimilarNames) {
-          outName.append(inName).append("_").append(
-              Strings::toString(entry + 1));
-        } else {
-          outName.append(outputBaseName).append("_").append(inName);
-        }
-
-        auto inputProp = std::find_if(m_inputWorkspaceProps.begin(),
-                                      m_inputWorkspaceProps.end(),
-                                      WorkspacePropertyValueIs(inName));
-
-        // Overwrite workspaces in any input property if they have the same
-        // name as an output (i.e. copy name button in algorithm dialog used)
-        // (only need to do this for a single input, multiple will be handled
-        // by ADS)
-        if (inputProp != m_inputWorkspaceProps.end()) {
-          const auto &inputGroup =
-              m_groups[inputProp - m_inputWorkspaceProps.begin()];
-          if (!inputGroup.empty())
-            outName = inputGroup[entry]->getName();
-        }
-        // Except if all inputs had similar names, then the name is "out_1"
-
-        // Set in the output
-        alg->setPropertyValue(prop->name(), outName);
-
-        outputWSNames[owp] = outName;
-      } else {
-        throw std::logic_error(
-            "Found a Workspace property which doesn't inherit from Property.");
-      }
-    } // for each OutputWorkspace property
-
-    // ------------ Execute the algo --------------
-    try {
-      alg->execute();
-    } catch (std::exception &e) {
-      std::ostringstream msg;
-      msg << "Execution of " << this->name() << " for group entry "
-          << (entry + 1) << " failed: ";
-      msg << e.what(); // Add original message
-      throw std::runtime_error(msg.str());
-    }
-
-    // ------------ Fill in the output workspace group ------------------
-    // this has to be done after execute() because a workspace must exist
-    // when it is added to a group
+  // this has to be done after execute() because a workspace must exist
+  // when it is added to a group
+  auto addToOutputGroups = [this, &outGroups](
+      const std::vector<std::string> &outputWSNames) {
     for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
       Property *prop =
           dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp]);
@@ -1448,8 +1372,35 @@ bool Algorithm::processGroups() {
       // And add it to the output group
       outGroups[owp]->add(outputWSNames[owp]);
     }
+  };
+
+  const bool inParallel = m_groupSize > 1 && this->processGroupsInParallel();
+  std::vector<Algorithm_sptr> algs(m_groupSize);
+  std::vector<std::vector<std::string>> outputWSNames(m_groupSize);
+  // Go through each entry in the input group(s)
+  for (size_t entry = 0; entry < m_groupSize; entry++) {
+    algs[entry] = this->createGroupMemberAlgorithm(entry, outputWSNames[entry]);
+    if (!inParallel) {
+      executeGroupMember(*algs[entry], entry);
+      addToOutputGroups(outputWSNames[entry]);
+      algs[entry].reset();
+    }
+  }
 
-  } // for each entry in each group
+  if (inParallel) {
+    // Each member reports its progress in its own range of the progress bar.
+    // An exception thrown by a member is thrown again by joinAll().
+    ThreadPool pool(new ThreadSchedulerFIFO());
+    for (size_t entry = 0; entry < m_groupSize; entry++) {
+      Algorithm &alg = *algs[entry];
+      pool.schedule(new FunctionTask(
+          [this, &alg, entry]() { executeGroupMember(alg, entry); }));
+    }
+    pool.joinAll();
+    // Fill the groups in the order of the inputs, whatever finished first
+    for (size_t entry = 0; entry < m_groupSize; entry++)
+      addToOutputGroups(outputWSNames[entry]);
+  }
 
   // restore group notifications
   for (auto &outGroup : outGroups) {
@@ -1459,6 +1410,135 @@ bool Algorithm::processGroups() {
   return true;
 }
 
+//--------------------------------------------------------------------------------------------
+/** Create and set up the algorithm for one entry of the input group(s),
+ * with the entry^th member of each group as input.
+ *
+ * @param entry :: index of the entry in the group(s)
+ * @param outputWSNames :: set to the names of the output workspaces of the
+ * algorithm, one per output workspace property
+ * @return the algorithm, ready to execute
+ */
+Algorithm_sptr
+Algorithm::createGroupMemberAlgorithm(const size_t entry,
+                                      std::vector<std::string> &outputWSNames) {
+  double progress_proportion = 1.0 / static_cast<double>(m_groupSize);
+  // use create Child Algorithm that look like this one
+  Algorithm_sptr alg_sptr = this->createChildAlgorithm(
+      this->name(), progress_proportion * static_cast<double>(entry),
+      progress_proportion * (1 + static_cast<double>(entry)),
+      this->isLogging(), this->version());
+  // Don't make the new algorithm a child so that it's workspaces are stored
+  // correctly
+  alg_sptr->setChild(false);
+
+  alg_sptr->setRethrows(true);
+
+  IAlgorithm *alg = alg_sptr.get();
+  // Set all non-workspace properties
+  this->copyNonWorkspaceProperties(alg, int(entry) + 1);
+
+  std::string outputBaseName;
+
+  // ---------- Set all the input workspaces ----------------------------
+  for (size_t iwp = 0; iwp < m_groups.size(); iwp++) {
+    std::vector<Workspace_sptr> &thisGroup = m_groups[iwp];
+    if (!thisGroup.empty()) {
+      // By default (for a single group) point to the first/only workspace
+      Workspace_sptr ws = thisGroup[0];
+
+      if ((m_singleGroup == int(iwp)) || m_singleGroup < 0) {
+        // Either: this is the single group
+        // OR: all inputs are groups
+        // ... so get then entry^th workspace in this group
+        ws = thisGroup[entry];
+      }
+      // Append the names together
+      if (!outputBaseName.empty())
+        outputBaseName += "_";
+      outputBaseName += ws->getName();
+
+      // Set the property using the name of that workspace
+      if (Property *prop =
+              dynamic_cast<Property *>(m_inputWorkspaceProps[iwp])) {
+        if (ws->getName().empty()) {
+          alg->setProperty(prop->name(), ws);
+        } else {
+          alg->setPropertyValue(prop->name(), ws->getName());
+        }
+      } else {
+        throw std::logic_error("Found a Workspace property which doesn't "
+                               "inherit from Property.");
+      }
+    } // not an empty (i.e. optional) input
+  }   // for each InputWorkspace property
+
+  outputWSNames.assign(m_pureOutputWorkspaceProps.size(), std::string());
+  // ---------- Set all the output workspaces ----------------------------
+  for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
+    if (Property *prop =
+            dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp])) {
+      // Default name = "in1_in2_out"
+      const std::string inName = prop->value();
+      if (inName.empty())
+        continue;
+      std::string outName;
+      if (m_groupsHaveSimilarNames) {
+        outName.append(inName).append("_").append(
+            Strings::toString(entry + 1));
+      } else {
+        outName.append(outputBaseName).append("_").append(inName);
+      }
+
+      auto inputProp = std::find_if(m_inputWorkspaceProps.begin(),
+                                    m_inputWorkspaceProps.end(),
+                                    WorkspacePropertyValueIs(inName));
+
+      // Overwrite workspaces in any input property if they have the same
+      // name as an output (i.e. copy name button in algorithm dialog used)
+      // (only need to do this for a single input, multiple will be handled
+      // by ADS)
+      if (inputProp != m_inputWorkspaceProps.end()) {
+        const auto &inputGroup =
+            m_groups[inputProp - m_inputWorkspaceProps.begin()];
+        if (!inputGroup.empty())
+          outName = inputGroup[entry]->getName();
+      }
+      // Except if all inputs had similar names, then the name is "out_1"
+
+      // Set in the output
+      alg->setPropertyValue(prop->name(), outName);
+
+      outputWSNames[owp] = outName;
+    } else {
+      throw std::logic_error(
+          "Found a Workspace property which doesn't inherit from Property.");
+    }
+  } // for each OutputWorkspace property
+
+  return alg_sptr;
+}
+
+//--------------------------------------------------------------------------------------------
+/** Execute the algorithm of one entry of the input group(s)
+ *
+ * @param alg :: the algorithm made by createGroupMemberAlgorithm()
+ * @param entry :: index of the entry in the group(s)
+ * @throw std::runtime_error if the execution fails
+ */
+void Algorithm::executeGroupMember(Algorithm &alg, const size_t entry) {
+  alg.m_profileParent = m_profileIndex;
+  try {
+    alg.execute();
+  } catch (std::exception &e) {
+    std::ostringstream msg;
+    msg << "Execution of " << this->name() << " for group entry "
+        << (entry + 1) << " failed: ";
+    msg << e.what(); // Add original message
+    throw std::runtime_error(msg.str());
+  }
+}
+
 //--------------------------------------------------------------------------------------------
 /** Copy all the non-workspace properties from this to alg
  *
@@ -0,0 +1,288 @@
+#include "MantidAPI/AlgorithmProfiler.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/Memory.h"
+
+#include <json/json.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace Mantid {
+namespace API {
+namespace {
+/// static logger
+Kernel::Logger g_log("AlgorithmProfiler");
+
+/// @return the peak resident memory of the process in bytes
+size_t peakRSS() {
+  // Only the process is needed, so skip the expensive system queries
+  static Kernel::MemoryStats stats(Kernel::MEMORY_STATS_IGNORE_SYSTEM);
+  return stats.getPeakRSS();
+}
+
+/// @return the CPU time used by the calling thread in seconds, or 0 if it is
+/// not available
+double threadCPUTime() {
+#ifdef _WIN32
+  FILETIME creation, exitTime, kernel, user;
+  if (!GetThreadTimes(GetCurrentThread(), &creation, &exitTime, &kernel,
+                      &user))
+    return 0.;
+  ULARGE_INTEGER kernelTime, userTime;
+  kernelTime.LowPart = kernel.dwLowDateTime;
+  kernelTime.HighPart = kernel.dwHighDateTime;
+  userTime.LowPart = user.dwLowDateTime;
+  userTime.HighPart = user.dwHighDateTime;
+  // In units of 100 ns
+  return static_cast<double>(kernelTime.QuadPart + userTime.QuadPart) * 1e-7;
+#else
+  timespec time;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0)
+    return 0.;
+  return static_cast<double>(time.tv_sec) +
+         static_cast<double>(time.tv_nsec) * 1e-9;
+#endif
+}
+
+/// @return the seconds from one time point to another
+double secondsBetween(const std::chrono::steady_clock::time_point &from,
+                      const std::chrono::steady_clock::time_point &to) {
+  return std::chrono::duration<double>(to - from).count();
+}
+
+/// @return true if the filename ends with .json, ignoring the case
+bool isJSONFilename(const std::string &filename) {
+  const std::string extension(".json");
+  if (filename.size() < extension.size())
+    return false;
+  std::string end = filename.substr(filename.size() - extension.size());
+  std::transform(end.begin(), end.end(), end.begin(), ::tolower);
+  return end == extension;
+}
+} // namespace
+
+constexpr size_t AlgorithmProfilerImpl::NO_PARENT;
+constexpr size_t AlgorithmProfilerImpl::DEFAULT_MAX_ENTRIES;
+
+/// Private Constructor for singleton class
+AlgorithmProfilerImpl::AlgorithmProfilerImpl()
+    : m_enabled(false), m_origin(std::chrono::steady_clock::now()),
+      m_first(0), m_maxEntries(DEFAULT_MAX_ENTRIES), m_truncated(false) {
+  auto &config = Kernel::ConfigService::Instance();
+  int enabled(0);
+  if (config.getValue("algorithms.profiling.enabled", enabled))
+    m_enabled = enabled > 0;
+  int maxEntries(0);
+  if (config.getValue("algorithms.profiling.maxentries", maxEntries) &&
+      maxEntries >= 0)
+    m_maxEntries = static_cast<size_t>(maxEntries);
+  m_filename = config.getString("algorithms.profiling.filename");
+}
+
+/** Start or stop recording the executions of algorithms. The executions
+ * already running when recording starts are not recorded.
+ * @param enabled :: true to record the executions
+ */
+void AlgorithmProfilerImpl::setEnabled(const bool enabled) {
+  m_enabled = enabled;
+}
+
+/** Set the number of entries kept until the next clear(). Executions
+ * starting once it is reached are not recorded.
+ * @param maxEntries :: the maximum number of entries
+ */
+void AlgorithmProfilerImpl::setMaxEntries(const size_t maxEntries) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_maxEntries = maxEntries;
+}
+
+/** Record the start of the execution of an algorithm
+ * @param name :: name of the algorithm
+ * @param version :: version of the algorithm
+ * @param parent :: index returned by start() for the parent algorithm, or
+ * NO_PARENT for a top level algorithm
+ * @return the index to pass to stop() at the end of the execution, or
+ * NO_PARENT if the maximum number of entries was reached
+ */
+size_t AlgorithmProfilerImpl::start(const std::string &name, const int version,
+                                    const size_t parent) {
+  Start values;
+  values.peakRSS = peakRSS();
+  values.cpuTime = threadCPUTime();
+  values.wallTime = std::chrono::steady_clock::now();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_entries.size() >= m_maxEntries) {
+    if (!m_truncated)
+      g_log.warning() << "The algorithm profile reached its maximum of "
+                      << m_maxEntries << " entries. Further executions are "
+                                         "not recorded until it is cleared.\n";
+    m_truncated = true;
+    return NO_PARENT;
+  }
+  Entry entry;
+  entry.name = name;
+  entry.version = version;
+  // The parent may have been cleared
+  entry.parent = (parent != NO_PARENT && parent >= m_first) ? parent - m_first
+                                                             : NO_PARENT;
+  const auto thread = m_threads.emplace(std::this_thread::get_id(),
+                                        static_cast<int>(m_threads.size()));
+  entry.thread = thread.first->second;
+  entry.start = secondsBetween(m_origin, values.wallTime);
+  entry.wallTime = 0.;
+  entry.cpuTime = 0.;
+  entry.peakRSSDelta = 0.;
+  entry.finished = false;
+  m_entries.push_back(entry);
+  m_starts.push_back(values);
+  return m_first + m_entries.size() - 1;
+}
+
+/** Record the end of the execution of an algorithm
+ * @param index :: the index returned by start()
+ */
+void AlgorithmProfilerImpl::stop(const size_t index) {
+  const auto wallTime = std::chrono::steady_clock::now();
+  const auto cpuTime = threadCPUTime();
+  const auto rss = peakRSS();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  // The entry may have been cleared, or not recorded
+  if (index < m_first || index - m_first >= m_entries.size())
+    return;
+  auto &entry = m_entries[index - m_first];
+  const auto &values = m_starts[index - m_first];
+  entry.wallTime = secondsBetween(values.wallTime, wallTime);
+  entry.cpuTime = std::max(cpuTime - values.cpuTime, 0.);
+  entry.peakRSSDelta =
+      rss > values.peakRSS ? static_cast<double>(rss - values.peakRSS) / 1024.
+                           : 0.;
+  entry.finished = true;
+}
+
+/// @return a copy of the entries, in the order the executions started
+std::vector<AlgorithmProfilerImpl::Entry>
+AlgorithmProfilerImpl::entries() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries;
+}
+
+/// Forget the entries recorded so far and restart the clock
+void AlgorithmProfilerImpl::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_first += m_entries.size();
+  m_entries.clear();
+  m_starts.clear();
+  m_truncated = false;
+  m_origin = std::chrono::steady_clock::now();
+}
+
+/** Format the finished entries in the Trace Event Format of Chrome, to be
+ * loaded in chrome://tracing. Each thread is shown on its own row.
+ * @return the trace as a JSON string
+ */
+std::string AlgorithmProfilerImpl::chromeTrace() const {
+  const auto entries = this->entries();
+  ::Json::Value events(::Json::arrayValue);
+  for (const auto &entry : entries) {
+    if (!entry.finished)
+      continue;
+    ::Json::Value event;
+    event["name"] = entry.name;
+    event["cat"] = "algorithm";
+    event["ph"] = "X";
+    event["ts"] = entry.start * 1e6;
+    event["dur"] = entry.wallTime * 1e6;
+    event["pid"] = 1;
+    event["tid"] = entry.thread;
+    ::Json::Value args;
+    args["version"] = entry.version;
+    args["cpu_time"] = entry.cpuTime;
+    args["thread_utilisation"] =
+        entry.wallTime > 0. ? entry.cpuTime / entry.wallTime : 0.;
+    args["peak_rss_delta_kib"] = entry.peakRSSDelta;
+    event["args"] = args;
+    events.append(event);
+  }
+  ::Json::Value root;
+  root["traceEvents"] = events;
+  root["displayTimeUnit"] = "ms";
+  ::Json::FastWriter writer;
+  return writer.write(root);
+}
+
+/** Format the finished entries as collapsed stacks, one line per stack of
+ * algorithms with the time spent in the last one outside of its children,
+ * in microseconds. This is the input of flamegraph.pl and speedscope.
+ * @return the stacks, one per line
+ */
+std::string AlgorithmProfilerImpl::collapsedStacks() const {
+  const auto entries = this->entries();
+  std::vector<double> selfTime(entries.size());
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (!entries[i].finished)
+      continue;
+    selfTime[i] += entries[i].wallTime;
+    const auto parent = entries[i].parent;
+    if (parent != NO_PARENT)
+      selfTime[parent] -= entries[i].wallTime;
+  }
+
+  // Children finishing on other threads can overlap, so clamp at 0
+  std::map<std::string, double> stacks;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (!entries[i].finished)
+      continue;
+    std::string stack;
+    for (auto index = i; index != NO_PARENT; index = entries[index].parent) {
+      const std::string frame =
+          entries[index].name + ".v" + std::to_string(entries[index].version);
+      stack = stack.empty() ? frame : frame + ";" + stack;
+    }
+    stacks[stack] += std::max(selfTime[i], 0.);
+  }
+
+  std::ostringstream out;
+  for (const auto &stack : stacks)
+    out << stack.first << ' '
+        << static_cast<uint64_t>(stack.second * 1e6 + 0.5) << '\n';
+  return out.str();
+}
+
+/** Save the finished entries to a file
+ * @param filename :: the file to write. A Chrome trace is written if it ends
+ * with .json, collapsed stacks otherwise.
+ * @throw std::runtime_error if the file cannot be written
+ */
+void AlgorithmProfilerImpl::save(const std::string &filename) const {
+  std::ofstream file(filename);
+  if (!file)
+    throw std::runtime_error("Unable to open " + filename +
+                             " to save the algorithm profile");
+  file << (isJSONFilename(filename) ? chromeTrace() : collapsedStacks());
+}
+
+/// Save the entries to algorithms.profiling.filename, if it is set
+void AlgorithmProfilerImpl::shutdown() {
+  if (m_filename.empty() || entries().empty())
+    return;
+  try {
+    save(m_filename);
+    g_log.notice() << "Algorithm profile saved to " << m_filename << '\n';
+  } catch (std::exception &e) {
+    g_log.error() << e.what() << '\n';
+  }
+}
+
+} // namespace API
+} // namespace Mantid
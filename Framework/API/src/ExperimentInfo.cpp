@@ -1139,6 +1139,8 @@ void ExperimentInfo::invalidateSpectrumDefinition(const size_t index) {
   // This uses a vector of char, such that flags for different indices can be
   // set from different threads (std::vector<bool> is not thread-safe).
   m_spectrumDefinitionNeedsUpdate.at(index) = 1;
+  if (m_spectrumInfoWrapper)
+    m_spectrumInfoWrapper->invalidateGeometryArrays();
 }
 
 void ExperimentInfo::updateSpectrumDefinitionIfNecessary(
@@ -1192,6 +1194,8 @@ size_t ExperimentInfo::groupOfDetectorID(const detid_t detID) const {
 void ExperimentInfo::invalidateAllSpectrumDefinitions() {
   std::fill(m_spectrumDefinitionNeedsUpdate.begin(),
             m_spectrumDefinitionNeedsUpdate.end(), 1);
+  if (m_spectrumInfoWrapper)
+    m_spectrumInfoWrapper->invalidateGeometryArrays();
 }
 
 /** Save the object to an open NeXus file.
@@ -1,4 +1,5 @@
 #include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/AlgorithmProfiler.h"
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/FrameworkManager.h"
 #include "MantidAPI/InstrumentDataService.h"
@@ -201,6 +202,7 @@ void FrameworkManagerImpl::clear() {
 
 void FrameworkManagerImpl::shutdown() {
   Kernel::UsageService::Instance().shutdown();
+  AlgorithmProfiler::Instance().shutdown();
   clear();
 }
 
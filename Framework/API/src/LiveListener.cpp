@@ -1,9 +1,45 @@
 #include "MantidAPI/LiveListener.h"
 #include "MantidAPI/IAlgorithm.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAPI/Run.h"
+#include "MantidAPI/WorkspaceFactory.h"
 
 namespace Mantid {
 namespace API {
 
+namespace {
+/**
+ * Create an empty workspace of the type and size of a buffer, with the same
+ * instrument, spectra and logs but without the values of the time series logs
+ * @param buffer :: The buffer to copy
+ * @return An empty copy of the buffer, with an empty copy of its monitor
+ * workspace if it has one
+ */
+MatrixWorkspace_sptr createEmptyBuffer(const MatrixWorkspace &buffer) {
+  const size_t numberOfHistograms = buffer.getNumberHistograms();
+  const size_t xLength = numberOfHistograms > 0 ? buffer.x(0).size() : 1;
+  const size_t yLength = numberOfHistograms > 0 ? buffer.blocksize() : 1;
+  auto empty = WorkspaceFactory::Instance().create(
+      buffer.id(), numberOfHistograms, xLength, yLength);
+  WorkspaceFactory::Instance().initializeFromParent(buffer, *empty, false);
+  empty->mutableRun().clearTimeSeriesLogs();
+  if (const auto monitors = buffer.monitorWorkspace())
+    empty->setMonitorWorkspace(createEmptyBuffer(*monitors));
+  return empty;
+}
+
+/// Create an empty copy of each buffer
+template <class Workspace_sptr>
+std::vector<MatrixWorkspace_sptr>
+createEmptyBuffers(const std::vector<Workspace_sptr> &buffers) {
+  std::vector<MatrixWorkspace_sptr> empty;
+  empty.reserve(buffers.size());
+  for (const auto &buffer : buffers)
+    empty.push_back(createEmptyBuffer(*buffer));
+  return empty;
+}
+} // namespace
+
 /// @copydoc ILiveListener::dataReset
 bool LiveListener::dataReset() {
   const bool retval = m_dataReset;
@@ -28,5 +64,48 @@ void LiveListener::setAlgorithm(const IAlgorithm &callingAlgorithm) {
   this->updatePropertyValues(callingAlgorithm);
 }
 
+/**
+ * Set the buffers the spare buffers are copied from and start creating the
+ * first spare buffers in the background. Only the instrument, spectra and
+ * logs of the buffers are copied, once here, so they must not be modified by
+ * another thread during the call.
+ * @param buffers :: The buffer workspaces the listener accumulates data in
+ */
+void LiveListener::initSpareBuffers(
+    const std::vector<MatrixWorkspace_sptr> &buffers) {
+  std::vector<MatrixWorkspace_const_sptr> prototypes;
+  for (const auto &prototype : createEmptyBuffers(buffers))
+    prototypes.push_back(prototype);
+
+  std::lock_guard<std::mutex> lock(m_spareBuffersMutex);
+  m_bufferPrototypes = prototypes;
+  m_spareBuffers = std::async(std::launch::async, [prototypes]() {
+    return createEmptyBuffers(prototypes);
+  });
+}
+
+/**
+ * Take empty buffers, copies of the buffers given to initSpareBuffers(), to
+ * swap with the buffers holding the data to extract. The buffers are normally
+ * ready, as they were created in the background after the previous call, and
+ * the next ones are started before returning.
+ * @return The spare buffers, in the order of initSpareBuffers(), or an empty
+ * vector if initSpareBuffers() has not been called
+ */
+std::vector<MatrixWorkspace_sptr> LiveListener::takeSpareBuffers() {
+  std::future<std::vector<MatrixWorkspace_sptr>> spareBuffers;
+  {
+    std::lock_guard<std::mutex> lock(m_spareBuffersMutex);
+    if (m_bufferPrototypes.empty())
+      return {};
+    spareBuffers = std::move(m_spareBuffers);
+    const auto prototypes = m_bufferPrototypes;
+    m_spareBuffers = std::async(std::launch::async, [prototypes]() {
+      return createEmptyBuffers(prototypes);
+    });
+  }
+  return spareBuffers.get();
+}
+
 } // namespace API
 } // namespace Mantid
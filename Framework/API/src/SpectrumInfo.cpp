@@ -1,5 +1,6 @@
 #include "MantidAPI/ExperimentInfo.h"
 #include "MantidAPI/SpectrumInfo.h"
+#include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/DetectorGroup.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidBeamline/SpectrumInfo.h"
@@ -9,6 +10,8 @@
 
 #include <boost/make_shared.hpp>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace Mantid {
 namespace API {
@@ -114,6 +117,84 @@ bool SpectrumInfo::hasUniqueDetector(const size_t index) const {
   return spectrumDefinition(index).size() == 1;
 }
 
+/** Returns L2 of all spectra, by spectrum index, as given by l2().
+ *
+ * The value is NaN for spectra without detectors. The array is computed once
+ * and kept until the geometry or the grouping of the detectors changes, so get
+ * it once before a loop over spectra rather than calling l2() for every
+ * spectrum. Not available for scanning instruments. */
+boost::shared_ptr<const std::vector<double>> SpectrumInfo::l2s() const {
+  const auto detectorL2s = m_detectorInfo.l2s();
+  return geometryArray(m_l2s, [this, &detectorL2s](std::vector<double> &l2s) {
+    averageOverDetectors(*detectorL2s, l2s);
+  });
+}
+
+/** Returns 2 theta of all spectra, by spectrum index, as given by twoTheta().
+ * The value is NaN for monitors and spectra without detectors. See l2s() for
+ * the lifetime of the array. */
+boost::shared_ptr<const std::vector<double>> SpectrumInfo::twoThetas() const {
+  const auto detectorTwoThetas = m_detectorInfo.twoThetas();
+  return geometryArray(
+      m_twoThetas, [this, &detectorTwoThetas](std::vector<double> &twoThetas) {
+        averageOverDetectors(*detectorTwoThetas, twoThetas);
+      });
+}
+
+/** Returns the azimuthal angle of all spectra, by spectrum index, in radians.
+ * This is the angle in the XY plane of the mean position of the detectors, as
+ * given by IDetector::getPhi(). The value is NaN for spectra without
+ * detectors. See l2s() for the lifetime of the array. */
+boost::shared_ptr<const std::vector<double>> SpectrumInfo::azimuths() const {
+  return geometryArray(m_azimuths, [this](std::vector<double> &azimuths) {
+    for (size_t i = 0; i < azimuths.size(); ++i) {
+      const auto &specDef = spectrumDefinition(i);
+      if (specDef.size() == 0) {
+        azimuths[i] = std::numeric_limits<double>::quiet_NaN();
+        continue;
+      }
+      Kernel::V3D pos;
+      for (const auto &detIndex : specDef)
+        pos += m_detectorInfo.position(detIndex);
+      azimuths[i] = std::atan2(pos.Y(), pos.X());
+    }
+  });
+}
+
+/** Returns DIFC, the factor converting d-spacing to time of flight, of all
+ * spectra, by spectrum index. It is computed from the L2 and 2 theta of the
+ * spectra. The value is NaN for monitors and spectra without detectors. See
+ * l2s() for the lifetime of the array. */
+boost::shared_ptr<const std::vector<double>> SpectrumInfo::difcs() const {
+  // Get these before locking, geometryArray() is not reentrant
+  const auto l2s = this->l2s();
+  const auto twoThetas = this->twoThetas();
+  return geometryArray(
+      m_difcs, [this, &l2s, &twoThetas](std::vector<double> &difcs) {
+        const auto l1 = this->l1();
+        for (size_t i = 0; i < difcs.size(); ++i)
+          difcs[i] = 1. / Geometry::Conversion::tofToDSpacingFactor(
+                              l1, (*l2s)[i], (*twoThetas)[i], 0.);
+      });
+}
+
+/** Returns the solid angle of all spectra seen from the sample, by spectrum
+ * index. This is the sum over the detectors of the spectrum, zero for spectra
+ * without detectors. See l2s() for the lifetime of the array. */
+boost::shared_ptr<const std::vector<double>>
+SpectrumInfo::solidAngles() const {
+  const auto detectorAngles = m_detectorInfo.solidAngles();
+  return geometryArray(
+      m_solidAngles, [this, &detectorAngles](std::vector<double> &angles) {
+        for (size_t i = 0; i < angles.size(); ++i) {
+          double angle{0.0};
+          for (const auto &detIndex : spectrumDefinition(i))
+            angle += (*detectorAngles)[detIndex.first];
+          angles[i] = angle;
+        }
+      });
+}
+
 /** Set the mask flag of the spectrum with given index. Not thread safe.
  *
  * Currently this simply sets the mask flags for the underlying detectors. */
@@ -141,6 +222,48 @@ Kernel::V3D SpectrumInfo::samplePosition() const {
 /// Returns L1 (distance from source to sample).
 double SpectrumInfo::l1() const { return m_detectorInfo.l1(); }
 
+/// Returns the values in `array`, computing them with `compute` if the
+/// geometry or the spectrum definitions changed since they were last computed.
+template <class Compute>
+boost::shared_ptr<const std::vector<double>>
+SpectrumInfo::geometryArray(GeometryArray &array,
+                            const Compute &compute) const {
+  std::lock_guard<std::mutex> lock(m_geometryArrayMutex);
+  const auto revision = m_detectorInfo.geometryRevision();
+  const size_t spectrumDefinitionRevision = m_spectrumDefinitionRevision;
+  if (!array.values || array.revision != revision ||
+      array.spectrumDefinitionRevision != spectrumDefinitionRevision) {
+    auto values = boost::make_shared<std::vector<double>>(size());
+    compute(*values);
+    array.values = std::move(values);
+    array.revision = revision;
+    array.spectrumDefinitionRevision = spectrumDefinitionRevision;
+  }
+  return array.values;
+}
+
+/// Sets `values` to the mean of `detectorValues` over the detectors of each
+/// spectrum, NaN for spectra without detectors.
+void SpectrumInfo::averageOverDetectors(
+    const std::vector<double> &detectorValues,
+    std::vector<double> &values) const {
+  for (size_t i = 0; i < values.size(); ++i) {
+    const auto &specDef = spectrumDefinition(i);
+    double sum{0.0};
+    for (const auto &detIndex : specDef)
+      sum += detectorValues[detIndex.first];
+    values[i] = specDef.size() == 0
+                    ? std::numeric_limits<double>::quiet_NaN()
+                    : sum / static_cast<double>(specDef.size());
+  }
+}
+
+/// Marks the arrays returned by l2s() etc. as out of date. Thread safe, used
+/// by ExperimentInfo when spectrum definitions are invalidated.
+void SpectrumInfo::invalidateGeometryArrays() {
+  ++m_spectrumDefinitionRevision;
+}
+
 const Geometry::IDetector &SpectrumInfo::getDetector(const size_t index) const {
   size_t thread = static_cast<size_t>(PARALLEL_THREAD_NUMBER);
   if (m_lastIndex[thread] == index)
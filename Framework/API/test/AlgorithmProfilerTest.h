@@ -0,0 +1,213 @@
+#ifndef MANTID_API_ALGORITHMPROFILERTEST_H_
+#define MANTID_API_ALGORITHMPROFILERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/AlgorithmProfiler.h"
+
+#include <Poco/File.h>
+#include <Poco/TemporaryFile.h>
+
+#include <boost/make_shared.hpp>
+
+#include <fstream>
+#include <iterator>
+
+using Mantid::API::Algorithm;
+using Mantid::API::AlgorithmProfiler;
+using Mantid::API::AlgorithmProfilerImpl;
+
+namespace {
+class ProfiledChildAlgorithm : public Algorithm {
+public:
+  const std::string name() const override { return "ProfiledChild"; }
+  int version() const override { return 2; }
+  const std::string summary() const override { return "Test summary"; }
+  void init() override {}
+  void exec() override {}
+};
+
+class ProfiledParentAlgorithm : public Algorithm {
+public:
+  const std::string name() const override { return "ProfiledParent"; }
+  int version() const override { return 1; }
+  const std::string summary() const override { return "Test summary"; }
+  void init() override {}
+  void exec() override {
+    auto child = boost::make_shared<ProfiledChildAlgorithm>();
+    setupAsChildAlgorithm(child);
+    child->execute();
+    child->execute();
+  }
+};
+} // namespace
+
+class AlgorithmProfilerTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static AlgorithmProfilerTest *createSuite() {
+    return new AlgorithmProfilerTest();
+  }
+  static void destroySuite(AlgorithmProfilerTest *suite) { delete suite; }
+
+  void setUp() override {
+    auto &profiler = AlgorithmProfiler::Instance();
+    m_wasEnabled = profiler.isEnabled();
+    profiler.clear();
+  }
+
+  void tearDown() override {
+    auto &profiler = AlgorithmProfiler::Instance();
+    profiler.setEnabled(m_wasEnabled);
+    profiler.setMaxEntries(AlgorithmProfilerImpl::DEFAULT_MAX_ENTRIES);
+    profiler.clear();
+  }
+
+  void test_nothing_is_recorded_when_disabled() {
+    AlgorithmProfiler::Instance().setEnabled(false);
+    runParent();
+    TS_ASSERT(AlgorithmProfiler::Instance().entries().empty());
+  }
+
+  void test_child_algorithms_are_recorded_under_their_parent() {
+    AlgorithmProfiler::Instance().setEnabled(true);
+    runParent();
+    runParent();
+
+    const auto entries = AlgorithmProfiler::Instance().entries();
+    TS_ASSERT_EQUALS(entries.size(), 6);
+    if (entries.size() != 6)
+      return;
+    for (size_t parent = 0; parent < 6; parent += 3) {
+      TS_ASSERT_EQUALS(entries[parent].name, "ProfiledParent");
+      TS_ASSERT_EQUALS(entries[parent].version, 1);
+      TS_ASSERT_EQUALS(entries[parent].parent,
+                       AlgorithmProfilerImpl::NO_PARENT);
+      for (size_t child = parent + 1; child < parent + 3; ++child) {
+        TS_ASSERT_EQUALS(entries[child].name, "ProfiledChild");
+        TS_ASSERT_EQUALS(entries[child].version, 2);
+        TS_ASSERT_EQUALS(entries[child].parent, parent);
+        TS_ASSERT_EQUALS(entries[child].thread, entries[parent].thread);
+        TS_ASSERT_LESS_THAN_EQUALS(entries[parent].start, entries[child].start);
+        TS_ASSERT_LESS_THAN_EQUALS(entries[child].wallTime,
+                                   entries[parent].wallTime);
+      }
+    }
+    for (const auto &entry : entries) {
+      TS_ASSERT(entry.finished);
+      TS_ASSERT_LESS_THAN_EQUALS(0., entry.wallTime);
+      TS_ASSERT_LESS_THAN_EQUALS(0., entry.cpuTime);
+      TS_ASSERT_LESS_THAN_EQUALS(0., entry.peakRSSDelta);
+    }
+  }
+
+  void test_entries_started_before_clear_are_ignored() {
+    auto &profiler = AlgorithmProfiler::Instance();
+    profiler.setEnabled(true);
+    const auto parent =
+        profiler.start("Cleared", 1, AlgorithmProfilerImpl::NO_PARENT);
+    profiler.clear();
+    const auto child = profiler.start("Child", 1, parent);
+    profiler.stop(parent);
+    profiler.stop(child);
+
+    const auto entries = profiler.entries();
+    TS_ASSERT_EQUALS(entries.size(), 1);
+    TS_ASSERT_EQUALS(entries.front().name, "Child");
+    TS_ASSERT_EQUALS(entries.front().parent,
+                     AlgorithmProfilerImpl::NO_PARENT);
+    TS_ASSERT(entries.front().finished);
+  }
+
+  void test_executions_beyond_the_maximum_are_not_recorded() {
+    auto &profiler = AlgorithmProfiler::Instance();
+    profiler.setEnabled(true);
+    profiler.setMaxEntries(2);
+    runParent();
+
+    const auto entries = profiler.entries();
+    TS_ASSERT_EQUALS(entries.size(), 2);
+    for (const auto &entry : entries)
+      TS_ASSERT(entry.finished);
+    // Clearing makes room again
+    profiler.clear();
+    runParent();
+    TS_ASSERT_EQUALS(profiler.entries().size(), 2);
+  }
+
+  void test_chromeTrace_has_one_event_per_execution() {
+    AlgorithmProfiler::Instance().setEnabled(true);
+    runParent();
+
+    const auto trace = AlgorithmProfiler::Instance().chromeTrace();
+    TS_ASSERT_EQUALS(trace.find("{\"displayTimeUnit\":\"ms\""), 0);
+    TS_ASSERT_EQUALS(countOf(trace, "\"ph\":\"X\""), 3);
+    TS_ASSERT_EQUALS(countOf(trace, "\"name\":\"ProfiledParent\""), 1);
+    TS_ASSERT_EQUALS(countOf(trace, "\"name\":\"ProfiledChild\""), 2);
+    TS_ASSERT_EQUALS(countOf(trace, "\"thread_utilisation\""), 3);
+    TS_ASSERT_EQUALS(countOf(trace, "\"peak_rss_delta_kib\""), 3);
+  }
+
+  void test_collapsedStacks_merges_identical_stacks() {
+    AlgorithmProfiler::Instance().setEnabled(true);
+    runParent();
+    runParent();
+
+    const auto stacks = AlgorithmProfiler::Instance().collapsedStacks();
+    TS_ASSERT_EQUALS(countOf(stacks, "\n"), 2);
+    TS_ASSERT_EQUALS(stacks.find("ProfiledParent.v1 "), 0);
+    TS_ASSERT_DIFFERS(stacks.find("\nProfiledParent.v1;ProfiledChild.v2 "),
+                      std::string::npos);
+  }
+
+  void test_save_chooses_the_format_from_the_extension() {
+    AlgorithmProfiler::Instance().setEnabled(true);
+    runParent();
+
+    Poco::TemporaryFile jsonFile;
+    const std::string jsonPath = jsonFile.path() + ".json";
+    AlgorithmProfiler::Instance().save(jsonPath);
+    TS_ASSERT_EQUALS(readFile(jsonPath),
+                     AlgorithmProfiler::Instance().chromeTrace());
+    Poco::File(jsonPath).remove();
+
+    Poco::TemporaryFile stacksFile;
+    AlgorithmProfiler::Instance().save(stacksFile.path());
+    TS_ASSERT_EQUALS(readFile(stacksFile.path()),
+                     AlgorithmProfiler::Instance().collapsedStacks());
+  }
+
+  void test_save_throws_if_the_file_cannot_be_written() {
+    TS_ASSERT_THROWS(AlgorithmProfiler::Instance().save(
+                         "/nonexistent_directory/profile.json"),
+                     std::runtime_error);
+  }
+
+private:
+  void runParent() {
+    ProfiledParentAlgorithm alg;
+    alg.initialize();
+    alg.setRethrows(true);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+  }
+
+  size_t countOf(const std::string &text, const std::string &pattern) {
+    size_t count(0);
+    for (auto pos = text.find(pattern); pos != std::string::npos;
+         pos = text.find(pattern, pos + pattern.size()))
+      ++count;
+    return count;
+  }
+
+  std::string readFile(const std::string &path) {
+    std::ifstream file(path);
+    return std::string(std::istreambuf_iterator<char>(file),
+                       std::istreambuf_iterator<char>());
+  }
+
+  bool m_wasEnabled{false};
+};
+
+#endif /* MANTID_API_ALGORITHMPROFILERTEST_H_ */
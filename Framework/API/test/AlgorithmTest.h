@@ -71,6 +71,18 @@ public:
 };
 DECLARE_ALGORITHM(StubbedWorkspaceAlgorithm)
 
+/// StubbedWorkspaceAlgorithm executed on all the group members at once
+class StubbedParallelGroupsAlgorithm : public StubbedWorkspaceAlgorithm {
+public:
+  const std::string name() const override {
+    return "StubbedParallelGroupsAlgorithm";
+  }
+
+protected:
+  bool processGroupsInParallel() const override { return true; }
+};
+DECLARE_ALGORITHM(StubbedParallelGroupsAlgorithm)
+
 class StubbedWorkspaceAlgorithm2 : public Algorithm {
 public:
   StubbedWorkspaceAlgorithm2() : Algorithm() {}
@@ -162,6 +174,18 @@ const std::string FailingAlgorithm::FAIL_MSG("Algorithm failed as requested");
 
 DECLARE_ALGORITHM(FailingAlgorithm)
 
+/// FailingAlgorithm executed on all the group members at once
+class FailingParallelGroupsAlgorithm : public FailingAlgorithm {
+public:
+  const std::string name() const override {
+    return "FailingParallelGroupsAlgorithm";
+  }
+
+protected:
+  bool processGroupsInParallel() const override { return true; }
+};
+DECLARE_ALGORITHM(FailingParallelGroupsAlgorithm)
+
 class IndexingAlgorithm : public Algorithm {
 public:
   const std::string name() const override { return "IndexingAlgorithm"; }
@@ -754,6 +778,63 @@ public:
     }
   }
 
+  void test_processGroups_inParallel() {
+    Mantid::API::AnalysisDataService::Instance().clear();
+    makeWorkspaceGroup("A", "A_1,A_2,A_3,A_4,A_5,A_6,A_7,A_8");
+    makeWorkspaceGroup("B", "");
+    makeWorkspaceGroup("C", "C_1,C_2,C_3,C_4,C_5,C_6,C_7,C_8");
+
+    StubbedParallelGroupsAlgorithm alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace1", "A");
+    alg.setPropertyValue("InputWorkspace2", "B");
+    alg.setPropertyValue("InOutWorkspace", "C");
+    alg.setPropertyValue("Number", "234");
+    alg.setPropertyValue("OutputWorkspace1", "D");
+    alg.setPropertyValue("OutputWorkspace2", "E");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+
+    // The outputs are in the order of the inputs
+    auto &ads = AnalysisDataService::Instance();
+    for (const auto &outName : {"D", "E"}) {
+      auto group = ads.retrieveWS<WorkspaceGroup>(outName);
+      TS_ASSERT(group);
+      if (!group)
+        return;
+      TS_ASSERT_EQUALS(group->getNumberOfEntries(), 8);
+      for (int i = 0; i < group->getNumberOfEntries(); ++i) {
+        const std::string entry = std::to_string(i + 1);
+        auto ws = group->getItem(i);
+        TS_ASSERT_EQUALS(ws->getName(), outName + ("_" + entry));
+        TS_ASSERT_EQUALS(ws->getTitle(), "A_" + entry + "+B+C_" + entry);
+      }
+    }
+  }
+
+  void test_processGroups_inParallel_failOnGroupMemberErrorMessage() {
+    makeWorkspaceGroup("A", "A_1,A_2,A_3,A_4");
+
+    FailingParallelGroupsAlgorithm alg;
+    alg.initialize();
+    alg.setRethrows(true);
+    alg.setLogging(false);
+    alg.setPropertyValue("InputWorkspace", "A");
+    alg.setPropertyValue("WsNameToFail", "A_3");
+
+    try {
+      alg.execute();
+      TS_FAIL("Exception wasn't thrown");
+    } catch (std::runtime_error &e) {
+      std::string msg(e.what());
+      TSM_ASSERT("Error message should name the group entry",
+                 msg.find("group entry 3") != std::string::npos);
+      TSM_ASSERT("Error message should contain original error",
+                 msg.find(FailingAlgorithm::FAIL_MSG) != std::string::npos);
+    }
+    TS_ASSERT(!alg.isExecuted());
+  }
+
   /// Rewrite first input group
   void test_processGroups_rewriteFirstGroup() {
     Mantid::API::AnalysisDataService::Instance().clear();
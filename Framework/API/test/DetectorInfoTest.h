@@ -3,6 +3,7 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/ComponentInfo.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
@@ -11,6 +12,7 @@
 #include "MantidTestHelpers/InstrumentCreationHelper.h"
 
 #include <algorithm>
+#include <cmath>
 
 using namespace Mantid;
 using namespace Mantid::Kernel;
@@ -159,6 +161,54 @@ public:
     TS_ASSERT_THROWS(detectorInfo.signedTwoTheta(4), std::logic_error);
   }
 
+  void test_arrays_match_the_values_of_each_detector() {
+    const auto &detectorInfo = m_workspace.detectorInfo();
+    const auto l2s = detectorInfo.l2s();
+    const auto twoThetas = detectorInfo.twoThetas();
+    const auto azimuths = detectorInfo.azimuths();
+    const auto difcs = detectorInfo.difcs();
+    const auto solidAngles = detectorInfo.solidAngles();
+    TS_ASSERT_EQUALS(l2s->size(), detectorInfo.size());
+    const auto samplePos = detectorInfo.samplePosition();
+    for (size_t i = 0; i < detectorInfo.size(); ++i) {
+      TS_ASSERT_EQUALS((*l2s)[i], detectorInfo.l2(i));
+      TS_ASSERT_EQUALS((*azimuths)[i], detectorInfo.detector(i).getPhi());
+      TS_ASSERT_EQUALS((*solidAngles)[i],
+                       detectorInfo.detector(i).solidAngle(samplePos));
+      if (detectorInfo.isMonitor(i)) {
+        TS_ASSERT(std::isnan((*twoThetas)[i]));
+        TS_ASSERT(std::isnan((*difcs)[i]));
+        continue;
+      }
+      TS_ASSERT_EQUALS((*twoThetas)[i], detectorInfo.twoTheta(i));
+      TS_ASSERT_EQUALS((*difcs)[i],
+                       1. / Conversion::tofToDSpacingFactor(
+                                detectorInfo.l1(), detectorInfo.l2(i),
+                                detectorInfo.twoTheta(i), 0.));
+    }
+  }
+
+  void test_arrays_are_recomputed_when_the_geometry_changes() {
+    auto &detectorInfo = m_workspace.mutableDetectorInfo();
+    const auto l2s = detectorInfo.l2s();
+    TS_ASSERT_EQUALS(detectorInfo.l2s(), l2s);
+
+    const auto oldPos = detectorInfo.position(1);
+    detectorInfo.setPosition(1, V3D(0.0, 0.0, 7.0));
+    TS_ASSERT_EQUALS((*detectorInfo.l2s())[1], 7.0);
+    TS_ASSERT_EQUALS((*l2s)[1], 5.0);
+    detectorInfo.setPosition(1, oldPos);
+    TS_ASSERT_EQUALS((*detectorInfo.l2s())[1], 5.0);
+
+    // Moving the sample changes all detectors
+    auto &componentInfo = m_workspace.mutableComponentInfo();
+    const auto oldSamplePos = componentInfo.samplePosition();
+    componentInfo.setPosition(componentInfo.sample(), V3D(0.0, 0.0, 1.0));
+    TS_ASSERT_EQUALS((*detectorInfo.l2s())[1], 4.0);
+    componentInfo.setPosition(componentInfo.sample(), oldSamplePos);
+    TS_ASSERT_EQUALS((*detectorInfo.l2s())[1], 5.0);
+  }
+
   void test_position() {
     const auto &detectorInfo = m_workspace.detectorInfo();
     TS_ASSERT_EQUALS(detectorInfo.position(0), V3D(0.0, -0.1, 5.0));
@@ -3,7 +3,11 @@
 
 #include "MantidAPI/IAlgorithm.h"
 #include "MantidAPI/LiveListener.h"
+#include "MantidAPI/Run.h"
+#include "MantidAPI/WorkspaceFactory.h"
+#include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/WarningSuppressions.h"
+#include "MantidTestHelpers/FakeObjects.h"
 #include <cxxtest/TestSuite.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -26,6 +30,17 @@ public:
   MOCK_CONST_METHOD0(runNumber, int());
   MOCK_METHOD1(setAlgorithm, void(const Mantid::API::IAlgorithm &));
   GCC_DIAG_ON_SUGGEST_OVERRIDE
+
+  using Mantid::API::LiveListener::countBufferedEvents;
+  using Mantid::API::LiveListener::countDroppedEvents;
+  using Mantid::API::LiveListener::initSpareBuffers;
+  using Mantid::API::LiveListener::resetBufferedEvents;
+  using Mantid::API::LiveListener::takeSpareBuffers;
+};
+
+class LiveBufferTester : public WorkspaceTester {
+public:
+  const std::string id() const override { return "LiveBufferTester"; }
 };
 
 class LiveListenerTest : public CxxTest::TestSuite {
@@ -40,6 +55,73 @@ public:
     TS_ASSERT(!l->dataReset())
     delete l;
   }
+
+  void test_spare_buffers_are_empty_copies_of_the_buffers() {
+    using namespace Mantid::API;
+    auto &factory = WorkspaceFactory::Instance();
+    if (!factory.exists("LiveBufferTester"))
+      factory.subscribe<LiveBufferTester>("LiveBufferTester");
+
+    auto buffer = boost::make_shared<LiveBufferTester>();
+    buffer->initialize(3, 2, 1);
+    buffer->getSpectrum(1).setSpectrumNo(42);
+    buffer->mutableY(1)[0] = 5.;
+    buffer->mutableRun().addProperty("run_number", std::string("123"));
+    auto charge = new Mantid::Kernel::TimeSeriesProperty<double>("charge");
+    charge->addValue("2018-01-01T00:00:00", 1.);
+    buffer->mutableRun().addLogData(charge);
+    auto monitors = boost::make_shared<LiveBufferTester>();
+    monitors->initialize(1, 2, 1);
+    buffer->setMonitorWorkspace(monitors);
+
+    MockLiveListener listener;
+    TS_ASSERT(listener.takeSpareBuffers().empty());
+    listener.initSpareBuffers({buffer});
+
+    MatrixWorkspace_sptr previous;
+    for (int extraction = 0; extraction < 3; ++extraction) {
+      const auto spares = listener.takeSpareBuffers();
+      TS_ASSERT_EQUALS(spares.size(), 1);
+      const auto &spare = spares.front();
+      TS_ASSERT_DIFFERS(spare, buffer);
+      TS_ASSERT_DIFFERS(spare, previous);
+      TS_ASSERT_EQUALS(spare->id(), "LiveBufferTester");
+      TS_ASSERT_EQUALS(spare->getNumberHistograms(), 3);
+      TS_ASSERT_EQUALS(spare->getSpectrum(1).getSpectrumNo(), 42);
+      TS_ASSERT_EQUALS(spare->y(1)[0], 0.);
+      TS_ASSERT_EQUALS(spare->run().getPropertyValueAsType<std::string>(
+                           "run_number"),
+                       "123");
+      TS_ASSERT_EQUALS(spare->run().getProperty("charge")->size(), 0);
+      const auto spareMonitors = spare->monitorWorkspace();
+      TS_ASSERT(spareMonitors);
+      TS_ASSERT_DIFFERS(spareMonitors, monitors);
+      if (spareMonitors)
+        TS_ASSERT_EQUALS(spareMonitors->getNumberHistograms(), 1);
+      previous = spare;
+    }
+    // The buffer itself is left alone
+    TS_ASSERT_EQUALS(buffer->y(1)[0], 5.);
+    TS_ASSERT_EQUALS(buffer->run().getProperty("charge")->size(), 1);
+  }
+
+  void test_event_counts() {
+    MockLiveListener listener;
+    listener.countBufferedEvents(5);
+    listener.countBufferedEvents(3);
+    listener.countDroppedEvents(2);
+    TS_ASSERT_EQUALS(listener.bufferedEvents(), 8);
+    TS_ASSERT_EQUALS(listener.droppedEvents(), 2);
+
+    // The counts are reported through the interface
+    const Mantid::API::ILiveListener &base = listener;
+    TS_ASSERT_EQUALS(base.bufferedEvents(), 8);
+    TS_ASSERT_EQUALS(base.droppedEvents(), 2);
+
+    TS_ASSERT_EQUALS(listener.resetBufferedEvents(), 8);
+    TS_ASSERT_EQUALS(listener.bufferedEvents(), 0);
+    TS_ASSERT_EQUALS(listener.droppedEvents(), 2);
+  }
 };
 
 #endif
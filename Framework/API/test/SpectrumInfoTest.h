@@ -13,6 +13,8 @@
 #include "MantidTestHelpers/FakeObjects.h"
 #include "MantidTestHelpers/InstrumentCreationHelper.h"
 
+#include <cmath>
+
 using namespace Mantid;
 using namespace Mantid::Geometry;
 using namespace Mantid::API;
@@ -275,6 +277,48 @@ public:
     detectorInfo.setPosition(1, oldPos);
   }
 
+  void test_grouped_arrays_match_the_values_of_each_spectrum() {
+    const auto &spectrumInfo = m_grouped.spectrumInfo();
+    const auto l2s = spectrumInfo.l2s();
+    const auto twoThetas = spectrumInfo.twoThetas();
+    const auto azimuths = spectrumInfo.azimuths();
+    const auto solidAngles = spectrumInfo.solidAngles();
+    TS_ASSERT_EQUALS(l2s->size(), spectrumInfo.size());
+    const auto samplePos = spectrumInfo.samplePosition();
+    for (const auto i : {GroupOfDets2And3, GroupOfDets1And2}) {
+      const auto &detector = spectrumInfo.detector(i);
+      TS_ASSERT_EQUALS((*l2s)[i], spectrumInfo.l2(i));
+      TS_ASSERT_EQUALS((*twoThetas)[i], spectrumInfo.twoTheta(i));
+      TS_ASSERT_DELTA((*azimuths)[i], detector.getPhi(), 1e-12);
+      TS_ASSERT_DELTA((*solidAngles)[i], detector.solidAngle(samplePos),
+                      1e-12);
+    }
+    // Scattering angles are not defined if the detectors include monitors
+    TS_ASSERT(std::isnan((*twoThetas)[GroupOfDets1And4]));
+    TS_ASSERT(std::isnan((*spectrumInfo.difcs())[GroupOfDets4And5]));
+  }
+
+  void test_arrays_track_changes() {
+    const auto &spectrumInfo = m_workspace.spectrumInfo();
+    TS_ASSERT_EQUALS((*spectrumInfo.l2s())[1], 5.0);
+
+    // Changes of the detectors of a spectrum
+    m_workspace.getSpectrum(1).setDetectorID(5);
+    TS_ASSERT_EQUALS((*spectrumInfo.l2s())[1], -2.0);
+    m_workspace.getSpectrum(1).clearDetectorIDs();
+    TS_ASSERT(std::isnan((*spectrumInfo.l2s())[1]));
+    m_workspace.getSpectrum(1).setDetectorID(2);
+    TS_ASSERT_EQUALS((*spectrumInfo.l2s())[1], 5.0);
+
+    // Changes of the positions of the detectors
+    auto &detectorInfo = m_workspace.mutableDetectorInfo();
+    const auto oldPos = detectorInfo.position(1);
+    detectorInfo.setPosition(1, V3D(0.0, 0.0, 7.0));
+    TS_ASSERT_EQUALS((*m_workspace.spectrumInfo().l2s())[1], 7.0);
+    detectorInfo.setPosition(1, oldPos);
+    TS_ASSERT_EQUALS((*m_workspace.spectrumInfo().l2s())[1], 5.0);
+  }
+
   void test_hasDetectors() {
     const auto &spectrumInfo = m_workspace.spectrumInfo();
     TS_ASSERT(spectrumInfo.hasDetectors(0));
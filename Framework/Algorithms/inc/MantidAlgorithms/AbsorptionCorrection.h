@@ -15,6 +15,7 @@ class Sample;
 namespace Geometry {
 class IDetector;
 class IObject;
+class Track;
 }
 
 namespace Algorithms {
@@ -132,6 +133,7 @@ private:
   void retrieveBaseProperties();
   void constructSample(API::Sample &sample);
   void calculateDistances(const Geometry::IDetector &detector,
+                          std::vector<Geometry::Track> &outgoing,
                           std::vector<double> &L2s) const;
   inline double doIntegration(const double &lambda,
                               const std::vector<double> &L2s) const;
@@ -165,6 +165,13 @@ protected:
   virtual void performEventBinaryOperation(DataObjects::EventList &lhs,
                                            const DataObjects::EventList &rhs);
 
+  /** Should return true if performEventBinaryOperation() with an EventList as
+   * the right-hand operand only appends events to the left-hand one, so that
+   * the histograms cached for the output can be updated instead of cleared.
+   * False by default.
+   */
+  virtual bool appendsEvents() const { return false; }
+
   /** Carries out the binary operation IN-PLACE on a single EventList,
    * with another (histogrammed) spectrum as the right-hand operand.
    *
@@ -6,6 +6,9 @@
 #include "MantidKernel/Unit.h"
 
 namespace Mantid {
+namespace Geometry {
+class Parameter;
+}
 namespace Algorithms {
 /** Converts the units in which a workspace is represented.
     Only implemented for histogram data, so far.
@@ -97,6 +100,8 @@ protected:
   const std::string workspaceMethodInputProperty() const override {
     return "InputWorkspace";
   }
+  /// The members of a group are processed independently
+  bool processGroupsInParallel() const override { return true; }
 
   // Overridden Algorithm methods
   void init() override;
@@ -119,11 +124,12 @@ protected:
                  const double &power);
 
   /// Internal function to gather detector specific L2, theta and efixed values
-  bool getDetectorValues(const API::SpectrumInfo &spectrumInfo,
-                         const Kernel::Unit &outputUnit, int emode,
-                         const API::MatrixWorkspace &ws, const bool signedTheta,
-                         int64_t wsIndex, double &efixed, double &l2,
-                         double &twoTheta);
+  bool getDetectorValues(
+      const API::SpectrumInfo &spectrumInfo, const Kernel::Unit &outputUnit,
+      int emode, const API::MatrixWorkspace &ws,
+      const std::vector<boost::shared_ptr<Geometry::Parameter>> &efixeds,
+      const bool signedTheta, int64_t wsIndex, double &efixed, double &l2,
+      double &twoTheta);
 
   /// Convert the workspace units using TOF as an intermediate step in the
   /// conversion
@@ -85,6 +85,8 @@ public:
   }
 
 private:
+  /// The members of a group are cropped independently
+  bool processGroupsInParallel() const override { return true; }
   /// Initialisation code
   void init() override;
   /// Execution code
@@ -5,6 +5,7 @@
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidKernel/V3D.h"
 #include "MantidGeometry/IDetector.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
 #include "MantidGeometry/Objects/IObject.h"
 
 #include <list>
@@ -132,8 +133,12 @@ private:
   API::MatrixWorkspace_const_sptr m_inputWS;
   /// output workspace, maybe the same as the input one
   API::MatrixWorkspace_sptr m_outputWS;
-  /// points the map that stores additional properties for detectors in that map
-  const Geometry::ParameterMap *m_paraMap;
+  /// the gas pressure of each detector, by detector index
+  boost::shared_ptr<const Geometry::ParameterMap::DetectorParameters>
+      m_pressures;
+  /// the wall thickness of each detector, by detector index
+  boost::shared_ptr<const Geometry::ParameterMap::DetectorParameters>
+      m_thicknesses;
 
   /// stores the user selected value for incidient energy of the neutrons
   double m_Ei;
@@ -121,6 +121,9 @@ private:
   /// Set up detector calibration parameters from customized values
   void setupCustomizedTOFCorrection();
 
+  /// Split the events of one spectrum to all the outputs
+  void splitSpectrum(const size_t wsIndex, const bool pulseTimeOnly);
+
   /// Filter events by splitters in format of Splitter
   void filterEventsBySplitters(double progressamount);
 
@@ -128,7 +131,10 @@ private:
   void filterEventsByVectorSplitters(double progressamount);
 
   /// Examine workspace
-  void examineAndSortEventWS();
+  void examineEventWS();
+
+  /// Set up the intervals and outputs the events are split to
+  void setupEventSplitters();
 
   /// Convert SplittersWorkspace to vector of time and vector of target
   /// (itarget)
@@ -218,6 +224,13 @@ private:
   /// Vector for splitting grouip
   std::vector<int> m_vecSplitterGroup;
 
+  /// Boundaries of the intervals the events are split by, in nanoseconds
+  std::vector<int64_t> m_eventSplitTimes;
+  /// Index in m_eventSplitOutputs of the output of each interval
+  std::vector<int> m_eventSplitTargets;
+  /// The output workspaces, in the order of m_outputWorkspacesMap
+  std::vector<DataObjects::EventWorkspace *> m_eventSplitOutputs;
+
   /// Flag to split sample logs
   bool m_splitSampleLogs;
 
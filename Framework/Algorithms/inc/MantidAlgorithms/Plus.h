@@ -74,6 +74,7 @@ private:
                               MantidVec &EOut) override;
   void performEventBinaryOperation(DataObjects::EventList &lhs,
                                    const DataObjects::EventList &rhs) override;
+  bool appendsEvents() const override { return true; }
   void performEventBinaryOperation(DataObjects::EventList &lhs,
                                    const MantidVec &rhsX, const MantidVec &rhsY,
                                    const MantidVec &rhsE) override;
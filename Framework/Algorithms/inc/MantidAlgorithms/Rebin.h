@@ -86,6 +86,8 @@ protected:
   const std::string workspaceMethodInputProperty() const override {
     return "InputWorkspace";
   }
+  /// The members of a group are processed independently
+  bool processGroupsInParallel() const override { return true; }
 
   // Overridden Algorithm methods
   void init() override;
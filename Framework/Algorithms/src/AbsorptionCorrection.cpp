@@ -132,6 +132,9 @@ void AbsorptionCorrection::exec() {
 
   // Calculate the cached values of L1 and element volumes.
   initialiseCachedDistances();
+  // The bounding box of the sample is calculated on first use: do it before
+  // tracing tracks in parallel
+  m_sampleObject->getBoundingBox();
   // If sample not at origin, shift cached positions.
   const auto &spectrumInfo = m_inputWS->spectrumInfo();
   const V3D samplePos = spectrumInfo.samplePosition();
@@ -141,6 +144,9 @@ void AbsorptionCorrection::exec() {
     }
   }
 
+  // The tracks to each detector, kept by each thread for all its detectors
+  std::vector<std::vector<Track>> threadTracks(PARALLEL_GET_MAX_THREADS);
+
   Progress prog(this, 0.0, 1.0, numHists);
   // Loop over the spectra
   PARALLEL_FOR_IF(Kernel::threadSafe(*m_inputWS, *correctionFactors))
@@ -156,7 +162,7 @@ void AbsorptionCorrection::exec() {
     const auto &det = spectrumInfo.detector(i);
 
     std::vector<double> L2s(m_numVolumeElements);
-    calculateDistances(det, L2s);
+    calculateDistances(det, threadTracks[PARALLEL_THREAD_NUMBER], L2s);
 
     // If an indirect instrument, see if there's an efixed in the parameter map
     double lambda_f = m_lambdaFixed;
@@ -312,9 +318,12 @@ void AbsorptionCorrection::constructSample(API::Sample &sample) {
 
 /// Calculate the distances traversed by the neutrons within the sample
 /// @param detector :: The detector we are working on
+/// @param outgoing :: The tracks to reuse for the path from each segment of the
+/// sample to the detector
 /// @param L2s :: A vector of the sample-detector distance for  each segment of
 /// the sample
 void AbsorptionCorrection::calculateDistances(const IDetector &detector,
+                                              std::vector<Track> &outgoing,
                                               std::vector<double> &L2s) const {
   V3D detectorPos(detector.getPos());
   if (detector.nDets() > 1) {
@@ -326,13 +335,19 @@ void AbsorptionCorrection::calculateDistances(const IDetector &detector,
                           detector.getPhi() * 180.0 / M_PI);
   }
 
+  // Create tracks for distance in cylinder between scattering points and
+  // detector, and trace them all at once
+  outgoing.resize(m_numVolumeElements);
   for (size_t i = 0; i < m_numVolumeElements; ++i) {
-    // Create track for distance in cylinder between scattering point and
-    // detector
     V3D direction = detectorPos - m_elementPositions[i];
     direction.normalize();
-    Track outgoing(m_elementPositions[i], direction);
-    int temp = m_sampleObject->interceptSurface(outgoing);
+    outgoing[i].reset(m_elementPositions[i], direction);
+    outgoing[i].clearIntersectionResults();
+  }
+  m_sampleObject->interceptSurfaces(outgoing);
+
+  for (size_t i = 0; i < m_numVolumeElements; ++i) {
+    const int temp = outgoing[i].count();
 
     /* Most of the time, the number of hits is 1. Sometime, we have more than
      * one intersection due to
@@ -363,7 +378,7 @@ void AbsorptionCorrection::calculateDistances(const IDetector &detector,
       // AbsorptionCorrection::calculateDistances");
     } else // The normal situation
     {
-      L2s[i] = outgoing.cbegin()->distFromStart;
+      L2s[i] = outgoing[i].cbegin()->distFromStart;
     }
   }
 }
@@ -46,10 +46,18 @@ public:
 
   std::function<double(double)>
   getConversionFunc(const std::set<detid_t> &detIds) const {
+    double difc, difa, tzero;
+    this->getDiffConstants(detIds, difc, difa, tzero);
+    return Kernel::Diffraction::getTofToDConversionFunc(difc, difa, tzero);
+  }
+
+  /// The calibration constants averaged over the given detectors
+  void getDiffConstants(const std::set<detid_t> &detIds, double &difc,
+                        double &difa, double &tzero) const {
     const std::set<size_t> rows = this->getRow(detIds);
-    double difc = 0.;
-    double difa = 0.;
-    double tzero = 0.;
+    difc = 0.;
+    difa = 0.;
+    tzero = 0.;
     for (auto row : rows) {
       difc += m_difcCol->toDouble(row);
       difa += m_difaCol->toDouble(row);
@@ -61,8 +69,6 @@ public:
       difa = norm * difa;
       tzero = norm * tzero;
     }
-
-    return Kernel::Diffraction::getTofToDConversionFunc(difc, difa, tzero);
   }
 
 private:
@@ -299,9 +305,18 @@ void AlignDetectors::align(const ConversionFactors &converter,
   for (int64_t i = 0; i < m_numberOfSpectra; ++i) {
     PARALLEL_START_INTERUPT_REGION
 
-    auto toDspacing = converter.getConversionFunc(
-        outputWS.getSpectrum(size_t(i)).getDetectorIDs());
-    outputWS.getSpectrum(i).convertTof(toDspacing);
+    auto &spectrum = outputWS.getSpectrum(size_t(i));
+    double difc, difa, tzero;
+    converter.getDiffConstants(spectrum.getDetectorIDs(), difc, difa, tzero);
+    if (difa == 0.) {
+      // d=(TOF-tzero)/difc is linear: scale and shift the events in one pass
+      // rather than calling a std::function for each of them
+      const double offset = (tzero == 0.) ? 0. : -1. * tzero / difc;
+      spectrum.convertTof(1. / difc, offset);
+    } else {
+      spectrum.convertTof(
+          Kernel::Diffraction::getTofToDConversionFunc(difc, difa, tzero));
+    }
 
     progress.report();
     PARALLEL_END_INTERUPT_REGION
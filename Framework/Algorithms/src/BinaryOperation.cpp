@@ -213,9 +213,12 @@ void BinaryOperation::exec() {
       m_eout = boost::dynamic_pointer_cast<EventWorkspace>(m_out);
     }
 
-    // Always clear the MRUs.
-    m_eout->clearMRU();
-    if (m_elhs)
+    // Clear the MRUs, unless events are only appended to the output in
+    // place: its cached histograms are then updated with the new events.
+    const bool appendInPlace = m_out == m_lhs && m_erhs && appendsEvents();
+    if (!appendInPlace)
+      m_eout->clearMRU();
+    if (m_elhs && !appendInPlace)
       m_elhs->clearMRU();
     if (m_erhs)
       m_erhs->clearMRU();
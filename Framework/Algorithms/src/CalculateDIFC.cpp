@@ -15,6 +15,8 @@ void calculateFromOffset(API::Progress &progress,
   const auto &detectorIDs = detectorInfo.detectorIDs();
   const bool haveOffset = (offsetsWS != nullptr);
   const double l1 = detectorInfo.l1();
+  const auto l2s = detectorInfo.l2s();
+  const auto twoThetas = detectorInfo.twoThetas();
 
   for (size_t i = 0; i < detectorInfo.size(); ++i) {
     if ((!detectorInfo.isMasked(i)) && (!detectorInfo.isMonitor(i))) {
@@ -23,9 +25,8 @@ void calculateFromOffset(API::Progress &progress,
           (haveOffset) ? offsetsWS->getValue(detectorIDs[i], 0.) : 0.;
 
       // tofToDSpacingFactor gives 1/DIFC
-      double difc =
-          1. / Geometry::Conversion::tofToDSpacingFactor(
-                   l1, detectorInfo.l2(i), detectorInfo.twoTheta(i), offset);
+      double difc = 1. / Geometry::Conversion::tofToDSpacingFactor(
+                             l1, (*l2s)[i], (*twoThetas)[i], offset);
       outputWs.setValue(detectorIDs[i], difc);
     }
 
@@ -9,11 +9,14 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/CompositeValidator.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidParallel/Communicator.h"
+#include "MantidTypes/SpectrumDefinition.h"
 
 #include <numeric>
 
@@ -392,6 +395,8 @@ ConvertUnits::convertQuickly(API::MatrixWorkspace_const_sptr inputWS,
 * @param outputUnit :: The output unit
 * @param emode :: The energy mode
 * @param ws :: The workspace
+* @param efixeds :: The Efixed parameters by detector index, as given by
+* DetectorInfo::parameters()
 * @param signedTheta :: Return twotheta with sign or without
 * @param wsIndex :: The workspace index
 * @param efixed :: the returned fixed energy
@@ -399,12 +404,12 @@ ConvertUnits::convertQuickly(API::MatrixWorkspace_const_sptr inputWS,
 * @param twoTheta :: the returned two theta angle
 * @returns true if lookup successful, false on error
 */
-bool ConvertUnits::getDetectorValues(const API::SpectrumInfo &spectrumInfo,
-                                     const Kernel::Unit &outputUnit, int emode,
-                                     const MatrixWorkspace &ws,
-                                     const bool signedTheta, int64_t wsIndex,
-                                     double &efixed, double &l2,
-                                     double &twoTheta) {
+bool ConvertUnits::getDetectorValues(
+    const API::SpectrumInfo &spectrumInfo, const Kernel::Unit &outputUnit,
+    int emode, const MatrixWorkspace &ws,
+    const std::vector<Geometry::Parameter_sptr> &efixeds,
+    const bool signedTheta, int64_t wsIndex, double &efixed, double &l2,
+    double &twoTheta) {
   if (!spectrumInfo.hasDetectors(wsIndex))
     return false;
 
@@ -420,12 +425,14 @@ bool ConvertUnits::getDetectorValues(const API::SpectrumInfo &spectrumInfo,
     if (emode == 2 && efixed == EMPTY_DBL()) // indirect
     {
       if (spectrumInfo.hasUniqueDetector(wsIndex)) {
-        const auto &det = spectrumInfo.detector(wsIndex);
-        auto par = ws.constInstrumentParameters().getRecursive(&det, "Efixed");
+        const auto detIndex =
+            spectrumInfo.spectrumDefinition(wsIndex)[0].first;
+        const auto &par = efixeds[detIndex];
         if (par) {
           efixed = par->value<double>();
-          g_log.debug() << "Detector: " << det.getID() << " EFixed: " << efixed
-                        << "\n";
+          g_log.debug() << "Detector: "
+                        << ws.detectorInfo().detectorIDs()[detIndex]
+                        << " EFixed: " << efixed << "\n";
         }
       }
       // Non-unique detector (i.e., DetectorGroup): use single provided value
@@ -510,6 +517,10 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
       (!parameters.empty()) &&
       find(parameters.begin(), parameters.end(), "Always") != parameters.end();
 
+  // Get the Efixed table once rather than for every spectrum. The output
+  // workspace has the same instrument, so the table serves both.
+  const auto efixeds = inputWS->detectorInfo().parameters("Efixed");
+
   auto localFromUnit = std::unique_ptr<Unit>(fromUnit->clone());
   auto localOutputUnit = std::unique_ptr<Unit>(outputUnit->clone());
 
@@ -518,8 +529,9 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
   double checkl2;
   double checktwoTheta;
   size_t checkIndex = 0;
-  if (getDetectorValues(spectrumInfo, *outputUnit, emode, *inputWS, signedTheta,
-                        checkIndex, checkefixed, checkl2, checktwoTheta)) {
+  if (getDetectorValues(spectrumInfo, *outputUnit, emode, *inputWS, *efixeds,
+                        signedTheta, checkIndex, checkefixed, checkl2,
+                        checktwoTheta)) {
     const double checkdelta = 0.0;
     // copy the X values for the check
     auto checkXValues = inputWS->readX(checkIndex);
@@ -546,7 +558,7 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
     double l2;
     double twoTheta;
     if (getDetectorValues(outSpectrumInfo, *outputUnit, emode, *outputWS,
-                          signedTheta, i, efixed, l2, twoTheta)) {
+                          *efixeds, signedTheta, i, efixed, l2, twoTheta)) {
 
       /// @todo Don't yet consider hold-off (delta)
       const double delta = 0.0;
@@ -74,8 +74,9 @@ const std::string THICKNESS_PARAM = "TubeThickness";
 // this default constructor calls default constructors and sets other member
 // data to impossible (flag) values
 DetectorEfficiencyCor::DetectorEfficiencyCor()
-    : Algorithm(), m_inputWS(), m_outputWS(), m_paraMap(nullptr), m_Ei(-1.0),
-      m_ki(-1.0), m_shapeCache(), m_samplePos(), m_spectraSkipped() {
+    : Algorithm(), m_inputWS(), m_outputWS(), m_pressures(), m_thicknesses(),
+      m_Ei(-1.0), m_ki(-1.0), m_shapeCache(), m_samplePos(),
+      m_spectraSkipped() {
   m_shapeCache.clear();
 }
 
@@ -162,7 +163,10 @@ void DetectorEfficiencyCor::exec() {
 void DetectorEfficiencyCor::retrieveProperties() {
   // these first three properties are fully checked by validators
   m_inputWS = getProperty("InputWorkspace");
-  m_paraMap = &(m_inputWS->constInstrumentParameters());
+  // look the parameters of all the detectors up once
+  const auto &detectorInfo = m_inputWS->detectorInfo();
+  m_pressures = detectorInfo.parameters(PRESSURE_PARAM);
+  m_thicknesses = detectorInfo.parameters(THICKNESS_PARAM);
 
   m_Ei = getProperty("IncidentEnergy");
   // If we're not given an Ei, see if one has been set.
@@ -220,13 +224,12 @@ void DetectorEfficiencyCor::correctForEfficiency(
   for (const auto index : spectrumDefinition) {
     const auto detIndex = index.first;
     const auto &det_member = detectorInfo.detector(detIndex);
-    Parameter_sptr par =
-        m_paraMap->getRecursive(det_member.getComponentID(), PRESSURE_PARAM);
+    Parameter_sptr par = (*m_pressures)[detIndex];
     if (!par) {
       throw Exception::NotFoundError(PRESSURE_PARAM, spectraIn);
     }
     const double atms = par->value<double>();
-    par = m_paraMap->getRecursive(det_member.getComponentID(), THICKNESS_PARAM);
+    par = (*m_thicknesses)[detIndex];
     if (!par) {
       throw Exception::NotFoundError(THICKNESS_PARAM, spectraIn);
     }
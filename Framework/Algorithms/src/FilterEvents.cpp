@@ -24,6 +24,7 @@
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/VisibleWhenProperty.h"
 
+#include <limits>
 #include <memory>
 #include <sstream>
 
@@ -58,7 +59,8 @@ FilterEvents::FilterEvents()
       m_wsNames(), m_detTofOffsets(), m_detTofFactors(),
       m_filterByPulseTime(false), m_informationWS(), m_hasInfoWS(),
       m_progress(0.), m_outputWSNameBase(), m_toGroupWS(false),
-      m_vecSplitterTime(), m_vecSplitterGroup(), m_splitSampleLogs(false),
+      m_vecSplitterTime(), m_vecSplitterGroup(), m_eventSplitTimes(),
+      m_eventSplitTargets(), m_eventSplitOutputs(), m_splitSampleLogs(false),
       m_useDBSpectrum(false), m_dbWSIndex(-1), m_tofCorrType(),
       m_specSkipType(), m_vecSkip(), m_isSplittersRelativeTime(false),
       m_filterStartTime(0), m_runStartTime(0) {}
@@ -209,7 +211,7 @@ void FilterEvents::exec() {
   processAlgorithmProperties();
 
   // Examine workspace for detectors
-  examineAndSortEventWS();
+  examineEventWS();
 
   // Parse splitters
   m_progress = 0.0;
@@ -230,6 +232,7 @@ void FilterEvents::exec() {
     createOutputWorkspaces();
   else
     createOutputWorkspacesMatrixCase();
+  setupEventSplitters();
 
   // clone the properties but TimeSeriesProperty
   std::vector<Kernel::TimeSeriesProperty<int> *> int_tsp_vector;
@@ -284,10 +287,11 @@ void FilterEvents::exec() {
 
 //----------------------------------------------------------------------------------------------
 /**  Examine whether any spectrum does not have detector
- * Warning message will be written out
+ * Warning message will be written out.
+ * The events do not need to be sorted: they are split without sorting.
  * @brief FilterEvents::examineEventWS
  */
-void FilterEvents::examineAndSortEventWS() {
+void FilterEvents::examineEventWS() {
   // get event workspace information
   size_t numhist = m_eventWS->getNumberHistograms();
   m_vecSkip.resize(numhist, false);
@@ -335,16 +339,6 @@ void FilterEvents::examineAndSortEventWS() {
 
   } // END-IF-ELSE
 
-  // sort events
-  DataObjects::EventSortType sortType = DataObjects::TOF_SORT;
-  if (m_filterByPulseTime)
-    sortType = DataObjects::PULSETIME_SORT;
-  else
-    sortType = DataObjects::PULSETIMETOF_SORT;
-
-  // This runs the SortEvents algorithm in parallel
-  m_eventWS->sortAll(sortType, nullptr);
-
   return;
 }
 
@@ -1252,6 +1246,69 @@ void FilterEvents::createOutputWorkspacesMatrixCase() {
   return;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Convert the splitters to the intervals and outputs used to split the events
+ * of every spectrum in one pass. The outputs are numbered in the order of
+ * m_outputWorkspacesMap, so that no map is searched for each event.
+ * Each interval includes its start and excludes its stop time, so an event on
+ * the boundary of two splitters goes to the later one.
+ * With a SplittersWorkspace the events before and between the splitters go to
+ * the unfiltered workspace, and the events after the last splitter are
+ * discarded. With the matrix and table splitters the gaps between splitters
+ * already have the unfiltered target, and the events before the first or
+ * after the last splitter time are discarded, as no output workspace is
+ * created for them.
+ */
+void FilterEvents::setupEventSplitters() {
+  std::map<int, int> outputIndexes;
+  m_eventSplitOutputs.clear();
+  for (auto &ws : m_outputWorkspacesMap) {
+    outputIndexes.emplace(ws.first,
+                          static_cast<int>(m_eventSplitOutputs.size()));
+    m_eventSplitOutputs.push_back(ws.second.get());
+  }
+  auto outputIndex = [&outputIndexes](const int target) {
+    auto it = outputIndexes.find(target);
+    return it == outputIndexes.end() ? -1 : it->second;
+  };
+
+  m_eventSplitTimes.clear();
+  m_eventSplitTargets.clear();
+  const int unfiltered = outputIndex(-1);
+  if ((m_useSplittersWorkspace && m_splitters.empty()) ||
+      (!m_useSplittersWorkspace && m_vecSplitterGroup.empty())) {
+    // No splitter: all the events are unfiltered
+    m_eventSplitTimes = {std::numeric_limits<int64_t>::min(),
+                         std::numeric_limits<int64_t>::max()};
+    m_eventSplitTargets.push_back(unfiltered);
+    return;
+  }
+
+  if (!m_useSplittersWorkspace) {
+    m_eventSplitTimes = m_vecSplitterTime;
+    m_eventSplitTargets.reserve(m_vecSplitterGroup.size());
+    for (const auto target : m_vecSplitterGroup)
+      m_eventSplitTargets.push_back(outputIndex(target));
+    return;
+  }
+
+  // m_splitters is sorted by start time
+  m_eventSplitTimes.push_back(std::numeric_limits<int64_t>::min());
+  for (const auto &splitter : m_splitters) {
+    const int64_t start = std::max(splitter.start().totalNanoseconds(),
+                                   m_eventSplitTimes.back());
+    const int64_t stop = splitter.stop().totalNanoseconds();
+    if (stop <= start)
+      continue;
+    if (start > m_eventSplitTimes.back()) {
+      m_eventSplitTargets.push_back(unfiltered);
+      m_eventSplitTimes.push_back(start);
+    }
+    m_eventSplitTargets.push_back(outputIndex(splitter.index()));
+    m_eventSplitTimes.push_back(stop);
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Create output EventWorkspaces in the case that the splitters are given by
  * TableWorkspace
@@ -1567,6 +1624,31 @@ void FilterEvents::setupCustomizedTOFCorrection() {
   }
 }
 
+/** Split the events of one spectrum to all the output workspaces in a single
+ * pass over the events
+ * @param wsIndex :: workspace index of the spectrum
+ * @param pulseTimeOnly :: if true, split by pulse time instead of full time
+ */
+void FilterEvents::splitSpectrum(const size_t wsIndex,
+                                 const bool pulseTimeOnly) {
+  // Get the output event lists (should be empty)
+  std::vector<DataObjects::EventList *> outputs;
+  outputs.reserve(m_eventSplitOutputs.size());
+  PARALLEL_CRITICAL(build_elist) {
+    for (auto ws : m_eventSplitOutputs)
+      outputs.push_back(&ws->getSpectrum(wsIndex));
+  }
+
+  const DataObjects::EventList &input_el = m_eventWS->getSpectrum(wsIndex);
+  if (m_tofCorrType != NoneCorrect && !pulseTimeOnly)
+    input_el.splitByTimeIntoTargets(m_eventSplitTimes, m_eventSplitTargets,
+                                    outputs, false, m_detTofFactors[wsIndex],
+                                    m_detTofOffsets[wsIndex]);
+  else
+    input_el.splitByTimeIntoTargets(m_eventSplitTimes, m_eventSplitTargets,
+                                    outputs, pulseTimeOnly);
+}
+
 /** Main filtering method
   * Structure: per spectrum --> per workspace
  */
@@ -1584,30 +1666,8 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
     PARALLEL_START_INTERUPT_REGION
 
     // Filter the non-skipped
-    if (!m_vecSkip[iws]) {
-      // Get the output event lists (should be empty) to be a map
-      std::map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWorkspacesMap) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
-      }
-      // Get a holder on input workspace's event list of this spectrum
-      const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
-
-      // Perform the filtering (using the splitting function and just one
-      // output)
-      if (m_filterByPulseTime) {
-        input_el.splitByPulseTime(m_splitters, outputs);
-      } else if (m_tofCorrType != NoneCorrect) {
-        input_el.splitByFullTime(m_splitters, outputs, true,
-                                 m_detTofFactors[iws], m_detTofOffsets[iws]);
-      } else {
-        input_el.splitByFullTime(m_splitters, outputs, false, 1.0, 0.0);
-      }
-    }
+    if (!m_vecSkip[iws])
+      splitSpectrum(static_cast<size_t>(iws), m_filterByPulseTime);
 
     PARALLEL_END_INTERUPT_REGION
   } // END FOR i = 0
@@ -1655,37 +1715,16 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
 
     // Filter the non-skipped spectrum
     if (!m_vecSkip[iws]) {
-      // Get the output event lists (should be empty) to be a map
-      map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWorkspacesMap) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
+      splitSpectrum(static_cast<size_t>(iws), false);
+
+      if (m_useDBSpectrum && iws == static_cast<int64_t>(m_dbWSIndex)) {
+        std::stringstream msgss;
+        msgss << "Spectrum " << iws << ": "
+              << m_eventWS->getSpectrum(iws).getNumberEvents()
+              << " events split to " << m_eventSplitOutputs.size()
+              << " workspaces.";
+        g_log.notice(msgss.str());
       }
-
-      // Get a holder on input workspace's event list of this spectrum
-      const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
-
-      bool printdetail = false;
-      if (m_useDBSpectrum)
-        printdetail = (iws == static_cast<int64_t>(m_dbWSIndex));
-
-      // Perform the filtering (using the splitting function and just one
-      // output)
-      std::string logmessage;
-      if (m_tofCorrType != NoneCorrect) {
-        logmessage = input_el.splitByFullTimeMatrixSplitter(
-            m_vecSplitterTime, m_vecSplitterGroup, outputs, true,
-            m_detTofFactors[iws], m_detTofOffsets[iws]);
-      } else {
-        logmessage = input_el.splitByFullTimeMatrixSplitter(
-            m_vecSplitterTime, m_vecSplitterGroup, outputs, false, 1.0, 0.0);
-      }
-
-      if (printdetail)
-        g_log.notice(logmessage);
     }
 
     PARALLEL_END_INTERUPT_REGION
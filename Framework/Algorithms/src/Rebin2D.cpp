@@ -129,33 +129,42 @@ void Rebin2D::exec() {
   m_progress = boost::shared_ptr<API::Progress>(
       new API::Progress(this, 0.0, 1.0, nreports));
 
-  PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS, *outputWS))
-  for (int64_t i = 0; i < static_cast<int64_t>(numYBins);
-       ++i) // signed for openmp
-  {
+  // Each block of spectra is rebinned by one thread into its own sums, which
+  // are added to the output in order once all the blocks are done: there is no
+  // lock and the result does not depend on the scheduling
+  const bool parallel = Kernel::threadSafe(*inputWS, *outputWS);
+  FractionalRebinning::PartialOutputs partials(*outputWS, numYBins, parallel);
+
+  PARALLEL_FOR_IF(parallel)
+  for (int block = 0; block < partials.numberOfBlocks(); ++block) {
     PARALLEL_START_INTERUPT_REGION
 
-    m_progress->report("Computing polygon intersections");
-    const double vlo = oldYEdges[i];
-    const double vhi = oldYEdges[i + 1];
-    for (size_t j = 0; j < numXBins; ++j) {
-      // For each input polygon test where it intersects with
-      // the output grid and assign the appropriate weights of Y/E
-      const double x_j = oldXEdges[j];
-      const double x_jp1 = oldXEdges[j + 1];
-      Quadrilateral inputQ = Quadrilateral(x_j, x_jp1, vlo, vhi);
-      if (!useFractionalArea) {
-        FractionalRebinning::rebinToOutput(inputQ, inputWS, i, j, *outputWS,
-                                           newYBins.rawData());
-      } else {
-        FractionalRebinning::rebinToFractionalOutput(
-            inputQ, inputWS, i, j, *outputRB, newYBins.rawData(), inputHasFA);
+    auto &partial = partials.initBlock(block);
+    const size_t blockEnd = partials.blockEnd(block);
+    for (size_t i = partials.blockBegin(block); i < blockEnd; ++i) {
+      m_progress->report("Computing polygon intersections");
+      const double vlo = oldYEdges[i];
+      const double vhi = oldYEdges[i + 1];
+      for (size_t j = 0; j < numXBins; ++j) {
+        // For each input polygon test where it intersects with
+        // the output grid and assign the appropriate weights of Y/E
+        const double x_j = oldXEdges[j];
+        const double x_jp1 = oldXEdges[j + 1];
+        Quadrilateral inputQ = Quadrilateral(x_j, x_jp1, vlo, vhi);
+        if (!useFractionalArea) {
+          FractionalRebinning::rebinToOutput(inputQ, inputWS, i, j, partial,
+                                             newYBins.rawData());
+        } else {
+          FractionalRebinning::rebinToFractionalOutput(
+              inputQ, inputWS, i, j, partial, newYBins.rawData(), inputHasFA);
+        }
       }
     }
 
     PARALLEL_END_INTERUPT_REGION
   }
   PARALLEL_CHECK_INTERUPT_REGION
+  partials.addTo(*outputWS);
   if (useFractionalArea) {
     outputRB->finalize(true, true);
   }
@@ -99,78 +99,92 @@ void SofQWNormalisedPolygon::exec() {
   const auto &inputIndices = inputWS->indexInfo();
   const auto &spectrumInfo = inputWS->spectrumInfo();
 
-  PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS, *outputWS))
-  for (int64_t i = 0; i < static_cast<int64_t>(nHistos);
-       ++i) // signed for openmp
-  {
+  // Each block of spectra is rebinned by one thread into its own sums and
+  // mapping, which are added to the output in order once all the blocks are
+  // done: there is no lock and the result does not depend on the scheduling
+  const bool parallel = Kernel::threadSafe(*inputWS, *outputWS);
+  constexpr bool withMapping(true);
+  FractionalRebinning::PartialOutputs partials(*outputWS, nHistos, parallel,
+                                               withMapping);
+
+  PARALLEL_FOR_IF(parallel)
+  for (int block = 0; block < partials.numberOfBlocks(); ++block) {
     PARALLEL_START_INTERUPT_REGION
 
-    if (spectrumInfo.isMasked(i) || spectrumInfo.isMonitor(i)) {
-      continue;
-    }
-    const auto *det =
-        m_EmodeProperties.m_emode == 1 ? nullptr : &spectrumInfo.detector(i);
-
-    const double theta = this->m_theta[i];
-    const double phi = this->m_phi[i];
-    const double thetaWidth = this->m_thetaWidths[i];
-    const double phiWidth = this->m_phiWidths[i];
-
-    // Compute polygon points
-    const double thetaHalfWidth = 0.5 * thetaWidth;
-
-    const double thetaLower = theta - thetaHalfWidth;
-    const double thetaUpper = theta + thetaHalfWidth;
-
-    const auto specNo = static_cast<specnum_t>(inputIndices.spectrumNumber(i));
-    std::stringstream logStream;
-    for (size_t j = 0; j < nEnergyBins; ++j) {
-      m_progress->report("Computing polygon intersections");
-      // For each input polygon test where it intersects with
-      // the output grid and assign the appropriate weights of Y/E
-      const double dE_j = X[j];
-      const double dE_jp1 = X[j + 1];
-
-      const double lrQ = m_EmodeProperties.q(dE_jp1, thetaLower, det);
-
-      const V2D ll(dE_j, m_EmodeProperties.q(dE_j, thetaLower, det));
-      const V2D lr(dE_jp1, lrQ);
-      const V2D ur(dE_jp1, m_EmodeProperties.q(dE_jp1, thetaUpper, det));
-      const V2D ul(dE_j, m_EmodeProperties.q(dE_j, thetaUpper, det));
-      if (g_log.is(Logger::Priority::PRIO_DEBUG)) {
-        logStream << "Spectrum=" << specNo << ", theta=" << theta
-                  << ",thetaWidth=" << thetaWidth << ", phi=" << phi
-                  << ", phiWidth=" << phiWidth << ". QE polygon: ll=" << ll
-                  << ", lr=" << lr << ", ur=" << ur << ", ul=" << ul << "\n";
+    auto &partial = partials.initBlock(block);
+    auto &blockMapping = partials.mapping(block);
+    const size_t blockEnd = partials.blockEnd(block);
+    for (size_t i = partials.blockBegin(block); i < blockEnd; ++i) {
+      if (spectrumInfo.isMasked(i) || spectrumInfo.isMonitor(i)) {
+        continue;
       }
+      const auto *det =
+          m_EmodeProperties.m_emode == 1 ? nullptr : &spectrumInfo.detector(i);
+
+      const double theta = this->m_theta[i];
+      const double phi = this->m_phi[i];
+      const double thetaWidth = this->m_thetaWidths[i];
+      const double phiWidth = this->m_phiWidths[i];
+
+      // Compute polygon points
+      const double thetaHalfWidth = 0.5 * thetaWidth;
+
+      const double thetaLower = theta - thetaHalfWidth;
+      const double thetaUpper = theta + thetaHalfWidth;
+
+      const auto specNo =
+          static_cast<specnum_t>(inputIndices.spectrumNumber(i));
+      std::stringstream logStream;
+      for (size_t j = 0; j < nEnergyBins; ++j) {
+        m_progress->report("Computing polygon intersections");
+        // For each input polygon test where it intersects with
+        // the output grid and assign the appropriate weights of Y/E
+        const double dE_j = X[j];
+        const double dE_jp1 = X[j + 1];
+
+        const double lrQ = m_EmodeProperties.q(dE_jp1, thetaLower, det);
+
+        const V2D ll(dE_j, m_EmodeProperties.q(dE_j, thetaLower, det));
+        const V2D lr(dE_jp1, lrQ);
+        const V2D ur(dE_jp1, m_EmodeProperties.q(dE_jp1, thetaUpper, det));
+        const V2D ul(dE_j, m_EmodeProperties.q(dE_j, thetaUpper, det));
+        if (g_log.is(Logger::Priority::PRIO_DEBUG)) {
+          logStream << "Spectrum=" << specNo << ", theta=" << theta
+                    << ",thetaWidth=" << thetaWidth << ", phi=" << phi
+                    << ", phiWidth=" << phiWidth << ". QE polygon: ll=" << ll
+                    << ", lr=" << lr << ", ur=" << ur << ", ul=" << ul << "\n";
+        }
 
-      Quadrilateral inputQ = Quadrilateral(ll, lr, ur, ul);
+        Quadrilateral inputQ = Quadrilateral(ll, lr, ur, ul);
 
-      FractionalRebinning::rebinToFractionalOutput(inputQ, inputWS, i, j,
-                                                   *outputWS, m_Qout);
+        FractionalRebinning::rebinToFractionalOutput(inputQ, inputWS, i, j,
+                                                     partial, m_Qout);
 
-      // Find which q bin this point lies in
-      const MantidVec::difference_type qIndex =
-          std::upper_bound(m_Qout.begin(), m_Qout.end(), lrQ) - m_Qout.begin();
-      if (qIndex != 0 && qIndex < static_cast<int>(m_Qout.size())) {
-        // Add this spectra-detector pair to the mapping
-        PARALLEL_CRITICAL(SofQWNormalisedPolygon_spectramap) {
+        // Find which q bin this point lies in
+        const MantidVec::difference_type qIndex =
+            std::upper_bound(m_Qout.begin(), m_Qout.end(), lrQ) -
+            m_Qout.begin();
+        if (qIndex != 0 && qIndex < static_cast<int>(m_Qout.size())) {
+          // Add this spectra-detector pair to the mapping
           // Could do a more complete merge of spectrum definitions here, but
           // historically only the ID of the first detector in the spectrum is
           // used, so I am keeping that for now.
-          detIDMapping[qIndex - 1].add(
+          blockMapping[qIndex - 1].add(
               spectrumInfo.spectrumDefinition(i)[0].first);
         }
       }
-    }
-    if (g_log.is(Logger::Priority::PRIO_DEBUG)) {
-      g_log.debug(logStream.str());
+      if (g_log.is(Logger::Priority::PRIO_DEBUG)) {
+        g_log.debug(logStream.str());
+      }
     }
 
     PARALLEL_END_INTERUPT_REGION
   }
   PARALLEL_CHECK_INTERUPT_REGION
 
+  partials.addTo(*outputWS);
+  partials.addMappingsTo(detIDMapping);
+
   outputWS->finalize();
   FractionalRebinning::normaliseOutput(outputWS, inputWS, m_progress);
 
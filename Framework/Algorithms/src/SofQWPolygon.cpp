@@ -63,53 +63,63 @@ void SofQWPolygon::exec() {
   // Holds the spectrum-detector mapping
   std::vector<SpectrumDefinition> detIDMapping(outputWS->getNumberHistograms());
 
-  PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS, *outputWS))
-  for (int64_t i = 0; i < static_cast<int64_t>(nTheta);
-       ++i) // signed for openmp
-  {
+  // Each block of spectra is rebinned by one thread into its own sums and
+  // mapping, which are added to the output in order once all the blocks are
+  // done: there is no lock and the result does not depend on the scheduling
+  const bool parallel = Kernel::threadSafe(*inputWS, *outputWS);
+  constexpr bool withMapping(true);
+  DataObjects::FractionalRebinning::PartialOutputs partials(
+      *outputWS, nTheta, parallel, withMapping);
+
+  PARALLEL_FOR_IF(parallel)
+  for (int block = 0; block < partials.numberOfBlocks(); ++block) {
     PARALLEL_START_INTERUPT_REGION
 
-    const double theta = m_thetaPts[i];
-    if (theta < 0.0) // One to skip
-    {
-      continue;
-    }
+    auto &partial = partials.initBlock(block);
+    auto &blockMapping = partials.mapping(block);
+    const size_t blockEnd = partials.blockEnd(block);
+    for (size_t i = partials.blockBegin(block); i < blockEnd; ++i) {
+      const double theta = m_thetaPts[i];
+      if (theta < 0.0) // One to skip
+      {
+        continue;
+      }
 
-    const auto &spectrumInfo = inputWS->spectrumInfo();
-    const auto *det =
-        m_EmodeProperties.m_emode == 1 ? nullptr : &spectrumInfo.detector(i);
-    const double halfWidth(0.5 * m_thetaWidth);
-    const double thetaLower = theta - halfWidth;
-    const double thetaUpper = theta + halfWidth;
-
-    for (size_t j = 0; j < nenergyBins; ++j) {
-      m_progress->report("Computing polygon intersections");
-      // For each input polygon test where it intersects with
-      // the output grid and assign the appropriate weights of Y/E
-      const double dE_j = X[j];
-      const double dE_jp1 = X[j + 1];
-
-      const double lrQ = m_EmodeProperties.q(dE_jp1, thetaLower, det);
-
-      const V2D ll(dE_j, m_EmodeProperties.q(dE_j, thetaLower, det));
-      const V2D lr(dE_jp1, lrQ);
-      const V2D ur(dE_jp1, m_EmodeProperties.q(dE_jp1, thetaUpper, det));
-      const V2D ul(dE_j, m_EmodeProperties.q(dE_j, thetaUpper, det));
-      Quadrilateral inputQ = Quadrilateral(ll, lr, ur, ul);
-
-      DataObjects::FractionalRebinning::rebinToOutput(inputQ, inputWS, i, j,
-                                                      *outputWS, m_Qout);
-
-      // Find which q bin this point lies in
-      const MantidVec::difference_type qIndex =
-          std::upper_bound(m_Qout.begin(), m_Qout.end(), lrQ) - m_Qout.begin();
-      if (qIndex != 0 && qIndex < static_cast<int>(m_Qout.size())) {
-        // Add this spectra-detector pair to the mapping
-        PARALLEL_CRITICAL(SofQWPolygon_spectramap) {
+      const auto &spectrumInfo = inputWS->spectrumInfo();
+      const auto *det =
+          m_EmodeProperties.m_emode == 1 ? nullptr : &spectrumInfo.detector(i);
+      const double halfWidth(0.5 * m_thetaWidth);
+      const double thetaLower = theta - halfWidth;
+      const double thetaUpper = theta + halfWidth;
+
+      for (size_t j = 0; j < nenergyBins; ++j) {
+        m_progress->report("Computing polygon intersections");
+        // For each input polygon test where it intersects with
+        // the output grid and assign the appropriate weights of Y/E
+        const double dE_j = X[j];
+        const double dE_jp1 = X[j + 1];
+
+        const double lrQ = m_EmodeProperties.q(dE_jp1, thetaLower, det);
+
+        const V2D ll(dE_j, m_EmodeProperties.q(dE_j, thetaLower, det));
+        const V2D lr(dE_jp1, lrQ);
+        const V2D ur(dE_jp1, m_EmodeProperties.q(dE_jp1, thetaUpper, det));
+        const V2D ul(dE_j, m_EmodeProperties.q(dE_j, thetaUpper, det));
+        Quadrilateral inputQ = Quadrilateral(ll, lr, ur, ul);
+
+        DataObjects::FractionalRebinning::rebinToOutput(inputQ, inputWS, i, j,
+                                                        partial, m_Qout);
+
+        // Find which q bin this point lies in
+        const MantidVec::difference_type qIndex =
+            std::upper_bound(m_Qout.begin(), m_Qout.end(), lrQ) -
+            m_Qout.begin();
+        if (qIndex != 0 && qIndex < static_cast<int>(m_Qout.size())) {
+          // Add this spectra-detector pair to the mapping
           // Could do a more complete merge of spectrum definitions here, but
           // historically only the ID of the first detector in the spectrum is
           // used, so I am keeping that for now.
-          detIDMapping[qIndex - 1].add(
+          blockMapping[qIndex - 1].add(
               spectrumInfo.spectrumDefinition(i)[0].first);
         }
       }
@@ -119,6 +129,9 @@ void SofQWPolygon::exec() {
   }
   PARALLEL_CHECK_INTERUPT_REGION
 
+  partials.addTo(*outputWS);
+  partials.addMappingsTo(detIDMapping);
+
   DataObjects::FractionalRebinning::normaliseOutput(outputWS, inputWS,
                                                     m_progress);
 
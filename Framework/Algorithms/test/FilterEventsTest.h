@@ -984,6 +984,65 @@ public:
     return;
   }
 
+  /** Events on a boundary between splitters go to the later splitter, and
+   * the events before the first or after the last splitter time of a
+   * MatrixWorkspace splitter are not put to any output
+   */
+  void test_matrixSplitter_edge_and_out_of_range_events() {
+    EventWorkspace_sptr inpWS = createEdgeEventWorkspace();
+    AnalysisDataService::Instance().addOrReplace("TestEdges", inpWS);
+
+    // splitters [0.25 s, 0.5 s) to 1 and [0.5 s, 0.75 s) to 2
+    MatrixWorkspace_sptr splws =
+        WorkspaceFactory::Instance().create("Workspace2D", 1, 3, 2);
+    splws->mutableX(0) = {0.25, 0.5, 0.75};
+    splws->mutableY(0) = {1., 2.};
+    AnalysisDataService::Instance().addOrReplace("EdgeSplitter", splws);
+
+    FilterEvents filter;
+    filter.initialize();
+    filter.setProperty("InputWorkspace", "TestEdges");
+    filter.setProperty("OutputWorkspaceBaseName", "FilteredEdges");
+    filter.setProperty("SplitterWorkspace", "EdgeSplitter");
+    filter.setProperty("RelativeTime", true);
+    TS_ASSERT_THROWS_NOTHING(filter.execute());
+    TS_ASSERT(filter.isExecuted());
+
+    checkEdgeEvents(filter, "FilteredEdges_1", "FilteredEdges_2");
+    AnalysisDataService::Instance().remove("EdgeSplitter");
+  }
+
+  /** Events on a boundary between splitters go to the later splitter, and
+   * the events before the first or after the last splitter time of a
+   * TableWorkspace splitter are not put to any output
+   */
+  void test_tableSplitter_edge_and_out_of_range_events() {
+    EventWorkspace_sptr inpWS = createEdgeEventWorkspace();
+    AnalysisDataService::Instance().addOrReplace("TestEdges", inpWS);
+
+    auto splws = boost::make_shared<DataObjects::TableWorkspace>();
+    splws->addColumn("double", "start");
+    splws->addColumn("double", "stop");
+    splws->addColumn("str", "target");
+    TableRow row0 = splws->appendRow();
+    row0 << 0.25 << 0.5 << "A";
+    TableRow row1 = splws->appendRow();
+    row1 << 0.5 << 0.75 << "B";
+    AnalysisDataService::Instance().addOrReplace("EdgeSplitter", splws);
+
+    FilterEvents filter;
+    filter.initialize();
+    filter.setProperty("InputWorkspace", "TestEdges");
+    filter.setProperty("OutputWorkspaceBaseName", "FilteredEdges");
+    filter.setProperty("SplitterWorkspace", "EdgeSplitter");
+    filter.setProperty("RelativeTime", true);
+    TS_ASSERT_THROWS_NOTHING(filter.execute());
+    TS_ASSERT(filter.isExecuted());
+
+    checkEdgeEvents(filter, "FilteredEdges_A", "FilteredEdges_B");
+    AnalysisDataService::Instance().remove("EdgeSplitter");
+  }
+
   /** Test the feature to exclude some sample logs to be split and add to child
    * workspaces
    * @brief Utest_excludeSampleLogs
@@ -1216,6 +1275,55 @@ public:
     return eventWS;
   }
 
+  /** Create an EventWorkspace with 10 pulses 0.125 s apart, each with 10
+   * events of zero TOF, so the event times are exact multiples of 0.125 s
+   * from the run start
+   */
+  EventWorkspace_sptr createEdgeEventWorkspace() {
+    return createEventWorkspace(20000000000, 125000000, 0, 10);
+  }
+
+  /** Check the outputs of splitting the events of createEdgeEventWorkspace
+   * by the splitters [0.25 s, 0.5 s) and [0.5 s, 0.75 s): each output has the
+   * events of the pulse at its start time and of the next pulse. The events
+   * of the pulses before 0.25 s and from 0.75 s are not in any output.
+   */
+  void checkEdgeEvents(const FilterEvents &filter, const std::string &first,
+                       const std::string &second) {
+    int numsplittedws = filter.getProperty("NumberOutputWS");
+    TS_ASSERT_EQUALS(numsplittedws, 2);
+
+    auto &ads = AnalysisDataService::Instance();
+    auto firstWS = ads.retrieveWS<EventWorkspace>(first);
+    auto secondWS = ads.retrieveWS<EventWorkspace>(second);
+    TS_ASSERT(firstWS);
+    TS_ASSERT(secondWS);
+    if (firstWS && secondWS) {
+      const int64_t runstart = 20000000000;
+      const int64_t pulsedt = 125000000;
+      for (size_t i = 0; i < firstWS->getNumberHistograms(); ++i) {
+        const auto &events1 = firstWS->getSpectrum(i).getEvents();
+        TS_ASSERT_EQUALS(events1.size(), 20);
+        for (const auto &event : events1) {
+          const int64_t time = event.pulseTime().totalNanoseconds() - runstart;
+          TS_ASSERT(time == 2 * pulsedt || time == 3 * pulsedt);
+        }
+        const auto &events2 = secondWS->getSpectrum(i).getEvents();
+        TS_ASSERT_EQUALS(events2.size(), 20);
+        for (const auto &event : events2) {
+          const int64_t time = event.pulseTime().totalNanoseconds() - runstart;
+          TS_ASSERT(time == 4 * pulsedt || time == 5 * pulsedt);
+        }
+      }
+    }
+
+    ads.remove("TestEdges");
+    std::vector<std::string> outputwsnames =
+        filter.getProperty("OutputWorkspaceNames");
+    for (const auto &outputwsname : outputwsnames)
+      ads.remove(outputwsname);
+  }
+
   //----------------------------------------------------------------------------------------------
   /** Create an EventWorkspace to mimic direct inelastic scattering insturment.
     * This workspace will have the same neutron events as the test case in
@@ -6,6 +6,7 @@
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 #include "MantidAPI/NumericAxis.h"
 
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Timer.h"
 
 using Mantid::Algorithms::Rebin2D;
@@ -145,6 +146,32 @@ public:
     }
   }
 
+  void test_Output_Does_Not_Depend_On_The_Scheduling_Of_The_Threads() {
+    MatrixWorkspace_sptr inputWS = makeInputWS(false, false, true);
+    const std::string axis1Params("5.,0.07,6"), axis2Params("-0.5,1.3,9.5");
+    MatrixWorkspace_sptr first =
+        runAlgorithm(inputWS, axis1Params, axis2Params);
+    MatrixWorkspace_sptr second =
+        runAlgorithm(inputWS, axis1Params, axis2Params);
+    const int nThreads = PARALLEL_GET_MAX_THREADS;
+    PARALLEL_SET_NUM_THREADS(1);
+    MatrixWorkspace_sptr serial =
+        runAlgorithm(inputWS, axis1Params, axis2Params);
+    PARALLEL_SET_NUM_THREADS(nThreads);
+
+    TS_ASSERT_EQUALS(first->getNumberHistograms(), 8);
+    for (size_t i = 0; i < first->getNumberHistograms(); ++i) {
+      // Bit for bit with the same number of threads
+      TS_ASSERT_EQUALS(first->y(i).rawData(), second->y(i).rawData());
+      TS_ASSERT_EQUALS(first->e(i).rawData(), second->e(i).rawData());
+      for (size_t j = 0; j < first->blocksize(); ++j) {
+        TS_ASSERT_DELTA(first->y(i)[j], serial->y(i)[j], 1e-12);
+        TS_ASSERT_DELTA(first->e(i)[j], serial->e(i)[j], 1e-12);
+      }
+    }
+    AnalysisDataService::Instance().remove(first->getName());
+  }
+
 private:
   void checkData(MatrixWorkspace_const_sptr outputWS, const size_t nxvalues,
                  const size_t nhist, const bool dist, const bool onAxis1,
@@ -109,7 +109,13 @@ public:
   Eigen::Vector3d sourcePosition() const;
   Eigen::Vector3d samplePosition() const;
 
+  size_t geometryRevision() const;
+
+  friend class ComponentInfo;
+
 private:
+  static size_t nextGeometryRevision();
+  void updateGeometryRevision();
   size_t linearIndex(const std::pair<size_t, size_t> &index) const;
   void checkNoTimeDependence() const;
   void initScanCounts();
@@ -137,6 +143,8 @@ private:
   /// For linear index -> (detector index, time index) conversions
   Kernel::cow_ptr<std::vector<std::pair<size_t, size_t>>> m_indices{nullptr};
   ComponentInfo *m_componentInfo = nullptr; // Geometry::ComponentInfo owner
+  /// Changes whenever a position or rotation changes, unique across instances
+  size_t m_geometryRevision{nextGeometryRevision()};
 };
 
 /** Returns the number of detectors in the instrument.
@@ -193,12 +201,14 @@ DetectorInfo::rotation(const std::pair<size_t, size_t> &index) const {
 inline void DetectorInfo::setPosition(const size_t index,
                                       const Eigen::Vector3d &position) {
   checkNoTimeDependence();
+  updateGeometryRevision();
   m_positions.access()[index] = position;
 }
 
 /// Set the position of the detector with given index.
 inline void DetectorInfo::setPosition(const std::pair<size_t, size_t> &index,
                                       const Eigen::Vector3d &position) {
+  updateGeometryRevision();
   m_positions.access()[linearIndex(index)] = position;
 }
 
@@ -209,12 +219,14 @@ inline void DetectorInfo::setPosition(const std::pair<size_t, size_t> &index,
 inline void DetectorInfo::setRotation(const size_t index,
                                       const Eigen::Quaterniond &rotation) {
   checkNoTimeDependence();
+  updateGeometryRevision();
   m_rotations.access()[index] = rotation.normalized();
 }
 
 /// Set the rotation of the detector with given index.
 inline void DetectorInfo::setRotation(const std::pair<size_t, size_t> &index,
                                       const Eigen::Quaterniond &rotation) {
+  updateGeometryRevision();
   m_rotations.access()[linearIndex(index)] = rotation.normalized();
 }
 
@@ -268,6 +268,9 @@ void ComponentInfo::doSetPosition(const std::pair<size_t, size_t> &index,
                                   const Eigen::Vector3d &newPosition,
                                   const ComponentInfo::Range &detectorRange) {
 
+  // Also covers the source and sample, which are not detectors.
+  if (m_detectorInfo)
+    m_detectorInfo->updateGeometryRevision();
   const auto componentIndex = index.first;
   const auto timeIndex = index.second;
   const Eigen::Vector3d offset = newPosition - position(componentIndex);
@@ -287,6 +290,9 @@ void ComponentInfo::doSetRotation(const std::pair<size_t, size_t> &index,
                                   const Eigen::Quaterniond &newRotation,
                                   const ComponentInfo::Range &detectorRange) {
 
+  // Also covers the source and sample, which are not detectors.
+  if (m_detectorInfo)
+    m_detectorInfo->updateGeometryRevision();
   const auto componentIndex = index.first;
   const auto timeIndex = index.second;
   const Eigen::Vector3d compPos = position(index);
@@ -550,6 +556,8 @@ size_t ComponentInfo::indexOfAny(const std::string &name) const {
 
 void ComponentInfo::setScaleFactor(const size_t componentIndex,
                                    const Eigen::Vector3d &scaleFactor) {
+  if (m_detectorInfo)
+    m_detectorInfo->updateGeometryRevision();
   m_scaleFactors.access()[componentIndex] = scaleFactor;
 }
 
@@ -3,6 +3,7 @@
 #include "MantidKernel/make_cow.h"
 
 #include <algorithm>
+#include <atomic>
 
 namespace Mantid {
 namespace Beamline {
@@ -258,6 +259,7 @@ getIndex(const Kernel::cow_ptr<std::vector<std::pair<size_t, size_t>>> &indices,
  * index in `other` is identical to a corresponding interval in `this`, it is
  * ignored, i.e., no time index is added. */
 void DetectorInfo::merge(const DetectorInfo &other) {
+  updateGeometryRevision();
   if (!m_scanCounts)
     initScanCounts();
   if (m_isSyncScan) {
@@ -306,7 +308,25 @@ void DetectorInfo::merge(const DetectorInfo &other) {
   m_scanCounts = std::move(scanCounts);
 }
 
+/** Returns a number that changes whenever a position or rotation changes.
+ *
+ * Two instances share a revision only while they share their geometry, i.e.,
+ * one is an unmodified copy of the other. Caches of quantities derived from
+ * the geometry can thus be keyed by the revision. */
+size_t DetectorInfo::geometryRevision() const { return m_geometryRevision; }
+
+size_t DetectorInfo::nextGeometryRevision() {
+  static std::atomic<size_t> revision{0};
+  return ++revision;
+}
+
+/// Marks cached quantities derived from the geometry as out of date.
+void DetectorInfo::updateGeometryRevision() {
+  m_geometryRevision = nextGeometryRevision();
+}
+
 void DetectorInfo::setComponentInfo(ComponentInfo *componentInfo) {
+  updateGeometryRevision();
   m_componentInfo = componentInfo;
 }
 
@@ -271,6 +271,23 @@ public:
     TS_ASSERT_EQUALS(info.rotation(0).coeffs(), rot.normalized().coeffs());
   }
 
+  void test_geometryRevision() {
+    DetectorInfo info(PosVec(1), RotVec(1));
+    DetectorInfo other(PosVec(1), RotVec(1));
+    TS_ASSERT_DIFFERS(info.geometryRevision(), other.geometryRevision());
+    const auto copy(info);
+    TS_ASSERT_EQUALS(copy.geometryRevision(), info.geometryRevision());
+    auto revision = info.geometryRevision();
+    info.setMasked(0, true);
+    TS_ASSERT_EQUALS(info.geometryRevision(), revision);
+    info.setPosition(0, Eigen::Vector3d{1, 2, 3});
+    TS_ASSERT_DIFFERS(info.geometryRevision(), revision);
+    TS_ASSERT_EQUALS(copy.geometryRevision(), revision);
+    revision = info.geometryRevision();
+    info.setRotation(0, Eigen::Quaterniond{1, 2, 3, 4});
+    TS_ASSERT_DIFFERS(info.geometryRevision(), revision);
+  }
+
   void test_scanCount() {
     DetectorInfo info(PosVec(1), RotVec(1));
     TS_ASSERT_EQUALS(info.scanCount(0), 1);
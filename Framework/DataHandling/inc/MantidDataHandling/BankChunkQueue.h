@@ -0,0 +1,141 @@
+#ifndef MANTID_DATAHANDLING_BANKCHUNKQUEUE_H_
+#define MANTID_DATAHANDLING_BANKCHUNKQUEUE_H_
+
+#include "MantidDataHandling/DllConfig.h"
+#include "MantidGeometry/IDTypes.h"
+
+#include <boost/shared_array.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class BankPulseTimes;
+
+namespace Mantid {
+namespace API {
+class Progress;
+}
+namespace DataHandling {
+class DefaultEventLoader;
+
+/** BankChunkQueue : Chunks of the events of one bank that have been read from
+  disk by LoadBankFromDiskTask but not yet added to the event lists.
+
+  The chunks are read into a fixed number of buffers (the queue depth) that
+  are reused for the whole bank. While one chunk is being processed the next
+  ones can be read, and the reader only has to wait once all the buffers are
+  full. Chunks are processed one at a time and in the order they were read,
+  as successive chunks fill the same event lists. Compression of the events,
+  if requested, is done once the last chunk has been processed.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAHANDLING_DLL BankChunkQueue {
+public:
+  /// The buffers and description of one chunk of events
+  struct Chunk {
+    /// event pixel ID array
+    boost::shared_array<uint32_t> eventId;
+    /// event TOF array
+    boost::shared_array<float> tof;
+    /// event weights array, NULL if the file has no weights
+    boost::shared_array<float> weight;
+    /// # of events in the arrays
+    size_t numEvents{0};
+    /// index of the first event from event_index
+    size_t startAt{0};
+    /// Flag for simulated data
+    bool haveWeight{false};
+    /// Minimum pixel id
+    detid_t minId{0};
+    /// Maximum pixel id
+    detid_t maxId{0};
+  };
+
+  BankChunkQueue(DefaultEventLoader &loader, const std::string &entryName,
+                 API::Progress *prog,
+                 boost::shared_ptr<std::vector<uint64_t>> eventIndex,
+                 boost::shared_ptr<BankPulseTimes> pulseTimes,
+                 const bool allocateWeights, const size_t chunkSize,
+                 const size_t depth);
+
+  Chunk &acquire(std::mutex *ioMutex = nullptr);
+  bool push(Chunk &chunk);
+  void release(Chunk &chunk);
+  void close();
+
+  void processQueued();
+
+private:
+  bool processNext();
+  void process(Chunk &chunk);
+  void recycle(Chunk &chunk);
+  void finish();
+
+  /// The loader with the event lists to fill
+  DefaultEventLoader &m_loader;
+  /// NXS path to bank
+  const std::string m_entryName;
+  /// Progress reporting
+  API::Progress *m_prog;
+  /// vector of event index (length of # of pulses)
+  boost::shared_ptr<std::vector<uint64_t>> m_eventIndex;
+  /// Pulse times for this bank
+  boost::shared_ptr<BankPulseTimes> m_pulseTimes;
+  /// Whether the buffers need space for weights
+  const bool m_allocateWeights;
+  /// Capacity of each buffer, in events
+  const size_t m_chunkSize;
+  /// Maximum number of buffers
+  const size_t m_depth;
+  /// The buffers, allocated as they are first needed
+  std::deque<Chunk> m_buffers;
+  /// Buffers that can be filled
+  std::deque<Chunk *> m_free;
+  /// Filled buffers, oldest first
+  std::deque<Chunk *> m_ready;
+  /// Pixel IDs with events, for the compression at the end
+  std::vector<bool> m_usedDetIds;
+  /// Number of chunks pushed to the queue
+  size_t m_numPushed{0};
+  /// Number of chunks processed
+  size_t m_numProcessed{0};
+  /// True if a task has been started to process the queue
+  bool m_processingScheduled{false};
+  /// True once no more chunks will be pushed
+  bool m_closed{false};
+  /// Protects the state of the queue
+  std::mutex m_mutex;
+  /// Held while a chunk is processed, so chunks are processed one at a time
+  std::mutex m_processingMutex;
+  /// Signalled when a buffer is returned to the free list
+  std::condition_variable m_bufferFreed;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
+
+#endif /* MANTID_DATAHANDLING_BANKCHUNKQUEUE_H_ */
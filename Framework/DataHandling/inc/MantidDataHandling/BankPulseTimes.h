@@ -40,6 +40,10 @@ public:
 
   /// Vector of period numbers corresponding to each pulse
   std::vector<int> periodNumbers;
+
+  /// True if the pulse times never decrease, so that the events of the bank
+  /// are in pulse time order
+  bool pulseTimesIncreasing;
 };
 
 #endif
@@ -5,6 +5,8 @@
 #include "MantidDataHandling/EventWorkspaceCollection.h"
 #include "MantidAPI/Axis.h"
 
+#include <mutex>
+
 class BankPulseTimes;
 
 namespace Mantid {
@@ -57,6 +59,10 @@ public:
   /// Do we pre-count the # of events in each pixel ID?
   bool precount;
 
+  /// Compress the events of each chunk into weighted events with pulse times
+  /// as they are added, instead of compressing the full event lists at the end
+  bool compressOnLoad;
+
   /// Offset in the pixelID_to_wi_vector to use.
   detid_t pixelID_to_wi_offset;
 
@@ -72,6 +78,15 @@ public:
   /// number of chunks per bank
   size_t eventsPerChunk;
 
+  /// Maximum number of events of a bank read from disk at once, 0 for no limit
+  size_t eventsPerRead;
+  /// Number of buffers for the chunks of a bank that are read ahead
+  size_t readQueueDepth;
+
+  bool readInChunks(const size_t numEvents) const;
+  void addDiskTime(const double seconds);
+  void addProcessingTime(const double seconds);
+
   LoadEventNexus *alg;
   EventWorkspaceCollection &m_ws;
 
@@ -103,6 +118,13 @@ private:
   /// Map detector IDs to event lists.
   template <class T>
   void makeMapToEventLists(std::vector<std::vector<T>> &vectors);
+
+  /// Protects the timing totals
+  std::mutex m_timingMutex;
+  /// Total time spent reading events from disk, in seconds
+  double m_diskTime{0.};
+  /// Total time spent processing events into event lists, in seconds
+  double m_processingTime{0.};
 };
 
 /** Generate a look-up table where the index = the pixel ID of an event
@@ -6,16 +6,19 @@
 #include "MantidKernel/Task.h"
 #include "MantidKernel/ThreadScheduler.h"
 
+#include <boost/shared_array.hpp>
 #include <nexus/NeXusFile.hpp>
 
 class BankPulseTimes;
 
 namespace Mantid {
 namespace DataHandling {
+class BankChunkQueue;
 class DefaultEventLoader;
 
 /** This task does the disk IO from loading the NXS file, and so will be on a
-  disk IO mutex
+  disk IO mutex. Banks with more events than DefaultEventLoader::eventsPerRead
+  are read in chunks, each of which is processed while the next is read.
 
   Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
   National Laboratory & European Spallation Source
@@ -60,6 +63,10 @@ private:
   void loadEventId(::NeXus::File &file);
   void loadTof(::NeXus::File &file);
   void loadEventWeights(::NeXus::File &file);
+  void loadEvents(::NeXus::File &file);
+  void loadChunks(::NeXus::File &file,
+                  boost::shared_ptr<std::vector<uint64_t>> event_index);
+  bool restrictIdRange();
   int64_t recalculateDataSize(const int64_t &size);
 
   /// Algorithm being run
@@ -83,17 +90,19 @@ private:
   /// How much to load in the file
   std::vector<int> m_loadSize;
   /// Event pixel ID data
-  uint32_t *m_event_id;
+  boost::shared_array<uint32_t> m_event_id;
   /// Minimum pixel ID in this data
   uint32_t m_min_id;
   /// Maximum pixel ID in this data
   uint32_t m_max_id;
   /// TOF data
-  float *m_event_time_of_flight;
+  boost::shared_array<float> m_event_time_of_flight;
   /// Flag for simulated data
   bool m_have_weight;
   /// Event weights
-  float *m_event_weight;
+  boost::shared_array<float> m_event_weight;
+  /// Chunks read but not processed yet, when reading in chunks
+  boost::shared_ptr<BankChunkQueue> m_chunkQueue;
   /// Frame period numbers
   const std::vector<int> m_framePeriodNumbers;
 }; // END-DEF-CLASS LoadBankFromDiskTask
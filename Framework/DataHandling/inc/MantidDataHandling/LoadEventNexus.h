@@ -89,6 +89,8 @@ public:
   /// Returns a confidence value that this algorithm can load a file
   int confidence(Kernel::NexusDescriptor &descriptor) const override;
 
+  std::map<std::string, std::string> validateInputs() override;
+
   template <typename T>
   static boost::shared_ptr<BankPulseTimes> runLoadNexusLogs(
       const std::string &nexusfilename, T localWorkspace, Algorithm &alg,
@@ -162,6 +164,11 @@ public:
 
   /// Tolerance for CompressEvents; use -1 to mean don't compress.
   double compressTolerance;
+  /// Width in seconds of the wall-clock bins of the events compressed while
+  /// loading; EMPTY_DBL() to compress them without pulse times at the end.
+  double compressWallClockTolerance;
+  /// Start of the first wall-clock bin of the compressed events
+  Mantid::Types::Core::DateAndTime compressStartTime;
 
   /// Pulse times for ALL banks, taken from proton_charge log.
   boost::shared_ptr<BankPulseTimes> m_allBanksPulseTimes;
@@ -45,8 +45,13 @@ public:
 
   void run() override;
 
+  void deferCompression(std::vector<bool> &usedDetIds);
+
 private:
   size_t getWorkspaceIndexFromPixelID(const detid_t pixID);
+  void setUnsortedForPixels();
+  void
+  compressNewEvents(const std::vector<std::vector<size_t>> &firstNewEvent);
 
   /// Algorithm being run
   DefaultEventLoader &m_loader;
@@ -79,6 +84,9 @@ private:
   detid_t m_min_id;
   /// Maximum pixel id
   detid_t m_max_id;
+  /// Pixel IDs with events, indexed by pixel ID, when compression is done by
+  /// the caller. NULL to compress at the end of run()
+  std::vector<bool> *m_deferredUsedDetIds;
   /// timer for performance
   Mantid::Kernel::Timer m_timer;
 }; // ENDDEF-CLASS ProcessBankData
@@ -0,0 +1,236 @@
+#include "MantidDataHandling/BankChunkQueue.h"
+#include "MantidDataHandling/DefaultEventLoader.h"
+#include "MantidDataHandling/LoadEventNexus.h"
+#include "MantidDataHandling/ProcessBankData.h"
+
+namespace Mantid {
+namespace DataHandling {
+
+namespace {
+/// Unlocks a mutex, if any, for its lifetime
+class ScopedUnlock {
+public:
+  explicit ScopedUnlock(std::mutex *mutex) : m_mutex(mutex) {
+    if (m_mutex)
+      m_mutex->unlock();
+  }
+  ~ScopedUnlock() {
+    if (m_mutex)
+      m_mutex->lock();
+  }
+  ScopedUnlock(const ScopedUnlock &) = delete;
+  ScopedUnlock &operator=(const ScopedUnlock &) = delete;
+
+private:
+  std::mutex *m_mutex;
+};
+} // namespace
+
+/** Constructor
+ *
+ * @param loader :: The loader with the event lists to fill
+ * @param entryName :: name of the bank
+ * @param prog :: Progress reporter
+ * @param eventIndex :: vector of event index (length of # of pulses)
+ * @param pulseTimes :: the pulse times for this bank
+ * @param allocateWeights :: true if the buffers need space for event weights
+ * @param chunkSize :: the maximum number of events in a chunk
+ * @param depth :: the number of buffers, i.e. the number of chunks that can be
+ * read before the first one has been processed
+ */
+BankChunkQueue::BankChunkQueue(
+    DefaultEventLoader &loader, const std::string &entryName,
+    API::Progress *prog, boost::shared_ptr<std::vector<uint64_t>> eventIndex,
+    boost::shared_ptr<BankPulseTimes> pulseTimes, const bool allocateWeights,
+    const size_t chunkSize, const size_t depth)
+    : m_loader(loader), m_entryName(entryName), m_prog(prog),
+      m_eventIndex(eventIndex), m_pulseTimes(pulseTimes),
+      m_allocateWeights(allocateWeights), m_chunkSize(chunkSize),
+      m_depth(std::max(depth, size_t(1))) {
+  // Events compressed while loading need no compression at the end
+  if (m_loader.alg->compressTolerance >= 0 && !m_loader.compressOnLoad)
+    m_usedDetIds.assign(m_loader.eventid_max + 1, false);
+}
+
+/** Get an empty buffer to read the next chunk into. If all the buffers are in
+ * use this waits for the processing of the oldest chunk, or processes it in
+ * the calling thread if no other thread has started to.
+ * @param ioMutex :: a mutex held by the caller, e.g. the one serialising disk
+ * reads, that is released while waiting and locked again before returning.
+ * May be NULL.
+ * @return the chunk to fill, which must be given back with push() or
+ * release()
+ */
+BankChunkQueue::Chunk &BankChunkQueue::acquire(std::mutex *ioMutex) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (m_free.empty() && m_buffers.size() < m_depth) {
+    m_buffers.emplace_back();
+    auto &chunk = m_buffers.back();
+    chunk.eventId.reset(new uint32_t[m_chunkSize]);
+    chunk.tof.reset(new float[m_chunkSize]);
+    if (m_allocateWeights)
+      chunk.weight.reset(new float[m_chunkSize]);
+    return chunk;
+  }
+  if (m_free.empty()) {
+    // Let the other banks be read while this one waits
+    lock.unlock();
+    ScopedUnlock ioUnlock(ioMutex);
+    lock.lock();
+    while (m_free.empty()) {
+      // Making progress here means the reader cannot be stuck waiting for a
+      // thread to become free to run the processing task.
+      lock.unlock();
+      const bool processed = processNext();
+      lock.lock();
+      if (!processed)
+        m_bufferFreed.wait(lock, [this] { return !m_free.empty(); });
+    }
+    auto chunk = m_free.front();
+    m_free.pop_front();
+    // Release the queue before the I/O mutex is locked again
+    lock.unlock();
+    return *chunk;
+  }
+  auto chunk = m_free.front();
+  m_free.pop_front();
+  return *chunk;
+}
+
+/** Queue a chunk that has been filled for processing.
+ * @param chunk :: a chunk from acquire()
+ * @return true if the caller must schedule a task to run processQueued(),
+ * false if such a task is already running or scheduled
+ */
+bool BankChunkQueue::push(Chunk &chunk) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_ready.push_back(&chunk);
+  ++m_numPushed;
+  if (m_processingScheduled)
+    return false;
+  m_processingScheduled = true;
+  return true;
+}
+
+/** Give back a chunk without processing it, e.g. if none of its events are
+ * to be loaded.
+ * @param chunk :: a chunk from acquire()
+ */
+void BankChunkQueue::release(Chunk &chunk) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_free.push_back(&chunk);
+}
+
+/** Signal that no more chunks will be pushed. The events are compressed after
+ * the last chunk has been processed, which may be immediately.
+ */
+void BankChunkQueue::close() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_closed = true;
+    if (m_numProcessed < m_numPushed)
+      return;
+  }
+  finish();
+}
+
+/** Process the queued chunks, oldest first, until the queue is empty. This is
+ * what the task scheduled after push() returns true must run.
+ */
+void BankChunkQueue::processQueued() {
+  while (true) {
+    std::lock_guard<std::mutex> processing(m_processingMutex);
+    Chunk *chunk;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_ready.empty()) {
+        m_processingScheduled = false;
+        return;
+      }
+      chunk = m_ready.front();
+      m_ready.pop_front();
+    }
+    process(*chunk);
+  }
+}
+
+/** Process the oldest queued chunk, unless another thread is processing one.
+ * @return true if a chunk was processed
+ */
+bool BankChunkQueue::processNext() {
+  std::unique_lock<std::mutex> processing(m_processingMutex, std::try_to_lock);
+  if (!processing.owns_lock())
+    return false;
+  Chunk *chunk;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_ready.empty())
+      return false;
+    chunk = m_ready.front();
+    m_ready.pop_front();
+  }
+  process(*chunk);
+  return true;
+}
+
+/** Add the events of a chunk to the event lists and recycle its buffer. Must
+ * be called with the processing mutex held.
+ * @param chunk :: the chunk to process
+ */
+void BankChunkQueue::process(Chunk &chunk) {
+  {
+    ProcessBankData task(m_loader, m_entryName, m_prog, chunk.eventId,
+                         chunk.tof, chunk.numEvents, chunk.startAt,
+                         m_eventIndex, m_pulseTimes, chunk.haveWeight,
+                         chunk.weight, chunk.minId, chunk.maxId);
+    if (!m_usedDetIds.empty())
+      task.deferCompression(m_usedDetIds);
+    task.run();
+  }
+  recycle(chunk);
+}
+
+/** Return the buffer of a processed chunk to the free list, and finish if it
+ * was the last chunk.
+ * @param chunk :: the processed chunk
+ */
+void BankChunkQueue::recycle(Chunk &chunk) {
+  bool last;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_free.push_back(&chunk);
+    ++m_numProcessed;
+    last = m_closed && m_numProcessed == m_numPushed;
+  }
+  m_bufferFreed.notify_all();
+  if (last)
+    finish();
+}
+
+/** Compress the events of all the pixels that were filled, if requested.
+ * This is only done once every chunk has been processed, as events cannot be
+ * added to a list after it has been compressed.
+ */
+void BankChunkQueue::finish() {
+  auto &outputWS = m_loader.m_ws;
+  const auto &pixelIDtoWI = m_loader.pixelID_to_wi_vector;
+  const auto numPixelIDs = static_cast<int64_t>(pixelIDtoWI.size());
+  const auto numHistograms = outputWS.getNumberHistograms();
+  for (size_t pixID = 0; pixID < m_usedDetIds.size(); ++pixID) {
+    if (!m_usedDetIds[pixID])
+      continue;
+    const auto index =
+        static_cast<int64_t>(pixID) + m_loader.pixelID_to_wi_offset;
+    if (index < 0 || index >= numPixelIDs)
+      continue;
+    const size_t wi = pixelIDtoWI[index];
+    if (wi < numHistograms) {
+      auto &el = outputWS.getSpectrum(wi);
+      el.compressEvents(m_loader.alg->compressTolerance, &el);
+    }
+  }
+  std::vector<bool>().swap(m_usedDetIds);
+}
+
+} // namespace DataHandling
+} // namespace Mantid
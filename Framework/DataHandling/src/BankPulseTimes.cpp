@@ -1,5 +1,7 @@
 #include "MantidDataHandling/BankPulseTimes.h"
 
+#include <algorithm>
+
 using namespace Mantid::Kernel;
 //===============================================================================================
 // BankPulseTimes
@@ -40,6 +42,7 @@ BankPulseTimes::BankPulseTimes(::NeXus::File &file,
   pulseTimes = new Mantid::Types::Core::DateAndTime[numPulses];
   for (size_t i = 0; i < numPulses; i++)
     pulseTimes[i] = start + seconds[i];
+  pulseTimesIncreasing = std::is_sorted(pulseTimes, pulseTimes + numPulses);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -51,6 +54,7 @@ BankPulseTimes::BankPulseTimes(
     const std::vector<Mantid::Types::Core::DateAndTime> &times) {
   numPulses = times.size();
   pulseTimes = nullptr;
+  pulseTimesIncreasing = std::is_sorted(times.begin(), times.end());
   if (numPulses == 0)
     return;
   pulseTimes = new Mantid::Types::Core::DateAndTime[numPulses];
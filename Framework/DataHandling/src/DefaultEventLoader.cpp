@@ -2,8 +2,9 @@
 #include "MantidDataHandling/LoadBankFromDiskTask.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidAPI/Progress.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/ThreadPool.h"
-#include "MantidKernel/ThreadSchedulerMutexes.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 #include "MantidKernel/make_unique.h"
 
 using namespace Mantid::Kernel;
@@ -24,15 +25,26 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
 
   auto bankRange = loader.setupChunking(bankNames, bankNumEvents);
 
-  // Make the thread pool
-  auto scheduler = new ThreadSchedulerMutexes;
+  // Make the thread pool. The tasks processing the events of a bank are
+  // pushed by the task reading them and so mostly run in the same thread.
+  auto scheduler = new ThreadSchedulerWorkStealing;
   ThreadPool pool(scheduler);
   auto diskIOMutex = boost::make_shared<std::mutex>();
 
   // set up progress bar for the rest of the (multi-threaded) process
-  size_t numProg = bankNames.size() * (1 + 3); // 1 = disktask, 3 = proc task
-  if (loader.splitProcessing)
-    numProg += bankNames.size() * 3; // 3 = second proc task
+  size_t numProg = bankNames.size(); // 1 = disktask
+  for (size_t i = bankRange.first; i < bankRange.second; i++) {
+    if (loader.readInChunks(bankNumEvents[i])) {
+      // 3 = proc task for each chunk
+      const auto numReads = (bankNumEvents[i] + loader.eventsPerRead - 1) /
+                            loader.eventsPerRead;
+      numProg += numReads * 3;
+    } else {
+      numProg += 3; // 3 = proc task
+      if (loader.splitProcessing)
+        numProg += 3; // 3 = second proc task
+    }
+  }
   auto prog = Kernel::make_unique<API::Progress>(loader.alg, 0.3, 1.0, numProg);
 
   for (size_t i = bankRange.first; i < bankRange.second; i++) {
@@ -44,6 +56,11 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
   // Start and end all threads
   pool.joinAll();
   diskIOMutex.reset();
+
+  alg->getLogger().information()
+      << "Spent " << loader.m_diskTime << " s reading events from disk and "
+      << loader.m_processingTime
+      << " s (summed over threads) filling event lists\n";
 }
 
 DefaultEventLoader::DefaultEventLoader(LoadEventNexus *alg,
@@ -63,13 +80,18 @@ DefaultEventLoader::DefaultEventLoader(LoadEventNexus *alg,
     pixelID_to_wi_vector =
         m_ws.getDetectorIDToWorkspaceIndexVector(pixelID_to_wi_offset, true);
 
+  compressOnLoad = alg->compressTolerance >= 0 &&
+                   alg->compressWallClockTolerance != EMPTY_DBL();
+
   // Cache a map for speed.
-  if (!haveWeights) {
+  if (!haveWeights && !compressOnLoad) {
     makeMapToEventLists(eventVectors);
   } else {
     // Convert to weighted events
-    for (size_t i = 0; i < m_ws.getNumberHistograms(); i++) {
-      m_ws.getSpectrum(i).switchTo(API::WEIGHTED);
+    for (size_t period = 0; period < m_ws.nPeriods(); ++period) {
+      for (size_t i = 0; i < m_ws.getNumberHistograms(); i++) {
+        m_ws.getSpectrum(i, period).switchTo(API::WEIGHTED);
+      }
     }
     makeMapToEventLists(weightedEventVectors);
   }
@@ -77,6 +99,41 @@ DefaultEventLoader::DefaultEventLoader(LoadEventNexus *alg,
   // split banks up if the number of cores is more than twice the number of
   // banks
   splitProcessing = bool(numBanks * 2 < ThreadPool::getNumPhysicalCores());
+
+  // Large banks are read in chunks, so that processing one chunk overlaps
+  // reading the next
+  auto &config = Kernel::ConfigService::Instance();
+  if (!config.getValue("LoadEventNexus.EventsPerRead", eventsPerRead))
+    eventsPerRead = 4194304;
+  if (!config.getValue("LoadEventNexus.ReadQueueDepth", readQueueDepth) ||
+      readQueueDepth < 1)
+    readQueueDepth = 2;
+}
+
+/**
+ * @param numEvents :: The number of events to read from a bank
+ * @return true if the bank is read and processed in more than one chunk
+ */
+bool DefaultEventLoader::readInChunks(const size_t numEvents) const {
+  return eventsPerRead > 0 && numEvents > eventsPerRead;
+}
+
+/** Add to the total time spent reading events, which is logged at the end
+ * of the loading. Thread-safe.
+ * @param seconds :: Time spent reading, in seconds
+ */
+void DefaultEventLoader::addDiskTime(const double seconds) {
+  std::lock_guard<std::mutex> lock(m_timingMutex);
+  m_diskTime += seconds;
+}
+
+/** Add to the total time spent filling event lists, which is logged at the
+ * end of the loading. Thread-safe.
+ * @param seconds :: Time spent processing, in seconds
+ */
+void DefaultEventLoader::addProcessingTime(const double seconds) {
+  std::lock_guard<std::mutex> lock(m_timingMutex);
+  m_processingTime += seconds;
 }
 
 std::pair<size_t, size_t>
@@ -1,8 +1,10 @@
+#include "MantidDataHandling/BankChunkQueue.h"
 #include "MantidDataHandling/BankPulseTimes.h"
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidDataHandling/LoadBankFromDiskTask.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
+#include "MantidKernel/FunctionTask.h"
 
 namespace Mantid {
 namespace DataHandling {
@@ -27,9 +29,8 @@ LoadBankFromDiskTask::LoadBankFromDiskTask(
     const std::vector<int> &framePeriodNumbers)
     : m_loader(loader), entry_name(entry_name), entry_type(entry_type),
       prog(prog), scheduler(scheduler), m_loadError(false),
-      m_oldNexusFileNames(oldNeXusFileNames), m_event_id(nullptr),
-      m_event_time_of_flight(nullptr), m_have_weight(false),
-      m_event_weight(nullptr), m_framePeriodNumbers(framePeriodNumbers) {
+      m_oldNexusFileNames(oldNeXusFileNames), m_have_weight(false),
+      m_framePeriodNumbers(framePeriodNumbers) {
   setMutex(ioMutex);
   m_cost = static_cast<double>(numEvents);
   m_min_id = std::numeric_limits<uint32_t>::max();
@@ -184,9 +185,6 @@ void LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
   ::NeXus::Info id_info = file.getInfo();
   int64_t dim0 = recalculateDataSize(id_info.dims[0]);
 
-  // Now we allocate the required arrays
-  m_event_id = new uint32_t[m_loadSize[0]];
-
   // Check that the required space is there in the file.
   if (dim0 < m_loadSize[0] + m_loadStart[0]) {
     m_loader.alg->getLogger().warning()
@@ -202,7 +200,7 @@ void LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
   if (!m_loadError) {
     // Must be uint32
     if (id_info.type == ::NeXus::UINT32)
-      file.getSlab(m_event_id, m_loadStart, m_loadSize);
+      file.getSlab(m_event_id.get(), m_loadStart, m_loadSize);
     else {
       m_loader.alg->getLogger().warning()
           << "Entry " << entry_name
@@ -220,12 +218,6 @@ void LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
         m_max_id = temp;
     }
 
-    if (m_min_id > static_cast<uint32_t>(m_loader.eventid_max)) {
-      // All the detector IDs in the bank are higher than the highest 'known'
-      // (from the IDF)
-      // ID. Setting this will abort the loading of the bank.
-      m_loadError = true;
-    }
     // fixup the minimum pixel id in the case that it's lower than the lowest
     // 'known' id. We test this by checking that when we add the offset we
     // would not get a negative index into the vector. Note that m_min_id is
@@ -244,11 +236,6 @@ void LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
 /** Open and load the times-of-flight data
 */
 void LoadBankFromDiskTask::loadTof(::NeXus::File &file) {
-  // Allocate the array
-  auto temp = new float[m_loadSize[0]];
-  delete[] m_event_time_of_flight;
-  m_event_time_of_flight = temp;
-
   // Get the list of event_time_of_flight's
   if (!m_oldNexusFileNames)
     file.openData("event_time_offset");
@@ -267,7 +254,7 @@ void LoadBankFromDiskTask::loadTof(::NeXus::File &file) {
 
   // Check that the type is what it is supposed to be
   if (tof_info.type == ::NeXus::FLOAT32)
-    file.getSlab(m_event_time_of_flight, m_loadStart, m_loadSize);
+    file.getSlab(m_event_time_of_flight.get(), m_loadStart, m_loadSize);
   else {
     m_loader.alg->getLogger().warning()
         << "Entry " << entry_name
@@ -302,11 +289,6 @@ void LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
   // OK, we've got them
   m_have_weight = true;
 
-  // Allocate the array
-  auto temp = new float[m_loadSize[0]];
-  delete[] m_event_weight;
-  m_event_weight = temp;
-
   ::NeXus::Info weight_info = file.getInfo();
   int64_t weight_dim0 = recalculateDataSize(weight_info.dims[0]);
   if (weight_dim0 < m_loadSize[0] + m_loadStart[0]) {
@@ -318,7 +300,7 @@ void LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
 
   // Check that the type is what it is supposed to be
   if (weight_info.type == ::NeXus::FLOAT32)
-    file.getSlab(m_event_weight, m_loadStart, m_loadSize);
+    file.getSlab(m_event_weight.get(), m_loadStart, m_loadSize);
   else {
     m_loader.alg->getLogger().warning()
         << "Entry " << entry_name
@@ -331,10 +313,130 @@ void LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
   }
 }
 
+/** Load the pixel IDs, times-of-flight and weights of the events in the range
+* given by m_loadStart and m_loadSize into the arrays, which must be allocated.
+* @param file :: File handle for the NeXus file, with the event_id field open
+*/
+void LoadBankFromDiskTask::loadEvents(::NeXus::File &file) {
+  Kernel::Timer diskTimer;
+  m_min_id = std::numeric_limits<uint32_t>::max();
+  m_max_id = 0;
+
+  // Load pixel IDs
+  this->loadEventId(file);
+  if (m_loader.alg->getCancel())
+    m_loadError = true; // To allow cancelling the algorithm
+
+  // And TOF, unless all the detector IDs are higher than the highest 'known'
+  // (from the IDF) ID, in which case none of the events are to be loaded.
+  if (!m_loadError &&
+      m_min_id <= static_cast<uint32_t>(m_loader.eventid_max)) {
+    this->loadTof(file);
+    if (m_have_weight) {
+      this->loadEventWeights(file);
+    }
+  }
+  m_loader.addDiskTime(diskTimer.elapsed());
+}
+
+/** Load the events in chunks of at most DefaultEventLoader::eventsPerRead
+* events. Each chunk is queued for processing as soon as it has been read, so
+* that the processing overlaps the reading of the following chunks.
+* @param file :: File handle for the NeXus file, with the event_id field open
+* @param event_index :: the event_index of the bank
+*/
+void LoadBankFromDiskTask::loadChunks(
+    ::NeXus::File &file, boost::shared_ptr<std::vector<uint64_t>> event_index) {
+  file.closeData();
+  const size_t chunkSize = m_loader.eventsPerRead;
+  const size_t start_event = static_cast<size_t>(m_loadStart[0]);
+  const size_t stop_event = start_event + static_cast<size_t>(m_loadSize[0]);
+  m_chunkQueue = boost::make_shared<BankChunkQueue>(
+      m_loader, entry_name, prog, event_index, thisBankPulseTimes,
+      m_have_weight, chunkSize, m_loader.readQueueDepth);
+
+  for (size_t first = start_event; first < stop_event; first += chunkSize) {
+    // The disk mutex, held while this task runs, is released if the queue
+    // has to wait for a free buffer
+    auto &chunk = m_chunkQueue->acquire(getMutex().get());
+    m_event_id = chunk.eventId;
+    m_event_time_of_flight = chunk.tof;
+    m_event_weight = chunk.weight;
+    m_loadStart[0] = static_cast<int>(first);
+    m_loadSize[0] = static_cast<int>(std::min(chunkSize, stop_event - first));
+
+    if (m_oldNexusFileNames)
+      file.openData("event_pixel_id");
+    else
+      file.openData("event_id");
+    this->loadEvents(file);
+    if (m_loadError) {
+      m_chunkQueue->release(chunk);
+      return;
+    }
+    if (!restrictIdRange()) {
+      // None of the events in this chunk are to be loaded
+      m_chunkQueue->release(chunk);
+      continue;
+    }
+
+    chunk.numEvents = m_loadSize[0];
+    chunk.startAt = first;
+    chunk.haveWeight = m_have_weight;
+    chunk.minId = m_min_id;
+    chunk.maxId = m_max_id;
+    if (m_chunkQueue->push(chunk)) {
+      auto queue = m_chunkQueue;
+      scheduler.push(new Kernel::FunctionTask(
+          [queue] { queue->processQueued(); },
+          static_cast<double>(chunk.numEvents)));
+    }
+  }
+}
+
+/** Restrict the range of pixel IDs to process to the spectra that were asked
+* for.
+* @return false if none of the events that were read are to be loaded
+*/
+bool LoadBankFromDiskTask::restrictIdRange() {
+  if (m_min_id > static_cast<uint32_t>(m_loader.eventid_max)) {
+    // All the detector IDs in the bank are higher than the highest 'known'
+    // (from the IDF) ID.
+    return false;
+  }
+
+  const uint32_t minSpectraToLoad =
+      static_cast<uint32_t>(m_loader.alg->m_specMin);
+  const uint32_t maxSpectraToLoad =
+      static_cast<uint32_t>(m_loader.alg->m_specMax);
+  const uint32_t emptyInt = static_cast<uint32_t>(EMPTY_INT());
+  // check that if a range of spectra were requested that these fit within
+  // this bank
+  if (minSpectraToLoad != emptyInt && m_min_id < minSpectraToLoad) {
+    if (minSpectraToLoad > m_max_id) { // the minimum spectra to load is more
+                                       // than the max of this bank
+      return false;
+    }
+    // the min spectra to load is higher than the min for this bank
+    m_min_id = minSpectraToLoad;
+  }
+  if (maxSpectraToLoad != emptyInt && m_max_id > maxSpectraToLoad) {
+    if (maxSpectraToLoad < m_min_id) {
+      // the maximum spectra to load is less than the minimum of this bank
+      return false;
+    }
+    // the max spectra to load is lower than the max for this bank
+    m_max_id = maxSpectraToLoad;
+  }
+  // if the min is now larger than the max, this means the entire block of
+  // spectra to load is outside this bank
+  return m_min_id <= m_max_id;
+}
+
 void LoadBankFromDiskTask::run() {
   // The vectors we will be filling
-  auto event_index_ptr = new std::vector<uint64_t>();
-  std::vector<uint64_t> &event_index = *event_index_ptr;
+  auto event_index_shrd = boost::make_shared<std::vector<uint64_t>>();
+  std::vector<uint64_t> &event_index = *event_index_shrd;
 
   // These give the limits in each file as to which events we actually load
   // (when filtering by time).
@@ -342,9 +444,10 @@ void LoadBankFromDiskTask::run() {
   m_loadSize.resize(1, 0);
 
   // Data arrays
-  m_event_id = nullptr;
-  m_event_time_of_flight = nullptr;
-  m_event_weight = nullptr;
+  m_event_id.reset();
+  m_event_time_of_flight.reset();
+  m_event_weight.reset();
+  m_chunkQueue.reset();
 
   m_loadError = false;
   m_have_weight = m_loader.m_haveWeights;
@@ -384,17 +487,15 @@ void LoadBankFromDiskTask::run() {
       m_loadSize[0] = static_cast<int>(stop_event - start_event);
 
       if ((m_loadSize[0] > 0) && (m_loadStart[0] >= 0)) {
-        // Load pixel IDs
-        this->loadEventId(file);
-        if (m_loader.alg->getCancel())
-          m_loadError = true; // To allow cancelling the algorithm
-
-        // And TOF.
-        if (!m_loadError) {
-          this->loadTof(file);
-          if (m_have_weight) {
-            this->loadEventWeights(file);
-          }
+        if (m_loader.readInChunks(m_loadSize[0])) {
+          this->loadChunks(file, event_index_shrd);
+        } else {
+          // Allocate the arrays
+          m_event_id.reset(new uint32_t[m_loadSize[0]]);
+          m_event_time_of_flight.reset(new float[m_loadSize[0]]);
+          if (m_have_weight)
+            m_event_weight.reset(new float[m_loadSize[0]]);
+          this->loadEvents(file);
         }
       } // Size is at least 1
       else {
@@ -420,47 +521,20 @@ void LoadBankFromDiskTask::run() {
   file.closeGroup();
   file.close();
 
-  // Abort if anything failed
-  if (m_loadError) {
-    delete[] m_event_id;
-    delete[] m_event_time_of_flight;
-    if (m_have_weight) {
-      delete[] m_event_weight;
-    }
-    delete event_index_ptr;
-
+  // The chunks that were read are processed even if a later one failed
+  if (m_chunkQueue) {
+    m_chunkQueue->close();
+    m_chunkQueue.reset();
     return;
   }
 
+  // Abort if anything failed
+  if (m_loadError)
+    return;
+
   const auto bank_size = m_max_id - m_min_id;
-  const uint32_t minSpectraToLoad =
-      static_cast<uint32_t>(m_loader.alg->m_specMin);
-  const uint32_t maxSpectraToLoad =
-      static_cast<uint32_t>(m_loader.alg->m_specMax);
-  const uint32_t emptyInt = static_cast<uint32_t>(EMPTY_INT());
-  // check that if a range of spectra were requested that these fit within
-  // this bank
-  if (minSpectraToLoad != emptyInt && m_min_id < minSpectraToLoad) {
-    if (minSpectraToLoad > m_max_id) { // the minimum spectra to load is more
-                                       // than the max of this bank
-      return;
-    }
-    // the min spectra to load is higher than the min for this bank
-    m_min_id = minSpectraToLoad;
-  }
-  if (maxSpectraToLoad != emptyInt && m_max_id > maxSpectraToLoad) {
-    if (maxSpectraToLoad < m_min_id) {
-      // the maximum spectra to load is less than the minimum of this bank
-      return;
-    }
-    // the max spectra to load is lower than the max for this bank
-    m_max_id = maxSpectraToLoad;
-  }
-  if (m_min_id > m_max_id) {
-    // the min is now larger than the max, this means the entire block of
-    // spectra to load is outside this bank
+  if (!restrictIdRange())
     return;
-  }
 
   // schedule the job to generate the event lists
   auto mid_id = m_max_id;
@@ -473,22 +547,16 @@ void LoadBankFromDiskTask::run() {
   size_t numEvents = m_loadSize[0];
   size_t startAt = m_loadStart[0];
 
-  // convert things to shared_arrays
-  boost::shared_array<uint32_t> event_id_shrd(m_event_id);
-  boost::shared_array<float> event_time_of_flight_shrd(m_event_time_of_flight);
-  boost::shared_array<float> event_weight_shrd(m_event_weight);
-  boost::shared_ptr<std::vector<uint64_t>> event_index_shrd(event_index_ptr);
-
   ProcessBankData *newTask1 = new ProcessBankData(
-      m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
+      m_loader, entry_name, prog, m_event_id, m_event_time_of_flight,
       numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
-      event_weight_shrd, m_min_id, mid_id);
+      m_event_weight, m_min_id, mid_id);
   scheduler.push(newTask1);
   if (m_loader.splitProcessing && (mid_id < m_max_id)) {
     ProcessBankData *newTask2 = new ProcessBankData(
-        m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
+        m_loader, entry_name, prog, m_event_id, m_event_time_of_flight,
         numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
-        event_weight_shrd, (mid_id + 1), m_max_id);
+        m_event_weight, (mid_id + 1), m_max_id);
     scheduler.push(newTask2);
   }
 }
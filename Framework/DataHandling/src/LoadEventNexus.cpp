@@ -77,7 +77,8 @@ void copyLogs(const Mantid::DataHandling::EventWorkspaceCollection_sptr &from,
 LoadEventNexus::LoadEventNexus()
     : filter_tof_min(0), filter_tof_max(0), m_specMin(0), m_specMax(0),
       longest_tof(0), shortest_tof(0), bad_tofs(0), discarded_events(0),
-      compressTolerance(0), m_instrument_loaded_correctly(false),
+      compressTolerance(0), compressWallClockTolerance(EMPTY_DBL()),
+      m_instrument_loaded_correctly(false),
       loadlogs(false), m_logs_loaded_correctly(false), event_id_is_spec(false) {
 }
 
@@ -99,6 +100,17 @@ int LoadEventNexus::confidence(Kernel::NexusDescriptor &descriptor) const {
   return confidence;
 }
 
+//----------------------------------------------------------------------------------------------
+/// @copydoc Mantid::API::Algorithm::validateInputs
+std::map<std::string, std::string> LoadEventNexus::validateInputs() {
+  std::map<std::string, std::string> result;
+  const double tolerance = getProperty("CompressTolerance");
+  if (!isDefault("CompressWallClockTolerance") && tolerance < 0.)
+    result["CompressWallClockTolerance"] =
+        "Compressing with a wall-clock tolerance requires a CompressTolerance";
+  return result;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Initialisation method.
 */
@@ -186,6 +198,17 @@ void LoadEventNexus::init() {
                   "This specified the tolerance to use (in microseconds) when "
                   "compressing.");
 
+  auto mustBePositiveDbl = boost::make_shared<BoundedValidator<double>>();
+  mustBePositiveDbl->setLower(0.);
+  declareProperty(
+      "CompressWallClockTolerance", EMPTY_DBL(), mustBePositiveDbl,
+      "The tolerance (in seconds) on the wall-clock time of the events when "
+      "compressing (optional). If set, the events of each chunk are "
+      "compressed as they are read into weighted events that keep their "
+      "pulse times, in bins of CompressTolerance and of this width starting "
+      "at the start of the run, so the uncompressed events are never all in "
+      "memory.");
+
   auto mustBePositive = boost::make_shared<BoundedValidator<int>>();
   mustBePositive->setLower(1);
   declareProperty("ChunkNumber", EMPTY_INT(), mustBePositive,
@@ -203,6 +226,7 @@ void LoadEventNexus::init() {
   std::string grp3 = "Reduce Memory Use";
   setPropertyGroup("Precount", grp3);
   setPropertyGroup("CompressTolerance", grp3);
+  setPropertyGroup("CompressWallClockTolerance", grp3);
   setPropertyGroup("ChunkNumber", grp3);
   setPropertyGroup("TotalChunks", grp3);
 
@@ -383,6 +407,7 @@ void LoadEventNexus::exec() {
   m_filename = getPropertyValue("Filename");
 
   compressTolerance = getProperty("CompressTolerance");
+  compressWallClockTolerance = getProperty("CompressWallClockTolerance");
 
   loadlogs = getProperty("LoadLogs");
 
@@ -663,6 +688,7 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
       m_ws->mutableRun().addProperty("run_start", run_start.toISO8601String(),
                                      true);
     }
+    compressStartTime = run_start;
   }
   m_ws->setNPeriods(
       nPeriods, periodLog); // This is how many workspaces we are going to make.
@@ -2,11 +2,155 @@
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 using namespace Mantid::DataObjects;
+using Mantid::Types::Core::DateAndTime;
 
 namespace Mantid {
 namespace DataHandling {
 
+namespace {
+/// Marks the pixels without events added by a task, when compressing on load
+constexpr size_t NO_NEW_EVENTS = std::numeric_limits<size_t>::max();
+
+/** The fixed TOF and wall-clock bins that events are grouped in when they are
+ * compressed while loading. Unlike the groups of EventList::compressEvents,
+ * which start at the first event of each group, they do not depend on the
+ * events, so the events of each chunk can be compressed on their own and then
+ * merged with the ones of the chunks before.
+ */
+class CompressionGrid {
+public:
+  CompressionGrid(const double tofTolerance, const DateAndTime &start,
+                  const double seconds)
+      : m_tofTolerance(tofTolerance), m_start(start.totalNanoseconds()),
+        m_delta(std::max(static_cast<int64_t>(seconds * 1.e9), int64_t(1))) {}
+
+  /// @return true if event a is in a bin before the one of event b
+  bool operator()(const WeightedEvent &a, const WeightedEvent &b) const {
+    const int64_t pulseBinA = pulseBin(a);
+    const int64_t pulseBinB = pulseBin(b);
+    if (pulseBinA != pulseBinB)
+      return pulseBinA < pulseBinB;
+    return tofBin(a) < tofBin(b);
+  }
+
+  /// @return true if both events are in the same bin
+  bool sameBin(const WeightedEvent &a, const WeightedEvent &b) const {
+    return pulseBin(a) == pulseBin(b) && tofBin(a) == tofBin(b);
+  }
+
+private:
+  int64_t pulseBin(const WeightedEvent &event) const {
+    const int64_t offset = event.pulseTime().totalNanoseconds() - m_start;
+    // Round down for the events before the start too
+    return offset >= 0 ? offset / m_delta : (offset + 1) / m_delta - 1;
+  }
+
+  double tofBin(const WeightedEvent &event) const {
+    return m_tofTolerance > 0. ? std::floor(event.tof() / m_tofTolerance)
+                               : event.tof();
+  }
+
+  double m_tofTolerance;
+  int64_t m_start;
+  int64_t m_delta;
+};
+
+/** Sums the events of one bin into a single weighted event, with the TOF and
+ * the pulse time averaged using the weights. For raw events the weights are
+ * the number of events, so events that were compressed already can be added
+ * to events that were not.
+ */
+class BinSum {
+public:
+  explicit BinSum(const WeightedEvent &event)
+      : m_first(event), m_tofSum(event.tof() * event.weight()),
+        m_pulseOffsetSum(0.), m_weight(event.weight()),
+        m_errorSquared(event.errorSquared()) {}
+
+  void add(const WeightedEvent &event) {
+    const double weight = event.weight();
+    m_tofSum += event.tof() * weight;
+    // Offsets from the first pulse time keep the sum well within precision
+    const int64_t offset = event.pulseTime().totalNanoseconds() -
+                           m_first.pulseTime().totalNanoseconds();
+    m_pulseOffsetSum += static_cast<double>(offset) * weight;
+    m_weight += weight;
+    m_errorSquared += event.errorSquared();
+  }
+
+  WeightedEvent event() const {
+    if (m_weight == 0.)
+      return WeightedEvent(m_first.tof(), m_first.pulseTime(), 0.,
+                           m_errorSquared);
+    const int64_t pulseTime = m_first.pulseTime().totalNanoseconds() +
+                              std::llround(m_pulseOffsetSum / m_weight);
+    return WeightedEvent(m_tofSum / m_weight, DateAndTime(pulseTime), m_weight,
+                         m_errorSquared);
+  }
+
+private:
+  WeightedEvent m_first;
+  double m_tofSum;
+  double m_pulseOffsetSum;
+  double m_weight;
+  double m_errorSquared;
+};
+
+/** Compress the events added to the end of a list and merge them with the
+ * events at the start, which were compressed on the same grid before.
+ * @param events :: the events of a pixel
+ * @param firstNew :: index of the first event that was not compressed yet
+ * @param grid :: the bins to group the events in
+ */
+void compressAndMerge(std::vector<WeightedEvent> &events,
+                      const size_t firstNew, const CompressionGrid &grid) {
+  const auto newBegin = events.begin() + firstNew;
+  std::sort(newBegin, events.end(), grid);
+  // Compress the new events in place
+  auto out = newBegin;
+  for (auto it = newBegin; it != events.end();) {
+    BinSum sum(*it);
+    auto next = it + 1;
+    for (; next != events.end() && grid.sameBin(*it, *next); ++next)
+      sum.add(*next);
+    *out++ = sum.event();
+    it = next;
+  }
+  events.erase(out, events.end());
+
+  if (firstNew > 0) {
+    // Both ranges are in bin order: merge them, summing the common bins
+    std::vector<WeightedEvent> merged;
+    merged.reserve(events.size());
+    auto old = events.cbegin();
+    const auto oldEnd = events.cbegin() + firstNew;
+    auto added = oldEnd;
+    while (old != oldEnd && added != events.cend()) {
+      if (grid(*old, *added)) {
+        merged.push_back(*old++);
+      } else if (grid(*added, *old)) {
+        merged.push_back(*added++);
+      } else {
+        BinSum sum(*old++);
+        sum.add(*added++);
+        merged.push_back(sum.event());
+      }
+    }
+    merged.insert(merged.end(), old, oldEnd);
+    merged.insert(merged.end(), added, events.cend());
+    events.swap(merged);
+  } else if (events.capacity() - events.size() > events.size() / 20) {
+    // If you have over-allocated by more than 5%, reduce the size.
+    events.shrink_to_fit();
+  }
+}
+} // namespace
+
 ProcessBankData::ProcessBankData(
     DefaultEventLoader &m_loader, std::string entry_name, API::Progress *prog,
     boost::shared_array<uint32_t> event_id,
@@ -22,7 +166,7 @@ ProcessBankData::ProcessBankData(
       numEvents(numEvents), startAt(startAt), event_index(event_index),
       thisBankPulseTimes(thisBankPulseTimes), have_weight(have_weight),
       event_weight(event_weight), m_min_id(min_event_id),
-      m_max_id(max_event_id) {
+      m_max_id(max_event_id), m_deferredUsedDetIds(nullptr) {
   // Cost is approximately proportional to the number of events to process.
   m_cost = static_cast<double>(numEvents);
 }
@@ -31,6 +175,7 @@ ProcessBankData::ProcessBankData(
  * FIXME/TODO - split run() into readable methods
  */
 void ProcessBankData::run() { // override {
+  Kernel::Timer processingTimer;
   // Local tof limits
   double my_shortest_tof =
       static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
@@ -80,7 +225,9 @@ void ProcessBankData::run() { // override {
   int periodIndex = 0;
   Mantid::Types::Core::DateAndTime lastpulsetime(0);
 
-  bool pulsetimesincreasing = true;
+  // The events are added in the order of the file, which is the pulse time
+  // order if the pulse times of the whole bank increase
+  bool pulsetimesincreasing = thisBankPulseTimes->pulseTimesIncreasing;
 
   // Index into the pulse array
   int pulse_i = 0;
@@ -99,13 +246,23 @@ void ProcessBankData::run() { // override {
 
   prog->report(entry_name + ": filling events");
 
-  // Will we need to compress?
-  bool compress = (alg->compressTolerance >= 0);
+  // Will we need to compress at the end, or as the events are added?
+  const bool compressOnLoad = m_loader.compressOnLoad;
+  bool compress = (alg->compressTolerance >= 0) && !compressOnLoad;
+
+  // Index of the first event added to each pixel, for each period, when
+  // compressing while loading
+  std::vector<std::vector<size_t>> firstNewEvent;
+  if (compressOnLoad)
+    firstNewEvent.resize(outputWS.nPeriods());
 
   // Which detector IDs were touched? - only matters if compress is on
-  std::vector<bool> usedDetIds;
-  if (compress)
-    usedDetIds.assign(m_max_id - m_min_id + 1, false);
+  std::vector<bool> localUsedDetIds;
+  if (compress && !m_deferredUsedDetIds)
+    localUsedDetIds.assign(m_max_id - m_min_id + 1, false);
+  std::vector<bool> &usedDetIds =
+      m_deferredUsedDetIds ? *m_deferredUsedDetIds : localUsedDetIds;
+  const detid_t firstUsedDetId = m_deferredUsedDetIds ? 0 : m_min_id;
 
   // Go through all events in the list
   for (std::size_t i = 0; i < numEvents; i++) {
@@ -153,12 +310,20 @@ void ProcessBankData::run() { // override {
       double tof = static_cast<double>(event_time_of_flight[i]);
       if ((tof >= alg->filter_tof_min) && (tof <= alg->filter_tof_max)) {
         // Handle simulated data if present
-        if (have_weight) {
-          double weight = static_cast<double>(event_weight[i]);
+        if (have_weight || compressOnLoad) {
+          double weight =
+              have_weight ? static_cast<double>(event_weight[i]) : 1.0;
           double errorSq = weight * weight;
           auto *eventVector = m_loader.weightedEventVectors[periodIndex][detId];
           // NULL eventVector indicates a bad spectrum lookup
           if (eventVector) {
+            if (compressOnLoad) {
+              auto &firstNew = firstNewEvent[periodIndex];
+              if (firstNew.empty())
+                firstNew.assign(m_max_id - m_min_id + 1, NO_NEW_EVENTS);
+              if (firstNew[detId - m_min_id] == NO_NEW_EVENTS)
+                firstNew[detId - m_min_id] = eventVector->size();
+            }
             eventVector->emplace_back(tof, pulsetime, weight, errorSq);
           } else {
             ++my_discarded_events;
@@ -190,7 +355,7 @@ void ProcessBankData::run() { // override {
         // Track all the touched wi (only necessary when compressing events,
         // for thread safety)
         if (compress)
-          usedDetIds[detId - m_min_id] = true;
+          usedDetIds[detId - firstUsedDetId] = true;
       } // valid time-of-flight
 
     } // valid detector IDs
@@ -198,22 +363,21 @@ void ProcessBankData::run() { // override {
 
   //------------ Compress Events (or set sort order) ------------------
   // Do it on all the detector IDs we touched
-  if (compress) {
+  if (compressOnLoad) {
+    compressNewEvents(firstNewEvent);
+  } else if (compress && !m_deferredUsedDetIds) {
     for (detid_t pixID = m_min_id; pixID <= m_max_id; pixID++) {
       if (usedDetIds[pixID - m_min_id]) {
         // Find the the workspace index corresponding to that pixel ID
         size_t wi = getWorkspaceIndexFromPixelID(pixID);
         auto &el = outputWS.getSpectrum(wi);
-        if (compress)
-          el.compressEvents(alg->compressTolerance, &el);
-        else {
-          if (pulsetimesincreasing)
-            el.setSortOrder(DataObjects::PULSETIME_SORT);
-          else
-            el.setSortOrder(DataObjects::UNSORTED);
-        }
+        el.compressEvents(alg->compressTolerance, &el);
       }
     }
+  } else if (!compress && !pulsetimesincreasing) {
+    // The event lists are marked as sorted by pulse time before loading, so
+    // that filtering them by time needs no sort. That is wrong here.
+    setUnsortedForPixels();
   }
   prog->report(entry_name + ": filled events");
 
@@ -236,12 +400,77 @@ void ProcessBankData::run() { // override {
     alg->discarded_events += my_discarded_events;
   }
 
+  m_loader.addProcessingTime(processingTimer.elapsed());
+
 #ifndef _WIN32
   alg->getLogger().debug() << "Time to process " << entry_name << " " << m_timer
                            << "\n";
 #endif
 } // END-OF-RUN()
 
+/**
+ * Mark the event lists of all the pixels of this task, in every period, as
+ * unsorted.
+ */
+void ProcessBankData::setUnsortedForPixels() {
+  auto &outputWS = m_loader.m_ws;
+  const auto numPixelIDs = static_cast<detid_t>(pixelID_to_wi_vector.size());
+  const size_t numHistograms = outputWS.getNumberHistograms();
+  for (detid_t pixID = m_min_id; pixID <= m_max_id; pixID++) {
+    const detid_t index = pixID + pixelID_to_wi_offset;
+    if (index < 0 || index >= numPixelIDs)
+      continue;
+    const size_t wi = pixelID_to_wi_vector[index];
+    if (wi >= numHistograms)
+      continue;
+    for (size_t period = 0; period < outputWS.nPeriods(); ++period)
+      outputWS.getSpectrum(wi, period).setSortOrder(DataObjects::UNSORTED);
+  }
+}
+
+/**
+ * Compress the events added by this task on the grid of bins set by the
+ * compression tolerances of the loader, and merge them with the events of
+ * the same pixels that were compressed before.
+ *
+ * @param firstNewEvent :: for each period, the index of the first event added
+ * to each pixel of the task, or NO_NEW_EVENTS. Empty for periods without
+ * events.
+ */
+void ProcessBankData::compressNewEvents(
+    const std::vector<std::vector<size_t>> &firstNewEvent) {
+  auto &outputWS = m_loader.m_ws;
+  const auto *alg = m_loader.alg;
+  const CompressionGrid grid(alg->compressTolerance, alg->compressStartTime,
+                             alg->compressWallClockTolerance);
+  for (size_t period = 0; period < firstNewEvent.size(); ++period) {
+    const auto &firstNew = firstNewEvent[period];
+    for (size_t i = 0; i < firstNew.size(); ++i) {
+      if (firstNew[i] == NO_NEW_EVENTS)
+        continue;
+      const size_t wi =
+          getWorkspaceIndexFromPixelID(m_min_id + static_cast<detid_t>(i));
+      auto &el = outputWS.getSpectrum(wi, period);
+      compressAndMerge(el.getWeightedEvents(), firstNew[i], grid);
+      // In TOF order within each pulse time bin only, and the averaged pulse
+      // times are not in order either
+      el.setSortOrder(DataObjects::UNSORTED);
+    }
+  }
+}
+
+/**
+ * Leave the compression of the events to the caller, for data that is
+ * processed in several chunks. Events must not be added to an event list after
+ * it has been compressed.
+ *
+ * @param usedDetIds :: Set to true for each pixel ID with events. Must have an
+ * entry for every pixel ID up to the maximum for the instrument.
+ */
+void ProcessBankData::deferCompression(std::vector<bool> &usedDetIds) {
+  m_deferredUsedDetIds = &usedDetIds;
+}
+
 /**
  * Get the workspace index for a given pixel ID. Throws if the pixel ID is
  * not in the expected range.
@@ -9,6 +9,7 @@
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/Workspace.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidDataHandling/LoadEventNexus.h"
@@ -563,6 +564,131 @@ public:
                              ->monitorWorkspace());
   }
 
+  void test_reading_in_chunks_gives_the_same_events() {
+    const auto reference = loadCNCSWithEventsPerRead("0", "-1");
+    // Much smaller than the banks, and a single buffer to read into
+    const auto chunked = loadCNCSWithEventsPerRead("1000", "-1", "1");
+    TS_ASSERT_EQUALS(chunked->getNumberEvents(), 112266);
+    for (size_t wi = 0; wi < reference->getNumberHistograms(); ++wi)
+      TS_ASSERT_EQUALS(chunked->getSpectrum(wi).getEvents(),
+                       reference->getSpectrum(wi).getEvents());
+  }
+
+  void test_reading_in_chunks_compresses_once_per_bank() {
+    const auto reference = loadCNCSWithEventsPerRead("0", "0.05");
+    const auto chunked = loadCNCSWithEventsPerRead("1000", "0.05");
+    TS_ASSERT_EQUALS(chunked->getNumberEvents(), 111274);
+    for (size_t wi = 0; wi < reference->getNumberHistograms(); ++wi)
+      TS_ASSERT_EQUALS(chunked->getSpectrum(wi).getWeightedEventsNoTime(),
+                       reference->getSpectrum(wi).getWeightedEventsNoTime());
+  }
+
+  void test_compressing_while_loading_keeps_the_pulse_times() {
+    // A run of CNCS_7860 is about four minutes long
+    const auto reference = loadCNCSWithEventsPerRead("0", "0.05", "2", "60");
+    const auto chunked = loadCNCSWithEventsPerRead("1000", "0.05", "2", "60");
+    const auto uncompressed = loadCNCSWithEventsPerRead("0", "-1");
+    TS_ASSERT_LESS_THAN(chunked->getNumberEvents(), 112266);
+    // The bins are fixed, so reading in chunks makes no difference
+    TS_ASSERT_EQUALS(chunked->getNumberEvents(), reference->getNumberEvents());
+    const auto startTime = uncompressed->getPulseTimeMin();
+    for (size_t wi = 0; wi < reference->getNumberHistograms(); ++wi) {
+      const auto &el = chunked->getSpectrum(wi);
+      if (el.getNumberEvents() == 0)
+        continue;
+      TS_ASSERT_EQUALS(el.getEventType(), WEIGHTED);
+      // Sorted by TOF in each pulse time bin, with averaged pulse times
+      TS_ASSERT_EQUALS(el.getSortType(), UNSORTED);
+      TS_ASSERT_DELTA(el.integrate(0., 0., true),
+                      uncompressed->getSpectrum(wi).integrate(0., 0., true),
+                      1e-6);
+      const auto &events = el.getWeightedEvents();
+      const auto &referenceEvents =
+          reference->getSpectrum(wi).getWeightedEvents();
+      TS_ASSERT_EQUALS(events.size(), referenceEvents.size());
+      if (events.size() != referenceEvents.size())
+        break;
+      for (size_t i = 0; i < events.size(); ++i) {
+        TS_ASSERT_DELTA(events[i].tof(), referenceEvents[i].tof(), 1e-6);
+        TS_ASSERT_DELTA(events[i].weight(), referenceEvents[i].weight(), 1e-6);
+        // Averages of pulse times in one-minute bins from the start
+        TS_ASSERT_DELTA(events[i].pulseTime().totalNanoseconds(),
+                        referenceEvents[i].pulseTime().totalNanoseconds(),
+                        100);
+        TS_ASSERT_LESS_THAN_EQUALS(startTime, events[i].pulseTime());
+      }
+    }
+  }
+
+  void test_filtering_events_compressed_while_loading_by_time() {
+    const auto compressed = loadCNCSWithEventsPerRead("1000", "0.05", "2", "60");
+    const auto start = compressed->getPulseTimeMin() + 90.;
+    const auto stop = start + 60.;
+    auto filter = AlgorithmManager::Instance().createUnmanaged("FilterByTime");
+    filter->initialize();
+    filter->setChild(true);
+    filter->setProperty("InputWorkspace", compressed);
+    filter->setPropertyValue("OutputWorkspace", "unused_for_child");
+    filter->setPropertyValue("AbsoluteStartTime", start.toISO8601String());
+    filter->setPropertyValue("AbsoluteStopTime", stop.toISO8601String());
+    filter->execute();
+    TS_ASSERT(filter->isExecuted());
+    EventWorkspace_sptr filtered = filter->getProperty("OutputWorkspace");
+
+    size_t nFiltered = 0;
+    for (size_t wi = 0; wi < compressed->getNumberHistograms(); ++wi) {
+      const auto &events = compressed->getSpectrum(wi).getWeightedEvents();
+      const auto expected = std::count_if(
+          events.cbegin(), events.cend(), [&](const WeightedEvent &event) {
+            return event.pulseTime() >= start && event.pulseTime() < stop;
+          });
+      TS_ASSERT_EQUALS(filtered->getSpectrum(wi).getNumberEvents(),
+                       static_cast<size_t>(expected));
+      nFiltered += static_cast<size_t>(expected);
+    }
+    TS_ASSERT_LESS_THAN(0, nFiltered);
+    TS_ASSERT_LESS_THAN(nFiltered, compressed->getNumberEvents());
+  }
+
+  void test_compressing_with_wall_clock_tolerance_needs_a_tolerance() {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("CompressWallClockTolerance", "60");
+    const auto errors = ld.validateInputs();
+    TS_ASSERT_EQUALS(errors.count("CompressWallClockTolerance"), 1);
+    ld.setPropertyValue("CompressTolerance", "0.05");
+    TS_ASSERT(ld.validateInputs().empty());
+  }
+
+  EventWorkspace_sptr
+  loadCNCSWithEventsPerRead(const std::string &eventsPerRead,
+                            const std::string &compress,
+                            const std::string &depth = "2",
+                            const std::string &wallClockTolerance = "") {
+    Mantid::API::FrameworkManager::Instance();
+    auto &config = ConfigService::Instance();
+    const auto oldEventsPerRead =
+        config.getString("LoadEventNexus.EventsPerRead");
+    const auto oldDepth = config.getString("LoadEventNexus.ReadQueueDepth");
+    config.setString("LoadEventNexus.EventsPerRead", eventsPerRead);
+    config.setString("LoadEventNexus.ReadQueueDepth", depth);
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setChild(true);
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "unused_for_child");
+    ld.setPropertyValue("CompressTolerance", compress);
+    if (!wallClockTolerance.empty())
+      ld.setPropertyValue("CompressWallClockTolerance", wallClockTolerance);
+    ld.setProperty<bool>("LoadLogs", false); // Time-saver
+    ld.execute();
+    config.setString("LoadEventNexus.EventsPerRead", oldEventsPerRead);
+    config.setString("LoadEventNexus.ReadQueueDepth", oldDepth);
+    TS_ASSERT(ld.isExecuted());
+    Workspace_sptr out = ld.getProperty("OutputWorkspace");
+    return boost::dynamic_pointer_cast<EventWorkspace>(out);
+  }
+
   void doTestSingleBank(bool SingleBankPixelsOnly, bool Precount,
                         std::string BankName = "bank36",
                         bool willFail = false) {
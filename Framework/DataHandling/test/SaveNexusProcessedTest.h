@@ -20,6 +20,7 @@
 #include "MantidDataHandling/LoadEmptyInstrument.h"
 #include "MantidDataHandling/LoadMuonNexus.h"
 #include "MantidDataHandling/LoadNexus.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/Unit.h"
 #include "MantidKernel/UnitFactory.h"
@@ -862,6 +863,62 @@ public:
     AnalysisDataService::Instance().remove("testSpace");
   }
 
+  void test_spectra_are_written_in_blocks_of_chunks() {
+    auto &config = ConfigService::Instance();
+    const std::string key("NexusProcessed.chunkSpectra");
+    const std::string oldChunkSpectra = config.getString(key);
+    // 10 spectra in chunks of 3, the last one partly filled
+    config.setString(key, "3");
+    auto ws = WorkspaceCreationHelper::create2DWorkspace(10, 7);
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i) {
+      auto &y = ws->mutableY(i);
+      auto &e = ws->mutableE(i);
+      for (size_t j = 0; j < y.size(); ++j) {
+        y[j] = static_cast<double>(100 * i + j);
+        e[j] = static_cast<double>(i + 1);
+      }
+    }
+
+    SaveNexusProcessed alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setProperty("InputWorkspace",
+                    boost::static_pointer_cast<MatrixWorkspace>(ws));
+    const std::string file = "SaveNexusProcessedTest_test_chunks.nxs";
+    if (Poco::File(file).exists())
+      Poco::File(file).remove();
+    alg.setPropertyValue("Filename", file);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    config.setString(key, oldChunkSpectra);
+    TS_ASSERT(alg.isExecuted());
+    const std::string filename = alg.getPropertyValue("Filename");
+
+    ::NeXus::File savedNexus(filename);
+    savedNexus.openGroup("mantid_workspace_1", "NXentry");
+    savedNexus.openGroup("workspace", "NXdata");
+    std::vector<double> values, errors;
+    savedNexus.openData("values");
+    savedNexus.getData(values);
+    savedNexus.closeData();
+    savedNexus.openData("errors");
+    savedNexus.getData(errors);
+    savedNexus.closeData();
+    savedNexus.close();
+
+    TS_ASSERT_EQUALS(values.size(), 70);
+    TS_ASSERT_EQUALS(errors.size(), 70);
+    if (values.size() == 70 && errors.size() == 70) {
+      for (size_t i = 0; i < ws->getNumberHistograms(); ++i) {
+        for (size_t j = 0; j < 7; ++j) {
+          TS_ASSERT_EQUALS(values[7 * i + j], ws->y(i)[j]);
+          TS_ASSERT_EQUALS(errors[7 * i + j], ws->e(i)[j]);
+        }
+      }
+    }
+    if (clearfiles)
+      Poco::File(filename).remove();
+  }
+
   void test_nexus_spectraMap() {
     NexusTestHelper th(true);
     th.createFile("MatrixWorkspaceTest.nxs");
@@ -0,0 +1,184 @@
+#ifndef MANTID_DATAOBJECTS_BOXCONTROLLER_MMAP_IO_H
+#define MANTID_DATAOBJECTS_BOXCONTROLLER_MMAP_IO_H
+
+#include "MantidAPI/BoxController.h"
+#include "MantidAPI/IBoxControllerIO.h"
+#include "MantidDataObjects/DllConfig.h"
+
+#include <Poco/RWLock.h>
+#include <Poco/SharedMemory.h>
+
+#include <atomic>
+
+namespace Mantid {
+namespace DataObjects {
+
+//===============================================================================================
+/** The class responsible for keeping the events of a file-backed MD workspace
+  in a flat binary file accessed through a memory map.
+
+  The events are stored one after the other, with the same columns as in the
+  event_data array written by BoxControllerNeXusIO, so the box file positions
+  are the same for both formats. The file starts with a fixed size header
+  describing the events and the list of free space blocks of the disk buffer
+  is appended to the events when the file is closed. The data are in the
+  native byte order of the machine that wrote them.
+
+  Loading a block is a copy from the mapped pages, with no file seek or read
+  call, and the operating system page cache decides which parts of the file
+  are kept in memory. When the file stores the values with the requested
+  precision, viewBlock passes the mapped values without copying them. Blocks
+  can be loaded and saved by several threads at once; the file is only locked
+  exclusively when it has to grow or is copied.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL BoxControllerMMapIO
+    : public API::IBoxControllerIO {
+public:
+  /// What an existing events file can be used for
+  enum class FileState {
+    Missing,  ///< the file does not exist
+    Reusable, ///< the file was closed properly and can be opened
+    InUse,    ///< the file is opened or was not closed properly
+    Invalid   ///< the file does not hold events of this type
+  };
+
+  BoxControllerMMapIO(API::BoxController *const bc);
+
+  ///@return true if the file to write events is opened and false otherwise
+  bool isOpened() const override { return m_opened; }
+  /// get the full file name of the file used for IO operations
+  const std::string &getFileName() const override { return m_fileName; }
+  /**Return the number of events the file grows by at least*/
+  size_t getDataChunk() const override { return DATA_CHUNK; }
+
+  bool openFile(const std::string &fileName, const std::string &mode) override;
+  bool openInPlace(const std::string &nexusFileName,
+                   const std::string &copyFileName);
+  /// @return true if the events are read from the NeXus file they were saved
+  /// to
+  bool isInPlace() const { return m_inPlace; }
+  void setRemoveOnClose(const bool remove,
+                        const std::string &keepUnchangedAs = "");
+  FileState getFileState(const std::string &fileName) const;
+
+  void saveBlock(const std::vector<float> & /* DataBlock */,
+                 const uint64_t /*blockPosition*/) const override;
+  void loadBlock(std::vector<float> & /* Block */,
+                 const uint64_t /*blockPosition*/,
+                 const size_t /*BlockSize*/) const override;
+  void saveBlock(const std::vector<double> & /* DataBlock */,
+                 const uint64_t /*blockPosition*/) const override;
+  void loadBlock(std::vector<double> & /* Block */,
+                 const uint64_t /*blockPosition*/,
+                 const size_t /*BlockSize*/) const override;
+  bool viewBlock(const uint64_t /*blockPosition*/, const size_t /*BlockSize*/,
+                 const std::function<void(const float *, size_t)> & /*visit*/)
+      const override;
+  bool viewBlock(const uint64_t /*blockPosition*/, const size_t /*BlockSize*/,
+                 const std::function<void(const double *, size_t)> & /*visit*/)
+      const override;
+
+  void flushData() const override;
+  void closeFile() override;
+
+  ~BoxControllerMMapIO() override;
+
+  void setDataType(const size_t blockSize,
+                   const std::string &typeName) override;
+  void getDataType(size_t &CoordSize, std::string &typeName) const override;
+
+  // Auxiliary functions (non-virtual, used for testing)
+  size_t getNDataColums() const { return m_nColumns; }
+  /// the number of events the file can hold before it has to grow
+  uint64_t getCapacity() const { return m_capacity; }
+
+private:
+  /// Minimal number of events the file grows by
+  enum { DATA_CHUNK = 10000 };
+  /// possible event types this class understands, as in BoxControllerNeXusIO
+  enum EventType { LeanEvent = 0, FatEvent = 1 };
+  /// The description of the events at the start of the file
+  struct FileHeader;
+
+  /// full file name (with path) of the events file
+  mutable std::string m_fileName;
+  /// the file the events mapped in place are copied to before they change
+  std::string m_copyFileName;
+  /// true when the file is opened
+  bool m_opened;
+  /// identifier if the file open only for reading or is in read/write
+  mutable bool m_ReadOnly;
+  /// true while the events are mapped from the NeXus file they were saved to
+  mutable std::atomic<bool> m_inPlace;
+  /// remove the file when it is closed
+  mutable bool m_removeOnClose;
+  /// if not empty, a file which should be removed is renamed to this name
+  /// instead if no events were saved to it
+  mutable std::string m_keepUnchangedAs;
+  /// true once events have been saved to the file since it was opened
+  mutable std::atomic<bool> m_written;
+  /// the box controller, which is responsible for this IO
+  API::BoxController *const m_bc;
+  /// number of bytes in the event coordinates requested by the client
+  unsigned int m_CoordSize;
+  /// the type of event this class deals with
+  EventType m_EventType;
+  /// the symbolic description of the event types supported by the class
+  std::vector<std::string> m_EventsTypesSupported;
+  /// number of values each event is stored as
+  size_t m_nColumns;
+  /// number of bytes in the event coordinates stored in the file
+  unsigned int m_fileCoordSize;
+  /// the number of events the mapped file can hold
+  mutable uint64_t m_capacity;
+  /// the position of the first event in the mapped file
+  mutable uint64_t m_dataOffset;
+  /// the mapping of the whole file
+  mutable Poco::SharedMemory m_map;
+  /// held exclusively while the file is remapped and shared otherwise
+  mutable Poco::RWLock m_mapLock;
+
+  char *eventData() const;
+  size_t eventBytes() const;
+  FileHeader readHeader(const std::string &fileName) const;
+  void readFile();
+  void writeHeader(const uint64_t nFreeSpaceEntries, const bool closed) const;
+  void copyToOwnFile() const;
+  void mapFile(const uint64_t capacity) const;
+  void growFile(const uint64_t nEvents) const;
+
+  template <typename Type>
+  void saveGenericBlock(const std::vector<Type> &DataBlock,
+                        const uint64_t blockPosition) const;
+  template <typename Type>
+  void loadGenericBlock(std::vector<Type> &Block, const uint64_t blockPosition,
+                        const size_t nPoints) const;
+  template <typename Type>
+  bool viewGenericBlock(const uint64_t blockPosition, const size_t nPoints,
+                        const std::function<void(const Type *, size_t)> &visit)
+      const;
+};
+} // namespace DataObjects
+} // namespace Mantid
+#endif
@@ -51,6 +51,7 @@ public:
   size_t getDataChunk() const override { return m_dataChunk; }
 
   bool openFile(const std::string &fileName, const std::string &mode) override;
+  void setContiguousLength(const uint64_t nEvents);
 
   void saveBlock(const std::vector<float> & /* DataBlock */,
                  const uint64_t /*blockPosition*/) const override;
@@ -103,6 +104,9 @@ private:
   /// the vector, which describes the event specific data size, namely how many
   /// column an event is composed into and this class reads/writres
   std::vector<int64_t> m_BlockSize;
+  /// the number of events of a new event data array stored contiguously, or 0
+  /// to create an extendible array stored in chunks
+  uint64_t m_contiguousLength;
   /// lock Nexus file operations as Nexus is not thread safe
   mutable std::mutex m_fileMutex;
 
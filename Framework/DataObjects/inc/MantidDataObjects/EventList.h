@@ -16,6 +16,7 @@ class DateAndTime;
 }
 } // namespace Types
 namespace Kernel {
+class BinEdgeFinder;
 class SplittingInterval;
 using TimeSplitterType = std::vector<SplittingInterval>;
 class Unit;
@@ -180,6 +181,8 @@ public:
 
   bool isSortedByTof() const override;
 
+  bool isSortedByPulseTime() const;
+
   EventSortType getSortType() const;
 
   // X-vector accessors. These reset the MRU for this spectrum
@@ -325,6 +328,14 @@ public:
                                   const std::vector<int> &vec_target,
                                   std::map<int, EventList *> outputs) const;
 
+  /// Split events into many outputs in a single pass, without sorting
+  void splitByTimeIntoTargets(const std::vector<int64_t> &splitTimes,
+                              const std::vector<int> &splitTargets,
+                              const std::vector<EventList *> &outputs,
+                              const bool pulseTimeOnly = false,
+                              const double toffactor = 1.0,
+                              const double tofshift = 0.0) const;
+
   void multiply(const double value, const double error = 0.0) override;
   EventList &operator*=(const double value);
 
@@ -377,6 +388,10 @@ private:
   }
   HistogramData::Histogram &mutableHistogramRef() override;
 
+  void cachedHistogram(Kernel::cow_ptr<HistogramData::HistogramY> &yData,
+                       Kernel::cow_ptr<HistogramData::HistogramE> &eData) const;
+  void eventsReordered() const;
+
   /// Histogram object holding the histogram data. Currently only X.
   HistogramData::Histogram m_histogram;
 
@@ -459,6 +474,15 @@ private:
                                         const MantidVec &X, MantidVec &Y,
                                         MantidVec &E);
   template <class T>
+  static void histogramUnsortedHelper(const std::vector<T> &events,
+                                      const Kernel::BinEdgeFinder &binFinder,
+                                      MantidVec &Y, MantidVec &E);
+  template <class T>
+  static void addEventsToHistogramHelper(const std::vector<T> &events,
+                                         const size_t first,
+                                         const Kernel::BinEdgeFinder &binFinder,
+                                         MantidVec &Y, MantidVec &E);
+  template <class T>
   static void integrateHelper(std::vector<T> &events, const double minX,
                               const double maxX, const bool entireRange,
                               double &sum, double &error);
@@ -493,6 +517,7 @@ private:
   template <class T>
   static void setTofsHelper(std::vector<T> &events,
                             const std::vector<double> &tofs);
+  void keepPulseTimeSortOrder() const;
   template <class T>
   static void filterByPulseTimeHelper(std::vector<T> &events,
                                       Types::Core::DateAndTime start,
@@ -530,6 +555,15 @@ private:
                                    std::map<int, EventList *> outputs,
                                    typename std::vector<T> &events) const;
 
+  template <class T>
+  void splitByTimeIntoTargetsHelper(const std::vector<int64_t> &splitTimes,
+                                    const std::vector<int> &splitTargets,
+                                    const std::vector<EventList *> &outputs,
+                                    const std::vector<T> &events,
+                                    const bool pulseTimeOnly,
+                                    const double toffactor,
+                                    const double tofshift) const;
+
   template <class T>
   std::string splitByFullTimeVectorSplitterHelper(
       const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
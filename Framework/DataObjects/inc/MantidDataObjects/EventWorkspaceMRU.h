@@ -1,16 +1,23 @@
 #ifndef MANTID_DATAOBJECTS_EVENTWORKSPACEMRU_H_
 #define MANTID_DATAOBJECTS_EVENTWORKSPACEMRU_H_
 
+#include "MantidAPI/IEventList.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/cow_ptr.h"
 #include "MantidKernel/MRUList.h"
+#include "MantidHistogramData/HistogramX.h"
 #include "MantidHistogramData/HistogramY.h"
 #include "MantidHistogramData/HistogramE.h"
 
 #include "Poco/RWLock.h"
 
+#include <array>
 #include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace Mantid {
@@ -53,6 +60,18 @@ public:
 /** This is a container for the MRU (most-recently-used) list
  * of generated histograms.
 
+  The histograms of the event lists are kept in a cache shared by all the
+  threads. The caches of all the workspaces share a memory limit set by the
+  eventworkspace.histogramcache.memory key of the ConfigService, in MB. Each
+  histogram records the number and type of the events and the bin edges it
+  was generated from, so that the histogram of an event list that only had
+  events appended since is updated with the new events instead of being
+  generated again. The cache is split in shards with their own locks, so
+  that threads reading different spectra rarely wait for each other.
+
+  The per-thread MRU lists keep the last histograms returned by reference on
+  each thread alive.
+
   Copyright &copy; 2011-2 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
  National Laboratory & European Spallation Source
 
@@ -84,6 +103,20 @@ public:
   using mru_listY = Kernel::MRUList<YWithMarker>;
   using mru_listE = Kernel::MRUList<EWithMarker>;
 
+  /// A histogram of an event list and what it was generated from
+  struct Histogram {
+    YType y{nullptr};
+    EType e{nullptr};
+    /// The number of events in the histogram
+    size_t numEvents{0};
+    /// The type of the events
+    API::EventType eventType{API::TOF};
+    /// The bin edges of the histogram
+    Kernel::cow_ptr<HistogramData::HistogramX> x{nullptr};
+  };
+
+  EventWorkspaceMRU();
+  explicit EventWorkspaceMRU(const size_t memoryLimit);
   ~EventWorkspaceMRU();
 
   void ensureEnoughBuffersY(size_t thread_num) const;
@@ -98,11 +131,21 @@ public:
 
   void deleteIndex(const EventList *index);
 
+  Histogram findHistogram(const EventList *index) const;
+  void insertHistogram(const EventList *index, Histogram histogram);
+  void eventsReordered(const EventList *index, const size_t numEvents);
+
   /** Return how many entries in the Y MRU list are used.
    * Only used in tests. It only returns the 0-th MRU list size.
    * @return :: number of entries in the MRU list. */
   size_t MRUSize() const;
 
+  size_t histogramCacheSize() const;
+  size_t histogramCacheMemory() const;
+  static size_t processHistogramCacheMemory();
+  static size_t processHistogramCacheMemoryLimit();
+  static void setProcessHistogramCacheMemoryLimit(const size_t memoryLimit);
+
 protected:
   /// The most-recently-used list of dataY histograms
   mutable std::vector<mru_listY *> m_bufferedDataY;
@@ -113,6 +156,43 @@ protected:
   /// Mutex when adding entries in the MRU list
   mutable Poco::RWLock m_changeMruListsMutexE;
   mutable Poco::RWLock m_changeMruListsMutexY;
+
+private:
+  /// A cached histogram, when it was last used and its position in the
+  /// least-recently-used order of its shard
+  struct CachedHistogram {
+    Histogram histogram;
+    size_t memory;
+    /// Time stamp of the last use, comparable across the caches sharing the
+    /// memory limit
+    size_t lastUsed;
+    std::list<const EventList *>::iterator position;
+  };
+
+  /// Part of the histogram cache, with its own lock
+  struct Shard {
+    std::unordered_map<const EventList *, CachedHistogram> histograms;
+    /// The event lists, from the most to the least recently used
+    std::list<const EventList *> order;
+    /// Memory used by the histograms in bytes
+    size_t memory{0};
+    mutable std::mutex mutex;
+  };
+
+  /// The memory that histogram caches may use together
+  class MemoryBudget;
+
+  /// Number of shards of the histogram cache
+  static constexpr size_t NUM_SHARDS = 16;
+
+  static std::shared_ptr<MemoryBudget> processMemoryBudget();
+  Shard &shard(const EventList *index) const;
+  void erase(Shard &shard, const EventList *index) const;
+
+  /// The shards of the histogram cache
+  mutable std::array<Shard, NUM_SHARDS> m_shards;
+  /// The memory limit of the histogram cache, shared with other caches
+  std::shared_ptr<MemoryBudget> m_budget;
 };
 
 } // namespace DataObjects
@@ -7,6 +7,9 @@
 #include "MantidDataObjects/DllConfig.h"
 #include "MantidGeometry/Math/Quadrilateral.h"
 #include "MantidDataObjects/RebinnedOutput.h"
+#include "MantidTypes/SpectrumDefinition.h"
+
+#include <vector>
 
 namespace Mantid {
 //------------------------------------------------------------------------------
@@ -50,6 +53,97 @@ Code Documentation is available at: <http://doxygen.mantidproject.org>
 
 namespace FractionalRebinning {
 
+/**
+ * Sums of the signal, variance and fractional area of the bins of an output
+ * workspace, accumulated by a single thread over a block of the input. Each
+ * block of the input is rebinned into its own PartialOutput, without locking,
+ * and addPartialOutputs() then adds them to the output workspace in a fixed
+ * order so that the result does not depend on the scheduling of the threads.
+ */
+class MANTID_DATAOBJECTS_DLL PartialOutput {
+public:
+  PartialOutput() = default;
+  explicit PartialOutput(const API::MatrixWorkspace &outputWS);
+
+  /// The output horizontal axis edges
+  const std::vector<double> &xAxis() const { return m_xAxis; }
+  /// Add to the sums of output bin xi of output spectrum yi
+  void add(const size_t yi, const size_t xi, const double signal,
+           const double variance, const double fraction) {
+    const size_t index = yi * m_blocksize + xi;
+    m_signal[index] += signal;
+    m_variance[index] += variance;
+    m_fraction[index] += fraction;
+  }
+
+private:
+  friend MANTID_DATAOBJECTS_DLL void
+  addPartialOutputs(const std::vector<PartialOutput> &partials,
+                    API::MatrixWorkspace &outputWS);
+
+  /// The output horizontal axis edges
+  std::vector<double> m_xAxis;
+  /// Number of bins in each output spectrum
+  size_t m_blocksize{0};
+  /// Sums of the signal, by output spectrum then bin
+  std::vector<double> m_signal;
+  /// Sums of the variance, by output spectrum then bin
+  std::vector<double> m_variance;
+  /// Sums of the fractional area, by output spectrum then bin
+  std::vector<double> m_fraction;
+};
+
+/// Add the sums of each block, in order, to the output workspace
+MANTID_DATAOBJECTS_DLL void
+addPartialOutputs(const std::vector<PartialOutput> &partials,
+                  API::MatrixWorkspace &outputWS);
+
+/**
+ * Splits the input of a rebinning into contiguous blocks, each rebinned by a
+ * single thread into its own PartialOutput and, optionally, its own mapping of
+ * the output spectra to detectors. There is one block per thread, so that
+ * the output only depends on the number of threads: each block holds three
+ * doubles per output bin.
+ */
+class MANTID_DATAOBJECTS_DLL PartialOutputs {
+public:
+  PartialOutputs(const API::MatrixWorkspace &outputWS, const size_t inputSize,
+                 const bool parallel, const bool withMapping = false);
+
+  /// The number of blocks the input is split into
+  int numberOfBlocks() const { return static_cast<int>(m_partials.size()); }
+  /// Index of the first item of the input in a block
+  size_t blockBegin(const int block) const {
+    return m_inputSize * block / m_partials.size();
+  }
+  /// Index past the last item of the input in a block
+  size_t blockEnd(const int block) const {
+    return m_inputSize * (block + 1) / m_partials.size();
+  }
+  /// Allocate the sums of a block, from the thread rebinning it
+  PartialOutput &initBlock(const int block);
+  /// The mapping of the output spectra to detectors of a block
+  std::vector<SpectrumDefinition> &mapping(const int block) {
+    return m_mappings[block];
+  }
+  /// Add the sums of each block, in order, to the output workspace
+  void addTo(API::MatrixWorkspace &outputWS) const;
+  /// Add the mapping of each block, in order, to the output mapping
+  void addMappingsTo(std::vector<SpectrumDefinition> &mapping) const;
+
+private:
+  /// The workspace the blocks are rebinned to
+  const API::MatrixWorkspace &m_outputWS;
+  /// Number of items (spectra or angles) in the input
+  size_t m_inputSize;
+  /// Whether the blocks record a mapping to detectors
+  bool m_withMapping;
+  /// The sums of each block
+  std::vector<PartialOutput> m_partials;
+  /// The mapping of each block
+  std::vector<std::vector<SpectrumDefinition>> m_mappings;
+};
+
 /// Find the intersect region on the output grid
 MANTID_DATAOBJECTS_DLL bool
 getIntersectionRegion(const std::vector<double> &xAxis,
@@ -79,6 +173,21 @@ MANTID_DATAOBJECTS_DLL void rebinToFractionalOutput(
     const std::vector<double> &verticalAxis,
     const DataObjects::RebinnedOutput_const_sptr &inputRB = nullptr);
 
+/// Rebin the input quadrilateral to the sums of a block of the input
+MANTID_DATAOBJECTS_DLL void
+rebinToOutput(const Geometry::Quadrilateral &inputQ,
+              const API::MatrixWorkspace_const_sptr &inputWS, const size_t i,
+              const size_t j, PartialOutput &partial,
+              const std::vector<double> &verticalAxis);
+
+/// Rebin the input quadrilateral to the sums of a block of the input
+MANTID_DATAOBJECTS_DLL void rebinToFractionalOutput(
+    const Geometry::Quadrilateral &inputQ,
+    const API::MatrixWorkspace_const_sptr &inputWS, const size_t i,
+    const size_t j, PartialOutput &partial,
+    const std::vector<double> &verticalAxis,
+    const DataObjects::RebinnedOutput_const_sptr &inputRB = nullptr);
+
 } // namespace FractionalRebinning
 
 } // namespace DataObjects
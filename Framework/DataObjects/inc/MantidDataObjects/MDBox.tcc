@@ -905,6 +905,14 @@ TMDE(void MDBox)::loadAndAddFrom(API::IBoxControllerIO *const FileSaver,
 
   std::lock_guard<std::mutex> _lock(this->m_dataMutex);
 
+  // convert the events where the IO keeps them, if it can, to avoid a copy
+  const std::function<void(const coord_t *, size_t)> addEvents =
+      [this](const coord_t *values, size_t nValues) {
+        MDE::dataToEvents(values, nValues, data, false);
+      };
+  if (FileSaver->viewBlock(filePosition, nEvents, addEvents))
+    return;
+
   std::vector<coord_t> TableData;
   FileSaver->loadBlock(TableData, filePosition, nEvents);
 
@@ -225,10 +225,23 @@ public:
   static inline void dataToEvents(const std::vector<coord_t> &data,
                                   std::vector<MDEvent<nd>> &events,
                                   bool reserveMemory = true) {
+    dataToEvents(data.data(), data.size(), events, reserveMemory);
+  }
+  /* static method used to convert an array of data into vector of events
+   @param data      -- array of events coordinates, their signal and error
+   casted to coord_t type
+   @param nValues   -- the number of values in the array
+   @param events    -- vector of events
+   @param reserveMemory -- reserve memory for events copying. Set to false if
+   one wants to add new events to the existing one.
+  */
+  static inline void dataToEvents(const coord_t *data, const size_t nValues,
+                                  std::vector<MDEvent<nd>> &events,
+                                  bool reserveMemory = true) {
     // Number of columns = number of dimensions + 4 (signal/error)+detId+runID
     size_t numColumns = (nd + 4);
-    size_t numEvents = data.size() / numColumns;
-    if (numEvents * numColumns != data.size())
+    size_t numEvents = nValues / numColumns;
+    if (numEvents * numColumns != nValues)
       throw(std::invalid_argument("wrong input array of data to convert to "
                                   "lean events, suspected column data for "
                                   "different dimensions/(type of) events "));
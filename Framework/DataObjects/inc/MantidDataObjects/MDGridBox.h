@@ -129,6 +129,7 @@ public:
   //----------------------------------------------------------------------------------------------------------------------
   size_t addEvent(const MDE &event) override;
   size_t addEventUnsafe(const MDE &event) override;
+  size_t addEvents(const std::vector<MDE> &events) override;
 
   /*--------------->  EVENTS from event data
    * <-------------------------------------------------------------*/
@@ -213,6 +214,8 @@ public:
 private:
   /// Compute the index of the child box for the given event
   size_t calculateChildIndex(const MDE &event) const;
+  /// Add events within the bounds of this box to the child boxes in bulk
+  void distributeEvents(const std::vector<const MDE *> &events);
 
   /// Each dimension is split into this many equally-sized boxes
   size_t split[nd];
@@ -11,6 +11,7 @@
 #include "MantidDataObjects/MDGridBox.h"
 #include <boost/math/special_functions/round.hpp>
 #include <boost/optional.hpp>
+#include <algorithm>
 #include <ostream>
 #include "MantidKernel/Strings.h"
 
@@ -1683,6 +1684,89 @@ TMDE(inline size_t MDGridBox)::addEventUnsafe(const MDE &event) {
     return 0;
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Add several events to the grid box. Bounds checking IS performed, and
+ * events outside the range are rejected.
+ *
+ * The events are grouped by the box they belong to and each group is added to
+ * its box at once, so a box is locked once per call rather than once per
+ * event. Threads that add their events in batches therefore contend much less
+ * for the most populated boxes than when adding them one at a time.
+ *
+ * Note! nPoints, signal and error must be re-calculated using refreshCache()
+ * after all events have been added.
+ *
+ * @param events :: vector of events to be copied.
+ * @return the number of events that were rejected (because of being out of
+ *bounds)
+ */
+TMDE(size_t MDGridBox)::addEvents(const std::vector<MDE> &events) {
+  std::vector<const MDE *> inBounds;
+  inBounds.reserve(events.size());
+  for (const auto &event : events) {
+    bool badEvent = false;
+    for (size_t d = 0; d < nd; d++) {
+      if (this->extents[d].outside(event.getCenter(d))) {
+        badEvent = true;
+        break;
+      }
+    }
+    if (!badEvent)
+      inBounds.push_back(&event);
+  }
+  distributeEvents(inBounds);
+  return events.size() - inBounds.size();
+}
+
+/** Add events to the child boxes, grouped by child. Grid boxes pass their
+ * group further down, other boxes receive it through a single addEvents()
+ * call. No bounds checking is done, as in addEvent().
+ *
+ * @param events :: the events to add, which must be within this box
+ */
+TMDE(void MDGridBox)::distributeEvents(const std::vector<const MDE *> &events) {
+  using IndexedEvent = std::pair<size_t, const MDE *>;
+  std::vector<IndexedEvent> indexed;
+  indexed.reserve(events.size());
+  for (const auto event : events) {
+    size_t cindex = calculateChildIndex(*event);
+    // Events on the upper boundary of the last child box go to the last box,
+    // as in addEvent()
+    if (cindex == numBoxes)
+      cindex = numBoxes - 1;
+    if (cindex < numBoxes)
+      indexed.emplace_back(cindex, event);
+  }
+  // Stable, so each box receives its events in the order they were given
+  std::stable_sort(indexed.begin(), indexed.end(),
+                   [](const IndexedEvent &a, const IndexedEvent &b) {
+                     return a.first < b.first;
+                   });
+
+  std::vector<MDE> boxEvents;
+  std::vector<const MDE *> gridBoxEvents;
+  auto groupBegin = indexed.cbegin();
+  while (groupBegin != indexed.cend()) {
+    const size_t cindex = groupBegin->first;
+    const auto groupEnd = std::find_if(
+        groupBegin, indexed.cend(),
+        [cindex](const IndexedEvent &e) { return e.first != cindex; });
+    MDBoxBase<MDE, nd> *child = m_Children[cindex];
+    if (child->isBox()) {
+      boxEvents.clear();
+      for (auto it = groupBegin; it != groupEnd; ++it)
+        boxEvents.push_back(*it->second);
+      child->addEvents(boxEvents);
+    } else {
+      gridBoxEvents.clear();
+      for (auto it = groupBegin; it != groupEnd; ++it)
+        gridBoxEvents.push_back(it->second);
+      static_cast<MDGridBox<MDE, nd> *>(child)->distributeEvents(gridBoxEvents);
+    }
+    groupBegin = groupEnd;
+  }
+}
+
 /**Sets particular child MDgridBox at the index, specified by the input
 *parameters
 *@param index     -- the position of the new child in the list of GridBox
@@ -275,10 +275,23 @@ public:
   static inline void dataToEvents(const std::vector<coord_t> &coord,
                                   std::vector<MDLeanEvent<nd>> &events,
                                   bool reserveMemory = true) {
+    dataToEvents(coord.data(), coord.size(), events, reserveMemory);
+  }
+  /* static method used to convert an array of data into vector of lean events
+   @param coord     -- array of events coordinates, their signal and error
+   casted to coord_t type
+   @param nValues   -- the number of values in the array
+   @param events    -- vector of events
+   @param reserveMemory -- reserve memory for events copying. Set to false if
+   one wants to add new events to the existing one.
+  */
+  static inline void dataToEvents(const coord_t *coord, const size_t nValues,
+                                  std::vector<MDLeanEvent<nd>> &events,
+                                  bool reserveMemory = true) {
     // Number of columns = number of dimensions + 2 (signal/error)
     size_t numColumns = (nd + 2);
-    size_t numEvents = coord.size() / numColumns;
-    if (numEvents * numColumns != coord.size())
+    size_t numEvents = nValues / numColumns;
+    if (numEvents * numColumns != nValues)
       throw(std::invalid_argument("wrong input array of data to convert to "
                                   "lean events, suspected column data for "
                                   "different dimensions/(type of) events "));
@@ -0,0 +1,657 @@
+#include "MantidDataObjects/BoxControllerMMapIO.h"
+
+#include "MantidAPI/FileFinder.h"
+#include "MantidDataObjects/MDEvent.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Exception.h"
+
+#include <H5Cpp.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace Mantid {
+namespace DataObjects {
+
+struct BoxControllerMMapIO::FileHeader {
+  char signature[8];
+  uint32_t version;
+  /// number of bytes in each stored value, 4 or 8
+  uint32_t coordSize;
+  /// the EventType of the events
+  uint32_t eventType;
+  /// number of values each event is stored as
+  uint32_t nColumns;
+  /// number of events in the file
+  uint64_t nEvents;
+  /// number of values in the free space list following the events
+  uint64_t nFreeSpaceEntries;
+  /// 1 if the file was closed properly, 0 while it is opened for writing
+  uint32_t closed;
+};
+
+namespace {
+/// The first bytes of every events file
+const char FILE_SIGNATURE[8] = {'M', 'D', 'E', 'V', 'E', 'N', 'T', 'S'};
+/// The version of the file format
+const uint32_t FILE_VERSION = 2;
+/// The space reserved for the header, which keeps the events aligned
+const uint64_t HEADER_SIZE = 64;
+
+/// The events and free space blocks in a NeXus file written by SaveMD
+const char NEXUS_EVENTS_PATH[] = "/MDEventWorkspace/event_data/event_data";
+const char NEXUS_FREE_SPACE_PATH[] =
+    "/MDEventWorkspace/event_data/free_space_blocks";
+
+/// Where the events are stored in a NeXus file
+struct NexusEvents {
+  /// the byte offset of the first event in the file
+  uint64_t offset;
+  /// number of events in the file
+  uint64_t nEvents;
+  /// number of bytes in each stored value, 4 or 8
+  unsigned int coordSize;
+  /// the free space blocks of the disk buffer
+  std::vector<uint64_t> freeSpaceBlocks;
+};
+
+/** Find the events in a NeXus file, if they can be mapped directly: they must
+ * be stored in one contiguous, unfiltered block of native floating point
+ * values.
+ * @param fileName :: the NeXus file written by SaveMD
+ * @param nColumns :: the number of values each event is stored as
+ * @param events :: the location of the events
+ * @return true if the events can be mapped in place
+ */
+bool findContiguousEvents(const std::string &fileName, const size_t nColumns,
+                          NexusEvents &events) {
+  H5::Exception::dontPrint();
+  try {
+    H5::H5File file(fileName, H5F_ACC_RDONLY);
+    H5::DataSet data = file.openDataSet(NEXUS_EVENTS_PATH);
+    const H5::DSetCreatPropList properties = data.getCreatePlist();
+    if (properties.getLayout() != H5D_CONTIGUOUS ||
+        properties.getNfilters() != 0)
+      return false;
+
+    const H5::DataType type = data.getDataType();
+    if (type == H5::PredType::NATIVE_FLOAT)
+      events.coordSize = 4;
+    else if (type == H5::PredType::NATIVE_DOUBLE)
+      events.coordSize = 8;
+    else
+      return false;
+
+    const H5::DataSpace space = data.getSpace();
+    hsize_t dims[2];
+    if (space.getSimpleExtentNdims() != 2)
+      return false;
+    space.getSimpleExtentDims(dims);
+    if (dims[1] != nColumns)
+      return false;
+    events.nEvents = dims[0];
+    const haddr_t offset = data.getOffset();
+    if (offset == HADDR_UNDEF)
+      return false;
+    events.offset = offset;
+
+    events.freeSpaceBlocks.clear();
+    if (H5Lexists(file.getId(), NEXUS_FREE_SPACE_PATH, H5P_DEFAULT) > 0) {
+      H5::DataSet blocks = file.openDataSet(NEXUS_FREE_SPACE_PATH);
+      events.freeSpaceBlocks.resize(blocks.getSpace().getSimpleExtentNpoints());
+      if (!events.freeSpaceBlocks.empty())
+        blocks.read(events.freeSpaceBlocks.data(),
+                    H5::PredType::NATIVE_UINT64);
+    }
+  } catch (H5::Exception &) {
+    return false;
+  }
+  return true;
+}
+
+/** Copy values, converting them to the destination type if needed */
+template <typename FROM, typename TO>
+void convertValues(const FROM *source, const size_t nValues, TO *dest) {
+  std::transform(source, source + nValues, dest,
+                 [](const FROM value) { return static_cast<TO>(value); });
+}
+template <typename Type>
+void convertValues(const Type *source, const size_t nValues, Type *dest) {
+  std::copy(source, source + nValues, dest);
+}
+} // namespace
+
+/**Constructor
+ @param bc pointer to the box controller which uses this IO operations
+*/
+BoxControllerMMapIO::BoxControllerMMapIO(API::BoxController *const bc)
+    : m_opened(false), m_ReadOnly(true), m_inPlace(false),
+      m_removeOnClose(false), m_written(false), m_bc(bc),
+      m_CoordSize(sizeof(coord_t)), m_EventType(FatEvent),
+      m_nColumns(4 + bc->getNDims()), m_fileCoordSize(sizeof(coord_t)),
+      m_capacity(0), m_dataOffset(HEADER_SIZE) {
+  m_EventsTypesSupported.resize(2);
+  m_EventsTypesSupported[LeanEvent] = MDLeanEvent<1>::getTypeName();
+  m_EventsTypesSupported[FatEvent] = MDEvent<1>::getTypeName();
+}
+
+/** Set up the event type and the size of the event coordinates used in the
+ * save/load operations. The file keeps the size it was created with and the
+ * values are converted when they are read or written.
+ * @param blockSize -- size (in bytes) of the event coordinates. 4 and 8 are
+ * supported only, e.g. float and double
+ * @param typeName  -- the name of the event used in the operations  */
+void BoxControllerMMapIO::setDataType(const size_t blockSize,
+                                      const std::string &typeName) {
+  if (blockSize != 4 && blockSize != 8)
+    throw std::invalid_argument("The class currently supports 4(float) and "
+                                "8(double) event coordinates only");
+  auto it = std::find(m_EventsTypesSupported.begin(),
+                      m_EventsTypesSupported.end(), typeName);
+  if (it == m_EventsTypesSupported.end())
+    throw std::invalid_argument("Unsupported event type: " + typeName +
+                                " provided ");
+  if (m_opened)
+    throw std::runtime_error(
+        "Can not change the type of the events when the file is opened");
+
+  m_CoordSize = static_cast<unsigned int>(blockSize);
+  m_EventType = static_cast<EventType>(
+      std::distance(m_EventsTypesSupported.begin(), it));
+  m_nColumns = (m_EventType == LeanEvent ? 2 : 4) + m_bc->getNDims();
+}
+
+/** Get the type name and the coordinate size used in the IO operations
+ *@return CoordSize -- size (in bytes) of the event coordinates
+ *@return typeName  -- the name of the event used in the operations
+ */
+void BoxControllerMMapIO::getDataType(size_t &CoordSize,
+                                      std::string &typeName) const {
+  CoordSize = m_CoordSize;
+  typeName = m_EventsTypesSupported[m_EventType];
+}
+
+/**Open the file to use in IO operations with events
+ *
+ *@param fileName -- the name of the file to open. Search for file performed
+ *within the Mantid search path.
+ *@param mode  -- opening mode (read or read/write)
+ *@return false if the file had been already opened
+*/
+bool BoxControllerMMapIO::openFile(const std::string &fileName,
+                                   const std::string &mode) {
+  // file already opened
+  if (m_opened)
+    return false;
+
+  Poco::ScopedWriteRWLock lock(m_mapLock);
+  m_ReadOnly = true;
+  if (mode.find('w') != std::string::npos ||
+      mode.find('W') != std::string::npos) {
+    m_ReadOnly = false;
+  }
+
+  // open file if it exists or create it if not in the mode requested
+  m_fileName = API::FileFinder::Instance().getFullPath(fileName);
+  if (m_fileName.empty()) {
+    if (!m_ReadOnly && Poco::Path(fileName).isAbsolute()) {
+      m_fileName = fileName;
+    } else if (!m_ReadOnly) {
+      std::string filePath =
+          Kernel::ConfigService::Instance().getString("defaultsave.directory");
+      if (filePath.empty())
+        m_fileName = fileName;
+      else
+        m_fileName = filePath + "/" + fileName;
+    } else
+      throw Kernel::Exception::FileError("Can not open file to read ",
+                                         m_fileName);
+  }
+
+  Poco::File file(m_fileName);
+  if (file.exists()) {
+    readFile();
+  } else {
+    if (m_ReadOnly)
+      throw Kernel::Exception::FileError("Can not open file to read ",
+                                         m_fileName);
+    file.createFile();
+    m_fileCoordSize = m_CoordSize;
+    this->setFileLength(0);
+    mapFile(0);
+    writeHeader(0, false);
+  }
+  m_opened = true;
+  return true;
+}
+
+/** Map the events of a NeXus file written by SaveMD directly, without copying
+ * them. This is only possible if the events are stored in one contiguous,
+ * uncompressed array of native values, as SaveMD writes them with
+ * ContiguousEvents set. The NeXus file is only read: the first
+ * time events are saved, all the events are copied to a new file, which is
+ * removed when it is closed.
+ *
+ * @param nexusFileName :: the NeXus file with the events
+ * @param copyFileName :: the file to copy the events to before they are
+ * changed. It must be writable and should not exist.
+ * @return true if the events are mapped, false if the file was already
+ * opened or the events can not be mapped in place
+ */
+bool BoxControllerMMapIO::openInPlace(const std::string &nexusFileName,
+                                      const std::string &copyFileName) {
+  if (m_opened)
+    return false;
+  NexusEvents events;
+  if (!findContiguousEvents(nexusFileName, m_nColumns, events))
+    return false;
+
+  Poco::ScopedWriteRWLock lock(m_mapLock);
+  m_fileName = nexusFileName;
+  m_copyFileName = copyFileName;
+  m_ReadOnly = true;
+  m_fileCoordSize = events.coordSize;
+  m_dataOffset = events.offset;
+  this->setFreeSpaceVector(events.freeSpaceBlocks);
+  this->setFileLength(events.nEvents);
+  mapFile(events.nEvents);
+  m_inPlace = true;
+  m_opened = true;
+  return true;
+}
+
+/** Set what happens to a file opened for writing when it is closed, by
+ * default it is kept.
+ * @param remove :: remove the file when it is closed
+ * @param keepUnchangedAs :: if not empty and no events were saved to the file,
+ * close it properly and rename it to this name instead of removing it, so it
+ * can be used again. An existing file of this name is replaced.
+ */
+void BoxControllerMMapIO::setRemoveOnClose(const bool remove,
+                                           const std::string &keepUnchangedAs) {
+  m_removeOnClose = remove;
+  m_keepUnchangedAs = keepUnchangedAs;
+}
+
+/** Find out if an existing file can be opened to hold the events of this
+ * type.
+ * @param fileName :: the full name of the file
+ * @return the state of the file
+ */
+BoxControllerMMapIO::FileState
+BoxControllerMMapIO::getFileState(const std::string &fileName) const {
+  if (!Poco::File(fileName).exists())
+    return FileState::Missing;
+  FileHeader header;
+  try {
+    header = readHeader(fileName);
+  } catch (Kernel::Exception::FileError &) {
+    return FileState::Invalid;
+  }
+  return header.closed ? FileState::Reusable : FileState::InUse;
+}
+
+/** Read the header of an events file and check that it describes events of
+ * the type set up for this class.
+ * @param fileName :: the full name of the file
+ * @return the header
+ * @throw FileError if the file does not hold events of this type
+ */
+BoxControllerMMapIO::FileHeader
+BoxControllerMMapIO::readHeader(const std::string &fileName) const {
+  FileHeader header;
+  std::ifstream in(fileName, std::ios::binary);
+  in.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!in || !std::equal(FILE_SIGNATURE, FILE_SIGNATURE + 8, header.signature))
+    throw Kernel::Exception::FileError("The file does not contain MD events ",
+                                       fileName);
+  if (header.version != FILE_VERSION)
+    throw Kernel::Exception::FileError(
+        "Unsupported version of the MD events file ", fileName);
+  if (header.eventType != static_cast<uint32_t>(m_EventType) ||
+      header.nColumns != m_nColumns)
+    throw Kernel::Exception::FileError(
+        "Trying to open event data with different type of events or number "
+        "of dimensions ",
+        fileName);
+  if (header.coordSize != 4 && header.coordSize != 8)
+    throw Kernel::Exception::FileError("Unknown events data format ",
+                                       fileName);
+  return header;
+}
+
+/** Read the header and the free space blocks of an existing file and map it.
+ * The free space blocks are removed from a file opened for writing, as the
+ * events may grow over them. */
+void BoxControllerMMapIO::readFile() {
+  const FileHeader header = readHeader(m_fileName);
+  m_fileCoordSize = header.coordSize;
+
+  const uint64_t eventsEnd = HEADER_SIZE + header.nEvents * eventBytes();
+  std::vector<uint64_t> freeSpaceBlocks(header.nFreeSpaceEntries);
+  if (!freeSpaceBlocks.empty()) {
+    std::ifstream in(m_fileName, std::ios::binary);
+    in.seekg(eventsEnd);
+    in.read(reinterpret_cast<char *>(freeSpaceBlocks.data()),
+            freeSpaceBlocks.size() * sizeof(uint64_t));
+    if (!in)
+      throw Kernel::Exception::FileError(
+          "Can not read the free space blocks from ", m_fileName);
+  }
+  this->setFreeSpaceVector(freeSpaceBlocks);
+  this->setFileLength(header.nEvents);
+
+  mapFile(header.nEvents);
+  if (!m_ReadOnly)
+    writeHeader(0, false);
+}
+
+/** Write the header to the start of the mapped file
+ * @param nFreeSpaceEntries :: the number of values in the list of free space
+ * blocks following the events
+ * @param closed :: true if the file is being closed */
+void BoxControllerMMapIO::writeHeader(const uint64_t nFreeSpaceEntries,
+                                      const bool closed) const {
+  static_assert(sizeof(FileHeader) <= HEADER_SIZE,
+                "The header must fit in the space reserved for it");
+  FileHeader header;
+  std::copy(FILE_SIGNATURE, FILE_SIGNATURE + 8, header.signature);
+  header.version = FILE_VERSION;
+  header.coordSize = m_fileCoordSize;
+  header.eventType = static_cast<uint32_t>(m_EventType);
+  header.nColumns = static_cast<uint32_t>(m_nColumns);
+  header.nEvents = this->getFileLength();
+  header.nFreeSpaceEntries = nFreeSpaceEntries;
+  header.closed = closed ? 1 : 0;
+  std::memcpy(m_map.begin(), &header, sizeof(header));
+}
+
+/** Copy the events mapped in place to the copy file and map that instead.
+ * The copy is removed when it is closed. Must be called with the map lock
+ * held exclusively. */
+void BoxControllerMMapIO::copyToOwnFile() const {
+  // keeps the NeXus file mapped until the events are copied
+  const Poco::SharedMemory nexusMap = m_map;
+  const char *nexusEvents = eventData();
+  const uint64_t nEvents = this->getFileLength();
+
+  m_fileName = m_copyFileName;
+  m_ReadOnly = false;
+  m_dataOffset = HEADER_SIZE;
+  Poco::File(m_fileName).createFile();
+  mapFile(nEvents);
+  std::memcpy(eventData(), nexusEvents, nEvents * eventBytes());
+  writeHeader(0, false);
+  m_removeOnClose = true;
+  m_keepUnchangedAs.clear();
+  m_inPlace = false;
+}
+
+/** (Re)map the file. A file opened for writing is resized first. Must be
+ * called with the map lock held exclusively.
+ * @param capacity :: the number of events the file must hold */
+void BoxControllerMMapIO::mapFile(const uint64_t capacity) const {
+  // unmap the old view of the file before it is resized
+  m_map = Poco::SharedMemory();
+  Poco::File file(m_fileName);
+  if (!m_ReadOnly)
+    file.setSize(HEADER_SIZE + capacity * eventBytes());
+  m_map = Poco::SharedMemory(file, m_ReadOnly ? Poco::SharedMemory::AM_READ
+                                              : Poco::SharedMemory::AM_WRITE);
+  m_capacity = capacity;
+}
+
+/** Grow the file so it can hold at least the given number of events. The file
+ * is at least doubled to make remapping rare. Must be called with the map
+ * lock held exclusively.
+ * @param nEvents :: the number of events the file must hold */
+void BoxControllerMMapIO::growFile(const uint64_t nEvents) const {
+  const uint64_t capacity =
+      std::max({nEvents, 2 * m_capacity, m_capacity + DATA_CHUNK});
+  mapFile(capacity);
+}
+
+/// @return the start of the events in the mapped file
+char *BoxControllerMMapIO::eventData() const {
+  return m_map.begin() + m_dataOffset;
+}
+
+/// @return the number of bytes each event occupies in the file
+size_t BoxControllerMMapIO::eventBytes() const {
+  return m_nColumns * m_fileCoordSize;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+/** Save generic data block on specific position within the file. Blocks which
+  *fit in the file are saved concurrently, the file is locked exclusively only
+  *if it has to grow or the events mapped in place have to be copied first.
+  *@param DataBlock     -- the vector with data to write
+  *@param blockPosition -- The starting place to save data to   */
+template <typename Type>
+void BoxControllerMMapIO::saveGenericBlock(const std::vector<Type> &DataBlock,
+                                           const uint64_t blockPosition) const {
+  const uint64_t blockEnd = blockPosition + DataBlock.size() / m_nColumns;
+  auto copyBlock = [&]() {
+    char *dest = eventData() + blockPosition * eventBytes();
+    if (m_fileCoordSize == 4)
+      convertValues(DataBlock.data(), DataBlock.size(),
+                    reinterpret_cast<float *>(dest));
+    else
+      convertValues(DataBlock.data(), DataBlock.size(),
+                    reinterpret_cast<double *>(dest));
+  };
+
+  auto checkWritable = [this]() {
+    if (m_ReadOnly)
+      throw Kernel::Exception::FileError(
+          "Attempt to write events to the file opened for reading", m_fileName);
+  };
+
+  {
+    Poco::ScopedReadRWLock lock(m_mapLock);
+    if (!m_inPlace) {
+      checkWritable();
+      if (blockEnd <= m_capacity && blockEnd <= this->getFileLength()) {
+        m_written = true;
+        copyBlock();
+        return;
+      }
+    }
+  }
+  Poco::ScopedWriteRWLock lock(m_mapLock);
+  if (m_inPlace)
+    copyToOwnFile();
+  checkWritable();
+  m_written = true;
+  if (blockEnd > m_capacity)
+    growFile(blockEnd);
+  copyBlock();
+  if (blockEnd > this->getFileLength())
+    this->setFileLength(blockEnd);
+}
+
+/** Save float data block on specific position within the file
+ *@param DataBlock     -- the vector with data to write
+ *@param blockPosition -- The starting place to save data to   */
+void BoxControllerMMapIO::saveBlock(const std::vector<float> &DataBlock,
+                                    const uint64_t blockPosition) const {
+  this->saveGenericBlock(DataBlock, blockPosition);
+}
+/** Save double precision data block on specific position within the file
+ *@param DataBlock     -- the vector with data to write
+ *@param blockPosition -- The starting place to save data to   */
+void BoxControllerMMapIO::saveBlock(const std::vector<double> &DataBlock,
+                                    const uint64_t blockPosition) const {
+  this->saveGenericBlock(DataBlock, blockPosition);
+}
+
+/** Load generic data block from the mapped file.
+  *@param Block         -- the storage vector to place data into
+  *@param blockPosition -- The starting place to read data from
+  *@param nPoints       -- number of data points (events) to read
+
+  *@returns Block -- resized block of data containing serialized events
+  representation.
+*/
+template <typename Type>
+void BoxControllerMMapIO::loadGenericBlock(std::vector<Type> &Block,
+                                           const uint64_t blockPosition,
+                                           const size_t nPoints) const {
+  const uint64_t blockEnd = blockPosition + nPoints;
+  if (blockEnd > this->getFileLength())
+    throw Kernel::Exception::FileError("Attempt to read behind the file end",
+                                       m_fileName);
+  Block.resize(nPoints * m_nColumns);
+
+  Poco::ScopedReadRWLock lock(m_mapLock);
+  if (blockEnd > m_capacity)
+    throw Kernel::Exception::FileError(
+        "Attempt to read events which have not been saved", m_fileName);
+  const char *source = eventData() + blockPosition * eventBytes();
+  if (m_fileCoordSize == 4)
+    convertValues(reinterpret_cast<const float *>(source), Block.size(),
+                  Block.data());
+  else
+    convertValues(reinterpret_cast<const double *>(source), Block.size(),
+                  Block.data());
+}
+
+/** Pass a generic data block to visit straight from the mapped file, if the
+  *file stores the values with the requested precision. The file is locked
+  *while visit runs, so it must not save events with this class.
+  *@param blockPosition -- The starting place to read data from
+  *@param nPoints       -- number of data points (events) to read
+  *@param visit         -- function called with the values and their number
+  *@return false if the block has to be loaded with loadBlock instead
+*/
+template <typename Type>
+bool BoxControllerMMapIO::viewGenericBlock(
+    const uint64_t blockPosition, const size_t nPoints,
+    const std::function<void(const Type *, size_t)> &visit) const {
+  const uint64_t blockEnd = blockPosition + nPoints;
+  if (blockEnd > this->getFileLength())
+    throw Kernel::Exception::FileError("Attempt to read behind the file end",
+                                       m_fileName);
+
+  Poco::ScopedReadRWLock lock(m_mapLock);
+  if (blockEnd > m_capacity)
+    throw Kernel::Exception::FileError(
+        "Attempt to read events which have not been saved", m_fileName);
+  const char *source = eventData() + blockPosition * eventBytes();
+  if (m_fileCoordSize != sizeof(Type) ||
+      reinterpret_cast<uintptr_t>(source) % alignof(Type) != 0)
+    return false;
+  visit(reinterpret_cast<const Type *>(source), nPoints * m_nColumns);
+  return true;
+}
+
+/** Pass float data block to visit straight from the mapped file.
+  *@param blockPosition -- The starting place to read data from
+  *@param nPoints       -- number of data points (events) to read
+  *@param visit         -- function called with the values and their number
+  *@return false if the block has to be loaded with loadBlock instead
+*/
+bool BoxControllerMMapIO::viewBlock(
+    const uint64_t blockPosition, const size_t nPoints,
+    const std::function<void(const float *, size_t)> &visit) const {
+  return this->viewGenericBlock(blockPosition, nPoints, visit);
+}
+/** Pass double data block to visit straight from the mapped file.
+  *@param blockPosition -- The starting place to read data from
+  *@param nPoints       -- number of data points (events) to read
+  *@param visit         -- function called with the values and their number
+  *@return false if the block has to be loaded with loadBlock instead
+*/
+bool BoxControllerMMapIO::viewBlock(
+    const uint64_t blockPosition, const size_t nPoints,
+    const std::function<void(const double *, size_t)> &visit) const {
+  return this->viewGenericBlock(blockPosition, nPoints, visit);
+}
+
+/** Load float data block from the mapped file.
+  *@param Block         -- the storage vector to place data into
+  *@param blockPosition -- The starting place to read data from
+  *@param nPoints       -- number of data points (events) to read
+*/
+void BoxControllerMMapIO::loadBlock(std::vector<float> &Block,
+                                    const uint64_t blockPosition,
+                                    const size_t nPoints) const {
+  this->loadGenericBlock(Block, blockPosition, nPoints);
+}
+/** Load double data block from the mapped file.
+  *@param Block         -- the storage vector to place data into
+  *@param blockPosition -- The starting place to read data from
+  *@param nPoints       -- number of data points (events) to read
+*/
+void BoxControllerMMapIO::loadBlock(std::vector<double> &Block,
+                                    const uint64_t blockPosition,
+                                    const size_t nPoints) const {
+  this->loadGenericBlock(Block, blockPosition, nPoints);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+
+/// Record the current number of events in the file header. The events
+/// themselves are written back by the operating system.
+void BoxControllerMMapIO::flushData() const {
+  if (!m_opened || m_ReadOnly)
+    return;
+  Poco::ScopedWriteRWLock lock(m_mapLock);
+  writeHeader(0, false);
+}
+
+/** flush disk buffer data from memory, unmap the file and close it. The file
+ * is truncated to the saved events and the free space blocks are appended to
+ * them, unless it has to be removed. An unchanged file which has to be kept
+ * under another name is renamed once it is complete, so nobody else can see
+ * it half written. */
+void BoxControllerMMapIO::closeFile() {
+  if (!m_opened)
+    return;
+  // write all file-backed data still in the write buffer into the file
+  this->flushCache();
+
+  Poco::ScopedWriteRWLock lock(m_mapLock);
+  if (m_ReadOnly) {
+    m_map = Poco::SharedMemory();
+  } else if (m_removeOnClose && (m_written || m_keepUnchangedAs.empty())) {
+    m_map = Poco::SharedMemory();
+    Poco::File(m_fileName).remove();
+  } else {
+    std::vector<uint64_t> freeSpaceBlocks;
+    this->getFreeSpaceVector(freeSpaceBlocks);
+    writeHeader(freeSpaceBlocks.size(), true);
+    m_map = Poco::SharedMemory();
+
+    const uint64_t eventsEnd =
+        HEADER_SIZE + this->getFileLength() * eventBytes();
+    Poco::File(m_fileName).setSize(eventsEnd);
+    if (!freeSpaceBlocks.empty()) {
+      std::ofstream out(m_fileName,
+                        std::ios::binary | std::ios::in | std::ios::out);
+      out.seekp(eventsEnd);
+      out.write(reinterpret_cast<const char *>(freeSpaceBlocks.data()),
+                freeSpaceBlocks.size() * sizeof(uint64_t));
+      if (!out)
+        throw Kernel::Exception::FileError(
+            "Can not write the free space blocks to ", m_fileName);
+    }
+    if (m_removeOnClose)
+      Poco::File(m_fileName).renameTo(m_keepUnchangedAs);
+  }
+  m_capacity = 0;
+  m_dataOffset = HEADER_SIZE;
+  m_inPlace = false;
+  m_removeOnClose = false;
+  m_keepUnchangedAs.clear();
+  m_written = false;
+  m_opened = false;
+}
+
+BoxControllerMMapIO::~BoxControllerMMapIO() { this->closeFile(); }
+} // namespace DataObjects
+} // namespace Mantid
@@ -26,7 +26,8 @@ std::string BoxControllerNeXusIO::g_DBDataName("free_space_blocks");
 */
 BoxControllerNeXusIO::BoxControllerNeXusIO(API::BoxController *const bc)
     : m_File(nullptr), m_ReadOnly(true), m_dataChunk(DATA_CHUNK), m_bc(bc),
-      m_BlockStart(2, 0), m_BlockSize(2, 0), m_CoordSize(sizeof(coord_t)),
+      m_BlockStart(2, 0), m_BlockSize(2, 0), m_contiguousLength(0),
+      m_CoordSize(sizeof(coord_t)),
       m_EventType(FatEvent), m_EventsVersion("1.0"),
       m_ReadConversion(noConversion) {
   m_BlockSize[1] = 4 + m_bc->getNDims();
@@ -165,6 +166,18 @@ bool BoxControllerNeXusIO::openFile(const std::string &fileName,
 
   return true;
 }
+
+/** Store the event data array created by the next openFile in one
+ * contiguous, uncompressed block of fixed size instead of extendible chunks.
+ * BoxControllerMMapIO can map such an array in place, but no event can be
+ * saved behind its end.
+ * @param nEvents :: the number of events the array holds, or 0 to create an
+ * extendible array
+ */
+void BoxControllerNeXusIO::setContiguousLength(const uint64_t nEvents) {
+  m_contiguousLength = nEvents;
+}
+
 /**Create group responsible for keeping events and add necessary attributes to
  * it*/
 void BoxControllerNeXusIO::CreateEventGroup() {
@@ -208,6 +221,15 @@ void BoxControllerNeXusIO::prepareNxSToWrite_CurVersion() {
   if (groupEntries.find(EventData) != groupEntries.end()) // yes, open it
   {
     prepareNxSdata_CurVersion();
+  } else if (m_contiguousLength > 0) {
+    // A fixed size array without compression is stored contiguously
+    m_BlockSize[0] = static_cast<int64_t>(m_contiguousLength);
+    if (m_CoordSize == 4)
+      m_File->makeData("event_data", ::NeXus::FLOAT32, m_BlockSize, true);
+    else
+      m_File->makeData("event_data", ::NeXus::FLOAT64, m_BlockSize, true);
+    m_File->putAttr("description", m_EventsTypeHeaders[m_EventType]);
+    this->setFileLength(0);
   } else // no, create it
   {
     // Prepare the event data array for writing operations:
@@ -2,6 +2,7 @@
 #include "MantidDataObjects/Histogram1D.h"
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
+#include "MantidKernel/BinEdgeFinder.h"
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/DateAndTimeHelpers.h"
 #include "MantidKernel/Exception.h"
@@ -17,6 +18,7 @@
 #pragma warning(default : 4180)
 #endif
 
+#include <array>
 #include <cfloat>
 #include <cmath>
 #include <functional>
@@ -85,6 +87,38 @@ public:
     return (tAtSample1 < tAtSample2);
   }
 };
+
+/**
+ * Find the first event at or after a pulse time by binary search
+ * @param first : start of a range of events sorted by pulse time
+ * @param last : end of the range
+ * @param time : the pulse time to look for
+ * @return The first event of the range with a pulse time >= time, or last
+ */
+template <typename Iterator>
+Iterator findPulseTime(Iterator first, Iterator last, const DateAndTime &time) {
+  using EventType = typename std::iterator_traits<Iterator>::value_type;
+  return std::lower_bound(first, last, time,
+                          [](const EventType &event, const DateAndTime &t) {
+                            return event.pulseTime() < t;
+                          });
+}
+
+/**
+ * Append a range of events to the events of another list, which must have the
+ * same event type
+ * @param output : The event list to add the events to
+ * @param first : start of the range of events
+ * @param last : end of the range of events
+ */
+template <typename Iterator>
+void appendEvents(EventList &output, Iterator first, Iterator last) {
+  if (first == last)
+    return;
+  std::vector<typename std::iterator_traits<Iterator>::value_type> *events;
+  getEventsFrom(output, events);
+  events->insert(events->end(), first, last);
+}
 }
 //==========================================================================
 /// --------------------- TofEvent Comparators
@@ -228,6 +262,8 @@ void EventList::copyDataFrom(const ISpectrum &source) {
 
 /// Used by copyDataFrom for dynamic dispatch for its `source`.
 void EventList::copyDataInto(EventList &sink) const {
+  if (sink.mru)
+    sink.mru->deleteIndex(&sink);
   sink.m_histogram = m_histogram;
   sink.events = events;
   sink.weightedEvents = weightedEvents;
@@ -337,6 +373,8 @@ void EventList::createFromHistogram(const ISpectrum *inSpec, bool GenerateZeros,
  * */
 EventList &EventList::operator=(const EventList &rhs) {
   // Note that we are NOT copying the MRU pointer.
+  if (mru)
+    mru->deleteIndex(this);
   IEventList::operator=(rhs);
   m_histogram = rhs.m_histogram;
   events = rhs.events;
@@ -1049,6 +1087,7 @@ void EventList::sortTof() const {
   }
   // Save the order to avoid unnecessary re-sorting.
   this->order = TOF_SORT;
+  eventsReordered();
 }
 
 // --------------------------------------------------------------------------
@@ -1092,18 +1131,19 @@ void EventList::sortTimeAtSample(const double &tofFactor,
   }
   // Save the order to avoid unnecessary re-sorting.
   this->order = TIMEATSAMPLE_SORT;
+  eventsReordered();
 }
 
 // --------------------------------------------------------------------------
 /** Sort events by Frame */
 void EventList::sortPulseTime() const {
-  if (this->order == PULSETIME_SORT)
+  if (this->isSortedByPulseTime())
     return; // nothing to do
 
   // Avoid sorting from multiple threads
   std::lock_guard<std::mutex> _lock(m_sortMutex);
   // If the list was sorted while waiting for the lock, return.
-  if (this->order == PULSETIME_SORT)
+  if (this->isSortedByPulseTime())
     return;
 
   // Perform sort.
@@ -1121,6 +1161,7 @@ void EventList::sortPulseTime() const {
   }
   // Save the order to avoid unnecessary re-sorting.
   this->order = PULSETIME_SORT;
+  eventsReordered();
 }
 
 /*
@@ -1152,6 +1193,7 @@ void EventList::sortPulseTimeTOF() const {
 
   // Save
   this->order = PULSETIMETOF_SORT;
+  eventsReordered();
 }
 
 /**
@@ -1183,12 +1225,39 @@ void EventList::sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start,
   }
 
   this->order = UNSORTED; // so the function always re-runs
+  eventsReordered();
+}
+
+// --------------------------------------------------------------------------
+/** Tell the histogram cache that the events were reordered, so that events
+ * appended since its histogram was generated are no longer the last ones. */
+void EventList::eventsReordered() const {
+  if (mru)
+    mru->eventsReordered(this, this->getNumberEvents());
 }
 
 // --------------------------------------------------------------------------
 /** Return true if the event list is sorted by TOF */
 bool EventList::isSortedByTof() const { return (this->order == TOF_SORT); }
 
+// --------------------------------------------------------------------------
+/** Return true if the events are in pulse time order, i.e. sorted by pulse
+ * time alone or by pulse time then TOF. The pulse time filtering and splitting
+ * methods then find the events of a time interval by binary search. */
+bool EventList::isSortedByPulseTime() const {
+  return (this->order == PULSETIME_SORT) || (this->order == PULSETIMETOF_SORT);
+}
+
+// --------------------------------------------------------------------------
+/** Update the sort order after the TOFs were changed without changing the
+ * order of the events: only the sorting by pulse time remains valid. */
+void EventList::keepPulseTimeSortOrder() const {
+  if (this->isSortedByPulseTime())
+    this->order = PULSETIME_SORT;
+  else
+    this->order = UNSORTED;
+}
+
 // --------------------------------------------------------------------------
 /** Return the type of sorting used in this event list */
 EventSortType EventList::getSortType() const { return this->order; }
@@ -1365,8 +1434,11 @@ MantidVec *EventList::makeDataE() const {
 
 HistogramData::Histogram EventList::histogram() const {
   HistogramData::Histogram ret(m_histogram);
-  ret.setSharedY(sharedY());
-  ret.setSharedE(sharedE());
+  Kernel::cow_ptr<HistogramData::HistogramY> yData(nullptr);
+  Kernel::cow_ptr<HistogramData::HistogramE> eData(nullptr);
+  cachedHistogram(yData, eData);
+  ret.setSharedY(yData);
+  ret.setSharedE(eData);
   return ret;
 }
 
@@ -1399,70 +1471,102 @@ const HistogramData::HistogramY &EventList::y() const {
     throw std::runtime_error(
         "'EventList::y()' called with no MRU set. This is not allowed.");
 
-  return *sharedY();
+  // Keep the histogram alive in the MRU of this thread, while the returned
+  // reference is in use
+  const int thread = PARALLEL_THREAD_NUMBER;
+  auto yData = sharedY();
+  mru->ensureEnoughBuffersY(thread);
+  mru->insertY(thread, yData, this);
+  return *yData;
 }
 const HistogramData::HistogramE &EventList::e() const {
   if (!mru)
     throw std::runtime_error(
         "'EventList::e()' called with no MRU set. This is not allowed.");
 
-  return *sharedE();
+  // Keep the histogram alive in the MRU of this thread, while the returned
+  // reference is in use
+  const int thread = PARALLEL_THREAD_NUMBER;
+  auto eData = sharedE();
+  mru->ensureEnoughBuffersE(thread);
+  mru->insertE(thread, eData, this);
+  return *eData;
 }
 Kernel::cow_ptr<HistogramData::HistogramY> EventList::sharedY() const {
-  // This is the thread number from which this function was called.
-  int thread = PARALLEL_THREAD_NUMBER;
-
   Kernel::cow_ptr<HistogramData::HistogramY> yData(nullptr);
-
-  // Is the data in the mrulist?
-  if (mru) {
-    mru->ensureEnoughBuffersY(thread);
-    yData = mru->findY(thread, this);
-  }
-
-  if (!yData) {
-    MantidVec Y;
-    MantidVec E;
-    this->generateHistogram(readX(), Y, E);
-
-    // Create the MRU object
-    yData = Kernel::make_cow<HistogramData::HistogramY>(std::move(Y));
-
-    // Lets save it in the MRU
-    if (mru) {
-      mru->insertY(thread, yData, this);
-      auto eData = Kernel::make_cow<HistogramData::HistogramE>(std::move(E));
-      mru->ensureEnoughBuffersE(thread);
-      mru->insertE(thread, eData, this);
-    }
-  }
+  Kernel::cow_ptr<HistogramData::HistogramE> eData(nullptr);
+  cachedHistogram(yData, eData);
   return yData;
 }
 Kernel::cow_ptr<HistogramData::HistogramE> EventList::sharedE() const {
-  // This is the thread number from which this function was called.
-  int thread = PARALLEL_THREAD_NUMBER;
-
+  Kernel::cow_ptr<HistogramData::HistogramY> yData(nullptr);
   Kernel::cow_ptr<HistogramData::HistogramE> eData(nullptr);
+  cachedHistogram(yData, eData);
+  return eData;
+}
 
-  // Is the data in the mrulist?
-  if (mru) {
-    mru->ensureEnoughBuffersE(thread);
-    eData = mru->findE(thread, this);
+/** Get the Y and E histograms from the histogram cache of the workspace. If
+ * events were only appended since they were cached, the new events are added
+ * to them. Otherwise they are generated from all the events and cached.
+ *
+ * @param yData :: set to the Y histogram
+ * @param eData :: set to the E histogram
+ */
+void EventList::cachedHistogram(
+    Kernel::cow_ptr<HistogramData::HistogramY> &yData,
+    Kernel::cow_ptr<HistogramData::HistogramE> &eData) const {
+  EventWorkspaceMRU::Histogram cached;
+  if (mru)
+    cached = mru->findHistogram(this);
+  const size_t numEvents = this->getNumberEvents();
+  // The cache holds the bin edges, so they are copied rather than changed in
+  // place and the same pointer means the same bin edges
+  const bool sameBins = cached.y && cached.eventType == eventType &&
+                        cached.x == m_histogram.sharedX();
+  if (sameBins && cached.numEvents == numEvents) {
+    yData = cached.y;
+    eData = cached.e;
+    return;
   }
 
-  if (!eData) {
-    // Now use that to get E -- Y values are generated from another function
-    MantidVec Y_ignored;
-    MantidVec E;
-    this->generateHistogram(readX(), Y_ignored, E);
-    eData = Kernel::make_cow<HistogramData::HistogramE>(std::move(E));
+  MantidVec Y;
+  MantidVec E;
+  if (sameBins && cached.numEvents < numEvents) {
+    // Only histogram the appended events
+    Y = cached.y->rawData();
+    E = cached.e->rawData();
+    const Kernel::BinEdgeFinder binFinder(readX());
+    switch (eventType) {
+    case TOF:
+      addEventsToHistogramHelper(this->events, cached.numEvents, binFinder, Y,
+                                 E);
+      break;
+    case WEIGHTED:
+      addEventsToHistogramHelper(this->weightedEvents, cached.numEvents,
+                                 binFinder, Y, E);
+      break;
+    case WEIGHTED_NOTIME:
+      addEventsToHistogramHelper(this->weightedEventsNoTime, cached.numEvents,
+                                 binFinder, Y, E);
+      break;
+    }
+  } else {
+    this->generateHistogram(readX(), Y, E);
+  }
+  yData = Kernel::make_cow<HistogramData::HistogramY>(std::move(Y));
+  eData = Kernel::make_cow<HistogramData::HistogramE>(std::move(E));
 
-    // Lets save it in the MRU
-    if (mru)
-      mru->insertE(thread, eData, this);
+  // Lets save it in the cache
+  if (mru) {
+    cached.y = yData;
+    cached.e = eData;
+    cached.numEvents = numEvents;
+    cached.eventType = eventType;
+    cached.x = m_histogram.sharedX();
+    mru->insertHistogram(this, std::move(cached));
   }
-  return eData;
 }
+
 /** Look in the MRU to see if the Y histogram has been generated before.
  * If so, return that. If not, calculate, cache and return it.
  *
@@ -1473,9 +1577,9 @@ const MantidVec &EventList::dataY() const {
     throw std::runtime_error(
         "'EventList::dataY()' called with no MRU set. This is not allowed.");
 
-  // WARNING: The Y data of sharedY() is stored in MRU, returning reference fine
+  // WARNING: The Y data of y() is stored in MRU, returning reference fine
   // as long as it stays there.
-  return sharedY()->rawData();
+  return y().rawData();
 }
 
 /** Look in the MRU to see if the E histogram has been generated before.
@@ -1488,9 +1592,9 @@ const MantidVec &EventList::dataE() const {
     throw std::runtime_error(
         "'EventList::dataE()' called with no MRU set. This is not allowed.");
 
-  // WARNING: The E data of sharedE() is stored in MRU, returning reference fine
+  // WARNING: The E data of e() is stored in MRU, returning reference fine
   // as long as it stays there.
-  return sharedE()->rawData();
+  return e().rawData();
 }
 
 // --------------------------------------------------------------------------
@@ -1835,8 +1939,9 @@ void EventList::compressFatEvents(
   }
   // In all cases, you end up WEIGHTED_NOTIME.
   destination->eventType = WEIGHTED;
-  // The sort order is pulsetimetof as we've compressed out the tolerance
-  destination->order = PULSETIMETOF_SORT;
+  // The events are sorted by TOF within each pulse time bin, so their
+  // (averaged) pulse times are not in order
+  destination->order = UNSORTED;
   // Empty out storage for vectors that are now unused.
   destination->clearUnused();
 }
@@ -2040,6 +2145,81 @@ void EventList::histogramForWeightsHelper(const std::vector<T> &events,
                  static_cast<double (*)(double)>(sqrt));
 }
 
+// --------------------------------------------------------------------------
+/** Generates both the Y and E (error) histograms for bin edges whose bin
+ * index can be computed directly (linear or logarithmic). The events do not
+ * need to be sorted.
+ *
+ * @param events: vector of events (with or without weights)
+ * @param binFinder: finds the bin index for the X-bins supplied
+ * @param Y: counts returned
+ * @param E: errors returned
+ */
+template <class T>
+void EventList::histogramUnsortedHelper(const std::vector<T> &events,
+                                        const Kernel::BinEdgeFinder &binFinder,
+                                        MantidVec &Y, MantidVec &E) {
+  Y.assign(binFinder.numberOfBins(), 0.0);
+  // Note: Errors will be squared until the last step.
+  E.assign(binFinder.numberOfBins(), 0.0);
+
+  // The bin indices are found for a block of events at a time, so that the
+  // index computation runs over a contiguous array of TOFs
+  constexpr size_t blockSize = 1024;
+  double tofs[blockSize];
+  int64_t bins[blockSize];
+  for (size_t start = 0; start < events.size(); start += blockSize) {
+    const size_t n = std::min(blockSize, events.size() - start);
+    const auto block = events.cbegin() + start;
+    for (size_t i = 0; i < n; ++i)
+      tofs[i] = block[i].tof();
+    binFinder.bins(tofs, n, bins);
+    for (size_t i = 0; i < n; ++i) {
+      if (bins[i] < 0)
+        continue;
+      // Add up the weight (convert to double before adding, to preserve
+      // precision)
+      Y[bins[i]] += block[i].weight();
+      E[bins[i]] += block[i].errorSquared(); // square of error
+    }
+  }
+
+  // Now do the sqrt of all errors
+  std::transform(E.begin(), E.end(), E.begin(),
+                 static_cast<double (*)(double)>(sqrt));
+}
+
+// --------------------------------------------------------------------------
+/** Adds events at the end of a list to Y and E (error) histograms generated
+ * from the events before them. The events do not need to be sorted.
+ *
+ * @param events: vector of events (with or without weights)
+ * @param first: index of the first event to add
+ * @param binFinder: finds the bin index for the X-bins of the histograms
+ * @param Y: counts to add to
+ * @param E: errors to add to
+ */
+template <class T>
+void EventList::addEventsToHistogramHelper(
+    const std::vector<T> &events, const size_t first,
+    const Kernel::BinEdgeFinder &binFinder, MantidVec &Y, MantidVec &E) {
+  // Note: Errors will be squared until the last step.
+  std::transform(E.begin(), E.end(), E.begin(),
+                 [](const double error) { return error * error; });
+  for (auto event = events.cbegin() + first; event != events.cend();
+       ++event) {
+    const auto bin = binFinder.bin(event->tof());
+    if (bin < 0)
+      continue;
+    Y[bin] += event->weight();
+    E[bin] += event->errorSquared(); // square of error
+  }
+
+  // Now do the sqrt of all errors
+  std::transform(E.begin(), E.end(), E.begin(),
+                 static_cast<double (*)(double)>(sqrt));
+}
+
 // --------------------------------------------------------------------------
 /** Generates both the Y and E (error) histograms w.r.t Pulse Time
  * for an EventList with or without WeightedEvents.
@@ -2122,8 +2302,24 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
  */
 void EventList::generateHistogram(const MantidVec &X, MantidVec &Y,
                                   MantidVec &E, bool skipError) const {
-  // All types of weights need to be sorted by TOF
+  // Linear and logarithmic bins are filled without sorting the events
+  const Kernel::BinEdgeFinder binFinder(X);
+  if (binFinder.isRegular()) {
+    switch (eventType) {
+    case TOF:
+      histogramUnsortedHelper(this->events, binFinder, Y, E);
+      break;
+    case WEIGHTED:
+      histogramUnsortedHelper(this->weightedEvents, binFinder, Y, E);
+      break;
+    case WEIGHTED_NOTIME:
+      histogramUnsortedHelper(this->weightedEventsNoTime, binFinder, Y, E);
+      break;
+    }
+    return;
+  }
 
+  // All types of weights need to be sorted by TOF
   this->sortTof();
 
   switch (eventType) {
@@ -2554,7 +2750,7 @@ void EventList::convertTof(std::function<double(double)> func,
 
   // do nothing if sorting > 0
   if (sorting == 0) {
-    this->setSortOrder(UNSORTED);
+    this->keepPulseTimeSortOrder();
   } else if ((sorting < 0) && (this->getSortType() == TOF_SORT)) {
     this->reverse();
   }
@@ -2602,6 +2798,8 @@ void EventList::convertTof(const double factor, const double offset) {
 
   if ((factor < 0.) && (this->getSortType() == TOF_SORT))
     this->reverse();
+  else if ((factor < 0.) && (this->getSortType() == PULSETIMETOF_SORT))
+    this->keepPulseTimeSortOrder();
 
   if (this->getNumberEvents() <= 0)
     return;
@@ -3059,7 +3257,7 @@ DateAndTime EventList::getPulseTimeMin() const {
     return tMin;
 
   // when events are ordered by pulse time just need the first value
-  if (this->order == PULSETIME_SORT) {
+  if (this->isSortedByPulseTime()) {
     switch (eventType) {
     case TOF:
       return this->events.begin()->pulseTime();
@@ -3103,7 +3301,7 @@ DateAndTime EventList::getPulseTimeMax() const {
     return tMax;
 
   // when events are ordered by pulse time just need the first value
-  if (this->order == PULSETIME_SORT) {
+  if (this->isSortedByPulseTime()) {
     switch (eventType) {
     case TOF:
       return this->events.rbegin()->pulseTime();
@@ -3147,7 +3345,7 @@ void EventList::getPulseTimeMinMax(
     return;
 
   // when events are ordered by pulse time just need the first/last values
-  if (this->order == PULSETIME_SORT) {
+  if (this->isSortedByPulseTime()) {
     switch (eventType) {
     case TOF:
       tMin = this->events.begin()->pulseTime();
@@ -3307,7 +3505,7 @@ void EventList::setTofsHelper(std::vector<T> &events,
  * @param tofs :: The vector of doubles to set the tofs to.
  */
 void EventList::setTofs(const MantidVec &tofs) {
-  this->order = UNSORTED;
+  this->keepPulseTimeSortOrder();
 
   // Convert the list
   switch (eventType) {
@@ -3736,8 +3934,7 @@ void EventList::divide(const double value, const double error) {
 // ----------- SPLITTING AND FILTERING ---------------------------------------
 // ==============================================================================================
 /** Filter a vector of events into another based on pulse time.
- * TODO: Make this more efficient using STL-fu.
- * @param events :: input events
+ * @param events :: input events, sorted by pulse time
  * @param start :: start time (absolute)
  * @param stop :: end time (absolute)
  * @param output :: reference to an event list that will be output.
@@ -3746,17 +3943,11 @@ template <class T>
 void EventList::filterByPulseTimeHelper(std::vector<T> &events,
                                         DateAndTime start, DateAndTime stop,
                                         std::vector<T> &output) {
-  auto itev = events.begin();
-  auto itev_end = events.end();
-  // Find the first event with m_pulsetime >= start
-  while ((itev != itev_end) && (itev->m_pulsetime < start))
-    itev++;
-
-  while ((itev != itev_end) && (itev->m_pulsetime < stop)) {
-    // Add the copy to the output
-    output.push_back(*itev);
-    ++itev;
-  }
+  // Find the first event with m_pulsetime >= start, then the first one with
+  // m_pulsetime >= stop
+  auto itev = findPulseTime(events.begin(), events.end(), start);
+  auto itev_end = findPulseTime(itev, events.end(), stop);
+  output.insert(output.end(), itev, itev_end);
 }
 
 /** Filter a vector of events into another based on time at sample.
@@ -3901,31 +4092,20 @@ void EventList::filterInPlaceHelper(Kernel::TimeSplitterType &splitter,
     const int index = itspl->index();
 
     // Skip the events before the start of the time
-    while ((itev != itev_end) && (itev->m_pulsetime < start))
-      itev++;
+    itev = findPulseTime(itev, itev_end, start);
+    // The events that are in the interval (if any)
+    auto itevStop = findPulseTime(itev, itev_end, stop);
 
     // Are we aligned in the input vs output?
     bool copyingInPlace = (itOut == itev);
     if (copyingInPlace) {
-      while ((itev != itev_end) && (itev->m_pulsetime < stop))
-        ++itev;
       // Make sure the iterators still match
-      itOut = itev;
-    } else {
-      // Go through all the events that are in the interval (if any)
-      while ((itev != itev_end) && (itev->m_pulsetime < stop)) {
-        if (index >= 0) {
-          // Copy the input Event to the output iterator position.
-          // Strictly speaking, this is not necessary if itOut == itev; but the
-          // extra check would likely
-          //  slow down the filtering in the 99% of cases where itOut != itev.
-          *itOut = *itev;
-          // And go up a spot in the output iterator.
-          ++itOut;
-        }
-        ++itev;
-      }
+      itOut = itevStop;
+    } else if (index >= 0) {
+      // Copy the input Events to the output iterator position.
+      itOut = std::copy(itev, itevStop, itOut);
     }
+    itev = itevStop;
 
     // Go to the next interval
     ++itspl;
@@ -4004,20 +4184,13 @@ void EventList::splitByTimeHelper(Kernel::TimeSplitterType &splitter,
     const size_t index = itspl->index();
 
     // Skip the events before the start of the time
-    while ((itev != itev_end) && (itev->m_pulsetime < start))
-      itev++;
-
-    // Go through all the events that are in the interval (if any)
-    while ((itev != itev_end) && (itev->m_pulsetime < stop)) {
-      // Copy the event into another
-      const T eventCopy(*itev);
-      if (index < numOutputs) {
-        EventList *myOutput = outputs[index];
-        // Add the copy to the output
-        myOutput->addEventQuickly(eventCopy);
-      }
-      ++itev;
-    }
+    itev = findPulseTime(itev, itev_end, start);
+
+    // Copy all the events that are in the interval (if any)
+    auto itevStop = findPulseTime(itev, itev_end, stop);
+    if (index < numOutputs)
+      appendEvents(*outputs[index], itev, itevStop);
+    itev = itevStop;
 
     // Go to the next interval
     ++itspl;
@@ -4073,6 +4246,9 @@ void EventList::splitByTime(Kernel::TimeSplitterType &splitter,
   case WEIGHTED_NOTIME:
     break;
   }
+  // The events were copied in order, so the outputs are sorted like this list
+  for (auto output : outputs)
+    output->setSortOrder(this->order);
 }
 
 //------------------------------------------------------------------------------------------------
@@ -4491,47 +4667,27 @@ void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
   auto itspl_end = splitter.end();
   Types::Core::DateAndTime start, stop;
 
-  // Prepare to Events Iterate through all events (sorted by tof)
+  // Prepare to Events Iterate through all events (sorted by pulse time)
   auto itev = events.begin();
   auto itev_end = events.end();
 
   // Iterate (loop) on all splitters
   while (itspl != itspl_end) {
     // Get the splitting interval times and destination group
-    start = itspl->start().totalNanoseconds();
-    stop = itspl->stop().totalNanoseconds();
+    start = itspl->start();
+    stop = itspl->stop();
     const int index = itspl->index();
 
-    // Skip the events before the start of the time and put to 'unfiltered'
-    // EventList
-    EventList *myOutput = outputs[-1];
-    while (itev != itev_end) {
-      if (itev->m_pulsetime < start) {
-        // Record to index = -1 space
-        const T eventCopy(*itev);
-        myOutput->addEventQuickly(eventCopy);
-        ++itev;
-      } else {
-        // Event within a splitter interval
-        break;
-      }
-    }
-
-    // Go through all the events that are in the interval (if any)
-    while (itev != itev_end) {
+    // Put the events before the start of the time to 'unfiltered' EventList
+    auto itevStart = findPulseTime(itev, itev_end, start);
+    if (itevStart != itev)
+      appendEvents(*outputs[-1], itev, itevStart);
 
-      if (itev->m_pulsetime < stop) {
-        // Duplicate event
-        const T eventCopy(*itev);
-        EventList *myOutput = outputs[index];
-        // Add the copy to the output
-        myOutput->addEventQuickly(eventCopy);
-        ++itev;
-      } else {
-        // Out of interval
-        break;
-      }
-    }
+    // Copy all the events that are in the interval (if any)
+    auto itevStop = findPulseTime(itevStart, itev_end, stop);
+    if (itevStop != itevStart)
+      appendEvents(*outputs[index], itevStart, itevStop);
+    itev = itevStop;
 
     // Go to the next interval
     ++itspl;
@@ -4556,7 +4712,7 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
                              "that no longer has time information.");
 
   // Start by sorting the event list by pulse time.
-  this->sortPulseTimeTOF();
+  this->sortPulseTime();
 
   // Initialize all the output event lists
   std::map<int, EventList *>::iterator outiter;
@@ -4585,6 +4741,10 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
     case WEIGHTED_NOTIME:
       break;
     }
+    // The events were copied in order, so the outputs are sorted like this
+    for (auto &output : outputs)
+      if (output.second)
+        output.second->setSortOrder(this->order);
   }
 }
 
@@ -4601,7 +4761,7 @@ void EventList::splitByPulseTimeWithMatrix(
                              "that no longer has time information.");
 
   // Start by sorting the event list by pulse time.
-  this->sortPulseTimeTOF();
+  this->sortPulseTime();
 
   // Initialize all the output event lists
   std::map<int, EventList *>::iterator outiter;
@@ -4632,6 +4792,10 @@ void EventList::splitByPulseTimeWithMatrix(
     case WEIGHTED_NOTIME:
       break;
     }
+    // The events were copied in order, so the outputs are sorted like this
+    for (auto &output : outputs)
+      if (output.second)
+        output.second->setSortOrder(this->order);
   }
 }
 
@@ -4652,40 +4816,20 @@ void EventList::splitByPulseTimeWithMatrixHelper(
   // Iterate (loop) on all splitters
   for (size_t i_target = 0; i_target < vec_split_target.size(); ++i_target) {
     // Get the splitting interval times and destination group
-    int64_t start = vec_split_times[i_target];
-    int64_t stop = vec_split_times[i_target + 1];
+    const DateAndTime start(vec_split_times[i_target]);
+    const DateAndTime stop(vec_split_times[i_target + 1]);
     const int index = vec_split_target[i_target];
 
-    // Skip the events before the start of the time and put to 'unfiltered'
-    // EventList
-    EventList *myOutput = outputs[-1];
-    while (itev != itev_end) {
-      if (itev->m_pulsetime < start) {
-        // Record to index = -1 space
-        const T eventCopy(*itev);
-        myOutput->addEventQuickly(eventCopy);
-        ++itev;
-      } else {
-        // Event within a splitter interval
-        break;
-      }
-    }
+    // Put the events before the start of the time to 'unfiltered' EventList
+    auto itevStart = findPulseTime(itev, itev_end, start);
+    if (itevStart != itev)
+      appendEvents(*outputs[-1], itev, itevStart);
 
-    // Go through all the events that are in the interval (if any)
-    while (itev != itev_end) {
-
-      if (itev->m_pulsetime < stop) {
-        // Duplicate event
-        const T eventCopy(*itev);
-        EventList *myOutput = outputs[index];
-        // Add the copy to the output
-        myOutput->addEventQuickly(eventCopy);
-        ++itev;
-      } else {
-        // Out of interval
-        break;
-      }
-    }
+    // Copy all the events that are in the interval (if any)
+    auto itevStop = findPulseTime(itevStart, itev_end, stop);
+    if (itevStop != itevStart)
+      appendEvents(*outputs[index], itevStart, itevStop);
+    itev = itevStop;
 
     // No need to keep looping through the filter if we are out of events
     if (itev == itev_end)
@@ -4693,6 +4837,126 @@ void EventList::splitByPulseTimeWithMatrixHelper(
   } // END-WHILE Splitter
 }
 
+//----------------------------------------------------------------------------------------------
+/** Split the event list into any number of outputs in a single pass over the
+ * events. The events do not need to be sorted: the interval of each event is
+ * found from the one of the event before, as the events are mostly in time
+ * order, or else by binary search. The events of each output are counted
+ * before any is copied, so each output is allocated only once.
+ *
+ * @param splitTimes :: the boundaries of the intervals, as absolute times in
+ * nanoseconds, sorted
+ * @param splitTargets :: the index in outputs of the output of each interval,
+ * one fewer than the boundaries. The events of an interval with a negative
+ * index, or with the index of a null output, are discarded, as are the events
+ * outside of all the intervals.
+ * @param outputs :: the event lists the events are split into. They are
+ * cleared first.
+ * @param pulseTimeOnly :: if true, split by the pulse times of the events,
+ * otherwise by their full times, i.e. pulse time plus time-of-flight
+ * @param toffactor :: factor multiplied to TOF for correcting event time from
+ * detector to sample
+ * @param tofshift :: shift in SECOND to TOF for correcting event time from
+ * detector to sample
+ */
+void EventList::splitByTimeIntoTargets(const std::vector<int64_t> &splitTimes,
+                                       const std::vector<int> &splitTargets,
+                                       const std::vector<EventList *> &outputs,
+                                       const bool pulseTimeOnly,
+                                       const double toffactor,
+                                       const double tofshift) const {
+  // Check for supported event type
+  if (eventType == WEIGHTED_NOTIME)
+    throw std::runtime_error("EventList::splitByTime() called on an EventList "
+                             "that no longer has time information.");
+  if (!splitTargets.empty() && splitTimes.size() != splitTargets.size() + 1)
+    throw std::invalid_argument("Splitter time vector size and splitter target "
+                                "vector size are not correct.");
+
+  // Initialize all the output event lists
+  for (auto output : outputs) {
+    if (!output)
+      continue;
+    output->clear();
+    output->setDetectorIDs(this->getDetectorIDs());
+    output->setHistogram(m_histogram);
+    // Match the output event type.
+    output->switchTo(eventType);
+  }
+
+  switch (eventType) {
+  case TOF:
+    splitByTimeIntoTargetsHelper(splitTimes, splitTargets, outputs,
+                                 this->events, pulseTimeOnly, toffactor,
+                                 tofshift);
+    break;
+  case WEIGHTED:
+    splitByTimeIntoTargetsHelper(splitTimes, splitTargets, outputs,
+                                 this->weightedEvents, pulseTimeOnly,
+                                 toffactor, tofshift);
+    break;
+  case WEIGHTED_NOTIME:
+    break;
+  }
+  // The events were copied in order, so the outputs are sorted like this
+  for (auto output : outputs)
+    if (output)
+      output->setSortOrder(this->order);
+}
+
+template <class T>
+void EventList::splitByTimeIntoTargetsHelper(
+    const std::vector<int64_t> &splitTimes,
+    const std::vector<int> &splitTargets,
+    const std::vector<EventList *> &outputs, const std::vector<T> &events,
+    const bool pulseTimeOnly, const double toffactor,
+    const double tofshift) const {
+  if (events.empty() || splitTargets.empty())
+    return;
+
+  // Find the output of each event, and count the events of each output
+  const auto numOutputs = static_cast<int>(outputs.size());
+  std::vector<int> eventTargets(events.size(), -1);
+  std::vector<size_t> counts(outputs.size(), 0);
+  const int64_t firstTime = splitTimes.front();
+  const int64_t lastTime = splitTimes.back();
+  size_t interval = 0;
+  for (size_t i = 0; i < events.size(); ++i) {
+    const T &event = events[i];
+    const int64_t time =
+        pulseTimeOnly ? event.m_pulsetime.totalNanoseconds()
+                      : calculateCorrectedFullTime(event, toffactor, tofshift);
+    if (time < firstTime || time >= lastTime)
+      continue;
+    if (time < splitTimes[interval] || time >= splitTimes[interval + 1]) {
+      if (time >= splitTimes[interval + 1] && time < splitTimes[interval + 2])
+        ++interval;
+      else
+        interval = std::upper_bound(splitTimes.cbegin(), splitTimes.cend(),
+                                    time) -
+                   splitTimes.cbegin() - 1;
+    }
+    const int target = splitTargets[interval];
+    if (target >= 0 && target < numOutputs && outputs[target]) {
+      eventTargets[i] = target;
+      ++counts[target];
+    }
+  }
+
+  // Allocate the outputs and copy the events
+  std::vector<std::vector<T> *> outputEvents(outputs.size(), nullptr);
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    if (counts[i] > 0) {
+      getEventsFrom(*outputs[i], outputEvents[i]);
+      outputEvents[i]->reserve(counts[i]);
+    }
+  }
+  for (size_t i = 0; i < events.size(); ++i) {
+    if (eventTargets[i] >= 0)
+      outputEvents[eventTargets[i]]->push_back(events[i]);
+  }
+}
+
 //--------------------------------------------------------------------------
 /** Get the vector of events contained in an EventList;
  * this is overloaded by event type.
@@ -4750,6 +5014,10 @@ void getEventsFrom(const EventList &el,
 /** Helper function for the conversion to TOF. This handles the different
  *  event types.
  *
+ *  The x values are gathered in batches into a contiguous buffer, converted
+ *  with Unit::toTOFBatch() and Unit::fromTOFBatch() and scattered back, so
+ *  there are two virtual calls per batch rather than per event.
+ *
  * @param events the list of events
  * @param fromUnit the unit to convert from
  * @param toUnit the unit to convert to
@@ -4758,13 +5026,19 @@ template <class T>
 void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events,
                                          Mantid::Kernel::Unit *fromUnit,
                                          Mantid::Kernel::Unit *toUnit) {
-  auto itev = events.begin();
-  auto itev_end = events.end();
-  for (; itev != itev_end; itev++) {
-    // Conver to TOF
-    double tof = fromUnit->singleToTOF(itev->m_tof);
-    // And back from TOF to whatever
-    itev->m_tof = toUnit->singleFromTOF(tof);
+  // Small enough for the buffer to stay in the L1 cache
+  constexpr size_t batchSize = 1024;
+  std::array<double, batchSize> buffer;
+  for (size_t start = 0; start < events.size(); start += batchSize) {
+    const size_t count = std::min(batchSize, events.size() - start);
+    double *const last = buffer.data() + count;
+    for (size_t i = 0; i < count; ++i)
+      buffer[i] = events[start + i].m_tof;
+    // Convert to TOF and back from TOF to whatever
+    fromUnit->toTOFBatch(buffer.data(), last);
+    toUnit->fromTOFBatch(buffer.data(), last);
+    for (size_t i = 0; i < count; ++i)
+      events[start + i].m_tof = buffer[i];
   }
 }
 
@@ -1,10 +1,145 @@
 #include "MantidDataObjects/EventWorkspaceMRU.h"
+#include "MantidDataObjects/EventList.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/System.h"
 
+#include <algorithm>
+#include <atomic>
+
 namespace Mantid {
 namespace DataObjects {
+namespace {
+/// Memory limit of the histogram caches in MB if it is not configured
+constexpr double DEFAULT_MEMORY_LIMIT = 256.;
+
+/// @return the memory limit of the histogram caches from the ConfigService
+size_t configuredMemoryLimit() {
+  double limit(DEFAULT_MEMORY_LIMIT);
+  if (!Kernel::ConfigService::Instance().getValue(
+          "eventworkspace.histogramcache.memory", limit) ||
+      limit < 0.)
+    limit = DEFAULT_MEMORY_LIMIT;
+  return static_cast<size_t>(limit * 1024. * 1024.);
+}
+} // namespace
+
+/// Memory used by histogram caches in bytes, up to a limit, and the caches
+/// sharing it
+class EventWorkspaceMRU::MemoryBudget {
+public:
+  explicit MemoryBudget(const size_t limit)
+      : m_limit(limit), m_used(0), m_clock(0) {}
+
+  /** Reserve memory if it fits within the limit
+   * @param bytes :: the memory to reserve
+   * @return true if the memory was reserved */
+  bool reserve(const size_t bytes) {
+    const size_t limit = m_limit;
+    size_t used = m_used.load();
+    do {
+      if (bytes > limit || used > limit - bytes)
+        return false;
+    } while (!m_used.compare_exchange_weak(used, used + bytes));
+    return true;
+  }
+  /// Give back reserved memory
+  void release(const size_t bytes) { m_used -= bytes; }
+  /// @return the memory limit in bytes
+  size_t limit() const { return m_limit; }
+  /// Set the memory limit in bytes. Caches over it shrink on their next
+  /// insertion.
+  void setLimit(const size_t limit) { m_limit = limit; }
+  /// @return the reserved memory in bytes
+  size_t used() const { return m_used; }
+  /// @return a time stamp for a histogram being used, later than all the
+  /// previous ones
+  size_t tick() { return ++m_clock; }
+
+  /// Register a cache sharing the memory
+  void add(const EventWorkspaceMRU *cache) {
+    std::lock_guard<std::mutex> lock(m_cachesMutex);
+    m_caches.push_back(cache);
+  }
+  /// Unregister a cache before it is destroyed
+  void remove(const EventWorkspaceMRU *cache) {
+    std::lock_guard<std::mutex> lock(m_cachesMutex);
+    m_caches.erase(std::remove(m_caches.begin(), m_caches.end(), cache),
+                   m_caches.end());
+  }
+
+  bool evictLeastRecentlyUsed(Shard &held);
+
+private:
+  std::atomic<size_t> m_limit;
+  std::atomic<size_t> m_used;
+  std::atomic<size_t> m_clock;
+  /// The caches sharing the memory
+  std::vector<const EventWorkspaceMRU *> m_caches;
+  std::mutex m_cachesMutex;
+};
+
+/** Drop the least recently used histogram of all the caches sharing the
+ * memory, so that an idle workspace does not keep memory that others need.
+ * Shards locked by other threads are skipped rather than waited for, since
+ * those threads may be waiting for the shard held by the caller.
+ *
+ * @param held :: the shard whose lock the caller holds
+ * @return true if a histogram was dropped
+ */
+bool EventWorkspaceMRU::MemoryBudget::evictLeastRecentlyUsed(Shard &held) {
+  std::lock_guard<std::mutex> lock(m_cachesMutex);
+  const EventWorkspaceMRU *oldestCache(nullptr);
+  Shard *oldestShard(nullptr);
+  std::unique_lock<std::mutex> oldestLock;
+  size_t oldest(0);
+  for (const auto cache : m_caches) {
+    for (auto &shard : cache->m_shards) {
+      std::unique_lock<std::mutex> shardLock;
+      if (&shard != &held) {
+        shardLock = std::unique_lock<std::mutex>(shard.mutex, std::try_to_lock);
+        if (!shardLock.owns_lock())
+          continue;
+      }
+      if (shard.order.empty())
+        continue;
+      // The least recently used histogram of a shard is at the back
+      const size_t lastUsed =
+          shard.histograms.find(shard.order.back())->second.lastUsed;
+      if (oldestShard && lastUsed >= oldest)
+        continue;
+      oldest = lastUsed;
+      oldestCache = cache;
+      oldestShard = &shard;
+      oldestLock = std::move(shardLock);
+    }
+  }
+  if (!oldestShard)
+    return false;
+  oldestCache->erase(*oldestShard, oldestShard->order.back());
+  return true;
+}
+
+constexpr size_t EventWorkspaceMRU::NUM_SHARDS;
+
+/// Constructor of a histogram cache sharing the memory limit set in the
+/// ConfigService with the caches of all the other workspaces
+EventWorkspaceMRU::EventWorkspaceMRU() : m_budget(processMemoryBudget()) {
+  m_budget->add(this);
+}
+
+/** Constructor of a histogram cache with its own memory limit
+ * @param memoryLimit :: memory limit of the histogram cache in bytes. 0
+ * disables the cache.
+ */
+EventWorkspaceMRU::EventWorkspaceMRU(const size_t memoryLimit)
+    : m_budget(std::make_shared<MemoryBudget>(memoryLimit)) {
+  m_budget->add(this);
+}
 
 EventWorkspaceMRU::~EventWorkspaceMRU() {
+  m_budget->remove(this);
+  for (auto &shard : m_shards)
+    m_budget->release(shard.memory);
   // Make sure you free up the memory in the MRUs
   {
     Poco::ScopedWriteRWLock _lock(m_changeMruListsMutexY);
@@ -58,6 +193,13 @@ void EventWorkspaceMRU::ensureEnoughBuffersY(size_t thread_num) const {
 //---------------------------------------------------------------------------
 /// Clear all the data in the MRU buffers
 void EventWorkspaceMRU::clear() {
+  for (auto &shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.histograms.clear();
+    shard.order.clear();
+    m_budget->release(shard.memory);
+    shard.memory = 0;
+  }
   {
     // Make sure you free up the memory in the MRUs
     Poco::ScopedWriteRWLock _lock(m_changeMruListsMutexY);
@@ -118,10 +260,17 @@ EventWorkspaceMRU::findE(size_t thread_num, const EventList *index) {
 void EventWorkspaceMRU::insertY(size_t thread_num, YType data,
                                 const EventList *index) {
   Poco::ScopedReadRWLock _lock(m_changeMruListsMutexY);
-  auto yWithMarker =
-      new TypeWithMarker<YType>(reinterpret_cast<const std::uintptr_t>(index));
+  auto &list = *m_bufferedDataY[thread_num];
+  const auto key = reinterpret_cast<const std::uintptr_t>(index);
+  if (auto existing = list.find(key)) {
+    // Replace the data and move it to the top
+    existing->m_data = std::move(data);
+    list.insert(existing);
+    return;
+  }
+  auto yWithMarker = new TypeWithMarker<YType>(key);
   yWithMarker->m_data = std::move(data);
-  auto oldData = m_bufferedDataY[thread_num]->insert(yWithMarker);
+  auto oldData = list.insert(yWithMarker);
   // And clear up the memory of the old one, if it is dropping out.
   delete oldData;
 }
@@ -135,10 +284,17 @@ void EventWorkspaceMRU::insertY(size_t thread_num, YType data,
 void EventWorkspaceMRU::insertE(size_t thread_num, EType data,
                                 const EventList *index) {
   Poco::ScopedReadRWLock _lock(m_changeMruListsMutexE);
-  auto eWithMarker =
-      new TypeWithMarker<EType>(reinterpret_cast<const std::uintptr_t>(index));
+  auto &list = *m_bufferedDataE[thread_num];
+  const auto key = reinterpret_cast<const std::uintptr_t>(index);
+  if (auto existing = list.find(key)) {
+    // Replace the data and move it to the top
+    existing->m_data = std::move(data);
+    list.insert(existing);
+    return;
+  }
+  auto eWithMarker = new TypeWithMarker<EType>(key);
   eWithMarker->m_data = std::move(data);
-  auto oldData = m_bufferedDataE[thread_num]->insert(eWithMarker);
+  auto oldData = list.insert(eWithMarker);
   // And clear up the memory of the old one, if it is dropping out.
   delete oldData;
 }
@@ -148,6 +304,11 @@ void EventWorkspaceMRU::insertE(size_t thread_num, EType data,
  * @param index :: index to delete.
  */
 void EventWorkspaceMRU::deleteIndex(const EventList *index) {
+  {
+    auto &indexShard = shard(index);
+    std::lock_guard<std::mutex> lock(indexShard.mutex);
+    erase(indexShard, index);
+  }
   {
     Poco::ScopedReadRWLock _lock1(m_changeMruListsMutexE);
     for (auto &data : m_bufferedDataE) {
@@ -172,5 +333,144 @@ size_t EventWorkspaceMRU::MRUSize() const {
   }
 }
 
+//---------------------------------------------------------------------------
+/** Find the cached histogram of an event list
+ *
+ * @param index :: the event list
+ * @return a copy of the histogram; its y and e are null if not found
+ */
+EventWorkspaceMRU::Histogram
+EventWorkspaceMRU::findHistogram(const EventList *index) const {
+  auto &indexShard = shard(index);
+  std::lock_guard<std::mutex> lock(indexShard.mutex);
+  auto cached = indexShard.histograms.find(index);
+  if (cached == indexShard.histograms.end())
+    return Histogram();
+  // Move it to the front of the least-recently-used order
+  cached->second.lastUsed = m_budget->tick();
+  indexShard.order.splice(indexShard.order.begin(), indexShard.order,
+                          cached->second.position);
+  return cached->second.histogram;
+}
+
+/** Insert or replace the cached histogram of an event list. The least
+ * recently used histograms of all the caches sharing the memory limit are
+ * dropped to stay within it. If that is not enough, because the other
+ * histograms are in shards being used by other threads, the histogram is not
+ * cached.
+ *
+ * @param index :: the event list
+ * @param histogram :: its histogram
+ */
+void EventWorkspaceMRU::insertHistogram(const EventList *index,
+                                        Histogram histogram) {
+  const size_t memory =
+      (histogram.y->size() + histogram.e->size()) * sizeof(double);
+  auto &indexShard = shard(index);
+  std::lock_guard<std::mutex> lock(indexShard.mutex);
+  erase(indexShard, index);
+  if (memory > m_budget->limit())
+    return;
+
+  while (!m_budget->reserve(memory)) {
+    if (!m_budget->evictLeastRecentlyUsed(indexShard))
+      return;
+  }
+  indexShard.order.push_front(index);
+  CachedHistogram cached{std::move(histogram), memory, m_budget->tick(),
+                         indexShard.order.begin()};
+  indexShard.histograms.emplace(index, std::move(cached));
+  indexShard.memory += memory;
+}
+
+/** Drop the cached histogram of an event list whose events were reordered,
+ * unless it already includes all the events. The events appended since it
+ * was generated are no longer at the end of the list.
+ *
+ * @param index :: the event list
+ * @param numEvents :: the number of events in the list
+ */
+void EventWorkspaceMRU::eventsReordered(const EventList *index,
+                                        const size_t numEvents) {
+  auto &indexShard = shard(index);
+  std::lock_guard<std::mutex> lock(indexShard.mutex);
+  auto cached = indexShard.histograms.find(index);
+  if (cached != indexShard.histograms.end() &&
+      cached->second.histogram.numEvents != numEvents)
+    erase(indexShard, index);
+}
+
+/// @return the number of histograms in the cache
+size_t EventWorkspaceMRU::histogramCacheSize() const {
+  size_t size(0);
+  for (const auto &shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    size += shard.histograms.size();
+  }
+  return size;
+}
+
+/// @return the memory used by the histograms in the cache in bytes
+size_t EventWorkspaceMRU::histogramCacheMemory() const {
+  size_t memory(0);
+  for (const auto &shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    memory += shard.memory;
+  }
+  return memory;
+}
+
+/// @return the memory used by the histogram caches of all the workspaces
+/// sharing the memory limit set in the ConfigService, in bytes
+size_t EventWorkspaceMRU::processHistogramCacheMemory() {
+  return processMemoryBudget()->used();
+}
+
+/// @return the memory limit shared by the histogram caches of the process,
+/// in bytes
+size_t EventWorkspaceMRU::processHistogramCacheMemoryLimit() {
+  return processMemoryBudget()->limit();
+}
+
+/** Change the memory limit shared by the histogram caches of the process.
+ * The caches over the new limit shrink when histograms are next inserted.
+ * @param memoryLimit :: the new limit in bytes
+ */
+void EventWorkspaceMRU::setProcessHistogramCacheMemoryLimit(
+    const size_t memoryLimit) {
+  processMemoryBudget()->setLimit(memoryLimit);
+}
+
+/// @return the memory budget shared by the histogram caches of the process
+std::shared_ptr<EventWorkspaceMRU::MemoryBudget>
+EventWorkspaceMRU::processMemoryBudget() {
+  static auto budget = std::make_shared<MemoryBudget>(configuredMemoryLimit());
+  return budget;
+}
+
+/// @return the shard of the histogram cache holding an event list
+EventWorkspaceMRU::Shard &
+EventWorkspaceMRU::shard(const EventList *index) const {
+  // Event lists are allocated one after the other, so their addresses
+  // divided by their size spread them over the shards
+  const auto address = reinterpret_cast<const std::uintptr_t>(index);
+  return m_shards[(address / sizeof(EventList)) % NUM_SHARDS];
+}
+
+/** Remove the histogram of an event list from a shard, whose lock must be
+ * held
+ * @param shard :: the shard holding the event list
+ * @param index :: the event list
+ */
+void EventWorkspaceMRU::erase(Shard &shard, const EventList *index) const {
+  auto cached = shard.histograms.find(index);
+  if (cached == shard.histograms.end())
+    return;
+  shard.memory -= cached->second.memory;
+  m_budget->release(cached->second.memory);
+  shard.order.erase(cached->second.position);
+  shard.histograms.erase(cached);
+}
+
 } // namespace Mantid
 } // namespace DataObjects
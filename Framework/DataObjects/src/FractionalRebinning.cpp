@@ -4,10 +4,15 @@
 #include "MantidGeometry/Math/ConvexPolygon.h"
 #include "MantidGeometry/Math/Quadrilateral.h"
 #include "MantidGeometry/Math/PolygonIntersection.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/Memory.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/V2D.h"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <ostream>
 
 namespace Mantid {
 
@@ -503,22 +508,19 @@ void normaliseOutput(MatrixWorkspace_sptr outputWS,
   outputWS->setDistribution(inputWS->isDistribution());
 }
 
+namespace {
 /**
- * Rebin the input quadrilateral to the output grid.
- * The quadrilateral must have a CLOCKWISE winding.
- * @param inputQ The input polygon (Polygon winding must be Clockwise)
- * @param inputWS The input workspace containing the input intensity values
- * @param i The index in the vertical axis direction that inputQ references
- * @param j The index in the horizontal axis direction that inputQ references
- * @param outputWS A pointer to the output workspace that accumulates the data
- * @param verticalAxis A vector containing the output vertical axis bin
- * boundaries
+ * Rebin the input quadrilateral to the output grid, passing the signal and
+ * variance of each overlap to addToBin(yi, xi, signal, variance, fraction).
+ * See rebinToOutput() for the parameters.
  */
-void rebinToOutput(const Quadrilateral &inputQ,
-                   const MatrixWorkspace_const_sptr &inputWS, const size_t i,
-                   const size_t j, MatrixWorkspace &outputWS,
-                   const std::vector<double> &verticalAxis) {
-  const auto &X = outputWS.x(0).rawData();
+template <typename AddToBin>
+void rebinToOutputImpl(const Quadrilateral &inputQ,
+                       const MatrixWorkspace_const_sptr &inputWS,
+                       const size_t i, const size_t j,
+                       const std::vector<double> &X,
+                       const std::vector<double> &verticalAxis,
+                       AddToBin addToBin) {
   size_t qstart(0), qend(verticalAxis.size() - 1), x_start(0),
       x_end(X.size() - 1);
   if (!getIntersectionRegion(X, verticalAxis, inputQ, qstart, qend, x_start,
@@ -556,38 +558,26 @@ void rebinToOutput(const Quadrilateral &inputQ,
           eValue *= overlapWidth;
         }
         eValue = eValue * eValue * weight;
-        PARALLEL_CRITICAL(overlap_sum) {
-          outputWS.mutableY(y)[xi] += yValue;
-          outputWS.mutableE(y)[xi] += eValue;
-        }
+        addToBin(y, xi, yValue, eValue, weight);
       }
     }
   }
 }
 
 /**
- * Rebin the input quadrilateral to the output grid
- * The quadrilateral must have a CLOCKWISE winding.
- * @param inputQ The input polygon (Polygon winding must be clockwise)
- * @param inputWS The input workspace containing the input intensity values
- * @param i The indexiin the vertical axis direction that inputQ references
- * @param j The index in the horizontal axis direction that inputQ references
- * @param outputWS A pointer to the output workspace that accumulates the data
- *        Note that the error array of the output workspace contains the
- *        **variance** and not the errors (standard deviations).
- * @param verticalAxis A vector containing the output vertical axis bin
- * boundaries
- * @param inputRB A pointer, of RebinnedOutput type, to the input workspace.
- * It is used to take into account the input area fractions when calcuting
- * the final output fractions.
- * This can be null to indicate that the input was a standard 2D workspace.
+ * Rebin the input quadrilateral to the output grid, passing the signal,
+ * variance and fractional area of each overlap to
+ * addToBin(yi, xi, signal, variance, fraction).
+ * See rebinToFractionalOutput() for the parameters.
  */
-void rebinToFractionalOutput(const Quadrilateral &inputQ,
-                             const MatrixWorkspace_const_sptr &inputWS,
-                             const size_t i, const size_t j,
-                             RebinnedOutput &outputWS,
-                             const std::vector<double> &verticalAxis,
-                             const RebinnedOutput_const_sptr &inputRB) {
+template <typename AddToBin>
+void rebinToFractionalOutputImpl(const Quadrilateral &inputQ,
+                                 const MatrixWorkspace_const_sptr &inputWS,
+                                 const size_t i, const size_t j,
+                                 const std::vector<double> &X,
+                                 const std::vector<double> &verticalAxis,
+                                 const RebinnedOutput_const_sptr &inputRB,
+                                 AddToBin addToBin) {
   const auto &inX = inputWS->x(i);
   const auto &inY = inputWS->y(i);
   const auto &inE = inputWS->e(i);
@@ -595,7 +585,6 @@ void rebinToFractionalOutput(const Quadrilateral &inputQ,
   if (std::isnan(signal))
     return;
 
-  const auto &X = outputWS.x(0).rawData();
   size_t qstart(0), qend(verticalAxis.size() - 1), x_start(0),
       x_end(X.size() - 1);
   if (!getIntersectionRegion(X, verticalAxis, inputQ, qstart, qend, x_start,
@@ -651,14 +640,269 @@ void rebinToFractionalOutput(const Quadrilateral &inputQ,
     const size_t xi = std::get<0>(ai);
     const size_t yi = std::get<1>(ai);
     const double weight = std::get<2>(ai) / inputQArea;
-    PARALLEL_CRITICAL(overlap) {
-      outputWS.mutableY(yi)[xi] += signal * weight;
-      outputWS.mutableE(yi)[xi] += variance * weight;
-      outputWS.dataF(yi)[xi] += weight * inputWeight;
+    addToBin(yi, xi, signal * weight, variance * weight, weight * inputWeight);
+  }
+}
+} // namespace
+
+/**
+ * Create empty sums for the bins of the output workspace
+ * @param outputWS The output workspace the sums will be added to
+ */
+PartialOutput::PartialOutput(const MatrixWorkspace &outputWS)
+    : m_xAxis(outputWS.x(0).rawData()), m_blocksize(outputWS.blocksize()),
+      m_signal(outputWS.getNumberHistograms() * m_blocksize, 0.),
+      m_variance(m_signal.size(), 0.), m_fraction(m_signal.size(), 0.) {}
+
+/**
+ * Add the sums of the blocks of the input to the output workspace. The blocks
+ * are added in order for each bin, so the result only depends on how the
+ * input was split into blocks. The fractional areas are added only if the
+ * output is a RebinnedOutput workspace.
+ * @param partials The sums of each block of the input, default constructed
+ * for the blocks that had nothing to add
+ * @param outputWS The workspace the sums are added to
+ */
+void addPartialOutputs(const std::vector<PartialOutput> &partials,
+                       MatrixWorkspace &outputWS) {
+  auto outputRB = dynamic_cast<RebinnedOutput *>(&outputWS);
+  const auto nHistos = static_cast<int64_t>(outputWS.getNumberHistograms());
+  const size_t blocksize = outputWS.blocksize();
+  PARALLEL_FOR_IF(Kernel::threadSafe(outputWS))
+  for (int64_t yi = 0; yi < nHistos; ++yi) {
+    auto &outY = outputWS.mutableY(yi);
+    auto &outE = outputWS.mutableE(yi);
+    const size_t offset = static_cast<size_t>(yi) * blocksize;
+    for (const auto &partial : partials) {
+      if (partial.m_signal.empty())
+        continue;
+      for (size_t xi = 0; xi < outY.size(); ++xi) {
+        outY[xi] += partial.m_signal[offset + xi];
+        outE[xi] += partial.m_variance[offset + xi];
+      }
+      if (outputRB) {
+        auto &outF = outputRB->dataF(yi);
+        for (size_t xi = 0; xi < outF.size(); ++xi)
+          outF[xi] += partial.m_fraction[offset + xi];
+      }
     }
   }
 }
 
+namespace {
+/// Logger for the rebinning
+Logger g_log("FractionalRebinning");
+
+/**
+ * @param inputSize Number of items in the input
+ * @param parallel Whether the blocks may be rebinned in parallel
+ * @return the number of blocks: one per thread, but no more than the items of
+ * the input. It does not depend on anything else, so that the output is the
+ * same from run to run for a given number of threads.
+ */
+size_t blockCount(const size_t inputSize, const bool parallel) {
+  if (!parallel || inputSize < 2)
+    return 1;
+  const size_t nThreads = static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+  return std::max<size_t>(1, std::min(nThreads, inputSize));
+}
+
+/**
+ * Warn if the blocks will not fit in the available memory. The number of
+ * blocks is not reduced, since that would change the output.
+ * @param outputWS The workspace the blocks are rebinned to
+ * @param nBlocks The number of blocks
+ * @param withMapping Whether the blocks record a mapping to detectors
+ */
+void checkBlockMemory(const MatrixWorkspace &outputWS, const size_t nBlocks,
+                      const bool withMapping) {
+  if (nBlocks < 2)
+    return;
+  const size_t nHistos = outputWS.getNumberHistograms();
+  size_t blockMemory = 3 * sizeof(double) * nHistos * outputWS.blocksize();
+  if (withMapping)
+    blockMemory += sizeof(SpectrumDefinition) * nHistos;
+  const size_t required = nBlocks * blockMemory / 1024;
+  const size_t available = MemoryStats().availMem();
+  if (required > available)
+    g_log.warning() << "Rebinning with " << nBlocks << " threads needs "
+                    << required << " kB for the copies of the output but only "
+                    << available << " kB are available. Use fewer threads to "
+                                    "reduce the memory needed.\n";
+}
+} // namespace
+
+/**
+ * Split the input into one block per thread. A warning is logged if the
+ * copies of the output do not fit in the available memory.
+ * @param outputWS The workspace the blocks are rebinned to. It must outlive
+ * this object.
+ * @param inputSize Number of items (spectra or angles) in the input
+ * @param parallel Whether the blocks may be rebinned in parallel
+ * @param withMapping Whether the blocks record a mapping of the output
+ * spectra to detectors
+ */
+PartialOutputs::PartialOutputs(const MatrixWorkspace &outputWS,
+                               const size_t inputSize, const bool parallel,
+                               const bool withMapping)
+    : m_outputWS(outputWS), m_inputSize(inputSize),
+      m_withMapping(withMapping), m_partials(blockCount(inputSize, parallel)),
+      m_mappings(m_partials.size()) {
+  checkBlockMemory(outputWS, m_partials.size(), withMapping);
+}
+
+/**
+ * Allocate the sums, and the mapping if required, of a block. This is called
+ * by the thread that rebins the block, so that the allocation is not
+ * serialised.
+ * @param block The index of the block
+ * @return the sums of the block
+ */
+PartialOutput &PartialOutputs::initBlock(const int block) {
+  if (m_withMapping)
+    m_mappings[block].resize(m_outputWS.getNumberHistograms());
+  return m_partials[block] = PartialOutput(m_outputWS);
+}
+
+/**
+ * Add the sums of the blocks, in order, to the output workspace
+ * @param outputWS The workspace the sums are added to
+ */
+void PartialOutputs::addTo(MatrixWorkspace &outputWS) const {
+  addPartialOutputs(m_partials, outputWS);
+}
+
+/**
+ * Add the mappings of the blocks, in order, to the output mapping
+ * @param mapping The mapping of each output spectrum to detectors
+ */
+void PartialOutputs::addMappingsTo(
+    std::vector<SpectrumDefinition> &mapping) const {
+  for (const auto &blockMapping : m_mappings) {
+    for (size_t q = 0; q < blockMapping.size(); ++q) {
+      for (const auto &index : blockMapping[q])
+        mapping[q].add(index.first, index.second);
+    }
+  }
+}
+
+/**
+ * Rebin the input quadrilateral to the output grid.
+ * The quadrilateral must have a CLOCKWISE winding.
+ * @param inputQ The input polygon (Polygon winding must be Clockwise)
+ * @param inputWS The input workspace containing the input intensity values
+ * @param i The index in the vertical axis direction that inputQ references
+ * @param j The index in the horizontal axis direction that inputQ references
+ * @param outputWS A pointer to the output workspace that accumulates the data
+ * @param verticalAxis A vector containing the output vertical axis bin
+ * boundaries
+ */
+void rebinToOutput(const Quadrilateral &inputQ,
+                   const MatrixWorkspace_const_sptr &inputWS, const size_t i,
+                   const size_t j, MatrixWorkspace &outputWS,
+                   const std::vector<double> &verticalAxis) {
+  rebinToOutputImpl(inputQ, inputWS, i, j, outputWS.x(0).rawData(),
+                    verticalAxis,
+                    [&outputWS](const size_t yi, const size_t xi,
+                                const double signal, const double variance,
+                                const double) {
+                      PARALLEL_CRITICAL(overlap_sum) {
+                        outputWS.mutableY(yi)[xi] += signal;
+                        outputWS.mutableE(yi)[xi] += variance;
+                      }
+                    });
+}
+
+/**
+ * Rebin the input quadrilateral to the sums of the block of the input it
+ * belongs to. Unlike the overload taking the output workspace, this takes no
+ * lock. The sums are added to the output with addPartialOutputs().
+ * The quadrilateral must have a CLOCKWISE winding.
+ * @param inputQ The input polygon (Polygon winding must be Clockwise)
+ * @param inputWS The input workspace containing the input intensity values
+ * @param i The index in the vertical axis direction that inputQ references
+ * @param j The index in the horizontal axis direction that inputQ references
+ * @param partial The sums of the block of the input i belongs to
+ * @param verticalAxis A vector containing the output vertical axis bin
+ * boundaries
+ */
+void rebinToOutput(const Quadrilateral &inputQ,
+                   const MatrixWorkspace_const_sptr &inputWS, const size_t i,
+                   const size_t j, PartialOutput &partial,
+                   const std::vector<double> &verticalAxis) {
+  rebinToOutputImpl(inputQ, inputWS, i, j, partial.xAxis(), verticalAxis,
+                    [&partial](const size_t yi, const size_t xi,
+                               const double signal, const double variance,
+                               const double) {
+                      partial.add(yi, xi, signal, variance, 0.);
+                    });
+}
+
+/**
+ * Rebin the input quadrilateral to the output grid
+ * The quadrilateral must have a CLOCKWISE winding.
+ * @param inputQ The input polygon (Polygon winding must be clockwise)
+ * @param inputWS The input workspace containing the input intensity values
+ * @param i The indexiin the vertical axis direction that inputQ references
+ * @param j The index in the horizontal axis direction that inputQ references
+ * @param outputWS A pointer to the output workspace that accumulates the data
+ *        Note that the error array of the output workspace contains the
+ *        **variance** and not the errors (standard deviations).
+ * @param verticalAxis A vector containing the output vertical axis bin
+ * boundaries
+ * @param inputRB A pointer, of RebinnedOutput type, to the input workspace.
+ * It is used to take into account the input area fractions when calcuting
+ * the final output fractions.
+ * This can be null to indicate that the input was a standard 2D workspace.
+ */
+void rebinToFractionalOutput(const Quadrilateral &inputQ,
+                             const MatrixWorkspace_const_sptr &inputWS,
+                             const size_t i, const size_t j,
+                             RebinnedOutput &outputWS,
+                             const std::vector<double> &verticalAxis,
+                             const RebinnedOutput_const_sptr &inputRB) {
+  rebinToFractionalOutputImpl(
+      inputQ, inputWS, i, j, outputWS.x(0).rawData(), verticalAxis, inputRB,
+      [&outputWS](const size_t yi, const size_t xi, const double signal,
+                  const double variance, const double fraction) {
+        PARALLEL_CRITICAL(overlap) {
+          outputWS.mutableY(yi)[xi] += signal;
+          outputWS.mutableE(yi)[xi] += variance;
+          outputWS.dataF(yi)[xi] += fraction;
+        }
+      });
+}
+
+/**
+ * Rebin the input quadrilateral to the sums of the block of the input it
+ * belongs to. Unlike the overload taking the output workspace, this takes no
+ * lock. The sums are added to the output with addPartialOutputs().
+ * The quadrilateral must have a CLOCKWISE winding.
+ * @param inputQ The input polygon (Polygon winding must be clockwise)
+ * @param inputWS The input workspace containing the input intensity values
+ * @param i The index in the vertical axis direction that inputQ references
+ * @param j The index in the horizontal axis direction that inputQ references
+ * @param partial The sums of the block of the input i belongs to. As for the
+ * output workspace, the variances are summed rather than the errors.
+ * @param verticalAxis A vector containing the output vertical axis bin
+ * boundaries
+ * @param inputRB A pointer, of RebinnedOutput type, to the input workspace,
+ * or null if the input was a standard 2D workspace.
+ */
+void rebinToFractionalOutput(const Quadrilateral &inputQ,
+                             const MatrixWorkspace_const_sptr &inputWS,
+                             const size_t i, const size_t j,
+                             PartialOutput &partial,
+                             const std::vector<double> &verticalAxis,
+                             const RebinnedOutput_const_sptr &inputRB) {
+  rebinToFractionalOutputImpl(
+      inputQ, inputWS, i, j, partial.xAxis(), verticalAxis, inputRB,
+      [&partial](const size_t yi, const size_t xi, const double signal,
+                 const double variance, const double fraction) {
+        partial.add(yi, xi, signal, variance, fraction);
+      });
+}
+
 } // namespace FractionalRebinning
 
 } // namespace DataObjects
@@ -0,0 +1,417 @@
+#ifndef BOXCONTROLLER_MMAP_IO_TEST_H
+#define BOXCONTROLLER_MMAP_IO_TEST_H
+
+#include "MantidAPI/FileFinder.h"
+#include "MantidDataObjects/BoxControllerMMapIO.h"
+#include "MantidDataObjects/BoxControllerNeXusIO.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/make_unique.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <H5Cpp.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+#include <fstream>
+#include <numeric>
+
+class BoxControllerMMapIOTest : public CxxTest::TestSuite {
+public:
+  static BoxControllerMMapIOTest *createSuite() {
+    return new BoxControllerMMapIOTest();
+  }
+  static void destroySuite(BoxControllerMMapIOTest *suite) { delete suite; }
+
+  Mantid::API::BoxController_sptr sc;
+  std::string xxfFileName;
+
+  BoxControllerMMapIOTest() {
+    sc = Mantid::API::BoxController_sptr(new Mantid::API::BoxController(4));
+    xxfFileName = "BoxCntrlMMapIOxxfFile.mdevents";
+  }
+
+  void setUp() override {
+    std::string FullPathFile =
+        Mantid::API::FileFinder::Instance().getFullPath(this->xxfFileName);
+    if (!FullPathFile.empty())
+      Poco::File(FullPathFile).remove();
+  }
+
+  void test_contstructor_setters() {
+    auto pSaver = createTestBoxController();
+
+    size_t CoordSize;
+    std::string typeName;
+    TS_ASSERT_THROWS_NOTHING(pSaver->getDataType(CoordSize, typeName));
+    // default settings
+    TS_ASSERT_EQUALS(4, CoordSize);
+    TS_ASSERT_EQUALS("MDEvent", typeName);
+    TS_ASSERT_EQUALS(8, pSaver->getNDataColums());
+
+    TS_ASSERT_THROWS(pSaver->setDataType(9, typeName), std::invalid_argument);
+    TS_ASSERT_THROWS(pSaver->setDataType(4, "UnknownEvent"),
+                     std::invalid_argument);
+    TS_ASSERT_THROWS_NOTHING(pSaver->setDataType(8, "MDLeanEvent"));
+    TS_ASSERT_THROWS_NOTHING(pSaver->getDataType(CoordSize, typeName));
+    TS_ASSERT_EQUALS(8, CoordSize);
+    TS_ASSERT_EQUALS("MDLeanEvent", typeName);
+    TS_ASSERT_EQUALS(6, pSaver->getNDataColums());
+  }
+
+  void test_CreateOrOpenFile() {
+    using Mantid::API::FileFinder;
+    using Mantid::Kernel::Exception::FileError;
+
+    auto pSaver = createTestBoxController();
+    std::string FullPathFile;
+
+    TSM_ASSERT_THROWS("new file does not open in read mode",
+                      pSaver->openFile(this->xxfFileName, "r"), FileError);
+
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
+    TS_ASSERT_THROWS_NOTHING(FullPathFile = pSaver->getFileName());
+    TS_ASSERT(pSaver->isOpened());
+    TSM_ASSERT("file is already opened",
+               !pSaver->openFile(this->xxfFileName, "w"));
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+    TS_ASSERT(!pSaver->isOpened());
+
+    TSM_ASSERT("file created ",
+               !FileFinder::Instance().getFullPath(FullPathFile).empty());
+
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(FullPathFile, "r"));
+    TS_ASSERT(pSaver->isOpened());
+    TS_ASSERT_EQUALS(0, pSaver->getFileLength());
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    // The events in the file are not the requested ones
+    pSaver->setDataType(4, "MDLeanEvent");
+    TS_ASSERT_THROWS(pSaver->openFile(FullPathFile, "r"), FileError);
+    TS_ASSERT(!pSaver->isOpened());
+
+    Poco::File(FullPathFile).remove();
+  }
+
+  void test_free_space_index_is_written_out_and_read_in() {
+    auto pSaver = createTestBoxController();
+    std::string FullPathFile;
+
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
+    TS_ASSERT_THROWS_NOTHING(FullPathFile = pSaver->getFileName());
+    std::vector<float> toWrite(30 * pSaver->getNDataColums(), 1.f);
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(toWrite, 0));
+
+    std::vector<uint64_t> freeSpaceVectorToSet;
+    for (uint64_t i = 0; i < 20; i++) {
+      freeSpaceVectorToSet.push_back(i);
+    }
+    pSaver->setFreeSpaceVector(freeSpaceVectorToSet);
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
+    std::vector<uint64_t> freeSpaceVectorToGet;
+    pSaver->getFreeSpaceVector(freeSpaceVectorToGet);
+    TS_ASSERT_EQUALS(freeSpaceVectorToSet, freeSpaceVectorToGet);
+    TS_ASSERT_EQUALS(30, pSaver->getFileLength());
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    Poco::File(FullPathFile).remove();
+  }
+
+  void test_file_grows_when_writing_behind_its_end() {
+    auto pSaver = createTestBoxController();
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
+    const std::string FullPathFile = pSaver->getFileName();
+    const size_t nColumns = pSaver->getNDataColums();
+    TS_ASSERT_EQUALS(0, pSaver->getCapacity());
+
+    std::vector<float> toWrite(10 * nColumns, 2.f);
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(toWrite, 0));
+    TS_ASSERT_EQUALS(10, pSaver->getFileLength());
+    TS_ASSERT_LESS_THAN_EQUALS(10, pSaver->getCapacity());
+
+    const uint64_t farAway = pSaver->getCapacity() + 5;
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(toWrite, farAway));
+    TS_ASSERT_EQUALS(farAway + 10, pSaver->getFileLength());
+    TS_ASSERT_LESS_THAN_EQUALS(farAway + 10, pSaver->getCapacity());
+
+    // the data written before the file grew are still there
+    std::vector<float> toRead;
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead, 0, 10));
+    TS_ASSERT_EQUALS(toWrite, toRead);
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead, farAway, 10));
+    TS_ASSERT_EQUALS(toWrite, toRead);
+    TS_ASSERT_THROWS(pSaver->loadBlock(toRead, farAway + 1, 10),
+                     Mantid::Kernel::Exception::FileError);
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    // the file is truncated to the events when closed
+    TS_ASSERT_EQUALS(Poco::File(FullPathFile).getSize(),
+                     64 + (farAway + 10) * nColumns * sizeof(float));
+    Poco::File(FullPathFile).remove();
+  }
+
+  void test_blocks_are_saved_and_loaded_in_parallel() {
+    auto pSaver = createTestBoxController();
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
+    const std::string FullPathFile = pSaver->getFileName();
+    const size_t nColumns = pSaver->getNDataColums();
+    const int nBlocks = 100;
+    const size_t blockSize = 1000;
+
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < nBlocks; ++i) {
+      std::vector<float> block(blockSize * nColumns, static_cast<float>(i));
+      pSaver->saveBlock(block, i * blockSize);
+    }
+    TS_ASSERT_EQUALS(nBlocks * blockSize, pSaver->getFileLength());
+
+    int nWrong = 0;
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < nBlocks; ++i) {
+      std::vector<float> block;
+      pSaver->loadBlock(block, i * blockSize, blockSize);
+      if (block != std::vector<float>(blockSize * nColumns,
+                                      static_cast<float>(i))) {
+        PARALLEL_ATOMIC
+        ++nWrong;
+      }
+    }
+    TS_ASSERT_EQUALS(0, nWrong);
+
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+    Poco::File(FullPathFile).remove();
+  }
+
+  //---------------------------------------------------------------------------------------------------------
+  // tests to read/write double/vs float events
+  template <typename FROM, typename TO> void WriteReadRead() {
+    auto pSaver = createTestBoxController();
+    pSaver->setDataType(sizeof(FROM), "MDEvent");
+
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
+    const std::string FullPathFile = pSaver->getFileName();
+
+    size_t nEvents = 20;
+    size_t nColumns = pSaver->getNDataColums();
+    std::vector<FROM> toWrite(nColumns * nEvents);
+    for (size_t i = 0; i < nEvents; i++) {
+      for (size_t j = 0; j < nColumns; j++) {
+        toWrite[i * nColumns + j] = static_cast<FROM>(j + 10 * i);
+      }
+    }
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(toWrite, 100));
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    // open and read what was written
+    pSaver->setDataType(sizeof(TO), "MDEvent");
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(FullPathFile, "r"));
+    TS_ASSERT_EQUALS(100 + nEvents, pSaver->getFileLength());
+    std::vector<TO> toRead;
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead, 100, nEvents));
+    TS_ASSERT_EQUALS(nEvents * nColumns, toRead.size());
+    for (size_t i = 0; i < toRead.size(); i++) {
+      TS_ASSERT_DELTA(toWrite[i], toRead[i], 1.e-6);
+    }
+    TSM_ASSERT_THROWS("file opened for reading",
+                      pSaver->saveBlock(toRead, 0),
+                      Mantid::Kernel::Exception::FileError);
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    Poco::File(FullPathFile).remove();
+  }
+
+  void test_WriteFloatReadFloat() { this->WriteReadRead<float, float>(); }
+  void test_WriteDoubleReadDouble() { this->WriteReadRead<double, double>(); }
+  void test_WriteDoubleReadFloat() { this->WriteReadRead<double, float>(); }
+  void test_WriteFloatReadDouble() { this->WriteReadRead<float, double>(); }
+
+  void test_file_state_and_remove_on_close() {
+    using FileState = Mantid::DataObjects::BoxControllerMMapIO::FileState;
+    auto pSaver = createTestBoxController();
+    const std::string FullPathFile = tempFileName(this->xxfFileName);
+    TS_ASSERT_EQUALS(FileState::Missing, pSaver->getFileState(FullPathFile));
+
+    const std::string privateFile =
+        tempFileName("BoxCntrlMMapIOPrivate.mdevents");
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(privateFile, "w"));
+    TS_ASSERT_EQUALS(privateFile, pSaver->getFileName());
+    TS_ASSERT_EQUALS(FileState::InUse, pSaver->getFileState(privateFile));
+    pSaver->setRemoveOnClose(true, FullPathFile);
+    TS_ASSERT_EQUALS(FileState::Missing, pSaver->getFileState(FullPathFile));
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+    TSM_ASSERT("an unchanged file is kept under the other name",
+               Poco::File(FullPathFile).exists());
+    TS_ASSERT(!Poco::File(privateFile).exists());
+    TS_ASSERT_EQUALS(FileState::Reusable, pSaver->getFileState(FullPathFile));
+
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(FullPathFile, "w"));
+    pSaver->setRemoveOnClose(true, privateFile);
+    std::vector<float> toWrite(10 * pSaver->getNDataColums(), 1.f);
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(toWrite, 0));
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+    TSM_ASSERT("a changed file is removed", !Poco::File(FullPathFile).exists());
+    TS_ASSERT(!Poco::File(privateFile).exists());
+
+    std::ofstream(FullPathFile) << "not events";
+    TS_ASSERT_EQUALS(FileState::Invalid, pSaver->getFileState(FullPathFile));
+    Poco::File(FullPathFile).remove();
+  }
+
+  void test_contiguous_NeXus_events_are_mapped_in_place() {
+    const std::string nexusFile =
+        createNexusEvents("BoxCntrlMMapIOInPlace.nxs", true);
+    const std::string copyFile = tempFileName(this->xxfFileName);
+    auto pSaver = createTestBoxController();
+
+    TS_ASSERT(pSaver->openInPlace(nexusFile, copyFile));
+    TS_ASSERT(pSaver->isInPlace());
+    TS_ASSERT_EQUALS(nexusFile, pSaver->getFileName());
+    TS_ASSERT_EQUALS(30, pSaver->getFileLength());
+    std::vector<uint64_t> freeSpace;
+    pSaver->getFreeSpaceVector(freeSpace);
+    TS_ASSERT_EQUALS(std::vector<uint64_t>({3, 4, 10, 5}), freeSpace);
+
+    std::vector<float> events;
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(events, 2, 3));
+    TS_ASSERT_EQUALS(3 * pSaver->getNDataColums(), events.size());
+    TS_ASSERT_EQUALS(16.f, events.front());
+    TS_ASSERT_EQUALS(39.f, events.back());
+
+    // saving events copies them out of the NeXus file
+    std::vector<float> toWrite(pSaver->getNDataColums(), -1.f);
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(toWrite, 3));
+    TS_ASSERT(!pSaver->isInPlace());
+    TS_ASSERT_EQUALS(copyFile, pSaver->getFileName());
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(events, 2, 3));
+    TS_ASSERT_EQUALS(16.f, events.front());
+    TS_ASSERT_EQUALS(-1.f, events[pSaver->getNDataColums()]);
+    TS_ASSERT_EQUALS(39.f, events.back());
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+    TSM_ASSERT("the copy belongs to the IO", !Poco::File(copyFile).exists());
+
+    // the NeXus file is unchanged
+    TS_ASSERT(pSaver->openInPlace(nexusFile, copyFile));
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(events, 3, 1));
+    TS_ASSERT_EQUALS(24.f, events.front());
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+    Poco::File(nexusFile).remove();
+  }
+
+  void test_view_block_passes_the_mapped_values() {
+    auto pSaver = createTestBoxController();
+    const std::string FullPathFile = tempFileName(this->xxfFileName);
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(FullPathFile, "w"));
+    const size_t nColumns = pSaver->getNDataColums();
+    std::vector<float> toWrite(5 * nColumns);
+    std::iota(toWrite.begin(), toWrite.end(), 0.f);
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(toWrite, 0));
+
+    std::vector<float> viewed;
+    const std::function<void(const float *, size_t)> visitFloats =
+        [&viewed](const float *values, size_t nValues) {
+          viewed.assign(values, values + nValues);
+        };
+    TS_ASSERT(pSaver->viewBlock(1, 3, visitFloats));
+    TS_ASSERT_EQUALS(std::vector<float>(toWrite.begin() + nColumns,
+                                        toWrite.begin() + 4 * nColumns),
+                     viewed);
+    TS_ASSERT_THROWS(pSaver->viewBlock(4, 2, visitFloats),
+                     Mantid::Kernel::Exception::FileError);
+
+    const std::function<void(const double *, size_t)> visitDoubles =
+        [](const double *, size_t) {
+          TS_FAIL("values of another precision can not be viewed");
+        };
+    TSM_ASSERT("values of another precision have to be loaded",
+               !pSaver->viewBlock(1, 3, visitDoubles));
+    pSaver->setRemoveOnClose(true);
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+  }
+
+  void test_events_saved_contiguously_by_NeXus_IO_are_mapped_in_place() {
+    const std::string nexusFile = tempFileName("BoxCntrlMMapIONeXusIO.nxs");
+    if (Poco::File(nexusFile).exists())
+      Poco::File(nexusFile).remove();
+    std::vector<float> toWrite(12 * 8);
+    std::iota(toWrite.begin(), toWrite.end(), 0.f);
+    {
+      Mantid::DataObjects::BoxControllerNeXusIO nexusSaver(sc.get());
+      nexusSaver.setContiguousLength(12);
+      TS_ASSERT_THROWS_NOTHING(nexusSaver.openFile(nexusFile, "w"));
+      TS_ASSERT_THROWS_NOTHING(nexusSaver.saveBlock(toWrite, 0));
+      TS_ASSERT_THROWS_NOTHING(nexusSaver.closeFile());
+    }
+
+    auto pSaver = createTestBoxController();
+    TS_ASSERT(pSaver->openInPlace(nexusFile, tempFileName(xxfFileName)));
+    TS_ASSERT_EQUALS(12, pSaver->getFileLength());
+    std::vector<float> viewed;
+    TS_ASSERT(pSaver->viewBlock(
+        0, 12, std::function<void(const float *, size_t)>(
+                   [&viewed](const float *values, size_t nValues) {
+                     viewed.assign(values, values + nValues);
+                   })));
+    TS_ASSERT_EQUALS(toWrite, viewed);
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+    Poco::File(nexusFile).remove();
+  }
+
+  void test_chunked_NeXus_events_are_not_mapped_in_place() {
+    const std::string nexusFile =
+        createNexusEvents("BoxCntrlMMapIOChunked.nxs", false);
+    auto pSaver = createTestBoxController();
+    TS_ASSERT(!pSaver->openInPlace(nexusFile, tempFileName(xxfFileName)));
+    TS_ASSERT(!pSaver->isOpened());
+    Poco::File(nexusFile).remove();
+  }
+
+private:
+  /// The full path of a file in the temporary directory
+  std::string tempFileName(const std::string &name) {
+    Poco::Path path(Mantid::Kernel::ConfigService::Instance().getTempDir());
+    path.makeDirectory();
+    path.setFileName(name);
+    return path.toString();
+  }
+
+  /// Write 30 events with consecutive values to a file laid out like the
+  /// files written by SaveMD
+  std::string createNexusEvents(const std::string &name,
+                                const bool contiguous) {
+    const std::string fileName = tempFileName(name);
+    H5::H5File file(fileName, H5F_ACC_TRUNC);
+    H5::Group group =
+        file.createGroup("MDEventWorkspace").createGroup("event_data");
+
+    hsize_t dims[2] = {30, 8};
+    H5::DSetCreatPropList properties;
+    if (!contiguous)
+      properties.setChunk(2, dims);
+    std::vector<float> values(dims[0] * dims[1]);
+    std::iota(values.begin(), values.end(), 0.f);
+    group
+        .createDataSet("event_data", H5::PredType::NATIVE_FLOAT,
+                       H5::DataSpace(2, dims), properties)
+        .write(values.data(), H5::PredType::NATIVE_FLOAT);
+
+    hsize_t freeDims[2] = {2, 2};
+    const std::vector<uint64_t> freeSpace{3, 4, 10, 5};
+    group
+        .createDataSet("free_space_blocks", H5::PredType::NATIVE_UINT64,
+                       H5::DataSpace(2, freeDims))
+        .write(freeSpace.data(), H5::PredType::NATIVE_UINT64);
+    return fileName;
+  }
+
+  /// Create a test box controller IO
+  std::unique_ptr<Mantid::DataObjects::BoxControllerMMapIO>
+  createTestBoxController() {
+    return Mantid::Kernel::make_unique<
+        Mantid::DataObjects::BoxControllerMMapIO>(sc.get());
+  }
+};
+#endif
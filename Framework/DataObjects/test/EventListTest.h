@@ -9,6 +9,7 @@
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/CPUTimer.h"
 #include "MantidKernel/Unit.h"
+#include "MantidKernel/VectorHelper.h"
 #include "MantidKernel/make_unique.h"
 
 #include <boost/scoped_ptr.hpp>
@@ -1229,6 +1230,39 @@ public:
     TS_ASSERT_EQUALS(this->el.ptrX()->size(), NUMBINS + 1);
   }
 
+  void test_histogram_linear_and_log_bins_does_not_sort() {
+    MantidVec linearX, logX;
+    VectorHelper::createAxisFromRebinParams({0., 1e5, 1e7}, linearX);
+    VectorHelper::createAxisFromRebinParams({10., -0.1, 1e7}, logX);
+    for (int this_type = 0; this_type < 3; this_type++) {
+      EventType curType = static_cast<EventType>(this_type);
+      this->fake_data(curType);
+      el *= 1.5;
+      for (const auto &X : {linearX, logX}) {
+        MantidVec Y, E;
+        el.generateHistogram(X, Y, E);
+        TS_ASSERT_EQUALS(el.getSortType(), UNSORTED);
+
+        // Compare with a histogram filled by a search for every event
+        MantidVec expectedY(X.size() - 1, 0.0), expectedE(X.size() - 1, 0.0);
+        for (size_t i = 0; i < el.getNumberEvents(); ++i) {
+          const auto event = el.getEvent(i);
+          auto bin = std::upper_bound(X.begin(), X.end(), event.tof());
+          if (bin == X.begin() || bin == X.end())
+            continue;
+          const auto index = std::distance(X.begin(), bin) - 1;
+          expectedY[index] += event.weight();
+          expectedE[index] += event.errorSquared();
+        }
+        TS_ASSERT_EQUALS(Y.size(), expectedY.size());
+        for (size_t i = 0; i < expectedY.size(); ++i) {
+          TS_ASSERT_DELTA(Y[i], expectedY[i], 1e-10);
+          TS_ASSERT_DELTA(E[i], std::sqrt(expectedE[i]), 1e-10);
+        }
+      }
+    }
+  }
+
   //  void test_histogram_static_function()
   //  {
   //    std::vector<WeightedEvent> events;
@@ -1456,6 +1490,12 @@ public:
       // Original tofs were 100, 5100, 10100, etc.). This becomes x * 200.
       TSM_ASSERT_EQUALS(this_type, this->el.getEvent(0).tof(), 100 * 200.);
       TSM_ASSERT_EQUALS(this_type, this->el.getEvent(1).tof(), 5100 * 200.);
+      // The events are converted in batches: check past the first one
+      TSM_ASSERT_EQUALS(this_type, this->el.getEvent(1500).tof(),
+                        7500100 * 200.);
+      TSM_ASSERT_EQUALS(this_type, this->el.getEvent(old_num - 1).tof(),
+                        (100. + 5000. * static_cast<double>(old_num - 1)) *
+                            200.);
     }
   }
 
@@ -1641,6 +1681,29 @@ public:
     }
   }
 
+  void test_filterByPulseTime_after_compressFatEvents() {
+    // All the events are in one pulse time bin, so the compressed events are
+    // in TOF order and their pulse times decrease
+    EventList input;
+    for (int64_t i = 0; i < 10; ++i)
+      input += TofEvent(100. * static_cast<double>(i + 1),
+                        DateAndTime(1000 - 100 * i));
+    EventList compressed;
+    TS_ASSERT_THROWS_NOTHING(
+        input.compressFatEvents(1., DateAndTime(0), 1., &compressed));
+    TS_ASSERT_EQUALS(compressed.getNumberEvents(), 10);
+    TS_ASSERT(!compressed.isSortedByPulseTime());
+
+    EventList out;
+    TS_ASSERT_THROWS_NOTHING(compressed.filterByPulseTime(
+        DateAndTime(300), DateAndTime(600), out));
+    TS_ASSERT_EQUALS(out.getNumberEvents(), 3);
+    for (std::size_t i = 0; i < out.getNumberEvents(); i++) {
+      TS_ASSERT_LESS_THAN_EQUALS(DateAndTime(300), out.getEvent(i).pulseTime());
+      TS_ASSERT_LESS_THAN(out.getEvent(i).pulseTime(), DateAndTime(600));
+    }
+  }
+
   void test_filterByPulseTime_output_same_as_input_throws() {
     TS_ASSERT_THROWS(el.filterByPulseTime(100, 200, el), std::invalid_argument);
   }
@@ -1880,6 +1943,47 @@ public:
     return;
   }
 
+  //-----------------------------------------------------------------------------------------------
+  void test_splitByTimeIntoTargets() {
+    // 1000 events with pulse times 999 to 0, i.e. not sorted
+    el = EventList();
+    for (int time = 999; time >= 0; time--)
+      el += TofEvent(static_cast<double>(time), time);
+    el.switchTo(WEIGHTED);
+
+    EventList out0, out1, out2;
+    std::vector<EventList *> outputs{&out0, &out1, nullptr, &out2};
+    // [100, 300) -> 0, [300, 600) discarded, [600, 800) -> 3,
+    // [800, 900) -> 2 (no output) and [900, 1000) -> 1
+    std::vector<int64_t> times{100, 300, 600, 800, 900, 1000};
+    std::vector<int> targets{0, -1, 3, 2, 1};
+    el.splitByTimeIntoTargets(times, targets, outputs, true);
+    TS_ASSERT_EQUALS(out0.getNumberEvents(), 200);
+    TS_ASSERT_EQUALS(out1.getNumberEvents(), 100);
+    TS_ASSERT_EQUALS(out2.getNumberEvents(), 200);
+    TS_ASSERT_EQUALS(out2.getEventType(), WEIGHTED);
+    // The events keep their order
+    TS_ASSERT_EQUALS(out2.getWeightedEvents().front().pulseTime(),
+                     DateAndTime(799));
+    TS_ASSERT_EQUALS(out2.getWeightedEvents().back().pulseTime(),
+                     DateAndTime(600));
+
+    // By full time, with a TOF factor of 0 to use the pulse time alone
+    el.splitByTimeIntoTargets(times, targets, outputs, false, 0.0, 0.0);
+    TS_ASSERT_EQUALS(out0.getNumberEvents(), 200);
+    TS_ASSERT_EQUALS(out1.getNumberEvents(), 100);
+    TS_ASSERT_EQUALS(out2.getNumberEvents(), 200);
+
+    // By full time: the TOFs move all the events out of the intervals
+    el.splitByTimeIntoTargets(times, targets, outputs);
+    TS_ASSERT_EQUALS(out0.getNumberEvents(), 0);
+    TS_ASSERT_EQUALS(out1.getNumberEvents(), 0);
+    TS_ASSERT_EQUALS(out2.getNumberEvents(), 0);
+
+    TS_ASSERT_THROWS(el.splitByTimeIntoTargets(times, {0, 1}, outputs),
+                     std::invalid_argument);
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_splitByTime_allTypes() {
     // Go through each possible EventType as the input
@@ -1941,6 +2045,85 @@ public:
     delete outputs.front();
   }
 
+  //-----------------------------------------------------------------------------------------------
+  void test_splitByTime_many_slices_keeps_pulse_time_order() {
+    this->fake_uniform_time_data();
+    // Sorted by pulse time then TOF is also in pulse time order
+    el.sortPulseTimeTOF();
+    const auto firstTof = el.getEvent(0).tof();
+
+    std::vector<EventList *> outputs;
+    TimeSplitterType split;
+    // Slices of 3, with gaps of 1
+    for (int i = 0; i < 250; i++) {
+      outputs.push_back(new EventList());
+      split.push_back(SplittingInterval(i * 4, i * 4 + 3, i));
+    }
+    el.splitByTime(split, outputs);
+
+    // The input was not sorted again
+    TS_ASSERT_EQUALS(el.getSortType(), PULSETIMETOF_SORT);
+    TS_ASSERT_EQUALS(el.getEvent(0).tof(), firstTof);
+    for (int i = 0; i < 250; i++) {
+      TS_ASSERT_EQUALS(outputs[i]->getNumberEvents(), 3);
+      TS_ASSERT_EQUALS(outputs[i]->getSortType(), PULSETIMETOF_SORT);
+      TS_ASSERT_EQUALS(outputs[i]->getEvent(0).pulseTime(), i * 4);
+      TS_ASSERT_EQUALS(outputs[i]->getEvent(2).pulseTime(), i * 4 + 2);
+      delete outputs[i];
+    }
+  }
+
+  //-----------------------------------------------------------------------------------------------
+  void test_splitByPulseTime() {
+    this->fake_uniform_time_data();
+    el.setSortOrder(PULSETIME_SORT);
+
+    std::map<int, EventList *> outputs;
+    for (int i = -1; i < 2; i++)
+      outputs[i] = new EventList();
+
+    TimeSplitterType split;
+    split.push_back(SplittingInterval(100, 200, 0));
+    split.push_back(SplittingInterval(300, 350, 1));
+    split.push_back(SplittingInterval(400, 410, 0));
+    el.splitByPulseTime(split, outputs);
+
+    // Events before an interval go to the unfiltered list
+    TS_ASSERT_EQUALS(outputs[-1]->getNumberEvents(), 100 + 100 + 50);
+    TS_ASSERT_EQUALS(outputs[0]->getNumberEvents(), 110);
+    TS_ASSERT_EQUALS(outputs[1]->getNumberEvents(), 50);
+    TS_ASSERT_EQUALS(outputs[0]->getEvent(100).pulseTime(), 400);
+    TS_ASSERT_EQUALS(outputs[1]->getEvent(0).pulseTime(), 300);
+    for (auto &output : outputs) {
+      TS_ASSERT_EQUALS(output.second->getSortType(), PULSETIME_SORT);
+      delete output.second;
+    }
+  }
+
+  //-----------------------------------------------------------------------------------------------
+  void test_changing_tofs_keeps_pulse_time_order() {
+    this->fake_uniform_time_data();
+    el.setSortOrder(PULSETIME_SORT);
+    el.convertTof([](double tof) { return 2. * tof; });
+    TS_ASSERT_EQUALS(el.getSortType(), PULSETIME_SORT);
+    TS_ASSERT(el.isSortedByPulseTime());
+
+    std::vector<double> tofs;
+    el.getTofs(tofs);
+    el.setTofs(tofs);
+    TS_ASSERT_EQUALS(el.getSortType(), PULSETIME_SORT);
+
+    // The TOFs are no longer sorted within a pulse
+    el.sortPulseTimeTOF();
+    el.convertTof(-1., 0.);
+    TS_ASSERT_EQUALS(el.getSortType(), PULSETIME_SORT);
+
+    el.sortTof();
+    el.convertTof([](double tof) { return 2. * tof; });
+    TS_ASSERT_EQUALS(el.getSortType(), UNSORTED);
+    TS_ASSERT(!el.isSortedByPulseTime());
+  }
+
   //-----------------------------------------------------------------------------------------------
   void do_testSplit_FilterInPlace(bool weighted) {
     this->fake_uniform_time_data();
@@ -2802,6 +2985,27 @@ public:
 
   void test_convertTof() { el_random.convertTof(2.5, 6.78); }
 
+  void test_convertUnitsViaTof() {
+    Mantid::Kernel::Units::TOF tof;
+    Mantid::Kernel::Units::dSpacing dSpacing;
+    tof.initialize(10., 2., 0.5, 0, 0., 0.);
+    dSpacing.initialize(10., 2., 0.5, 0, 0., 0.);
+    el_random.convertUnitsViaTof(&tof, &dSpacing);
+  }
+
+  void test_splitByTime_many_slices() {
+    el_random.sortPulseTime();
+    std::vector<EventList *> outputs;
+    TimeSplitterType split;
+    for (int i = 0; i < 1000; i++) {
+      outputs.push_back(new EventList());
+      split.push_back(SplittingInterval(i, i + 1, i));
+    }
+    el_random.splitByTime(split, outputs);
+    for (auto output : outputs)
+      delete output;
+  }
+
   void test_getTofs_setTofs() {
     std::vector<double> tofs;
     el_random.getTofs(tofs);
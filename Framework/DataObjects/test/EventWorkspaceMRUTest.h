@@ -5,9 +5,25 @@
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/System.h"
 
+#include "MantidDataObjects/EventList.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
 
 using namespace Mantid::DataObjects;
+using Mantid::HistogramData::HistogramE;
+using Mantid::HistogramData::HistogramY;
+using Mantid::Kernel::make_cow;
+
+namespace {
+/// A histogram with n bins, generated from numEvents events
+EventWorkspaceMRU::Histogram makeHistogram(const size_t n,
+                                           const size_t numEvents = 0) {
+  EventWorkspaceMRU::Histogram histogram;
+  histogram.y = make_cow<HistogramY>(n, 1.);
+  histogram.e = make_cow<HistogramE>(n, 1.);
+  histogram.numEvents = numEvents;
+  return histogram;
+}
+} // namespace
 
 class EventWorkspaceMRUTest : public CxxTest::TestSuite {
 public:
@@ -15,6 +31,127 @@ public:
     EventWorkspaceMRU mru;
     TS_ASSERT_THROWS_NOTHING(mru.MRUSize());
     TS_ASSERT_EQUALS(mru.MRUSize(), 0);
+    TS_ASSERT_EQUALS(mru.histogramCacheSize(), 0);
+  }
+
+  void test_findHistogram() {
+    EventWorkspaceMRU mru(1024 * 1024);
+    EventList el1, el2;
+    TS_ASSERT(!mru.findHistogram(&el1).y);
+
+    mru.insertHistogram(&el1, makeHistogram(10, 3));
+    const auto histogram = mru.findHistogram(&el1);
+    TS_ASSERT(histogram.y);
+    TS_ASSERT(histogram.e);
+    TS_ASSERT_EQUALS(histogram.y->size(), 10);
+    TS_ASSERT_EQUALS(histogram.numEvents, 3);
+    TS_ASSERT(!mru.findHistogram(&el2).y);
+    TS_ASSERT_EQUALS(mru.histogramCacheSize(), 1);
+    TS_ASSERT_EQUALS(mru.histogramCacheMemory(), 20 * sizeof(double));
+
+    // Replacing a histogram does not count it twice
+    mru.insertHistogram(&el1, makeHistogram(5, 4));
+    TS_ASSERT_EQUALS(mru.findHistogram(&el1).numEvents, 4);
+    TS_ASSERT_EQUALS(mru.histogramCacheSize(), 1);
+    TS_ASSERT_EQUALS(mru.histogramCacheMemory(), 10 * sizeof(double));
+
+    mru.deleteIndex(&el1);
+    TS_ASSERT(!mru.findHistogram(&el1).y);
+    TS_ASSERT_EQUALS(mru.histogramCacheMemory(), 0);
+  }
+
+  void test_memory_limit_drops_least_recently_used_histograms() {
+    // Room for 64 histograms of 100 bins, 4 in each shard
+    EventWorkspaceMRU mru(16 * 4 * 200 * sizeof(double));
+    std::vector<EventList> lists(200);
+    for (const auto &el : lists)
+      mru.insertHistogram(&el, makeHistogram(100));
+    TS_ASSERT_LESS_THAN_EQUALS(mru.histogramCacheSize(), 64);
+    TS_ASSERT_LESS_THAN_EQUALS(mru.histogramCacheMemory(),
+                               64 * 200 * sizeof(double));
+    // The last one is the most recently used
+    TS_ASSERT(mru.findHistogram(&lists.back()).y);
+    TS_ASSERT(!mru.findHistogram(&lists.front()).y);
+  }
+
+  void test_caches_share_the_process_memory_limit() {
+    const size_t before = EventWorkspaceMRU::processHistogramCacheMemory();
+    EventList el1, el2;
+    {
+      EventWorkspaceMRU mru1;
+      EventWorkspaceMRU mru2;
+      mru1.insertHistogram(&el1, makeHistogram(10));
+      mru2.insertHistogram(&el2, makeHistogram(5));
+      TS_ASSERT_EQUALS(EventWorkspaceMRU::processHistogramCacheMemory(),
+                       before + 30 * sizeof(double));
+      mru1.clear();
+      TS_ASSERT_EQUALS(EventWorkspaceMRU::processHistogramCacheMemory(),
+                       before + 10 * sizeof(double));
+    }
+    TS_ASSERT_EQUALS(EventWorkspaceMRU::processHistogramCacheMemory(), before);
+
+    // A cache with its own limit does not count
+    EventWorkspaceMRU mru(1024 * 1024);
+    mru.insertHistogram(&el1, makeHistogram(10));
+    TS_ASSERT_EQUALS(EventWorkspaceMRU::processHistogramCacheMemory(), before);
+  }
+
+  void test_idle_cache_gives_memory_to_the_others() {
+    const size_t limit = EventWorkspaceMRU::processHistogramCacheMemoryLimit();
+    const size_t before = EventWorkspaceMRU::processHistogramCacheMemory();
+    // Room for 10 more histograms of 100 bins
+    EventWorkspaceMRU::setProcessHistogramCacheMemoryLimit(
+        before + 10 * 200 * sizeof(double));
+    std::vector<EventList> lists1(10), lists2(10);
+    {
+      EventWorkspaceMRU idle;
+      EventWorkspaceMRU busy;
+      for (const auto &el : lists1)
+        idle.insertHistogram(&el, makeHistogram(100));
+      TS_ASSERT_EQUALS(idle.histogramCacheSize(), 10);
+      // The histograms of the idle cache are the least recently used ones,
+      // even if they are in other shards
+      for (const auto &el : lists2)
+        busy.insertHistogram(&el, makeHistogram(100));
+      TS_ASSERT_EQUALS(busy.histogramCacheSize(), 10);
+      TS_ASSERT_EQUALS(idle.histogramCacheSize(), 0);
+      // Using a histogram keeps it over older ones of other caches
+      busy.findHistogram(&lists2.front());
+      idle.insertHistogram(&lists1.front(), makeHistogram(100));
+      TS_ASSERT(busy.findHistogram(&lists2.front()).y);
+      TS_ASSERT(!busy.findHistogram(&lists2[1]).y);
+      TS_ASSERT(idle.findHistogram(&lists1.front()).y);
+    }
+    EventWorkspaceMRU::setProcessHistogramCacheMemoryLimit(limit);
+    TS_ASSERT_EQUALS(EventWorkspaceMRU::processHistogramCacheMemory(), before);
+  }
+
+  void test_zero_memory_limit_disables_the_cache() {
+    EventWorkspaceMRU mru(0);
+    EventList el;
+    mru.insertHistogram(&el, makeHistogram(10));
+    TS_ASSERT(!mru.findHistogram(&el).y);
+    TS_ASSERT_EQUALS(mru.histogramCacheSize(), 0);
+  }
+
+  void test_eventsReordered_drops_histograms_missing_events() {
+    EventWorkspaceMRU mru(1024 * 1024);
+    EventList el1, el2;
+    mru.insertHistogram(&el1, makeHistogram(10, 3));
+    mru.insertHistogram(&el2, makeHistogram(10, 3));
+    mru.eventsReordered(&el1, 3);
+    mru.eventsReordered(&el2, 4);
+    TS_ASSERT(mru.findHistogram(&el1).y);
+    TS_ASSERT(!mru.findHistogram(&el2).y);
+  }
+
+  void test_clear() {
+    EventWorkspaceMRU mru(1024 * 1024);
+    EventList el;
+    mru.insertHistogram(&el, makeHistogram(10));
+    mru.clear();
+    TS_ASSERT(!mru.findHistogram(&el).y);
+    TS_ASSERT_EQUALS(mru.histogramCacheMemory(), 0);
   }
 };
 
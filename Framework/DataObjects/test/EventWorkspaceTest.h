@@ -522,6 +522,78 @@ public:
     */
   }
 
+  /// Check the cached histograms against histograms generated from scratch
+  void checkCachedHistogram(const EventList &el) {
+    EventList copy(el);
+    MantidVec Y, E;
+    copy.generateHistogram(el.readX(), Y, E);
+    const MantidVec &cachedY = el.readY();
+    const MantidVec &cachedE = el.readE();
+    TS_ASSERT_EQUALS(cachedY.size(), Y.size());
+    TS_ASSERT_EQUALS(cachedE.size(), E.size());
+    for (size_t i = 0; i < std::min(Y.size(), cachedY.size()); ++i) {
+      TS_ASSERT_DELTA(cachedY[i], Y[i], 1e-10);
+      TS_ASSERT_DELTA(cachedE[i], E[i], 1e-10);
+    }
+  }
+
+  void test_histogram_cache_adds_appended_events() {
+    EventList &el = ew->getSpectrum(5);
+    const MantidVec Y0 = el.readY();
+    const MantidVec E0 = el.readE();
+
+    // Appended events are added to the cached histograms
+    el.addEventQuickly(TofEvent(2.5 * BIN_DELTA, 0));
+    el += TofEvent(2.5 * BIN_DELTA, 0);
+    el += std::vector<TofEvent>(3, TofEvent(7.5 * BIN_DELTA, 0));
+    TS_ASSERT_EQUALS(el.readY()[2], Y0[2] + 2.);
+    TS_ASSERT_EQUALS(el.readY()[7], Y0[7] + 3.);
+    TS_ASSERT_DELTA(el.readE()[7], std::sqrt(E0[7] * E0[7] + 3.), 1e-12);
+    checkCachedHistogram(el);
+
+    // Switching to weighted events generates them again
+    el += WeightedEvent(4.5 * BIN_DELTA, 0, 2., 4.);
+    TS_ASSERT_EQUALS(el.readY()[4], Y0[4] + 2.);
+    TS_ASSERT_DELTA(el.readE()[4], std::sqrt(E0[4] * E0[4] + 4.), 1e-12);
+    checkCachedHistogram(el);
+    el += WeightedEvent(4.5 * BIN_DELTA, 0, 1., 1.);
+    TS_ASSERT_EQUALS(el.readY()[4], Y0[4] + 3.);
+    checkCachedHistogram(el);
+  }
+
+  void test_histogram_cache_after_appended_events_are_sorted() {
+    EventList &el = ew->getSpectrum(5);
+    const MantidVec Y0 = el.readY();
+
+    // The appended events are no longer the last ones after sorting
+    el += TofEvent(0.5 * BIN_DELTA, 0);
+    el.sortTof();
+    TS_ASSERT_EQUALS(el.readY()[0], Y0[0] + 1.);
+    checkCachedHistogram(el);
+
+    // Sorting events that are all in the histogram keeps it
+    const MantidVec &Y1 = el.readY();
+    el.sortPulseTime();
+    TS_ASSERT_EQUALS(&Y1, &el.readY());
+  }
+
+  void test_histogram_cache_is_cleared_by_other_changes() {
+    EventList &el = ew->getSpectrum(5);
+    el.readY();
+    // More events than before, with the same bins
+    EventList other(el);
+    other.clear(false);
+    other += std::vector<TofEvent>(3000, TofEvent(1.5 * BIN_DELTA, 0));
+    el = other;
+    TS_ASSERT_EQUALS(el.readY()[1], 3000.);
+    checkCachedHistogram(el);
+
+    ew->clearMRU();
+    el += std::vector<TofEvent>(4, TofEvent(2.5 * BIN_DELTA, 0));
+    TS_ASSERT_EQUALS(el.readY()[2], 4.);
+    checkCachedHistogram(el);
+  }
+
   void test_droppingOffMRU() {
     // Try caching and most-recently-used MRU list.
     EventWorkspace_const_sptr ew2 =
@@ -539,9 +611,10 @@ public:
     for (size_t i = 0; i < 200; i++)
       MantidVec otherData = ew2->readY(i);
 
-    // data0 and e300 are now invalid references!
-    TS_ASSERT_DIFFERS(&data0, &inSpec.readY());
-    TS_ASSERT_DIFFERS(&e300, &inSpec.readE());
+    // data0 and e300 dropped off the MRU, but the histograms are still in the
+    // histogram cache and are not generated again
+    TS_ASSERT_EQUALS(&data0, &inSpec.readY());
+    TS_ASSERT_EQUALS(&e300, &inSpec300.readE());
 
     // MRU is full
     TS_ASSERT_EQUALS(ew2->MRUSize(), 50);
@@ -0,0 +1,77 @@
+#ifndef MANTID_DATAOBJECTS_FRACTIONALREBINNINGTEST_H_
+#define MANTID_DATAOBJECTS_FRACTIONALREBINNINGTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/FractionalRebinning.h"
+#include "MantidDataObjects/Workspace2D.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <cmath>
+
+using namespace Mantid::DataObjects;
+using Mantid::DataObjects::FractionalRebinning::PartialOutputs;
+using Mantid::SpectrumDefinition;
+
+class FractionalRebinningTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static FractionalRebinningTest *createSuite() {
+    return new FractionalRebinningTest();
+  }
+  static void destroySuite(FractionalRebinningTest *suite) { delete suite; }
+
+  void test_PartialOutputs_blocks_cover_the_input_in_order() {
+    auto outputWS = WorkspaceCreationHelper::create2DWorkspaceBinned(3, 4);
+    constexpr size_t inputSize(10);
+    const PartialOutputs partials(*outputWS, inputSize, true);
+
+    const int nBlocks = partials.numberOfBlocks();
+    TS_ASSERT_LESS_THAN_EQUALS(1, nBlocks);
+    TS_ASSERT_EQUALS(partials.blockBegin(0), 0);
+    for (int block = 1; block < nBlocks; ++block)
+      TS_ASSERT_EQUALS(partials.blockBegin(block),
+                       partials.blockEnd(block - 1));
+    TS_ASSERT_EQUALS(partials.blockEnd(nBlocks - 1), inputSize);
+  }
+
+  void test_PartialOutputs_has_one_block_if_not_parallel() {
+    auto outputWS = WorkspaceCreationHelper::create2DWorkspaceBinned(3, 4);
+    const PartialOutputs partials(*outputWS, 10, false);
+    TS_ASSERT_EQUALS(partials.numberOfBlocks(), 1);
+  }
+
+  void test_PartialOutputs_has_one_block_per_thread() {
+    auto outputWS = WorkspaceCreationHelper::create2DWorkspaceBinned(3, 4);
+    const int nThreads = PARALLEL_GET_MAX_THREADS;
+    const PartialOutputs partials(*outputWS, 1000, true);
+    TS_ASSERT_EQUALS(partials.numberOfBlocks(), nThreads);
+    // But no more blocks than items in the input
+    const PartialOutputs small(*outputWS, 1, true);
+    TS_ASSERT_EQUALS(small.numberOfBlocks(), 1);
+  }
+
+  void test_PartialOutputs_add_their_sums_and_mappings_to_the_output() {
+    auto outputWS = WorkspaceCreationHelper::create2DWorkspaceBinned(3, 4);
+    constexpr bool withMapping(true);
+    PartialOutputs partials(*outputWS, 10, false, withMapping);
+    partials.initBlock(0).add(1, 2, 3., 4., 0.);
+    partials.mapping(0)[1].add(7);
+
+    partials.addTo(*outputWS);
+    std::vector<SpectrumDefinition> mapping(3);
+    partials.addMappingsTo(mapping);
+
+    TS_ASSERT_EQUALS(outputWS->y(1)[2], 5.);
+    TS_ASSERT_DELTA(outputWS->e(1)[2], M_SQRT2 + 4., 1e-12);
+    TS_ASSERT_EQUALS(outputWS->y(0)[2], 2.);
+    TS_ASSERT_EQUALS(outputWS->y(1)[1], 2.);
+    TS_ASSERT_EQUALS(mapping[0].size(), 0);
+    TS_ASSERT_EQUALS(mapping[1].size(), 1);
+    TS_ASSERT_EQUALS(mapping[1][0].first, 7);
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_FRACTIONALREBINNINGTEST_H_ */
@@ -21,6 +21,7 @@
 #include "MantidKernel/WarningSuppressions.h"
 #include "MantidTestHelpers/MDEventsTestHelper.h"
 #include <Poco/File.h>
+#include <array>
 #include <cmath>
 #include <cxxtest/TestSuite.h>
 #include <gmock/gmock.h>
@@ -500,6 +501,77 @@ public:
     delete bcc;
   }
 
+  void test_addEvents_with_recursive_gridding() {
+    // 10x10 box, extents 0-10.0, with the 0-th box further split
+    MDGridBox<MDLeanEvent<2>, 2> *superbox =
+        MDEventsTestHelper::makeMDGridBox<2>();
+    TS_ASSERT_THROWS_NOTHING(superbox->splitContents(0));
+
+    std::vector<MDLeanEvent<2>> events;
+    for (const auto &center : std::vector<std::array<coord_t, 2>>{
+             {{0.05f, 0.05f}},
+             {{9.5f, 9.5f}},
+             {{0.15f, 0.05f}},
+             {{0.05f, 0.05f}},
+             {{10.5f, 0.05f}}}) {
+      events.emplace_back(2.0f, 2.0f, center.data());
+    }
+    // The last one is out of bounds
+    TS_ASSERT_EQUALS(superbox->addEvents(events), 1);
+    superbox->refreshCache(nullptr);
+    TS_ASSERT_EQUALS(superbox->getNPoints(), 4);
+
+    auto boxes = superbox->getBoxes();
+    auto gb = dynamic_cast<MDGridBox<MDLeanEvent<2>, 2> *>(boxes[0]);
+    TS_ASSERT(gb);
+    if (!gb)
+      return;
+    TS_ASSERT_EQUALS(gb->getNPoints(), 3);
+    TS_ASSERT_EQUALS(gb->getBoxes()[0]->getNPoints(), 2);
+    TS_ASSERT_EQUALS(gb->getBoxes()[1]->getNPoints(), 1);
+    TS_ASSERT_EQUALS(boxes[99]->getNPoints(), 1);
+
+    BoxController *const bcc = superbox->getBoxController();
+    delete superbox;
+    delete bcc;
+  }
+
+  void test_addEvents_in_parallel_with_recursive_gridding() {
+    MDGridBox<MDLeanEvent<2>, 2> *superbox =
+        MDEventsTestHelper::makeMDGridBox<2>();
+    superbox->splitContents(0);
+    superbox->splitContents(55);
+    const int numRepeat = 200;
+
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < numRepeat; i++) {
+      std::vector<MDLeanEvent<2>> events;
+      // Several events in each box, mostly in the split ones
+      for (int j = 0; j < 100; j++) {
+        const coord_t x = 0.05f + 0.1f * static_cast<coord_t>(j);
+        coord_t centers[2] = {x, x};
+        events.emplace_back(1.0f, 1.0f, centers);
+      }
+      for (int j = 0; j < 10; j++) {
+        const coord_t x = 5.05f + 0.1f * static_cast<coord_t>(j);
+        coord_t centers[2] = {x, 5.5f};
+        events.emplace_back(1.0f, 1.0f, centers);
+        centers[0] = 0.05f + 0.1f * static_cast<coord_t>(j);
+        centers[1] = 0.35f;
+        events.emplace_back(1.0f, 1.0f, centers);
+      }
+      superbox->addEvents(events);
+    }
+
+    superbox->refreshCache(nullptr);
+    TS_ASSERT_EQUALS(superbox->getNPoints(), 120 * numRepeat);
+    TS_ASSERT_EQUALS(superbox->getSignal(), 120 * numRepeat);
+
+    BoxController *const bcc = superbox->getBoxController();
+    delete superbox;
+    delete bcc;
+  }
+
   //-------------------------------------------------------------------------------------
   void test_transformDimensions() {
     MDBox<MDLeanEvent<1>, 1> *b = MDEventsTestHelper::makeMDBox1();
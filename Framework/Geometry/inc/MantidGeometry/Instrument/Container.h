@@ -74,6 +74,9 @@ public:
   int interceptSurface(Geometry::Track &t) const override {
     return m_shape->interceptSurface(t);
   }
+  int interceptSurfaces(std::vector<Geometry::Track> &tracks) const override {
+    return m_shape->interceptSurfaces(tracks);
+  }
   double solidAngle(const Kernel::V3D &observer) const override {
     return m_shape->solidAngle(observer);
   }
@@ -9,6 +9,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include <mutex>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -22,6 +23,7 @@ class SpectrumInfo;
 }
 namespace Geometry {
 class IDetector;
+class Parameter;
 class Instrument;
 
 /** Geometry::DetectorInfo is an intermediate step towards a DetectorInfo that
@@ -115,6 +117,17 @@ public:
   double l1() const;
 
   const std::vector<detid_t> &detectorIDs() const;
+
+  boost::shared_ptr<const std::vector<boost::shared_ptr<Parameter>>>
+  parameters(const std::string &name) const;
+
+  boost::shared_ptr<const std::vector<double>> l2s() const;
+  boost::shared_ptr<const std::vector<double>> twoThetas() const;
+  boost::shared_ptr<const std::vector<double>> azimuths() const;
+  boost::shared_ptr<const std::vector<double>> difcs() const;
+  boost::shared_ptr<const std::vector<double>> solidAngles() const;
+  size_t geometryRevision() const;
+
   /// Returns the index of the detector with the given detector ID.
   /// This will throw an out of range exception if the detector does not exist.
   size_t indexOf(const detid_t id) const { return m_detIDToIndex->at(id); }
@@ -134,6 +147,16 @@ public:
   friend class Instrument;
 
 private:
+  /// An array of a quantity derived from the geometry, for all detectors
+  struct GeometryArray {
+    /// Geometry revision the values were computed for
+    size_t revision{0};
+    boost::shared_ptr<const std::vector<double>> values;
+  };
+  template <class Compute>
+  boost::shared_ptr<const std::vector<double>>
+  geometryArray(GeometryArray &array, const Compute &compute) const;
+
   const Geometry::IDetector &getDetector(const size_t index) const;
   boost::shared_ptr<const Geometry::IDetector>
   getDetectorPtr(const size_t index) const;
@@ -148,6 +171,13 @@ private:
   mutable std::vector<boost::shared_ptr<const Geometry::IDetector>>
       m_lastDetector;
   mutable std::vector<size_t> m_lastIndex;
+
+  mutable GeometryArray m_l2s;
+  mutable GeometryArray m_twoThetas;
+  mutable GeometryArray m_azimuths;
+  mutable GeometryArray m_difcs;
+  mutable GeometryArray m_solidAngles;
+  mutable std::mutex m_geometryArrayMutex;
 };
 
 } // namespace Geometry
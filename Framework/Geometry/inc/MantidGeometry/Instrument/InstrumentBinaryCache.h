@@ -0,0 +1,82 @@
+#ifndef MANTID_GEOMETRY_INSTRUMENTBINARYCACHE_H_
+#define MANTID_GEOMETRY_INSTRUMENTBINARYCACHE_H_
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidGeometry/Instrument_fwd.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace Mantid {
+namespace Geometry {
+class IObject;
+
+/** InstrumentBinaryCache : A file holding an instrument built from an IDF, so
+  that a later process can rebuild it without parsing the XML.
+
+  The file holds the component tree with the positions, rotations and
+  detector IDs, the shapes of the types as XML, the source, sample, monitors
+  and chopper points, the parameters of the IDF and the defaults of the
+  instrument. It is keyed by the checksum of the IDF, the version of the
+  format and the revision of Mantid: a file written from another IDF, or by
+  a build whose parser may have built the instrument differently, is ignored.
+  The file is memory-mapped to be read.
+
+  Only the component classes created by the InstrumentDefinitionParser are
+  supported, except StructuredDetector, and only CSGObject shapes. Instruments
+  with neutronic positions are not cached either: save() returns false for
+  all of these and the IDF is parsed every time.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_GEOMETRY_DLL InstrumentBinaryCache {
+public:
+  /// Shapes of the types of an IDF, by type name
+  using TypeShapes = std::map<std::string, boost::shared_ptr<IObject>>;
+
+  /// Version of the format, to increase whenever the format changes
+  static const uint32_t VERSION;
+
+  InstrumentBinaryCache(const std::string &filename,
+                        const std::string &checksum);
+
+  /// Path of the file
+  const std::string &filename() const { return m_filename; }
+  bool exists() const;
+
+  bool save(const Instrument &instrument, const TypeShapes &typeShapes) const;
+  bool load(Instrument &instrument, TypeShapes &typeShapes) const;
+
+private:
+  /// Path of the file
+  std::string m_filename;
+  /// Checksum of the IDF the instrument was built from
+  std::string m_checksum;
+};
+
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_INSTRUMENTBINARYCACHE_H_ */
@@ -25,6 +25,7 @@ namespace Geometry {
 class ICompAssembly;
 class IComponent;
 class Instrument;
+class InstrumentBinaryCache;
 class ObjComponent;
 class IObject;
 class ShapeFactory;
@@ -305,6 +306,15 @@ private:
   CachingOption writeAndApplyCache(IDFObject_const_sptr firstChoiceCache,
                                    IDFObject_const_sptr fallBackCache);
 
+  /// Directories of the binary instrument cache
+  std::vector<std::string> binaryCacheDirectories() const;
+  /// The binary instrument cache in a directory
+  InstrumentBinaryCache binaryCache(const std::string &directory);
+  /// Replace the instrument with the one in the binary instrument cache
+  bool loadBinaryCache();
+  /// Write the instrument to the binary instrument cache
+  void saveBinaryCache();
+
   /// This method returns the parent appended which its child components and
   /// also name of type of the last child component
   std::string getShapeCoorSysComp(
@@ -9,7 +9,9 @@
 
 #include "tbb/concurrent_unordered_map.h"
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <typeinfo>
 
@@ -71,6 +73,8 @@ public:
   /// Parameter map iterator typedef
   using pmap_cit = tbb::concurrent_unordered_multimap<
       ComponentID, boost::shared_ptr<Parameter>>::const_iterator;
+  /// Parameters of the detectors, by detector index
+  using DetectorParameters = std::vector<boost::shared_ptr<Parameter>>;
   /// Default constructor
   ParameterMap();
   /// Const constructor
@@ -109,12 +113,15 @@ public:
   inline void clear() {
     m_map.clear();
     clearPositionSensitiveCaches();
+    clearDetectorParameters();
   }
   /// method swaps two parameter maps contents  each other. All caches contents
   /// is nullified (TO DO: it can be efficiently swapped too)
   void swap(ParameterMap &other) {
     m_map.swap(other.m_map);
     clearPositionSensitiveCaches();
+    clearDetectorParameters();
+    other.clearDetectorParameters();
   }
   /// Clear any parameters with the given name
   void clearParametersByName(const std::string &name);
@@ -238,6 +245,10 @@ public:
   /// a parameter with a specified type.
   boost::shared_ptr<Parameter>
   getRecursiveByType(const IComponent *comp, const std::string &type) const;
+  /// Use getRecursive() once per component to find a parameter of all the
+  /// detectors
+  boost::shared_ptr<const DetectorParameters>
+  detectorParameters(const std::string &name) const;
 
   /** Get the values of a given parameter of all the components that have the
    * name: compName
@@ -307,6 +318,8 @@ public:
 
   /// Clears the location, rotation & bounding box caches
   void clearPositionSensitiveCaches();
+  /// Clears the tables returned by detectorParameters()
+  void clearDetectorParameters();
   /// Sets a cached location on the location cache
   void setCachedLocation(const IComponent *comp,
                          const Kernel::V3D &location) const;
@@ -371,6 +384,11 @@ private:
   std::unique_ptr<Kernel::Cache<const ComponentID, Kernel::V3D>> m_cacheLocMap;
   /// internal cache map instance for cached rotation values
   std::unique_ptr<Kernel::Cache<const ComponentID, Kernel::Quat>> m_cacheRotMap;
+  /// Tables of the parameters of the detectors, by parameter name
+  mutable std::map<std::string, boost::shared_ptr<const DetectorParameters>>
+      m_detectorParameters;
+  /// Mutex for the tables of the parameters of the detectors
+  mutable std::mutex m_detectorParametersMutex;
 
   /// Pointer to the DetectorInfo wrapper. NULL unless the instrument is
   /// associated with an ExperimentInfo object.
@@ -143,6 +143,7 @@ public:
 
   // INTERSECTION
   int interceptSurface(Geometry::Track &) const override;
+  int interceptSurfaces(std::vector<Geometry::Track> &) const override;
 
   // Solid angle - uses triangleSolidAngle unless many (>30000) triangles
   double solidAngle(const Kernel::V3D &observer) const override;
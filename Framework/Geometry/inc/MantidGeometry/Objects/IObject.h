@@ -70,6 +70,8 @@ public:
   virtual int getName() const = 0;
 
   virtual int interceptSurface(Geometry::Track &) const = 0;
+  /// Intercept a batch of tracks
+  virtual int interceptSurfaces(std::vector<Geometry::Track> &) const = 0;
   // Solid angle
   virtual double solidAngle(const Kernel::V3D &observer) const = 0;
   // Solid angle with a scaling of the object
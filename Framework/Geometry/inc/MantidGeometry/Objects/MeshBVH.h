@@ -0,0 +1,89 @@
+#ifndef MANTID_GEOMETRY_MESHBVH_H_
+#define MANTID_GEOMETRY_MESHBVH_H_
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/V3D.h"
+
+#include <boost/container/small_vector.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+namespace detail {
+
+/** MeshBVH : A bounding volume hierarchy over the triangles of a mesh.
+
+  The triangles are split recursively in two halves along the longest axis of
+  the box of their centres, down to a few triangles per leaf. A ray is then
+  only tested against the triangles of the leaves whose boxes it crosses.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_GEOMETRY_DLL MeshBVH {
+public:
+  /// Indices of the triangles a ray may cross
+  using Candidates = boost::container::small_vector<uint32_t, 32>;
+
+  MeshBVH() = default;
+  MeshBVH(const std::vector<uint16_t> &triangles,
+          const std::vector<Kernel::V3D> &vertices);
+
+  /// Find the triangles whose boxes the ray from start crosses
+  void trianglesOnRay(const Kernel::V3D &start, const Kernel::V3D &direction,
+                      Candidates &candidates) const;
+  /// Number of nodes of the tree
+  size_t numberOfNodes() const { return m_nodes.size(); }
+
+private:
+  struct Node {
+    std::array<double, 3> min;
+    std::array<double, 3> max;
+    /// First index in m_triangles of the triangles of a leaf
+    uint32_t first;
+    /// Number of triangles of a leaf, 0 for the other nodes
+    uint32_t count;
+    /// Index of the second child. The first one follows the node.
+    uint32_t second;
+  };
+
+  uint32_t build(const std::vector<std::array<double, 3>> &centres,
+                 const std::vector<Node> &boxes, uint32_t first,
+                 uint32_t last);
+  bool rayCrossesNode(const Node &node, const Kernel::V3D &start,
+                      const Kernel::V3D &direction) const;
+
+  /// The nodes, each followed by its first child
+  std::vector<Node> m_nodes;
+  /// Triangle indices, ordered so that each leaf has a contiguous range
+  std::vector<uint32_t> m_triangles;
+  /// Margin added to the boxes for the rounding errors of the ray tests
+  double m_margin = 0.;
+};
+
+} // namespace detail
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_MESHBVH_H_ */
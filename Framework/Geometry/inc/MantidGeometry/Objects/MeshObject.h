@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------
 #include "MantidGeometry/DllConfig.h"
 #include "MantidGeometry/Objects/IObject.h"
+#include "MantidGeometry/Objects/MeshBVH.h"
 #include "MantidKernel/Material.h"
 #include "MantidGeometry/Rendering/ShapeInfo.h"
 #include "BoundingBox.h"
@@ -102,6 +103,7 @@ public:
 
   // INTERSECTION
   int interceptSurface(Geometry::Track &) const override;
+  int interceptSurfaces(std::vector<Geometry::Track> &) const override;
 
   // Solid angle - uses triangleSolidAngle unless many (>30000) triangles
   double solidAngle(const Kernel::V3D &observer) const override;
@@ -151,18 +153,20 @@ public:
 
   void updateGeometryHandler();
 
+  /// Determine intersection between ray and an one triangle
+  static bool rayIntersectsTriangle(const Kernel::V3D &start,
+                                    const Kernel::V3D &direction,
+                                    const Kernel::V3D &v1,
+                                    const Kernel::V3D &v2,
+                                    const Kernel::V3D &v3,
+                                    Kernel::V3D &intersection, int &entryExit);
+
 private:
   void initialize();
   /// Get intersections
   void getIntersections(const Kernel::V3D &start, const Kernel::V3D &direction,
                         std::vector<Kernel::V3D> &intersectionPoints,
                         std::vector<int> &entryExitFlags) const;
-  /// Determine intersection between ray and an one triangle
-  bool rayIntersectsTriangle(const Kernel::V3D &start,
-                             const Kernel::V3D &direction,
-                             const Kernel::V3D &v1, const Kernel::V3D &v2,
-                             const Kernel::V3D &v3, Kernel::V3D &intersection,
-                             int &entryExit) const;
   /// Get triangle
   bool getTriangle(const size_t index, Kernel::V3D &v1, Kernel::V3D &v2,
                    Kernel::V3D &v3) const;
@@ -193,6 +197,8 @@ private:
   /// Triangles are specified by indices into a list of vertices.
   std::vector<uint16_t> m_triangles;
   std::vector<Kernel::V3D> m_vertices;
+  /// Hierarchy of the triangles to find the ones a ray may cross
+  detail::MeshBVH m_bvh;
   /// material composition
   Kernel::Material m_material;
 };
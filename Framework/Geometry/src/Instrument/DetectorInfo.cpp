@@ -1,6 +1,7 @@
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/Detector.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
 #include "MantidBeamline/DetectorInfo.h"
 #include "MantidKernel/EigenConversionHelpers.h"
@@ -8,6 +9,11 @@
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/make_unique.h"
 
+#include <boost/make_shared.hpp>
+
+#include <cmath>
+#include <limits>
+
 namespace Mantid {
 namespace Geometry {
 
@@ -320,6 +326,106 @@ const std::vector<detid_t> &DetectorInfo::detectorIDs() const {
   return *m_detectorIDs;
 }
 
+/** Returns a parameter of all the detectors, found by looking up the
+ * component tree like ParameterMap::getRecursive(). The table is kept by the
+ * ParameterMap until a parameter changes, so get it once before a loop over
+ * detectors rather than once per detector.
+ * @param name :: The name of the parameter
+ * @return the parameters by detector index, null for the detectors without
+ * the parameter
+ */
+boost::shared_ptr<const std::vector<boost::shared_ptr<Parameter>>>
+DetectorInfo::parameters(const std::string &name) const {
+  // A base instrument has no parameters
+  if (!m_instrument->isParametrized())
+    return boost::make_shared<
+        const std::vector<boost::shared_ptr<Parameter>>>(size());
+  return m_instrument->getParameterMap()->detectorParameters(name);
+}
+
+/** Returns L2 of all detectors, by detector index, as given by l2().
+ *
+ * The array is computed once and kept until a position or rotation changes,
+ * so get it once before a loop over detectors rather than calling l2() for
+ * every detector. Not available for scanning instruments. */
+boost::shared_ptr<const std::vector<double>> DetectorInfo::l2s() const {
+  return geometryArray(m_l2s, [this](std::vector<double> &l2s) {
+    const auto sourcePos = sourcePosition();
+    const auto samplePos = samplePosition();
+    const auto l1 = this->l1();
+    for (size_t i = 0; i < l2s.size(); ++i) {
+      const auto pos = position(i);
+      l2s[i] = isMonitor(i) ? pos.distance(sourcePos) - l1
+                            : pos.distance(samplePos);
+    }
+  });
+}
+
+/** Returns 2 theta of all detectors, by detector index, as given by
+ * twoTheta(). The value is NaN for monitors. See l2s() for the lifetime of the
+ * array. */
+boost::shared_ptr<const std::vector<double>> DetectorInfo::twoThetas() const {
+  return geometryArray(m_twoThetas, [this](std::vector<double> &twoThetas) {
+    const auto samplePos = samplePosition();
+    const auto beamLine = samplePos - sourcePosition();
+    if (beamLine.nullVector())
+      throw Kernel::Exception::InstrumentDefinitionError(
+          "Source and sample are at same position!");
+    for (size_t i = 0; i < twoThetas.size(); ++i)
+      twoThetas[i] = isMonitor(i)
+                         ? std::numeric_limits<double>::quiet_NaN()
+                         : (position(i) - samplePos).angle(beamLine);
+  });
+}
+
+/** Returns the azimuthal angle of all detectors, by detector index, in
+ * radians. This is the angle of the position in the XY plane, as given by
+ * IDetector::getPhi(). See l2s() for the lifetime of the array. */
+boost::shared_ptr<const std::vector<double>> DetectorInfo::azimuths() const {
+  return geometryArray(m_azimuths, [this](std::vector<double> &azimuths) {
+    for (size_t i = 0; i < azimuths.size(); ++i) {
+      const auto pos = position(i);
+      azimuths[i] = std::atan2(pos.Y(), pos.X());
+    }
+  });
+}
+
+/** Returns DIFC, the factor converting d-spacing to time of flight, of all
+ * detectors, by detector index. The value is NaN for monitors. See l2s() for
+ * the lifetime of the array. */
+boost::shared_ptr<const std::vector<double>> DetectorInfo::difcs() const {
+  // Get these before locking, geometryArray() is not reentrant
+  const auto l2s = this->l2s();
+  const auto twoThetas = this->twoThetas();
+  return geometryArray(
+      m_difcs, [this, &l2s, &twoThetas](std::vector<double> &difcs) {
+        const auto l1 = this->l1();
+        for (size_t i = 0; i < difcs.size(); ++i)
+          difcs[i] = isMonitor(i) ? std::numeric_limits<double>::quiet_NaN()
+                                  : 1. / Conversion::tofToDSpacingFactor(
+                                             l1, (*l2s)[i], (*twoThetas)[i],
+                                             0.);
+      });
+}
+
+/** Returns the solid angle of all detectors seen from the sample, by detector
+ * index. See l2s() for the lifetime of the array. */
+boost::shared_ptr<const std::vector<double>>
+DetectorInfo::solidAngles() const {
+  return geometryArray(m_solidAngles, [this](std::vector<double> &angles) {
+    const auto samplePos = samplePosition();
+    for (size_t i = 0; i < angles.size(); ++i)
+      angles[i] = getDetector(i).solidAngle(samplePos);
+  });
+}
+
+/** Returns a number that changes whenever a position, rotation or scale
+ * factor in the instrument changes. Can be used to key caches of quantities
+ * derived from the geometry. */
+size_t DetectorInfo::geometryRevision() const {
+  return m_detectorInfo->geometryRevision();
+}
+
 /// Returns the scan count of the detector with given detector index.
 size_t DetectorInfo::scanCount(const size_t index) const {
   return m_detectorInfo->scanCount(index);
@@ -369,6 +475,27 @@ void DetectorInfo::merge(const DetectorInfo &other) {
   m_detectorInfo->merge(*other.m_detectorInfo);
 }
 
+/// Returns the values in `array`, computing them with `compute` if the
+/// geometry changed since they were last computed.
+template <class Compute>
+boost::shared_ptr<const std::vector<double>>
+DetectorInfo::geometryArray(GeometryArray &array,
+                            const Compute &compute) const {
+  if (isScanning())
+    throw std::runtime_error("DetectorInfo: Arrays of quantities derived from "
+                             "the geometry are not available for scanning "
+                             "instruments.");
+  std::lock_guard<std::mutex> lock(m_geometryArrayMutex);
+  const auto revision = geometryRevision();
+  if (!array.values || array.revision != revision) {
+    auto values = boost::make_shared<std::vector<double>>(size());
+    compute(*values);
+    array.values = std::move(values);
+    array.revision = revision;
+  }
+  return array.values;
+}
+
 const Geometry::IDetector &DetectorInfo::getDetector(const size_t index) const {
   size_t thread = static_cast<size_t>(PARALLEL_THREAD_NUMBER);
   if (m_lastIndex[thread] != index) {
@@ -0,0 +1,703 @@
+#include "MantidGeometry/Instrument/InstrumentBinaryCache.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/ObjCompAssembly.h"
+#include "MantidGeometry/Instrument/RectangularDetector.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Instrument/XMLInstrumentParameter.h"
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/ShapeFactory.h"
+#include "MantidKernel/Interpolation.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/MantidVersion.h"
+
+#include <Poco/File.h>
+#include <Poco/Process.h>
+#include <Poco/SharedMemory.h>
+
+#include <boost/make_shared.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Mantid {
+namespace Geometry {
+
+using Kernel::Quat;
+using Kernel::V3D;
+
+const uint32_t InstrumentBinaryCache::VERSION = 2;
+
+namespace {
+/// static logger
+Kernel::Logger g_log("InstrumentBinaryCache");
+
+/// First bytes of a cache file
+const char MAGIC[8] = {'M', 'T', 'D', 'I', 'N', 'S', 'T', 'R'};
+/// Written in the native byte order, to detect files from other platforms
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+/// Index of a missing component or shape
+const int32_t NONE = -1;
+
+/// The records of the component tree
+enum class Kind : uint8_t {
+  Assembly,
+  ObjAssembly,
+  ObjComponent,
+  Detector,
+  Rectangular,
+  /// A component created by its RectangularDetector
+  Generated
+};
+
+/// What a detector is marked as in the instrument
+enum class Role : uint8_t { None, Detector, Monitor };
+
+/// Writes values in their native binary representation
+class Writer {
+public:
+  explicit Writer(std::ostream &out) : m_out(out) {}
+  template <typename T> void write(const T &value) {
+    m_out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+  void write(const std::string &value) {
+    write(static_cast<uint64_t>(value.size()));
+    m_out.write(value.data(), value.size());
+  }
+  void write(const V3D &value) {
+    for (size_t i = 0; i < 3; ++i)
+      write(value[i]);
+  }
+  void write(const Quat &value) {
+    for (int i = 0; i < 4; ++i)
+      write(value[i]);
+  }
+
+private:
+  std::ostream &m_out;
+};
+
+/// Reads the values written by Writer from memory
+class Reader {
+public:
+  Reader(const char *begin, const char *end) : m_pos(begin), m_end(end) {}
+  template <typename T> T read() {
+    check(sizeof(T));
+    T value;
+    std::memcpy(&value, m_pos, sizeof(T));
+    m_pos += sizeof(T);
+    return value;
+  }
+  std::string readString() {
+    const auto size = read<uint64_t>();
+    check(size);
+    std::string value(m_pos, static_cast<size_t>(size));
+    m_pos += size;
+    return value;
+  }
+  V3D readV3D() {
+    V3D value;
+    for (size_t i = 0; i < 3; ++i)
+      value[i] = read<double>();
+    return value;
+  }
+  Quat readQuat() {
+    Quat value;
+    for (int i = 0; i < 4; ++i)
+      value[i] = read<double>();
+    return value;
+  }
+
+private:
+  void check(const uint64_t size) const {
+    if (size > static_cast<uint64_t>(m_end - m_pos))
+      throw std::runtime_error("The instrument cache file is truncated");
+  }
+  const char *m_pos;
+  const char *m_end;
+};
+
+/// A component to write, in the order of a depth-first walk of the tree
+struct Record {
+  const IComponent *component;
+  int32_t parent;
+  Kind kind;
+};
+
+/// Numbers the components and shapes of an instrument to write them
+class Collector {
+public:
+  explicit Collector(const Instrument &instrument) {
+    m_indices[&instrument] = 0;
+    detid2det_map detectors;
+    instrument.getDetectors(detectors);
+    for (const auto &detector : detectors)
+      m_detectors.insert(detector.second.get());
+    for (const auto id : instrument.getMonitors())
+      m_monitors.insert(id);
+  }
+
+  /// Add the children of an assembly. @return false if one is not supported
+  bool addChildren(const ICompAssembly &assembly, const int32_t parent,
+                   const bool generated) {
+    for (int i = 0; i < assembly.nelements(); ++i) {
+      if (!add(*assembly.getChild(i), parent, generated))
+        return false;
+    }
+    return true;
+  }
+
+  /// @return the index of a shape, numbering it if needed, or NONE
+  int32_t shapeIndex(const IObject *shape) {
+    if (!shape)
+      return NONE;
+    const auto found = m_shapeIndices.find(shape);
+    if (found != m_shapeIndices.end())
+      return found->second;
+    const auto index = static_cast<int32_t>(m_shapes.size());
+    m_shapes.push_back(shape);
+    m_shapeIndices[shape] = index;
+    return index;
+  }
+
+  /// @return the index of a component, or NONE if it is not in the tree
+  int32_t componentIndex(const IComponent *component) const {
+    const auto found = m_indices.find(component);
+    return found == m_indices.end() ? NONE : found->second;
+  }
+
+  /// @return what a detector is marked as in the instrument
+  Role role(const IComponent &component) const {
+    const auto detector = dynamic_cast<const IDetector *>(&component);
+    if (!detector)
+      return Role::None;
+    if (m_monitors.count(detector->getID()) > 0)
+      return Role::Monitor;
+    return m_detectors.count(detector) > 0 ? Role::Detector : Role::None;
+  }
+
+  const std::vector<Record> &records() const { return m_records; }
+  const std::vector<const IObject *> &shapes() const { return m_shapes; }
+
+private:
+  bool add(const IComponent &component, const int32_t parent,
+           const bool generated) {
+    Kind kind;
+    const auto &type = typeid(component);
+    if (generated)
+      kind = Kind::Generated;
+    else if (type == typeid(CompAssembly))
+      kind = Kind::Assembly;
+    else if (type == typeid(ObjCompAssembly))
+      kind = Kind::ObjAssembly;
+    else if (type == typeid(ObjComponent))
+      kind = Kind::ObjComponent;
+    else if (type == typeid(Detector))
+      kind = Kind::Detector;
+    else if (type == typeid(RectangularDetector))
+      kind = Kind::Rectangular;
+    else {
+      g_log.debug() << "Components of type " << component.type()
+                    << " cannot be cached\n";
+      return false;
+    }
+
+    const auto index = static_cast<int32_t>(m_records.size() + 1);
+    m_indices[&component] = index;
+    m_records.push_back({&component, parent, kind});
+    if (kind == Kind::ObjAssembly || kind == Kind::ObjComponent ||
+        kind == Kind::Detector) {
+      const auto &objComponent = dynamic_cast<const IObjComponent &>(component);
+      if (!isSupported(objComponent.shape().get()))
+        return false;
+    }
+    if (kind == Kind::Rectangular) {
+      const auto &bank = dynamic_cast<const RectangularDetector &>(component);
+      if (bank.xpixels() <= 0 || bank.ypixels() <= 0 ||
+          !isSupported(bank.getAtXY(0, 0)->shape().get()))
+        return false;
+    }
+
+    if (const auto assembly = dynamic_cast<const ICompAssembly *>(&component))
+      return addChildren(*assembly, index,
+                         generated || kind == Kind::Rectangular);
+    return true;
+  }
+
+  /// Only shapes defined in XML can be cached
+  bool isSupported(const IObject *shape) {
+    if (shape && !dynamic_cast<const CSGObject *>(shape))
+      return false;
+    shapeIndex(shape);
+    return true;
+  }
+
+  std::vector<Record> m_records;
+  std::unordered_map<const IComponent *, int32_t> m_indices;
+  std::vector<const IObject *> m_shapes;
+  std::unordered_map<const IObject *, int32_t> m_shapeIndices;
+  std::unordered_set<const IDetector *> m_detectors;
+  std::unordered_set<detid_t> m_monitors;
+};
+
+/// Write the axes of the reference frame
+void writeReferenceFrame(Writer &writer, const ReferenceFrame &frame) {
+  writer.write(static_cast<int32_t>(frame.pointingUp()));
+  writer.write(static_cast<int32_t>(frame.pointingAlongBeam()));
+  const V3D thetaSign = frame.vecThetaSign();
+  int32_t thetaSignAxis(Z);
+  if (thetaSign.X() != 0.)
+    thetaSignAxis = X;
+  else if (thetaSign.Y() != 0.)
+    thetaSignAxis = Y;
+  writer.write(thetaSignAxis);
+  writer.write(static_cast<int32_t>(frame.getHandedness()));
+  writer.write(frame.origin());
+}
+
+/// Write a parameter of the IDF and the index of its component
+void writeParameter(Writer &writer, const Collector &collector,
+                    const XMLInstrumentParameter &parameter) {
+  writer.write(parameter.m_logfileID);
+  writer.write(parameter.m_value);
+  writer.write(parameter.m_paramName);
+  writer.write(parameter.m_type);
+  writer.write(parameter.m_tie);
+  writer.write(static_cast<uint64_t>(parameter.m_constraint.size()));
+  for (const auto &constraint : parameter.m_constraint)
+    writer.write(constraint);
+  writer.write(parameter.m_penaltyFactor);
+  writer.write(parameter.m_fittingFunction);
+  writer.write(parameter.m_formula);
+  writer.write(parameter.m_formulaUnit);
+  writer.write(parameter.m_resultUnit);
+  writer.write(static_cast<bool>(parameter.m_interpolation));
+  if (parameter.m_interpolation) {
+    std::ostringstream interpolation;
+    interpolation.precision(17);
+    interpolation << *parameter.m_interpolation;
+    writer.write(interpolation.str());
+  }
+  writer.write(parameter.m_extractSingleValueAs);
+  writer.write(parameter.m_eq);
+  writer.write(collector.componentIndex(parameter.m_component));
+  writer.write(parameter.m_angleConvertConst);
+  writer.write(parameter.m_description);
+}
+
+/// Read a parameter written by writeParameter
+boost::shared_ptr<XMLInstrumentParameter>
+readParameter(Reader &reader, const std::vector<IComponent *> &components) {
+  const auto logfileID = reader.readString();
+  const auto value = reader.readString();
+  const auto paramName = reader.readString();
+  const auto type = reader.readString();
+  const auto tie = reader.readString();
+  std::vector<std::string> constraint(
+      static_cast<size_t>(reader.read<uint64_t>()));
+  for (auto &item : constraint)
+    item = reader.readString();
+  auto penaltyFactor = reader.readString();
+  const auto fittingFunction = reader.readString();
+  const auto formula = reader.readString();
+  const auto formulaUnit = reader.readString();
+  const auto resultUnit = reader.readString();
+  boost::shared_ptr<Kernel::Interpolation> interpolation;
+  if (reader.read<bool>()) {
+    interpolation = boost::make_shared<Kernel::Interpolation>();
+    std::istringstream in(reader.readString());
+    in >> *interpolation;
+  }
+  const auto extractSingleValueAs = reader.readString();
+  const auto eq = reader.readString();
+  const auto componentIndex = reader.read<int32_t>();
+  const IComponent *component =
+      componentIndex == NONE ? nullptr : components.at(componentIndex);
+  const auto angleConvertConst = reader.read<double>();
+  const auto description = reader.readString();
+  return boost::make_shared<XMLInstrumentParameter>(
+      logfileID, value, interpolation, formula, formulaUnit, resultUnit,
+      paramName, type, tie, constraint, penaltyFactor, fittingFunction,
+      extractSingleValueAs, eq, component, angleConvertConst, description);
+}
+
+/// @return all the components below an assembly, depth first
+std::vector<IComponent *> descendants(const ICompAssembly &assembly) {
+  std::vector<IComponent *> result;
+  for (int i = 0; i < assembly.nelements(); ++i) {
+    auto child = assembly.getChild(i);
+    result.push_back(child.get());
+    if (auto childAssembly = dynamic_cast<ICompAssembly *>(child.get())) {
+      auto below = descendants(*childAssembly);
+      result.insert(result.end(), below.begin(), below.end());
+    }
+  }
+  return result;
+}
+} // namespace
+
+/**
+ * Constructor
+ * @param filename :: path of the cache file
+ * @param checksum :: checksum of the IDF the cached instrument is built from
+ */
+InstrumentBinaryCache::InstrumentBinaryCache(const std::string &filename,
+                                             const std::string &checksum)
+    : m_filename(filename), m_checksum(checksum) {}
+
+/// @return true if the file exists
+bool InstrumentBinaryCache::exists() const {
+  try {
+    return Poco::File(m_filename).exists();
+  } catch (Poco::Exception &) {
+    return false;
+  }
+}
+
+/**
+ * Write an instrument built from the IDF to the file. The file is written
+ * under another name first, then renamed, so that other processes never read
+ * a partial file.
+ * @param instrument :: the instrument, as built by the parser
+ * @param typeShapes :: the shapes of the types of the IDF
+ * @return false if the instrument cannot be cached
+ * @throw std::runtime_error if the file cannot be written
+ */
+bool InstrumentBinaryCache::save(const Instrument &instrument,
+                                 const TypeShapes &typeShapes) const {
+  if (instrument.isParametrized() || instrument.getPhysicalInstrument())
+    return false;
+  Collector collector(instrument);
+  if (!collector.addChildren(instrument, 0, false))
+    return false;
+  for (const auto &typeShape : typeShapes) {
+    if (typeShape.second &&
+        !dynamic_cast<const CSGObject *>(typeShape.second.get()))
+      return false;
+    collector.shapeIndex(typeShape.second.get());
+  }
+
+  const std::string temporary =
+      m_filename + "." + std::to_string(Poco::Process::id()) + ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary);
+    if (!file)
+      throw std::runtime_error("Unable to open " + temporary);
+    Writer writer(file);
+    file.write(MAGIC, sizeof(MAGIC));
+    writer.write(VERSION);
+    writer.write(BYTE_ORDER_MARK);
+    writer.write(std::string(Kernel::MantidVersion::revisionFull()));
+    writer.write(m_checksum);
+    writer.write(instrument.getName());
+
+    // Defaults of the instrument
+    writer.write(instrument.getValidFromDate().totalNanoseconds());
+    writer.write(instrument.getValidToDate().totalNanoseconds());
+    writer.write(instrument.getDefaultView());
+    writer.write(instrument.getDefaultAxis());
+    writeReferenceFrame(writer, *instrument.getReferenceFrame());
+    writer.write(instrument.getRelativePos());
+    writer.write(instrument.getRelativeRot());
+
+    // Shapes, with the names of the types they are the shapes of
+    const auto &shapes = collector.shapes();
+    writer.write(static_cast<uint64_t>(shapes.size()));
+    for (const auto shape : shapes) {
+      const auto &csgObject = dynamic_cast<const CSGObject &>(*shape);
+      writer.write(csgObject.getShapeXML());
+      writer.write(static_cast<int32_t>(csgObject.getName()));
+      writer.write(csgObject.id());
+      std::vector<std::string> typeNames;
+      for (const auto &typeShape : typeShapes) {
+        if (typeShape.second.get() == shape)
+          typeNames.push_back(typeShape.first);
+      }
+      writer.write(static_cast<uint64_t>(typeNames.size()));
+      for (const auto &typeName : typeNames)
+        writer.write(typeName);
+    }
+
+    // Component tree
+    const auto &records = collector.records();
+    writer.write(static_cast<uint64_t>(records.size()));
+    for (const auto &record : records) {
+      const IComponent &component = *record.component;
+      writer.write(static_cast<uint8_t>(record.kind));
+      writer.write(record.parent);
+      writer.write(component.getName());
+      writer.write(component.getRelativePos());
+      writer.write(component.getRelativeRot());
+      switch (record.kind) {
+      case Kind::ObjAssembly:
+      case Kind::ObjComponent:
+        writer.write(collector.shapeIndex(
+            dynamic_cast<const IObjComponent &>(component).shape().get()));
+        break;
+      case Kind::Detector:
+        writer.write(collector.shapeIndex(
+            dynamic_cast<const IObjComponent &>(component).shape().get()));
+        writer.write(dynamic_cast<const IDetector &>(component).getID());
+        writer.write(static_cast<uint8_t>(collector.role(component)));
+        break;
+      case Kind::Rectangular: {
+        const auto &bank = dynamic_cast<const RectangularDetector &>(component);
+        writer.write(collector.shapeIndex(bank.getAtXY(0, 0)->shape().get()));
+        writer.write(static_cast<int32_t>(bank.xpixels()));
+        writer.write(bank.xstart());
+        writer.write(bank.xstep());
+        writer.write(static_cast<int32_t>(bank.ypixels()));
+        writer.write(bank.ystart());
+        writer.write(bank.ystep());
+        writer.write(static_cast<int32_t>(bank.idstart()));
+        writer.write(bank.idfillbyfirst_y());
+        writer.write(static_cast<int32_t>(bank.idstepbyrow()));
+        writer.write(static_cast<int32_t>(bank.idstep()));
+        break;
+      }
+      case Kind::Generated:
+        writer.write(static_cast<uint8_t>(collector.role(component)));
+        break;
+      case Kind::Assembly:
+        break;
+      }
+    }
+
+    // Special components
+    auto source = instrument.getSource();
+    writer.write(collector.componentIndex(source.get()));
+    auto sample = instrument.getSample();
+    writer.write(collector.componentIndex(sample.get()));
+    const auto numChoppers = instrument.getNumberOfChopperPoints();
+    writer.write(static_cast<uint64_t>(numChoppers));
+    for (size_t i = 0; i < numChoppers; ++i)
+      writer.write(
+          collector.componentIndex(instrument.getChopperPoint(i).get()));
+
+    // Parameters of the IDF
+    const auto &logfileCache = instrument.getLogfileCache();
+    writer.write(static_cast<uint64_t>(logfileCache.size()));
+    for (const auto &item : logfileCache) {
+      writer.write(item.first.first);
+      writer.write(collector.componentIndex(item.first.second));
+      writeParameter(writer, collector, *item.second);
+    }
+    auto &logfileUnits = const_cast<Instrument &>(instrument).getLogfileUnit();
+    writer.write(static_cast<uint64_t>(logfileUnits.size()));
+    for (const auto &unit : logfileUnits) {
+      writer.write(unit.first);
+      writer.write(unit.second);
+    }
+
+    if (!file)
+      throw std::runtime_error("Unable to write " + temporary);
+  }
+
+  Poco::File(temporary).renameTo(m_filename);
+  return true;
+}
+
+/**
+ * Rebuild an instrument from the file.
+ * @param instrument :: an instrument without components, named like the
+ * cached one
+ * @param typeShapes :: filled with the shapes of the types of the IDF
+ * @return false if the file does not exist or was written for another IDF,
+ * another instrument, another version of the format or by another revision
+ * of Mantid
+ * @throw std::runtime_error if the file is corrupt
+ */
+bool InstrumentBinaryCache::load(Instrument &instrument,
+                                 TypeShapes &typeShapes) const {
+  if (!exists())
+    return false;
+  Poco::File file(m_filename);
+  if (file.getSize() < sizeof(MAGIC) + 2 * sizeof(uint32_t))
+    return false;
+  Poco::SharedMemory memory(file, Poco::SharedMemory::AM_READ);
+  if (std::memcmp(memory.begin(), MAGIC, sizeof(MAGIC)) != 0)
+    return false;
+  Reader reader(memory.begin() + sizeof(MAGIC), memory.end());
+  if (reader.read<uint32_t>() != VERSION ||
+      reader.read<uint32_t>() != BYTE_ORDER_MARK ||
+      reader.readString() != Kernel::MantidVersion::revisionFull() ||
+      reader.readString() != m_checksum ||
+      reader.readString() != instrument.getName())
+    return false;
+
+  // Defaults of the instrument
+  instrument.setValidFromDate(
+      Types::Core::DateAndTime(reader.read<int64_t>()));
+  instrument.setValidToDate(Types::Core::DateAndTime(reader.read<int64_t>()));
+  instrument.setDefaultView(reader.readString());
+  instrument.setDefaultViewAxis(reader.readString());
+  const auto up = static_cast<PointingAlong>(reader.read<int32_t>());
+  const auto alongBeam = static_cast<PointingAlong>(reader.read<int32_t>());
+  const auto thetaSign = static_cast<PointingAlong>(reader.read<int32_t>());
+  const auto handedness = static_cast<Handedness>(reader.read<int32_t>());
+  const auto origin = reader.readString();
+  instrument.setReferenceFrame(boost::make_shared<ReferenceFrame>(
+      up, alongBeam, thetaSign, handedness, origin));
+  instrument.setPos(reader.readV3D());
+  instrument.setRot(reader.readQuat());
+
+  // Shapes
+  std::vector<boost::shared_ptr<IObject>> shapes(
+      static_cast<size_t>(reader.read<uint64_t>()));
+  ShapeFactory shapeFactory;
+  for (auto &shape : shapes) {
+    const auto xml = reader.readString();
+    // Shapes created without XML are empty
+    auto csgObject = xml.empty() ? boost::make_shared<CSGObject>()
+                                 : shapeFactory.createShape(xml, false);
+    csgObject->setName(reader.read<int32_t>());
+    csgObject->setID(reader.readString());
+    shape = csgObject;
+    const auto numTypes = reader.read<uint64_t>();
+    for (uint64_t i = 0; i < numTypes; ++i)
+      typeShapes[reader.readString()] = shape;
+  }
+  auto readShape = [&reader, &shapes]() {
+    const auto index = reader.read<int32_t>();
+    return index == NONE ? boost::shared_ptr<IObject>() : shapes.at(index);
+  };
+
+  // Component tree
+  const auto numRecords = static_cast<size_t>(reader.read<uint64_t>());
+  std::vector<IComponent *> components(1, &instrument);
+  components.reserve(numRecords + 1);
+  std::vector<const IDetector *> detectors, monitors;
+  auto mark = [&detectors, &monitors](const IComponent *component,
+                                      const Role role) {
+    const auto detector = dynamic_cast<const IDetector *>(component);
+    if (detector && role == Role::Detector)
+      detectors.push_back(detector);
+    else if (detector && role == Role::Monitor)
+      monitors.push_back(detector);
+  };
+  // The components created by the last RectangularDetector
+  std::vector<IComponent *> generated;
+  size_t nextGenerated(0);
+  for (size_t i = 0; i < numRecords; ++i) {
+    const auto kind = static_cast<Kind>(reader.read<uint8_t>());
+    auto parent =
+        dynamic_cast<ICompAssembly *>(components.at(reader.read<int32_t>()));
+    if (!parent)
+      throw std::runtime_error("The parent of a component is not an assembly");
+    const auto name = reader.readString();
+    const auto pos = reader.readV3D();
+    const auto rot = reader.readQuat();
+
+    IComponent *component(nullptr);
+    switch (kind) {
+    case Kind::Assembly:
+      component = new CompAssembly(name, parent);
+      break;
+    case Kind::ObjAssembly: {
+      auto assembly = new ObjCompAssembly(name, parent);
+      auto outline = readShape();
+      if (outline)
+        assembly->setOutline(outline);
+      component = assembly;
+      break;
+    }
+    case Kind::ObjComponent:
+      component = new ObjComponent(name, readShape(), parent);
+      parent->add(component);
+      break;
+    case Kind::Detector: {
+      auto shape = readShape();
+      const auto id = reader.read<int32_t>();
+      component = new Detector(name, id, shape, parent);
+      parent->add(component);
+      mark(component, static_cast<Role>(reader.read<uint8_t>()));
+      break;
+    }
+    case Kind::Rectangular: {
+      auto bank = new RectangularDetector(name, parent);
+      auto shape = readShape();
+      const auto xpixels = reader.read<int32_t>();
+      const auto xstart = reader.read<double>();
+      const auto xstep = reader.read<double>();
+      const auto ypixels = reader.read<int32_t>();
+      const auto ystart = reader.read<double>();
+      const auto ystep = reader.read<double>();
+      const auto idstart = reader.read<int32_t>();
+      const auto idfillbyfirst_y = reader.read<bool>();
+      const auto idstepbyrow = reader.read<int32_t>();
+      const auto idstep = reader.read<int32_t>();
+      bank->initialize(shape, xpixels, xstart, xstep, ypixels, ystart, ystep,
+                       idstart, idfillbyfirst_y, idstepbyrow, idstep);
+      if (nextGenerated != generated.size())
+        throw std::runtime_error("Components of a bank are missing");
+      generated = descendants(*bank);
+      nextGenerated = 0;
+      component = bank;
+      break;
+    }
+    case Kind::Generated:
+      if (nextGenerated == generated.size() ||
+          generated[nextGenerated]->getName() != name)
+        throw std::runtime_error("The components of a bank do not match");
+      component = generated[nextGenerated++];
+      mark(component, static_cast<Role>(reader.read<uint8_t>()));
+      break;
+    default:
+      throw std::runtime_error("Unknown kind of component");
+    }
+    component->setPos(pos);
+    component->setRot(rot);
+    components.push_back(component);
+  }
+  if (nextGenerated != generated.size())
+    throw std::runtime_error("Components of a bank are missing");
+
+  // Special components. The chopper points need the source.
+  const auto source = reader.read<int32_t>();
+  if (source != NONE)
+    instrument.markAsSource(components.at(source));
+  const auto sample = reader.read<int32_t>();
+  if (sample != NONE)
+    instrument.markAsSamplePos(components.at(sample));
+  const auto numChoppers = reader.read<uint64_t>();
+  for (uint64_t i = 0; i < numChoppers; ++i) {
+    const auto index = reader.read<int32_t>();
+    auto chopper = dynamic_cast<const ObjComponent *>(components.at(index));
+    if (!chopper)
+      throw std::runtime_error("A chopper point is not an ObjComponent");
+    instrument.markAsChopperPoint(chopper);
+  }
+  // Monitors are inserted in order, so add them before the other detectors
+  for (const auto monitor : monitors)
+    instrument.markAsMonitor(monitor);
+  for (const auto detector : detectors)
+    instrument.markAsDetectorIncomplete(detector);
+  instrument.markAsDetectorFinalize();
+
+  // Parameters of the IDF
+  auto &logfileCache = instrument.getLogfileCache();
+  const auto numParameters = reader.read<uint64_t>();
+  for (uint64_t i = 0; i < numParameters; ++i) {
+    const auto name = reader.readString();
+    const auto index = reader.read<int32_t>();
+    const IComponent *component =
+        index == NONE ? nullptr : components.at(index);
+    logfileCache[std::make_pair(name, component)] =
+        readParameter(reader, components);
+  }
+  auto &logfileUnits = instrument.getLogfileUnit();
+  const auto numUnits = reader.read<uint64_t>();
+  for (uint64_t i = 0; i < numUnits; ++i) {
+    const auto name = reader.readString();
+    logfileUnits[name] = reader.readString();
+  }
+  return true;
+}
+
+} // namespace Geometry
+} // namespace Mantid
@@ -2,6 +2,7 @@
 #include <sstream>
 
 #include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/InstrumentBinaryCache.h"
 #include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
 #include "MantidGeometry/Instrument/ObjCompAssembly.h"
 #include "MantidGeometry/Instrument/RectangularDetector.h"
@@ -26,6 +27,7 @@
 #include <Poco/DOM/NodeFilter.h>
 #include <Poco/DOM/NodeIterator.h>
 #include <Poco/DOM/NodeList.h>
+#include <Poco/File.h>
 #include <Poco/Path.h>
 #include <Poco/SAX/AttributesImpl.h>
 #include <Poco/String.h>
@@ -51,6 +53,15 @@ namespace Geometry {
 namespace {
 // initialize the static logger
 Kernel::Logger g_log("InstrumentDefinitionParser");
+
+/// @return true if binary instrument caches are enabled in the config. They
+/// are disabled by default.
+bool binaryCacheEnabled() {
+  int enabled(0);
+  ConfigService::Instance().getValue("instrumentDefinition.binaryCache",
+                                     enabled);
+  return enabled != 0;
+}
 }
 //----------------------------------------------------------------------------------------------
 /** Default Constructor - not very functional in this state
@@ -235,6 +246,16 @@ InstrumentDefinitionParser::parseXML(Kernel::ProgressBase *progressReporter) {
 
   setValidityRange(pRootElem);
   readDefaults(pRootElem->getChildElement("defaults"));
+
+  // Skip creating the components if a previous load of the same IDF cached
+  // them. The XML is still parsed, for the defaults above and the
+  // <component-link> parameters below, which are not in the cache.
+  if (loadBinaryCache()) {
+    m_cachingOption = setupGeometryCache();
+    setComponentLinks(m_instrument, pRootElem);
+    return m_instrument;
+  }
+
   Geometry::ShapeFactory shapeCreator;
 
   const std::string filename = m_xmlFile->getFileFullPathStr();
@@ -279,6 +300,8 @@ InstrumentDefinitionParser::parseXML(Kernel::ProgressBase *progressReporter) {
   // (which does the final sorting).
   m_instrument->markAsDetectorFinalize();
 
+  saveBinaryCache();
+
   // And give back what we created
   return m_instrument;
 }
@@ -2552,6 +2575,90 @@ InstrumentDefinitionParser::setupGeometryCache() {
   return cachingOption;
 }
 
+/** Returns the directories a binary instrument cache is looked for in: the
+ * directory of the geometry cache file, then the temporary directory.
+ * @return the directories, in order of preference
+ */
+std::vector<std::string>
+InstrumentDefinitionParser::binaryCacheDirectories() const {
+  std::vector<std::string> directories;
+  const auto &vtpFilename = m_cacheFile->getFileFullPathStr();
+  if (!vtpFilename.empty())
+    directories.push_back(Poco::Path(vtpFilename).parent().toString());
+  directories.push_back(ConfigService::Instance().getTempDir());
+  return directories;
+}
+
+/** Returns the binary instrument cache of the IDF in a directory
+ * @param directory :: the directory of the cache file
+ * @return the cache, keyed by the checksum of the XML
+ */
+InstrumentBinaryCache
+InstrumentDefinitionParser::binaryCache(const std::string &directory) {
+  const std::string &xml = m_instrument->getXmlText();
+  return InstrumentBinaryCache(
+      Poco::Path(directory).makeDirectory().append(getMangledName() +
+                                                   ".instrument")
+          .toString(),
+      Kernel::ChecksumHelper::sha1FromString(Poco::trim(xml)));
+}
+
+/** Replaces the instrument with the one in the binary instrument cache of the
+ * IDF, if there is one. Instruments with neutronic positions are never
+ * cached.
+ * @return true if the instrument was read from a cache
+ */
+bool InstrumentDefinitionParser::loadBinaryCache() {
+  if (!binaryCacheEnabled() || m_indirectPositions)
+    return false;
+  for (const auto &directory : binaryCacheDirectories()) {
+    auto cache = binaryCache(directory);
+    if (!cache.exists())
+      continue;
+    // Read into a new instrument, so a bad file leaves this one unchanged
+    auto instrument = boost::make_shared<Instrument>(m_instName);
+    instrument->setFilename(m_instrument->getFilename());
+    instrument->setXmlText(m_instrument->getXmlText());
+    InstrumentBinaryCache::TypeShapes typeShapes;
+    try {
+      if (!cache.load(*instrument, typeShapes))
+        continue;
+    } catch (std::exception &e) {
+      g_log.warning() << "Unable to read the instrument cache "
+                      << cache.filename() << ": " << e.what() << '\n';
+      continue;
+    }
+    g_log.information("Loaded instrument from cache " + cache.filename());
+    m_instrument = instrument;
+    mapTypeNameToShape.clear();
+    mapTypeNameToShape.insert(typeShapes.begin(), typeShapes.end());
+    return true;
+  }
+  return false;
+}
+
+/// Writes the instrument to a binary instrument cache, if it can be cached
+void InstrumentDefinitionParser::saveBinaryCache() {
+  if (!binaryCacheEnabled() || m_instrument->getPhysicalInstrument())
+    return;
+  for (const auto &directory : binaryCacheDirectories()) {
+    try {
+      const Poco::File dir(directory);
+      if (!dir.exists() || !dir.canWrite())
+        continue;
+      auto cache = binaryCache(directory);
+      InstrumentBinaryCache::TypeShapes typeShapes(mapTypeNameToShape.begin(),
+                                                   mapTypeNameToShape.end());
+      if (cache.save(*m_instrument, typeShapes))
+        g_log.information("Wrote instrument cache " + cache.filename());
+      return;
+    } catch (std::exception &e) {
+      g_log.information() << "Unable to write the instrument cache in "
+                          << directory << ": " << e.what() << '\n';
+    }
+  }
+}
+
 /**
 Getter for the applied caching option.
 @return selected caching.
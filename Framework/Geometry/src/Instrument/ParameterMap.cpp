@@ -10,6 +10,7 @@
 #include <cstring>
 #include <nexus/NeXusFile.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/make_shared.hpp>
 
 #ifdef _WIN32
 #define strcasecmp _stricmp
@@ -307,6 +308,7 @@ void ParameterMap::clearParametersByName(const std::string &name) {
   // Check if the caches need invalidating
   if (name == pos() || name == rot())
     clearPositionSensitiveCaches();
+  clearDetectorParameters();
 }
 
 /**
@@ -331,6 +333,7 @@ void ParameterMap::clearParametersByName(const std::string &name,
     // Check if the caches need invalidating
     if (name == pos() || name == rot())
       clearPositionSensitiveCaches();
+    clearDetectorParameters();
   }
 }
 
@@ -396,6 +399,7 @@ void ParameterMap::add(const IComponent *comp,
     m_map.insert(std::make_pair(comp->getComponentID(), par));
 #endif
   }
+  clearDetectorParameters();
 }
 
 /** Create or adjust "pos" parameter for a component
@@ -634,6 +638,7 @@ void ParameterMap::forceUnsafeSetMasked(const IComponent *comp, bool value) {
 #else
   m_map.insert(std::make_pair(comp->getComponentID(), param));
 #endif
+  clearDetectorParameters();
 }
 
 /**
@@ -915,6 +920,44 @@ Parameter_sptr ParameterMap::getRecursiveByType(const IComponent *comp,
   return Parameter_sptr();
 }
 
+/**
+ * Find a parameter of all the detectors, as getRecursive() would for each of
+ * them. The component tree is walked from the root once, so each component
+ * is looked up once. The table is built on the first call for a name and kept
+ * until the map is modified, so that finding the parameter of a detector is
+ * then an index into a vector.
+ * @param name :: Parameter name
+ * @returns the parameters by detector index, null for the detectors without
+ * the parameter. The table is not updated if the map is modified later.
+ * @throw std::runtime_error if the map has no ComponentInfo
+ */
+boost::shared_ptr<const ParameterMap::DetectorParameters>
+ParameterMap::detectorParameters(const std::string &name) const {
+  checkIsNotMaskingParameter(name);
+  std::lock_guard<std::mutex> lock(m_detectorParametersMutex);
+  auto &table = m_detectorParameters[name];
+  if (table)
+    return table;
+
+  const auto &info = componentInfo();
+  DetectorParameters parameters(info.size());
+  std::vector<size_t> toVisit{info.root()};
+  while (!toVisit.empty()) {
+    const auto index = toVisit.back();
+    toVisit.pop_back();
+    parameters[index] = get(info.componentID(index), name);
+    // Parents are visited before their children
+    if (!parameters[index] && info.hasParent(index))
+      parameters[index] = parameters[info.parent(index)];
+    const auto &children = info.children(index);
+    toVisit.insert(toVisit.end(), children.begin(), children.end());
+  }
+  // Detectors are the first components
+  parameters.resize(detectorInfo().size());
+  table = boost::make_shared<const DetectorParameters>(std::move(parameters));
+  return table;
+}
+
 /**
  * Find a parameter by name, recursively going up the component tree
  * to higher parents.
@@ -1032,6 +1075,15 @@ void ParameterMap::clearPositionSensitiveCaches() {
   m_cacheRotMap->clear();
 }
 
+/**
+ * Clears the tables returned by detectorParameters(), when a parameter is
+ * added, replaced or removed
+ */
+void ParameterMap::clearDetectorParameters() {
+  std::lock_guard<std::mutex> lock(m_detectorParametersMutex);
+  m_detectorParameters.clear();
+}
+
 /// Sets a cached location on the location cache
 /// @param comp :: The Component to set the location of
 /// @param location :: The location
@@ -1088,6 +1140,7 @@ void ParameterMap::copyFromParameterMap(const IComponent *oldComp,
         std::make_pair(newComp->getComponentID(), std::move(thisParameter)));
 #endif
   }
+  clearDetectorParameters();
 }
 
 //--------------------------------------------------------------------------------------------
@@ -27,9 +27,11 @@
 #include <boost/accumulators/statistics/stats.hpp>
 #include <boost/make_shared.hpp>
 
+#include <algorithm>
 #include <array>
 #include <deque>
 #include <iostream>
+#include <limits>
 #include <stack>
 #include <random>
 
@@ -38,6 +40,42 @@ namespace Geometry {
 
 using Kernel::Material;
 using Kernel::V3D;
+
+namespace {
+/**
+* Check whether a track can cross a bounding box, with a margin for the
+* tolerance of the intersection points, using the slab method.
+* @param box :: An axis-aligned bounding box
+* @param track :: The track
+* @return False if the track cannot pass through the box
+*/
+bool trackCanCrossBox(const BoundingBox &box, const Track &track) {
+  const double margin = 100. * Kernel::Tolerance;
+  const V3D &start = track.startPoint();
+  const V3D &direction = track.direction();
+  double nearest(std::numeric_limits<double>::lowest());
+  double farthest(std::numeric_limits<double>::max());
+  for (size_t i = 0; i < 3; ++i) {
+    const double low = box.minPoint()[i] - margin;
+    const double high = box.maxPoint()[i] + margin;
+    if (direction[i] == 0.) {
+      if (start[i] < low || start[i] > high)
+        return false;
+      continue;
+    }
+    double distLow = (low - start[i]) / direction[i];
+    double distHigh = (high - start[i]) / direction[i];
+    if (distLow > distHigh)
+      std::swap(distLow, distHigh);
+    nearest = std::max(nearest, distLow);
+    farthest = std::min(farthest, distHigh);
+    if (nearest > farthest)
+      return false;
+  }
+  // Only the points in front of the start of the track are used
+  return farthest > 0.;
+}
+} // namespace
 using Kernel::Quat;
 
 /**
@@ -776,6 +814,28 @@ int CSGObject::interceptSurface(Geometry::Track &UT) const {
   return (UT.count() - originalCount);
 }
 
+/**
+* Given a batch of tracks, fill each track with its valid sections. The
+* tracks that do not cross the bounding box of the object are skipped
+* without testing any surface.
+* The bounding box is calculated if it has not been already, so call
+* getBoundingBox() once before tracing tracks from several threads.
+* @param tracks :: Initial tracks
+* @return Number of segments added to all the tracks
+*/
+int CSGObject::interceptSurfaces(std::vector<Geometry::Track> &tracks) const {
+  const BoundingBox &box = getBoundingBox();
+  const bool useBox =
+      box.isNonNull() && box.isAxisAligned() && isFiniteGeometry();
+  int count(0);
+  for (auto &track : tracks) {
+    if (useBox && !trackCanCrossBox(box, track))
+      continue;
+    count += interceptSurface(track);
+  }
+  return count;
+}
+
 /**
 * Calculate if a point PT is a valid point on the track
 * @param point :: Point to calculate from.
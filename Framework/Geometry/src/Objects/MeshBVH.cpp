@@ -0,0 +1,190 @@
+#include "MantidGeometry/Objects/MeshBVH.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace Mantid {
+namespace Geometry {
+namespace detail {
+
+using Kernel::V3D;
+
+namespace {
+/// Maximum number of triangles in a leaf
+constexpr uint32_t MAX_LEAF_SIZE = 4;
+/// Maximum depth of the tree, far above what halving 2^32 triangles needs
+constexpr size_t MAX_DEPTH = 64;
+} // namespace
+
+/**
+ * Build the hierarchy of the triangles of a mesh
+ * @param triangles :: indices of the three vertices of each triangle
+ * @param vertices :: the vertices of the mesh
+ */
+MeshBVH::MeshBVH(const std::vector<uint16_t> &triangles,
+                 const std::vector<V3D> &vertices) {
+  const auto numTriangles = static_cast<uint32_t>(triangles.size() / 3);
+  if (numTriangles == 0)
+    return;
+
+  // Box and centre of each triangle
+  std::vector<Node> boxes(numTriangles);
+  std::vector<std::array<double, 3>> centres(numTriangles);
+  for (uint32_t i = 0; i < numTriangles; ++i) {
+    auto &box = boxes[i];
+    box.min.fill(std::numeric_limits<double>::max());
+    box.max.fill(std::numeric_limits<double>::lowest());
+    for (size_t j = 0; j < 3; ++j) {
+      const V3D &vertex = vertices[triangles[3 * i + j]];
+      for (size_t k = 0; k < 3; ++k) {
+        box.min[k] = std::min(box.min[k], vertex[k]);
+        box.max[k] = std::max(box.max[k], vertex[k]);
+      }
+    }
+    for (size_t k = 0; k < 3; ++k)
+      centres[i][k] = 0.5 * (box.min[k] + box.max[k]);
+  }
+
+  m_triangles.resize(numTriangles);
+  for (uint32_t i = 0; i < numTriangles; ++i)
+    m_triangles[i] = i;
+  m_nodes.reserve(2 * (numTriangles / MAX_LEAF_SIZE + 1));
+  build(centres, boxes, 0, numTriangles);
+
+  // The ray-triangle test accepts points a tiny distance behind the start of
+  // the ray and rounds the intersection points: widen the boxes to match
+  const auto &root = m_nodes.front();
+  double extent(0.);
+  for (size_t k = 0; k < 3; ++k)
+    extent = std::max(extent, root.max[k] - root.min[k]);
+  m_margin = 1e-6 * extent + std::numeric_limits<double>::min();
+  for (auto &node : m_nodes) {
+    for (size_t k = 0; k < 3; ++k) {
+      node.min[k] -= m_margin;
+      node.max[k] += m_margin;
+    }
+  }
+}
+
+/**
+ * Find the triangles that the ray may cross, i.e. the triangles of the leaves
+ * whose boxes the ray crosses in front of its start
+ * @param start :: start of the ray
+ * @param direction :: unit vector along the ray
+ * @param candidates :: filled with the indices of the triangles, in
+ * increasing order
+ */
+void MeshBVH::trianglesOnRay(const V3D &start, const V3D &direction,
+                             Candidates &candidates) const {
+  candidates.clear();
+  if (m_nodes.empty())
+    return;
+
+  std::array<uint32_t, MAX_DEPTH> stack;
+  size_t stackSize(0);
+  stack[stackSize++] = 0;
+  while (stackSize > 0) {
+    const uint32_t index = stack[--stackSize];
+    const Node &node = m_nodes[index];
+    if (!rayCrossesNode(node, start, direction))
+      continue;
+    if (node.count > 0) {
+      candidates.insert(candidates.end(), m_triangles.begin() + node.first,
+                        m_triangles.begin() + node.first + node.count);
+    } else {
+      stack[stackSize++] = node.second;
+      stack[stackSize++] = index + 1;
+    }
+  }
+  // Keep the order of a scan over all the triangles
+  std::sort(candidates.begin(), candidates.end());
+}
+
+/**
+ * Add the node of the triangles m_triangles[first, last) and its children.
+ * @param centres :: centre of the box of each triangle
+ * @param boxes :: box of each triangle
+ * @param first :: index in m_triangles of the first triangle of the node
+ * @param last :: index in m_triangles after the last triangle of the node
+ * @return the index of the node
+ */
+uint32_t MeshBVH::build(const std::vector<std::array<double, 3>> &centres,
+                        const std::vector<Node> &boxes, uint32_t first,
+                        uint32_t last) {
+  const auto index = static_cast<uint32_t>(m_nodes.size());
+  m_nodes.emplace_back();
+  Node node;
+  node.min.fill(std::numeric_limits<double>::max());
+  node.max.fill(std::numeric_limits<double>::lowest());
+  std::array<double, 3> centreMin(node.min), centreMax(node.max);
+  for (uint32_t i = first; i < last; ++i) {
+    const auto triangle = m_triangles[i];
+    for (size_t k = 0; k < 3; ++k) {
+      node.min[k] = std::min(node.min[k], boxes[triangle].min[k]);
+      node.max[k] = std::max(node.max[k], boxes[triangle].max[k]);
+      centreMin[k] = std::min(centreMin[k], centres[triangle][k]);
+      centreMax[k] = std::max(centreMax[k], centres[triangle][k]);
+    }
+  }
+
+  // Split along the longest axis of the centres, unless they coincide
+  size_t axis(0);
+  for (size_t k = 1; k < 3; ++k) {
+    if (centreMax[k] - centreMin[k] > centreMax[axis] - centreMin[axis])
+      axis = k;
+  }
+  if (last - first <= MAX_LEAF_SIZE || centreMax[axis] <= centreMin[axis]) {
+    node.first = first;
+    node.count = last - first;
+    node.second = 0;
+    m_nodes[index] = node;
+    return index;
+  }
+
+  const uint32_t middle = first + (last - first) / 2;
+  std::nth_element(m_triangles.begin() + first, m_triangles.begin() + middle,
+                   m_triangles.begin() + last,
+                   [&centres, axis](const uint32_t a, const uint32_t b) {
+                     return centres[a][axis] < centres[b][axis];
+                   });
+  node.first = first;
+  node.count = 0;
+  build(centres, boxes, first, middle);
+  node.second = build(centres, boxes, middle, last);
+  m_nodes[index] = node;
+  return index;
+}
+
+/**
+ * Check whether a ray crosses the box of a node in front of its start, using
+ * the slab method
+ * @param node :: the node
+ * @param start :: start of the ray
+ * @param direction :: direction of the ray
+ * @return true if the ray crosses the box
+ */
+bool MeshBVH::rayCrossesNode(const Node &node, const V3D &start,
+                             const V3D &direction) const {
+  double nearest(std::numeric_limits<double>::lowest());
+  double farthest(std::numeric_limits<double>::max());
+  for (size_t k = 0; k < 3; ++k) {
+    if (direction[k] == 0.) {
+      if (start[k] < node.min[k] || start[k] > node.max[k])
+        return false;
+      continue;
+    }
+    double distMin = (node.min[k] - start[k]) / direction[k];
+    double distMax = (node.max[k] - start[k]) / direction[k];
+    if (distMin > distMax)
+      std::swap(distMin, distMax);
+    nearest = std::max(nearest, distMin);
+    farthest = std::min(farthest, distMax);
+    if (nearest > farthest)
+      return false;
+  }
+  return farthest >= -m_margin;
+}
+
+} // namespace detail
+} // namespace Geometry
+} // namespace Mantid
@@ -43,6 +43,7 @@ void MeshObject::initialize() {
         "Too many vertices (" + std::to_string(m_vertices.size()) +
         "). MeshObject cannot have more than 65535 vertices.");
   }
+  m_bvh = detail::MeshBVH(m_triangles, m_vertices);
   m_handler = boost::make_shared<GeometryHandler>(this);
 }
 
@@ -168,6 +169,18 @@ int MeshObject::interceptSurface(Geometry::Track &UT) const {
   return UT.count() - originalCount;
 }
 
+/**
+* Given a batch of tracks, fill each track with its valid sections
+* @param tracks :: Initial tracks
+* @return Number of segments added to all the tracks
+*/
+int MeshObject::interceptSurfaces(std::vector<Geometry::Track> &tracks) const {
+  int count(0);
+  for (auto &track : tracks)
+    count += interceptSurface(track);
+  return count;
+}
+
 /**
  * Get intersection points and their in out directions on the given ray
  * @param start :: Start point of ray
@@ -180,9 +193,14 @@ void MeshObject::getIntersections(const Kernel::V3D &start,
                                   std::vector<Kernel::V3D> &intersectionPoints,
                                   std::vector<int> &entryExitFlags) const {
 
+  // Only the triangles in the boxes the ray crosses can be intersected
+  detail::MeshBVH::Candidates candidates;
+  m_bvh.trianglesOnRay(start, direction, candidates);
+
   V3D vertex1, vertex2, vertex3, intersection;
   int entryExit;
-  for (size_t i = 0; getTriangle(i, vertex1, vertex2, vertex3); ++i) {
+  for (const auto i : candidates) {
+    getTriangle(i, vertex1, vertex2, vertex3);
     if (rayIntersectsTriangle(start, direction, vertex1, vertex2, vertex3,
                               intersection, entryExit)) {
       intersectionPoints.push_back(intersection);
@@ -207,7 +225,7 @@ bool MeshObject::rayIntersectsTriangle(const Kernel::V3D &start,
                                        const Kernel::V3D &direction,
                                        const V3D &v1, const V3D &v2,
                                        const V3D &v3, V3D &intersection,
-                                       int &entryExit) const {
+                                       int &entryExit) {
   // Implements Möller–Trumbore intersection algorithm
   V3D edge1, edge2, h, s, q;
   double a, f, u, v;
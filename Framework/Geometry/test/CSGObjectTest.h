@@ -403,6 +403,30 @@ public:
     checkTrackIntercept(geom_obj, track, expectedResults);
   }
 
+  void testInterceptSurfacesGivesSameLinksAsSingleTracks() {
+    auto geom_obj = ComponentCreationHelper::createSphere(4.1);
+    std::vector<Track> tracks{
+        Track(V3D(-10, 0, 0), V3D(1, 0, 0)),  // through the centre
+        Track(V3D(0, 0, 0), V3D(0, 0, 1)),    // from inside
+        Track(V3D(-10, 0, 0), V3D(-1, 0, 0)), // pointing away
+        Track(V3D(-10, 5, 0), V3D(1, 0, 0)),  // misses the bounding box
+        Track(V3D(-10, 4, 4), V3D(1, 0, 0)),  // misses the sphere only
+        Track(V3D(5, 5, 0), V3D(-M_SQRT1_2, -M_SQRT1_2, 0))};
+    std::vector<Track> singleTracks(tracks);
+    int singleCount(0);
+    for (auto &track : singleTracks)
+      singleCount += geom_obj->interceptSurface(track);
+
+    TS_ASSERT_EQUALS(geom_obj->interceptSurfaces(tracks), singleCount);
+    TS_ASSERT_EQUALS(singleCount, 3);
+    for (size_t i = 0; i < tracks.size(); ++i) {
+      TS_ASSERT_EQUALS(tracks[i].count(), singleTracks[i].count());
+      if (tracks[i].count() == 1)
+        TS_ASSERT_DELTA(tracks[i].front().distInsideObject,
+                        singleTracks[i].front().distInsideObject, 1e-10);
+    }
+  }
+
   void checkTrackIntercept(Track &track,
                            const std::vector<Link> &expectedResults) {
     size_t index = 0;
@@ -0,0 +1,149 @@
+#ifndef MANTID_GEOMETRY_INSTRUMENTBINARYCACHETEST_H_
+#define MANTID_GEOMETRY_INSTRUMENTBINARYCACHETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/InstrumentBinaryCache.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidKernel/MantidVersion.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
+
+#include <Poco/TemporaryFile.h>
+
+#include <fstream>
+
+using Mantid::Geometry::Component;
+using Mantid::Geometry::CSGObject;
+using Mantid::Geometry::Detector;
+using Mantid::Geometry::IDetector_const_sptr;
+using Mantid::Geometry::Instrument;
+using Mantid::Geometry::Instrument_sptr;
+using Mantid::Geometry::InstrumentBinaryCache;
+using Mantid::Kernel::V3D;
+
+class InstrumentBinaryCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static InstrumentBinaryCacheTest *createSuite() {
+    return new InstrumentBinaryCacheTest();
+  }
+  static void destroySuite(InstrumentBinaryCacheTest *suite) { delete suite; }
+
+  void test_load_returns_false_if_the_file_does_not_exist() {
+    Poco::TemporaryFile file;
+    InstrumentBinaryCache cache(file.path(), "checksum");
+    TS_ASSERT(!cache.exists());
+    Instrument loaded("basic");
+    InstrumentBinaryCache::TypeShapes typeShapes;
+    TS_ASSERT(!cache.load(loaded, typeShapes));
+  }
+
+  void test_load_rebuilds_the_saved_instrument() {
+    auto instrument = createInstrument();
+    Poco::TemporaryFile file;
+    InstrumentBinaryCache cache(file.path(), "checksum");
+    InstrumentBinaryCache::TypeShapes typeShapes;
+    typeShapes["pixel"] = boost::const_pointer_cast<Mantid::Geometry::IObject>(
+        instrument->getDetector(1)->shape());
+    TS_ASSERT(cache.save(*instrument, typeShapes));
+    TS_ASSERT(cache.exists());
+
+    Instrument loaded(instrument->getName());
+    InstrumentBinaryCache::TypeShapes loadedShapes;
+    TS_ASSERT(cache.load(loaded, loadedShapes));
+
+    TS_ASSERT_EQUALS(loaded.getDetectorIDs(), instrument->getDetectorIDs());
+    TS_ASSERT_EQUALS(loaded.getMonitors(), instrument->getMonitors());
+    for (const auto id : instrument->getDetectorIDs()) {
+      const auto original = instrument->getDetector(id);
+      const auto copy = loaded.getDetector(id);
+      TS_ASSERT_EQUALS(copy->getName(), original->getName());
+      TS_ASSERT_DELTA(copy->getPos().distance(original->getPos()), 0., 1e-12);
+    }
+    TS_ASSERT_EQUALS(loaded.getSource()->getName(),
+                     instrument->getSource()->getName());
+    TS_ASSERT_EQUALS(loaded.getSource()->getPos(),
+                     instrument->getSource()->getPos());
+    TS_ASSERT_EQUALS(loaded.getSample()->getPos(),
+                     instrument->getSample()->getPos());
+    TS_ASSERT_EQUALS(loaded.getReferenceFrame()->pointingUp(),
+                     instrument->getReferenceFrame()->pointingUp());
+
+    TS_ASSERT_EQUALS(loadedShapes.size(), 1);
+    const auto shape = loadedShapes["pixel"];
+    TS_ASSERT(shape);
+    if (shape) {
+      const auto &csgObject = dynamic_cast<const CSGObject &>(*shape);
+      TS_ASSERT_EQUALS(
+          csgObject.getShapeXML(),
+          dynamic_cast<const CSGObject &>(*typeShapes["pixel"]).getShapeXML());
+      TS_ASSERT_EQUALS(loaded.getDetector(1)->shape(), shape);
+    }
+  }
+
+  void test_load_ignores_a_file_written_for_another_IDF() {
+    auto instrument = createInstrument();
+    Poco::TemporaryFile file;
+    TS_ASSERT(InstrumentBinaryCache(file.path(), "checksum")
+                  .save(*instrument, InstrumentBinaryCache::TypeShapes()));
+
+    InstrumentBinaryCache otherIDF(file.path(), "other checksum");
+    Instrument loaded(instrument->getName());
+    InstrumentBinaryCache::TypeShapes typeShapes;
+    TS_ASSERT(!otherIDF.load(loaded, typeShapes));
+    TS_ASSERT_EQUALS(loaded.nelements(), 0);
+
+    InstrumentBinaryCache otherInstrument(file.path(), "checksum");
+    Instrument renamed("renamed");
+    TS_ASSERT(!otherInstrument.load(renamed, typeShapes));
+  }
+
+  void test_load_ignores_a_file_written_by_another_revision() {
+    auto instrument = createInstrument();
+    Poco::TemporaryFile file;
+    InstrumentBinaryCache cache(file.path(), "checksum");
+    TS_ASSERT(cache.save(*instrument, InstrumentBinaryCache::TypeShapes()));
+
+    // The revision follows the magic, the version, the byte order mark and
+    // its size
+    const std::string revision(Mantid::Kernel::MantidVersion::revisionFull());
+    if (revision.empty())
+      return;
+    std::fstream stream(file.path(),
+                        std::ios::in | std::ios::out | std::ios::binary);
+    stream.seekp(8 + 2 * sizeof(uint32_t) + sizeof(uint64_t));
+    stream.put(static_cast<char>(revision[0] ^ 1));
+    stream.close();
+
+    Instrument loaded(instrument->getName());
+    InstrumentBinaryCache::TypeShapes typeShapes;
+    TS_ASSERT(!cache.load(loaded, typeShapes));
+    TS_ASSERT_EQUALS(loaded.nelements(), 0);
+  }
+
+  void test_save_returns_false_for_components_that_cannot_be_cached() {
+    auto instrument = createInstrument();
+    instrument->add(new Component("plain", instrument.get()));
+    Poco::TemporaryFile file;
+    InstrumentBinaryCache cache(file.path(), "checksum");
+    TS_ASSERT(!cache.save(*instrument, InstrumentBinaryCache::TypeShapes()));
+    TS_ASSERT(!cache.exists());
+  }
+
+private:
+  Instrument_sptr createInstrument() {
+    auto instrument =
+        ComponentCreationHelper::createTestInstrumentRectangular2(2, 4);
+    auto monitor = new Detector("monitor", 1000, nullptr, instrument.get());
+    monitor->setPos(V3D(0., 0., -1.));
+    instrument->add(monitor);
+    instrument->markAsMonitor(monitor);
+    return instrument;
+  }
+};
+
+#endif /* MANTID_GEOMETRY_INSTRUMENTBINARYCACHETEST_H_ */
@@ -573,6 +573,52 @@ public:
     TS_ASSERT_EQUALS(dets.size(), 100 * 200 * 2);
   }
 
+  void test_parse_reads_the_instrument_written_to_the_binary_cache() {
+    std::string filename =
+        ConfigService::Instance().getInstrumentDirectory() +
+        "/IDFs_for_UNIT_TESTING/IDF_for_RECTANGULAR_UNIT_TESTING.xml";
+    std::string xmlText = Strings::loadFile(filename);
+
+    InstrumentDefinitionParser parser(filename, "BinaryCacheTest", xmlText);
+    boost::shared_ptr<const Instrument> parsed;
+    TS_ASSERT_THROWS_NOTHING(parsed = parser.parseXML(nullptr));
+    const std::string cacheName = parser.getMangledName() + ".instrument";
+    Poco::Path cachePath(parser.createVTPFileName());
+    cachePath.setFileName(cacheName);
+    Poco::Path fallbackPath(ConfigService::Instance().getTempDir());
+    fallbackPath.makeDirectory();
+    fallbackPath.setFileName(cacheName);
+    Poco::File cacheFile(cachePath);
+    if (!cacheFile.exists())
+      cacheFile = Poco::File(fallbackPath);
+    TS_ASSERT(cacheFile.exists());
+
+    InstrumentDefinitionParser cachedParser(filename, "BinaryCacheTest",
+                                            xmlText);
+    boost::shared_ptr<const Instrument> cached;
+    TS_ASSERT_THROWS_NOTHING(cached = cachedParser.parseXML(nullptr));
+    TS_ASSERT_EQUALS(cached->getDetectorIDs(), parsed->getDetectorIDs());
+    TS_ASSERT_EQUALS(cached->getSource()->getPos(),
+                     parsed->getSource()->getPos());
+    auto bank = boost::dynamic_pointer_cast<const RectangularDetector>(
+        cached->getComponentByName("bank2"));
+    auto parsedBank = boost::dynamic_pointer_cast<const RectangularDetector>(
+        parsed->getComponentByName("bank2"));
+    TS_ASSERT(bank);
+    if (bank && parsedBank) {
+      TS_ASSERT_EQUALS(bank->getAtXY(1, 1)->getID(),
+                       parsedBank->getAtXY(1, 1)->getID());
+      TS_ASSERT_DELTA(bank->getAtXY(1, 1)->getPos().distance(
+                          parsedBank->getAtXY(1, 1)->getPos()),
+                      0., 1e-12);
+    }
+    TS_ASSERT_EQUALS(cached->getLogfileCache().size(),
+                     parsed->getLogfileCache().size());
+
+    if (cacheFile.exists())
+      cacheFile.remove();
+  }
+
   void testGetAbsolutPositionInCompCoorSys() {
     CompAssembly base("base");
     base.setPos(1.0, 1.0, 1.0);
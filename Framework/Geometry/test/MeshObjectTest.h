@@ -4,6 +4,7 @@
 #include "MantidGeometry/Objects/MeshObject.h"
 
 #include "MantidGeometry/Math/Algebra.h"
+#include "MantidGeometry/Objects/MeshBVH.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidGeometry/Rendering/GeometryHandler.h"
 #include "MantidGeometry/Objects/ShapeFactory.h"
@@ -195,6 +196,53 @@ std::unique_ptr<MeshObject> createLShape() {
       std::move(triangles), std::move(vertices), Mantid::Kernel::Material());
   return retVal;
 }
+void createSphereMesh(const double radius, const uint16_t nRings,
+                      const uint16_t nSegments,
+                      std::vector<uint16_t> &triangles,
+                      std::vector<V3D> &vertices) {
+  /**
+  * Create the triangles of a sphere centred on the origin with nRings
+  * rings of nSegments vertices between the poles, anticlockwise when
+  * viewed from outside.
+  */
+  vertices.clear();
+  triangles.clear();
+  vertices.emplace_back(V3D(0, 0, radius));
+  vertices.emplace_back(V3D(0, 0, -radius));
+  for (uint16_t i = 0; i < nRings; ++i) {
+    const double theta = M_PI * (i + 1) / (nRings + 1);
+    for (uint16_t j = 0; j < nSegments; ++j) {
+      const double phi = 2.0 * M_PI * j / nSegments;
+      vertices.emplace_back(V3D(radius * std::sin(theta) * std::cos(phi),
+                                radius * std::sin(theta) * std::sin(phi),
+                                radius * std::cos(theta)));
+    }
+  }
+  auto vertex = [nSegments](uint16_t ring, uint16_t segment) {
+    return static_cast<uint16_t>(2 + ring * nSegments + segment % nSegments);
+  };
+  for (uint16_t j = 0; j < nSegments; ++j) {
+    triangles.insert(triangles.end(), {0, vertex(0, j), vertex(0, j + 1)});
+    for (uint16_t i = 0; i + 1 < nRings; ++i) {
+      triangles.insert(triangles.end(), {vertex(i, j), vertex(i + 1, j),
+                                         vertex(i + 1, j + 1)});
+      triangles.insert(triangles.end(), {vertex(i, j), vertex(i + 1, j + 1),
+                                         vertex(i, j + 1)});
+    }
+    triangles.insert(triangles.end(), {vertex(nRings - 1, j), 1,
+                                       vertex(nRings - 1, j + 1)});
+  }
+}
+
+std::unique_ptr<MeshObject> createSphere(const double radius,
+                                         const uint16_t nRings,
+                                         const uint16_t nSegments) {
+  std::vector<uint16_t> triangles;
+  std::vector<V3D> vertices;
+  createSphereMesh(radius, nRings, nSegments, triangles, vertices);
+  return Mantid::Kernel::make_unique<MeshObject>(
+      std::move(triangles), std::move(vertices), Mantid::Kernel::Material());
+}
 }
 
 class MeshObjectTest : public CxxTest::TestSuite {
@@ -945,6 +993,60 @@ public:
                     M_PI * 2.0 / 3.0, satol);
   }
 
+  void testBVHFindsAllTrianglesCrossedByRays() {
+    std::vector<uint16_t> triangles;
+    std::vector<V3D> vertices;
+    createSphereMesh(1.0, 30, 40, triangles, vertices);
+    const detail::MeshBVH bvh(triangles, vertices);
+    const size_t nTriangles = triangles.size() / 3;
+    TS_ASSERT(bvh.numberOfNodes() > 1);
+
+    Mantid::Kernel::MersenneTwister rng(12345);
+    detail::MeshBVH::Candidates candidates;
+    size_t hits(0);
+    for (size_t ray = 0; ray < 2000; ++ray) {
+      // Start inside, on and outside the sphere, aiming at random
+      const double r = 2.0 * rng.nextValue();
+      V3D start(rng.nextValue() - 0.5, rng.nextValue() - 0.5,
+                rng.nextValue() - 0.5);
+      start.normalize();
+      start *= r;
+      V3D direction(rng.nextValue() - 0.5, rng.nextValue() - 0.5,
+                    rng.nextValue() - 0.5);
+      if (ray % 4 == 0)
+        direction = V3D(0, 0, 1); // as used by isValid
+      direction.normalize();
+
+      bvh.trianglesOnRay(start, direction, candidates);
+      TS_ASSERT(std::is_sorted(candidates.begin(), candidates.end()));
+      TS_ASSERT(candidates.size() < nTriangles / 4);
+      V3D intersection;
+      int entryExit;
+      for (size_t i = 0; i < nTriangles; ++i) {
+        if (MeshObject::rayIntersectsTriangle(
+                start, direction, vertices[triangles[3 * i]],
+                vertices[triangles[3 * i + 1]], vertices[triangles[3 * i + 2]],
+                intersection, entryExit)) {
+          ++hits;
+          TS_ASSERT(std::binary_search(candidates.begin(), candidates.end(),
+                                       static_cast<uint32_t>(i)));
+        }
+      }
+    }
+    // Most of the rays must have hit something
+    TS_ASSERT(hits > 1000);
+  }
+
+  void testInterceptSphere() {
+    auto geom_obj = createSphere(1.0, 30, 40);
+    Track track(V3D(-2, 0.01, 0.02), V3D(1, 0, 0));
+    TS_ASSERT_EQUALS(geom_obj->interceptSurface(track), 1);
+    TS_ASSERT_EQUALS(track.count(), 1);
+    TS_ASSERT_DELTA(track.cbegin()->distInsideObject, 2.0, 0.01);
+    TS_ASSERT(geom_obj->isValid(V3D(0.5, 0.5, 0.5)));
+    TS_ASSERT(!geom_obj->isValid(V3D(0.7, 0.7, 0.7)));
+  }
+
   void testOutputForRendering()
   /* Here we test the output functions used in rendering */
   {
@@ -973,6 +1075,9 @@ public:
         smallCube(createCube(0.2)) {
     testPoints = create_test_points();
     testRays = create_test_rays();
+    createSphereMesh(1.0, 100, 200, sphereTriangles, sphereVertices);
+    sphere = Mantid::Kernel::make_unique<MeshObject>(
+        sphereTriangles, sphereVertices, Mantid::Kernel::Material());
   }
 
   void test_isOnSide() {
@@ -1006,6 +1111,52 @@ public:
     }
   }
 
+  void test_interceptSurface_large_mesh() {
+    const size_t number(10000);
+    for (size_t i = 0; i < number; ++i) {
+      Track ray(testRays[i % testRays.size()]);
+      sphere->interceptSurface(ray);
+    }
+  }
+
+  void test_interceptSurface_large_mesh_linear_scan() {
+    // What interceptSurface costs when testing every triangle, for comparison
+    // with the bounding volume hierarchy above
+    const size_t number(10000);
+    const size_t nTriangles(sphereTriangles.size() / 3);
+    V3D intersection;
+    int entryExit;
+    size_t hits(0);
+    for (size_t i = 0; i < number; ++i) {
+      const Track &ray = testRays[i % testRays.size()];
+      for (size_t j = 0; j < nTriangles; ++j) {
+        if (MeshObject::rayIntersectsTriangle(
+                ray.startPoint(), ray.direction(),
+                sphereVertices[sphereTriangles[3 * j]],
+                sphereVertices[sphereTriangles[3 * j + 1]],
+                sphereVertices[sphereTriangles[3 * j + 2]], intersection,
+                entryExit))
+          ++hits;
+      }
+    }
+    TS_ASSERT(hits > 0);
+  }
+
+  void test_isValid_large_mesh() {
+    const size_t number(10000);
+    for (size_t i = 0; i < number; ++i) {
+      sphere->isValid(testPoints[i % testPoints.size()]);
+    }
+  }
+
+  void test_generatePointInside_large_mesh() {
+    const size_t npoints(6000);
+    const size_t maxAttempts(500);
+    for (size_t i = 0; i < npoints; ++i) {
+      sphere->generatePointInObject(rng, maxAttempts);
+    }
+  }
+
   void test_solid_angle() {
     const size_t number(10000);
     for (size_t i = 0; i < number; ++i) {
@@ -1117,6 +1268,9 @@ private:
   std::unique_ptr<MeshObject> octahedron;
   std::unique_ptr<MeshObject> lShape;
   std::unique_ptr<MeshObject> smallCube;
+  std::unique_ptr<MeshObject> sphere;
+  std::vector<uint16_t> sphereTriangles;
+  std::vector<V3D> sphereVertices;
   std::vector<V3D> testPoints;
   std::vector<Track> testRays;
 };
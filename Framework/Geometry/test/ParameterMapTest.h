@@ -5,6 +5,7 @@
 #include "MantidGeometry/Instrument/ParameterFactory.h"
 #include "MantidGeometry/Instrument/ParameterMap.h"
 #include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidBeamline/ComponentInfo.h"
 #include "MantidBeamline/DetectorInfo.h"
 #include "MantidTestHelpers/ComponentCreationHelper.h"
@@ -632,6 +633,53 @@ public:
     TS_ASSERT_EQUALS(oldA->value<bool>(), false);
   }
 
+  void test_detectorParameters_finds_the_parameters_like_getRecursive() {
+    ParameterMap pmap;
+    pmap.setInstrument(m_testInstrument.get());
+    IComponent_sptr bank = m_testInstrument->getChild(0);
+    auto detector = m_testInstrument->getDetector(5);
+    pmap.addDouble(m_testInstrument.get(), "A", 1.0);
+    pmap.addDouble(bank.get(), "A", 2.0);
+    pmap.addDouble(detector.get(), "A", 3.0);
+    pmap.addDouble(detector.get(), "B", 4.0);
+
+    const auto &detectorInfo = pmap.detectorInfo();
+    const auto a = detectorInfo.parameters("A");
+    const auto b = detectorInfo.parameters("b");
+    TS_ASSERT_EQUALS(a->size(), detectorInfo.size());
+    TS_ASSERT_EQUALS(b->size(), detectorInfo.size());
+    for (size_t i = 0; i < detectorInfo.size(); ++i) {
+      const auto &det = detectorInfo.detector(i);
+      TS_ASSERT_EQUALS((*a)[i], pmap.getRecursive(&det, "A"));
+      TS_ASSERT_EQUALS((*b)[i], pmap.getRecursive(&det, "b"));
+    }
+    const auto index = detectorInfo.indexOf(5);
+    TS_ASSERT_DELTA((*a)[index]->value<double>(), 3.0, 1e-12);
+    TS_ASSERT_DELTA((*a)[detectorInfo.indexOf(1)]->value<double>(), 2.0,
+                    1e-12);
+    TS_ASSERT(!(*b)[detectorInfo.indexOf(1)]);
+    // The table is kept until the map changes
+    TS_ASSERT_EQUALS(detectorInfo.parameters("A"), a);
+  }
+
+  void test_detectorParameters_are_found_again_when_the_map_changes() {
+    ParameterMap pmap;
+    pmap.setInstrument(m_testInstrument.get());
+    IComponent_sptr bank = m_testInstrument->getChild(0);
+    pmap.addDouble(bank.get(), "A", 1.0);
+    const auto index = pmap.detectorInfo().indexOf(1);
+    const auto before = pmap.detectorParameters("A");
+
+    pmap.addDouble(bank.get(), "A", 2.0);
+    const auto replaced = pmap.detectorParameters("A");
+    TS_ASSERT_DIFFERS(replaced, before);
+    TS_ASSERT_DELTA((*before)[index]->value<double>(), 1.0, 1e-12);
+    TS_ASSERT_DELTA((*replaced)[index]->value<double>(), 2.0, 1e-12);
+
+    pmap.clearParametersByName("A");
+    TS_ASSERT(!(*pmap.detectorParameters("A"))[index]);
+  }
+
 private:
   template <typename ValueType>
   void doCopyAndUpdateTestUsingGenericAdd(const std::string &type,
@@ -775,6 +823,17 @@ public:
     TS_ASSERT_DELTA(11.0, par_sptr->value<double>(), 1e-12);
   }
 
+  void test_Inst_Par_Lookup_Via_DetectorParameters() {
+    Mantid::Geometry::Parameter_sptr par_sptr;
+
+    m_pmap.setInstrument(m_testInst.get());
+    for (size_t i = 0; i < 10000; ++i) {
+      par_sptr = (*m_pmap.detectorParameters("instlevel"))[0];
+    }
+    // Use it to ensure the compiler doesn't optimise the loop away
+    TS_ASSERT_DELTA(10.0, par_sptr->value<double>(), 1e-12);
+  }
+
   void test_Leaf_Par_Lookup_Via_Get_And_Leaf_Component() {
     Mantid::Geometry::Parameter_sptr par_sptr;
 
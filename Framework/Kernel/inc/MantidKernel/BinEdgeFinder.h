@@ -0,0 +1,125 @@
+#ifndef MANTID_KERNEL_BINEDGEFINDER_H_
+#define MANTID_KERNEL_BINEDGEFINDER_H_
+
+#include "MantidKernel/DllConfig.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** BinEdgeFinder : Finds the bin index of many values for a given set of bin
+  edges. Unlike BinFinder, which is constructed from rebinning parameters, it
+  takes the bin edges themselves and detects whether they are linearly or
+  logarithmically spaced, as produced by Rebin with a constant positive or
+  negative step. For such edges the bin index is computed directly from the
+  value rather than searched for, so that values do not need to be sorted to
+  be histogrammed efficiently. Arbitrary edges fall back to a binary search.
+
+  The computed index is always corrected against the actual edges, so the
+  result is identical to a search: the bin i satisfies
+  edges[i] <= x < edges[i + 1]. The finder keeps a reference to the edges,
+  which must outlive it.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL BinEdgeFinder {
+public:
+  /// How the bin edges are spaced
+  enum class Spacing { Linear, Logarithmic, Arbitrary };
+
+  explicit BinEdgeFinder(const std::vector<double> &binEdges);
+
+  /// @return how the bin edges are spaced
+  Spacing spacing() const { return m_spacing; }
+  /// @return true if the bin index can be computed without a search
+  bool isRegular() const { return m_spacing != Spacing::Arbitrary; }
+  /// @return the number of bins, one less than the number of edges
+  size_t numberOfBins() const { return m_numberOfBins; }
+
+  inline int64_t bin(const double x) const;
+  void bins(const double *x, const size_t n, int64_t *indices) const;
+
+private:
+  inline int64_t correct(const double x, int64_t index) const;
+
+  /// The bin edges
+  const std::vector<double> &m_edges;
+  /// How the edges are spaced
+  Spacing m_spacing;
+  /// The number of bins
+  size_t m_numberOfBins;
+  /// The first edge, +infinity if there are no bins
+  double m_min;
+  /// The last edge, -infinity if there are no bins
+  double m_max;
+  /// The first edge, or its log for logarithmic spacing
+  double m_start;
+  /// 1 / bin width, or 1 / log(ratio) for logarithmic spacing
+  double m_inverseStep;
+};
+
+/** Find the bin index for a value.
+ * @param x :: value to histogram
+ * @return the index i with edges[i] <= x < edges[i + 1], or -1 if x is
+ * outside of the edges
+ */
+inline int64_t BinEdgeFinder::bin(const double x) const {
+  // Written so that NaN is outside of the edges too
+  if (!(x >= m_min && x < m_max))
+    return -1;
+  switch (m_spacing) {
+  case Spacing::Linear:
+    return correct(x, static_cast<int64_t>((x - m_start) * m_inverseStep));
+  case Spacing::Logarithmic:
+    return correct(
+        x, static_cast<int64_t>((std::log(x) - m_start) * m_inverseStep));
+  default:
+    return std::upper_bound(m_edges.cbegin(), m_edges.cend(), x) -
+           m_edges.cbegin() - 1;
+  }
+}
+
+/** Correct a computed bin index for rounding and for small deviations of the
+ * edges from the ideal spacing.
+ * @param x :: value to histogram, known to be inside the edges
+ * @param index :: the estimated bin index
+ * @return the index i with edges[i] <= x < edges[i + 1]
+ */
+inline int64_t BinEdgeFinder::correct(const double x, int64_t index) const {
+  const auto last = static_cast<int64_t>(m_numberOfBins) - 1;
+  index = std::max(int64_t(0), std::min(index, last));
+  while (x < m_edges[index])
+    --index;
+  while (x >= m_edges[index + 1])
+    ++index;
+  return index;
+}
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_BINEDGEFINDER_H_ */
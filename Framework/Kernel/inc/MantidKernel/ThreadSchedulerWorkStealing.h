@@ -0,0 +1,101 @@
+#ifndef MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_
+#define MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/ThreadScheduler.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** ThreadSchedulerWorkStealing : a scheduler keeping one queue of tasks
+  per thread of the pool instead of a single queue shared by all of them.
+
+  A thread pops tasks from its own queue, and only when that is empty does it
+  "steal" a task from the queue of another thread. A task pushed by a task
+  running in the pool goes to the queue of the thread that runs it, so tasks
+  that create many small tasks do not all wait on the same lock. Tasks pushed
+  from outside the pool are spread over the queues in turn.
+
+  Within each queue the tasks are sorted by cost and the largest one is
+  popped first, as in ThreadSchedulerLargestCost. As in
+  ThreadSchedulerMutexes, a task whose mutex is used by a running task is
+  only popped when no other task is left.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL ThreadSchedulerWorkStealing : public ThreadScheduler {
+public:
+  explicit ThreadSchedulerWorkStealing(size_t numQueues = 0);
+  ~ThreadSchedulerWorkStealing() override;
+
+  void push(Task *newTask) override;
+  Task *pop(size_t threadnum) override;
+  void finished(Task *task, size_t threadnum) override;
+  size_t size() override;
+  bool empty() override;
+  void clear() override;
+  double totalCost() override;
+  double totalCostExecuted() override;
+
+  /// @return the number of task queues
+  size_t numQueues() const { return m_queues.size(); }
+  size_t queueSize(size_t index);
+
+private:
+  /// The tasks waiting to run in one thread, sorted by cost.
+  struct TaskQueue {
+    std::mutex lock;
+    std::multimap<double, Task *> tasks;
+    /// Total cost of the tasks pushed to this queue
+    double cost = 0.;
+    /// Total cost of the tasks popped from this queue
+    double costExecuted = 0.;
+  };
+
+  Task *popFrom(TaskQueue &queue, bool mutexMustBeFree);
+  size_t queueIndexForPush();
+
+  /// Identifies the scheduler to the threads popping from it
+  const size_t m_id;
+  /// One queue per thread
+  std::vector<std::unique_ptr<TaskQueue>> m_queues;
+  /// Number of tasks in all the queues
+  std::atomic<size_t> m_size;
+  /// Queue the next task pushed from outside the pool goes to
+  std::atomic<size_t> m_nextQueue;
+  /// Number of running tasks using each mutex
+  std::map<boost::shared_ptr<std::mutex>, size_t> m_busyMutexes;
+  /// Protects m_busyMutexes. Only locked for tasks with a mutex, and always
+  /// after a queue lock, never before.
+  std::mutex m_busyLock;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_ */
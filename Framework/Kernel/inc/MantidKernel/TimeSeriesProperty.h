@@ -314,12 +314,17 @@ public:
   /// If filtering by log, get the time intervals for splitting
   std::vector<Mantid::Kernel::SplittingInterval> getSplittingIntervals() const;
 
+  /// Sort the property into increasing times, if not already sorted. Call it
+  /// before the property is read by several threads.
+  void sortIfNecessary() const;
+
 private:
+  /// The other types read the entries of a filter directly
+  template <typename T> friend class TimeSeriesProperty;
+
   //----------------------------------------------------------------------------------------------
   /// Saves the time vector has time + start attribute
   void saveTimeVector(::NeXus::File *file);
-  /// Sort the property into increasing times, if not already sorted
-  void sortIfNecessary() const;
   ///  Find the index of the entry of time t in the mP vector (sorted)
   int findIndex(Types::Core::DateAndTime t) const;
   ///  Find the upper_bound of time t in container.
@@ -0,0 +1,122 @@
+#include "MantidKernel/BinEdgeFinder.h"
+
+#include <limits>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Largest deviation of an edge from the ideal spacing, as a fraction of a bin
+constexpr double SPACING_TOLERANCE = 0.01;
+
+/** Check if values are equally spaced. The last value is allowed to be
+ * closer or further by up to one step, as Rebin may have shortened or merged
+ * the last bin.
+ * @param values :: strictly increasing values to check
+ * @param start :: output, the first value
+ * @param step :: output, the spacing between the values
+ * @return true if the values are equally spaced
+ */
+bool isEquallySpaced(const std::vector<double> &values, double &start,
+                     double &step) {
+  const size_t n = values.size() - 1;
+  start = values.front();
+  // The spacing is taken from all but the last value
+  step = n > 1 ? (values[n - 1] - start) / static_cast<double>(n - 1)
+               : values[1] - start;
+  if (!(step > 0.) || !std::isfinite(step))
+    return false;
+  for (size_t i = 1; i < n; ++i) {
+    const double expected = start + static_cast<double>(i) * step;
+    if (std::abs(values[i] - expected) > SPACING_TOLERANCE * step)
+      return false;
+  }
+  return values[n] - values[n - 1] <= 2. * step;
+}
+} // namespace
+
+/** Constructor. Detects how the bin edges are spaced.
+ * @param binEdges :: the bin edges, which must outlive this object
+ */
+BinEdgeFinder::BinEdgeFinder(const std::vector<double> &binEdges)
+    : m_edges(binEdges), m_spacing(Spacing::Arbitrary),
+      m_numberOfBins(binEdges.size() > 1 ? binEdges.size() - 1 : 0),
+      m_min(std::numeric_limits<double>::infinity()),
+      m_max(-std::numeric_limits<double>::infinity()), m_start(0.),
+      m_inverseStep(0.) {
+  if (m_numberOfBins == 0)
+    return;
+  m_min = m_edges.front();
+  m_max = m_edges.back();
+
+  // Direct computation of the index is only possible for sorted edges
+  for (size_t i = 0; i < m_numberOfBins; ++i) {
+    if (!(m_edges[i] < m_edges[i + 1]))
+      return;
+  }
+
+  double start, step;
+  if (isEquallySpaced(m_edges, start, step)) {
+    m_spacing = Spacing::Linear;
+    m_start = start;
+    m_inverseStep = 1. / step;
+    return;
+  }
+
+  if (m_min > 0.) {
+    std::vector<double> logEdges(m_edges.size());
+    std::transform(m_edges.cbegin(), m_edges.cend(), logEdges.begin(),
+                   static_cast<double (*)(double)>(std::log));
+    if (isEquallySpaced(logEdges, start, step)) {
+      m_spacing = Spacing::Logarithmic;
+      m_start = start;
+      m_inverseStep = 1. / step;
+    }
+  }
+}
+
+/** Find the bin indices for an array of values. This is equivalent to calling
+ * bin() for each value, but the estimate of the index is computed in a
+ * separate loop that the compiler can vectorize.
+ * @param x :: pointer to the values to histogram
+ * @param n :: the number of values
+ * @param indices :: output, the bin index of each value or -1 if it is
+ * outside of the edges
+ */
+void BinEdgeFinder::bins(const double *x, const size_t n,
+                         int64_t *indices) const {
+  if (!isRegular()) {
+    for (size_t i = 0; i < n; ++i)
+      indices[i] = bin(x[i]);
+    return;
+  }
+
+  // Clamping before the conversion keeps values outside of the edges (and NaN)
+  // from overflowing the integer type.
+  const double last = static_cast<double>(m_numberOfBins - 1);
+  const double start = m_start;
+  const double inverseStep = m_inverseStep;
+  if (m_spacing == Spacing::Linear) {
+    for (size_t i = 0; i < n; ++i) {
+      const double estimate = (x[i] - start) * inverseStep;
+      indices[i] =
+          static_cast<int64_t>(std::min(last, std::max(0., estimate)));
+    }
+  } else {
+    for (size_t i = 0; i < n; ++i) {
+      const double estimate = (std::log(x[i]) - start) * inverseStep;
+      indices[i] =
+          static_cast<int64_t>(std::min(last, std::max(0., estimate)));
+    }
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    if (x[i] >= m_min && x[i] < m_max)
+      indices[i] = correct(x[i], indices[i]);
+    else
+      indices[i] = -1;
+  }
+}
+
+} // namespace Kernel
+} // namespace Mantid
@@ -5,9 +5,13 @@
 #include "MantidKernel/FilteredTimeSeriesProperty.h"
 #include "MantidKernel/StringTokenizer.h"
 #include "MantidKernel/IPropertySettings.h"
+#include "MantidKernel/MultiThreaded.h"
 
 #include <json/json.h>
 
+#include <exception>
+#include <mutex>
+
 namespace Mantid {
 namespace Kernel {
 
@@ -16,7 +20,32 @@ using std::string;
 namespace {
 // static logger reference
 Logger g_log("PropertyManager");
-}
+
+/// Keeps the first exception thrown by the iterations of a parallel loop, as
+/// an exception must not escape an OpenMP region, to rethrow it after the loop
+class FirstException {
+public:
+  /// Run one iteration, catching any exception it throws
+  template <typename Function> void run(const Function &function) {
+    try {
+      function();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_exception)
+        m_exception = std::current_exception();
+    }
+  }
+  /// Rethrow the exception caught, if any
+  void rethrow() const {
+    if (m_exception)
+      std::rethrow_exception(m_exception);
+  }
+
+private:
+  std::mutex m_mutex;
+  std::exception_ptr m_exception;
+};
+} // namespace
 
 //-----------------------------------------------------------------------------------------------
 /// Default constructor
@@ -100,13 +129,15 @@ PropertyManager &PropertyManager::operator+=(const PropertyManager &rhs) {
  */
 void PropertyManager::filterByTime(const Types::Core::DateAndTime &start,
                                    const Types::Core::DateAndTime &stop) {
-  // Iterate through all properties
-  PropertyMap::const_iterator it;
-  for (it = this->m_properties.begin(); it != this->m_properties.end(); ++it) {
-    // Filter out the property
-    auto prop = it->second.get();
-    prop->filterByTime(start, stop);
+  // The properties are independent: filter them in parallel
+  const auto numProperties = static_cast<int>(m_orderedProperties.size());
+  FirstException exception;
+  PARALLEL_FOR_IF(numProperties > 1)
+  for (int i = 0; i < numProperties; ++i) {
+    exception.run(
+        [&]() { m_orderedProperties[i]->filterByTime(start, stop); });
   }
+  exception.rethrow();
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -121,31 +152,33 @@ void PropertyManager::filterByTime(const Types::Core::DateAndTime &start,
 void PropertyManager::splitByTime(
     std::vector<SplittingInterval> &splitter,
     std::vector<PropertyManager *> outputs) const {
-  size_t n = outputs.size();
-
-  // Iterate through all properties
-  PropertyMap::const_iterator it;
-  for (it = this->m_properties.begin(); it != this->m_properties.end(); ++it) {
-    // Filter out the property
-    Property *prop = it->second.get();
-
-    // Make a vector of the output properties contained in the other property
-    // managers.
-    //  NULL if it was not found.
-    std::vector<Property *> output_properties;
-    for (size_t i = 0; i < n; i++) {
-      if (outputs[i])
-        output_properties.push_back(
-            outputs[i]->getPointerToPropertyOrNull(prop->name()));
-      else
-        output_properties.push_back(nullptr);
-    }
-
-    // Now the property does the splitting.
-    bool isProtonCharge = prop->name() == "proton_charge";
-    prop->splitByTime(splitter, output_properties, isProtonCharge);
+  const size_t n = outputs.size();
+
+  // Each property is split into its own outputs, against the same splitter:
+  // split them in parallel
+  const auto numProperties = static_cast<int>(m_orderedProperties.size());
+  FirstException exception;
+  PARALLEL_FOR_IF(numProperties > 1)
+  for (int i = 0; i < numProperties; ++i) {
+    exception.run([&]() {
+      const Property *prop = m_orderedProperties[i];
+
+      // Make a vector of the output properties contained in the other
+      // property managers.
+      //  NULL if it was not found.
+      std::vector<Property *> output_properties(n, nullptr);
+      for (size_t j = 0; j < n; j++) {
+        if (outputs[j])
+          output_properties[j] =
+              outputs[j]->getPointerToPropertyOrNull(prop->name());
+      }
 
+      // Now the property does the splitting.
+      bool isProtonCharge = prop->name() == "proton_charge";
+      prop->splitByTime(splitter, output_properties, isProtonCharge);
+    });
   } // for each property
+  exception.rethrow();
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -157,22 +190,45 @@ void PropertyManager::splitByTime(
  */
 void PropertyManager::filterByProperty(
     const Kernel::TimeSeriesProperty<bool> &filter) {
-  constexpr bool transferOwnership(
-      false); // New FilteredProperty should not own the original time series
-  for (auto &orderedProperty : m_orderedProperties) {
-    Property *currentProp = orderedProperty;
-    if (auto doubleSeries =
-            dynamic_cast<TimeSeriesProperty<double> *>(currentProp)) {
-      std::unique_ptr<Property> filtered =
-          make_unique<FilteredTimeSeriesProperty<double>>(doubleSeries, filter,
-                                                          transferOwnership);
-      // Replace the property in the ordered properties list
-      orderedProperty = filtered.get();
-      // Now replace in the map
-      const std::string key = createKey(currentProp->name());
-      this->m_properties[key] = std::move(filtered);
-    }
+  // Sort the filter once, before the threads share it
+  filter.sortIfNecessary();
+
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < m_orderedProperties.size(); ++i) {
+    if (dynamic_cast<TimeSeriesProperty<double> *>(m_orderedProperties[i]))
+      indices.push_back(i);
+  }
+
+  // Filter the series in parallel. Each filtered property takes ownership of
+  // the original series instead of cloning it.
+  const auto numFiltered = static_cast<int>(indices.size());
+  std::vector<std::unique_ptr<Property>> filtered(indices.size());
+  FirstException exception;
+  PARALLEL_FOR_IF(numFiltered > 1)
+  for (int i = 0; i < numFiltered; ++i) {
+    exception.run([&]() {
+      auto doubleSeries = static_cast<TimeSeriesProperty<double> *>(
+          m_orderedProperties[indices[i]]);
+      constexpr bool transferOwnership(true);
+      filtered[i] = make_unique<FilteredTimeSeriesProperty<double>>(
+          doubleSeries, filter, transferOwnership);
+    });
+  }
+
+  // The filtered properties own their original series, so they replace them
+  // even if another one failed
+  for (size_t i = 0; i < indices.size(); ++i) {
+    if (!filtered[i])
+      continue;
+    Property *currentProp = m_orderedProperties[indices[i]];
+    // Replace the property in the ordered properties list
+    m_orderedProperties[indices[i]] = filtered[i].get();
+    // Now replace in the map. The original series is owned by the filtered one
+    auto &stored = this->m_properties[createKey(currentProp->name())];
+    stored.release();
+    stored = std::move(filtered[i]);
   }
+  exception.rethrow();
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -0,0 +1,199 @@
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+#include "MantidKernel/ThreadPool.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Source of the identifiers of the schedulers, 0 is never used
+std::atomic<size_t> lastSchedulerId(0);
+/// Identifier of the scheduler the calling thread last popped a task from
+thread_local size_t currentSchedulerId = 0;
+/// The thread number the calling thread last popped a task with
+thread_local size_t currentThreadNum = 0;
+} // namespace
+
+/** Constructor
+ *
+ * @param numQueues :: number of task queues, normally the number of threads
+ *        of the pool. 0 means the number of physical cores.
+ */
+ThreadSchedulerWorkStealing::ThreadSchedulerWorkStealing(size_t numQueues)
+    : ThreadScheduler(), m_id(++lastSchedulerId), m_size(0), m_nextQueue(0) {
+  if (numQueues == 0)
+    numQueues = ThreadPool::getNumPhysicalCores();
+  numQueues = std::max(numQueues, size_t{1});
+  m_queues.reserve(numQueues);
+  for (size_t i = 0; i < numQueues; ++i)
+    m_queues.emplace_back(new TaskQueue);
+}
+
+/// Destructor. Deletes the tasks that were not run.
+ThreadSchedulerWorkStealing::~ThreadSchedulerWorkStealing() { clear(); }
+
+//-------------------------------------------------------------------------------
+/** Add a Task to the queue of the calling thread, when it runs in the pool,
+ * or else to the next queue in turn.
+ *
+ * @param newTask :: Task to add to queue
+ */
+void ThreadSchedulerWorkStealing::push(Task *newTask) {
+  TaskQueue &queue = *m_queues[queueIndexForPush()];
+  std::lock_guard<std::mutex> lock(queue.lock);
+  queue.cost += newTask->cost();
+  queue.tasks.emplace(newTask->cost(), newTask);
+  ++m_size;
+}
+
+//-------------------------------------------------------------------------------
+/** Retrieves the next Task to execute: the largest one of the queue of the
+ * thread, or one stolen from another queue when that one is empty.
+ *
+ * @param threadnum :: ID of the calling thread.
+ * @return a Task pointer to execute, or NULL if there is none.
+ */
+Task *ThreadSchedulerWorkStealing::pop(size_t threadnum) {
+  currentSchedulerId = m_id;
+  currentThreadNum = threadnum;
+  if (m_size == 0)
+    return nullptr;
+
+  const size_t numQueues = m_queues.size();
+  const size_t own = threadnum % numQueues;
+  // Look for a task whose mutex is free, then for any task: the thread pool
+  // waits on the mutex of the task if all the tasks left use a busy one.
+  for (const bool mutexMustBeFree : {true, false}) {
+    for (size_t i = 0; i < numQueues; ++i) {
+      Task *task = popFrom(*m_queues[(own + i) % numQueues], mutexMustBeFree);
+      if (task)
+        return task;
+    }
+  }
+  return nullptr;
+}
+
+//-------------------------------------------------------------------------------
+/** Signal to the scheduler that a task is complete, releasing its mutex.
+ *
+ * @param task :: the Task that was completed.
+ * @param threadnum :: unused argument
+ */
+void ThreadSchedulerWorkStealing::finished(Task *task, size_t threadnum) {
+  UNUSED_ARG(threadnum);
+  const auto &mut = task->getMutex();
+  if (!mut)
+    return;
+  std::lock_guard<std::mutex> lock(m_busyLock);
+  auto busy = m_busyMutexes.find(mut);
+  if (busy != m_busyMutexes.end() && --busy->second == 0)
+    m_busyMutexes.erase(busy);
+}
+
+//-------------------------------------------------------------------------------
+/// @return the number of tasks in all the queues
+size_t ThreadSchedulerWorkStealing::size() { return m_size; }
+
+/// @return true if all the queues are empty
+bool ThreadSchedulerWorkStealing::empty() { return m_size == 0; }
+
+//-------------------------------------------------------------------------------
+/// Empty out all the queues, deleting the tasks.
+void ThreadSchedulerWorkStealing::clear() {
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    for (auto &task : queue->tasks)
+      delete task.second;
+    m_size -= queue->tasks.size();
+    queue->tasks.clear();
+    queue->cost = 0.;
+    queue->costExecuted = 0.;
+  }
+}
+
+//-------------------------------------------------------------------------------
+/// @return the total cost of the tasks pushed to all the queues
+double ThreadSchedulerWorkStealing::totalCost() {
+  double cost = 0.;
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    cost += queue->cost;
+  }
+  return cost;
+}
+
+/// @return the total cost of the tasks popped from all the queues
+double ThreadSchedulerWorkStealing::totalCostExecuted() {
+  double cost = 0.;
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    cost += queue->costExecuted;
+  }
+  return cost;
+}
+
+//-------------------------------------------------------------------------------
+/** @param index :: index of the queue
+ * @return the number of tasks in the given queue
+ */
+size_t ThreadSchedulerWorkStealing::queueSize(size_t index) {
+  TaskQueue &queue = *m_queues.at(index);
+  std::lock_guard<std::mutex> lock(queue.lock);
+  return queue.tasks.size();
+}
+
+//-------------------------------------------------------------------------------
+/** Take the largest task out of a queue and mark its mutex as busy. The
+ * busy mutexes are only looked at for tasks that have a mutex, so tasks
+ * without one are popped under the lock of their queue alone.
+ *
+ * @param queue :: the queue to pop from
+ * @param mutexMustBeFree :: if true, skip the tasks whose mutex is busy
+ * @return the task, or NULL if there is none to pop
+ */
+Task *ThreadSchedulerWorkStealing::popFrom(TaskQueue &queue,
+                                           bool mutexMustBeFree) {
+  std::lock_guard<std::mutex> queueLock(queue.lock);
+  if (queue.tasks.empty())
+    return nullptr;
+
+  std::unique_lock<std::mutex> busyLock(m_busyLock, std::defer_lock);
+  auto lockBusy = [&busyLock]() {
+    if (!busyLock.owns_lock())
+      busyLock.lock();
+  };
+  auto it = queue.tasks.end();
+  do {
+    --it;
+    const auto &mut = it->second->getMutex();
+    if (!mutexMustBeFree || !mut)
+      break;
+    lockBusy();
+    if (m_busyMutexes.find(mut) == m_busyMutexes.end())
+      break;
+    if (it == queue.tasks.begin())
+      return nullptr;
+  } while (true);
+
+  Task *task = it->second;
+  queue.tasks.erase(it);
+  queue.costExecuted += task->cost();
+  --m_size;
+  if (const auto &mut = task->getMutex()) {
+    lockBusy();
+    ++m_busyMutexes[mut];
+  }
+  return task;
+}
+
+//-------------------------------------------------------------------------------
+/// @return the index of the queue a task pushed now goes to
+size_t ThreadSchedulerWorkStealing::queueIndexForPush() {
+  if (currentSchedulerId == m_id)
+    return currentThreadNum % m_queues.size();
+  return m_nextQueue++ % m_queues.size();
+}
+
+} // namespace Kernel
+} // namespace Mantid
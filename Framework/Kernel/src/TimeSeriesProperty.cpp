@@ -327,64 +327,56 @@ void TimeSeriesProperty<TYPE>::filterByTimes(
     return;
   }
 
-  // 3. Prepare a copy
-  std::vector<TimeValueUnit<TYPE>> mp_copy;
-
-  g_log.debug() << "DB541  mp_copy Size = " << mp_copy.size()
-                << "  Original MP Size = " << m_values.size() << "\n";
-
-  // 4. Create new
+  // 3. Find the range of entries of each splitter, so that the filtered
+  // values can be allocated once
+  std::vector<std::pair<size_t, size_t>> ranges;
+  ranges.reserve(splittervec.size());
+  size_t numEntries(0);
+  const int lastIndex = static_cast<int>(m_values.size()) - 1;
   for (const auto &splitter : splittervec) {
-    Types::Core::DateAndTime t_start = splitter.start();
-    Types::Core::DateAndTime t_stop = splitter.stop();
-
-    int tstartindex = findIndex(t_start);
+    int tstartindex = findIndex(splitter.start());
     if (tstartindex < 0) {
       // The splitter is not well defined, and use the first
       tstartindex = 0;
-    } else if (tstartindex >= int(m_values.size())) {
-      // The splitter is not well defined, adn use the last
-      tstartindex = int(m_values.size()) - 1;
+    } else if (tstartindex > lastIndex) {
+      // The splitter is not well defined, and use the last
+      tstartindex = lastIndex;
     }
 
+    const DateAndTime t_stop = splitter.stop();
     int tstopindex = findIndex(t_stop);
-
     if (tstopindex < 0) {
       tstopindex = 0;
-    } else if (tstopindex >= int(m_values.size())) {
-      tstopindex = int(m_values.size()) - 1;
-    } else {
-      if (t_stop == m_values[size_t(tstopindex)].time() &&
-          size_t(tstopindex) > 0) {
-        tstopindex--;
-      }
+    } else if (tstopindex > lastIndex) {
+      tstopindex = lastIndex;
+    } else if (t_stop == m_values[size_t(tstopindex)].time() &&
+               tstopindex > 0) {
+      tstopindex--;
     }
 
-    /* Check */
-    if (tstartindex < 0 || tstopindex >= int(m_values.size())) {
-      g_log.warning() << "Memory Leak In SplitbyTime!\n";
-    }
+    // The first entry is always written, at the start of the splitter
+    const size_t first = static_cast<size_t>(tstartindex);
+    const size_t last =
+        std::max(first, static_cast<size_t>(std::max(tstopindex, 0)));
+    ranges.emplace_back(first, last);
+    numEntries += last - first + 1;
+  }
 
-    if (tstartindex == tstopindex) {
-      TimeValueUnit<TYPE> temp(t_start, m_values[tstartindex].value());
-      mp_copy.push_back(temp);
-    } else {
-      mp_copy.emplace_back(t_start, m_values[tstartindex].value());
-      for (size_t im = size_t(tstartindex + 1); im <= size_t(tstopindex);
-           ++im) {
-        mp_copy.emplace_back(m_values[im].time(), m_values[im].value());
-      }
-    }
-  } // ENDFOR
+  // 4. Create new
+  std::vector<TimeValueUnit<TYPE>> mp_copy;
+  mp_copy.reserve(numEntries);
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    mp_copy.emplace_back(splittervec[i].start(),
+                         m_values[ranges[i].first].value());
+    for (size_t im = ranges[i].first + 1; im <= ranges[i].second; ++im)
+      mp_copy.emplace_back(m_values[im].time(), m_values[im].value());
+  }
 
   g_log.debug() << "DB530  Filtered Log Size = " << mp_copy.size()
                 << "  Original Log Size = " << m_values.size() << "\n";
 
-  // 5. Clear
-  m_values.clear();
-  m_values = mp_copy;
-  mp_copy.clear();
-
+  // 5. Replace
+  m_values.swap(mp_copy);
   m_size = static_cast<int>(m_values.size());
 }
 
@@ -438,88 +430,84 @@ void TimeSeriesProperty<TYPE>::splitByTime(
   if (this->m_values.size() == 1)
     return;
 
-  // 3. We will be iterating through all the entries in the the map/vector
-  size_t i_property = 0;
+  // 3. Select the entries of each output, as (output index, entry index).
+  // They are only added to the outputs once all of them are known, so that
+  // each output is allocated at its final size.
+  std::vector<std::pair<size_t, size_t>> selected;
+  std::vector<bool> hasEntries(numOutputs, false);
+  std::vector<DateAndTime> lastTimes(numOutputs);
+  auto select = [&](const size_t output, const size_t index) {
+    selected.emplace_back(output, index);
+    lastTimes[output] = m_values[index].time();
+    hasEntries[output] = true;
+  };
+  auto isBefore = [](const TimeValueUnit<TYPE> &entry, const DateAndTime &t) {
+    return entry.time() < t;
+  };
 
-  //    And at the same time, iterate through the splitter
+  //    Iterate through the entries and the splitter at the same time
+  size_t i_property = 0;
   auto itspl = splitter.begin();
 
-  size_t counter = 0;
   g_log.debug() << "[DB] Number of time series entries = " << m_values.size()
                 << ", Number of splitters = " << splitter.size() << "\n";
-  while (itspl != splitter.end() && i_property < m_values.size()) {
+  for (; itspl != splitter.end() && i_property < m_values.size(); ++itspl) {
     // Get the splitting interval times and destination
-    DateAndTime start = itspl->start();
-    DateAndTime stop = itspl->stop();
+    const DateAndTime start = itspl->start();
+    const DateAndTime stop = itspl->stop();
 
-    int output_index = itspl->index();
     // output workspace index is out of range. go to the next splitter
+    const int output_index = itspl->index();
     if (output_index < 0 || output_index >= static_cast<int>(numOutputs))
       continue;
 
-    TimeSeriesProperty<TYPE> *myOutput = outputs_tsp[output_index];
     // skip if the input property is of wrong type
-    if (!myOutput) {
-      ++itspl;
-      ++counter;
+    const auto output = static_cast<size_t>(output_index);
+    if (!outputs_tsp[output])
       continue;
-    }
 
-    // Skip the events before the start of the time
-    while (i_property < m_values.size() && m_values[i_property].time() < start)
-      ++i_property;
+    // Skip the entries before the start of the time
+    i_property = std::lower_bound(m_values.begin() + i_property,
+                                  m_values.end(), start, isBefore) -
+                 m_values.begin();
 
     if (i_property == m_values.size()) {
       // i_property is out of the range. Then use the last entry
-      myOutput->addValue(m_values[i_property - 1].time(),
-                         m_values[i_property - 1].value());
-
-      ++itspl;
-      ++counter;
+      select(output, i_property - 1);
       break;
     }
 
     // The current entry is within an interval. Record them until out
     if (m_values[i_property].time() > start && i_property > 0 && !isPeriodic) {
-      // Record the previous oneif this property is not exactly on start time
+      // Record the previous one if this property is not exactly on start time
       //   and this entry is not recorded
       size_t i_prev = i_property - 1;
-      if (myOutput->size() == 0 ||
-          m_values[i_prev].time() != myOutput->lastTime())
-        myOutput->addValue(m_values[i_prev].time(), m_values[i_prev].value());
+      if (!hasEntries[output] || m_values[i_prev].time() != lastTimes[output])
+        select(output, i_prev);
     }
 
     // Loop through all the entries until out.
     while (i_property < m_values.size() && m_values[i_property].time() < stop) {
-
-      // Copy the log out to the output
-      myOutput->addValue(m_values[i_property].time(),
-                         m_values[i_property].value());
+      select(output, i_property);
       ++i_property;
     }
-
-    // Go to the next interval
-    ++itspl;
-    ++counter;
-    // But if we reached the end, then we are done.
-    if (itspl == splitter.end())
-      break;
-
-    // No need to keep looping through the filter if we are out of events
-    if (i_property == this->m_values.size())
-      break;
-
   } // Looping through entries in the splitter vector
 
+  // 4. Size the outputs from the number of entries of each, then fill them
+  std::vector<size_t> counts(numOutputs, 0);
+  for (const auto &entry : selected)
+    ++counts[entry.first];
+  for (size_t i = 0; i < numOutputs; ++i)
+    if (counts[i] > 0)
+      outputs_tsp[i]->reserve(counts[i]);
+  for (const auto &entry : selected)
+    outputs_tsp[entry.first]->addValue(m_values[entry.second].time(),
+                                       m_values[entry.second].value());
+
   // Make sure all entries have the correct size recorded in m_size.
-  for (std::size_t i = 0; i < numOutputs; i++) {
-    TimeSeriesProperty<TYPE> *myOutput =
-        dynamic_cast<TimeSeriesProperty<TYPE> *>(outputs[i]);
-    if (myOutput) {
+  for (auto myOutput : outputs_tsp) {
+    if (myOutput)
       myOutput->m_size = myOutput->realSize();
-      // g_log.notice() << "[DB] Final output size = " << myOutput->size() <<
-      // "\n";
-    }
   }
 }
 
@@ -603,6 +591,28 @@ void TimeSeriesProperty<TYPE>::splitByTimeVector(
     }
   }
 
+  // The entries of each target, in order, as (target, entry index). They are
+  // only added to the outputs once all of them are known, so that the outputs
+  // can be allocated at their final size.
+  std::vector<std::pair<int, size_t>> selected;
+  std::vector<DateAndTime> lastTimes(outputs.size(), DateAndTime::minimum());
+  std::vector<bool> hasEntries(outputs.size(), false);
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    if (outputs[i]->size() > 0) {
+      lastTimes[i] = outputs[i]->lastTime();
+      hasEntries[i] = true;
+    }
+  }
+  // avoid to add duplicate entry
+  auto select = [&](const int target, const size_t index) {
+    const DateAndTime &time = m_values[index].time();
+    if (!hasEntries[target] || lastTimes[target] < time) {
+      selected.emplace_back(target, index);
+      lastTimes[target] = time;
+      hasEntries[target] = true;
+    }
+  };
+
   // now it is the time to put TSP's entries to corresponding
   continue_search = !no_entry_in_range;
   while (continue_search) {
@@ -625,22 +635,14 @@ void TimeSeriesProperty<TYPE>::splitByTimeVector(
       }
 
       // add current entry
-      if (outputs[target]->size() == 0 ||
-          outputs[target]->lastTime() < tsp_time_vec[index_tsp_time]) {
-        // avoid to add duplicate entry
-        outputs[target]->addValue(m_values[index_tsp_time].time(),
-                                  m_values[index_tsp_time].value());
-      }
+      select(target, index_tsp_time);
 
       const size_t nextTspIndex = index_tsp_time + 1;
       if (nextTspIndex < tspTimeVecSize) {
         if (tsp_time_vec[nextTspIndex] > split_stop_time) {
           // next entry is out of this splitter: add the next one and quit
-          if (outputs[target]->lastTime() < m_values[nextTspIndex].time()) {
-            // avoid the duplicate cases occurred in fast frequency issue
-            outputs[target]->addValue(m_values[nextTspIndex].time(),
-                                      m_values[nextTspIndex].value());
-          }
+          // (avoiding the duplicate cases occurred in fast frequency issue)
+          select(target, nextTspIndex);
           // FIXME - in future, need to find out WHETHER there is way to
           // skip the
           // rest without going through the whole sequence
@@ -666,7 +668,16 @@ void TimeSeriesProperty<TYPE>::splitByTimeVector(
     }
   } // END-OF-WHILE
 
-  return;
+  // Size the outputs from the number of entries of each, then fill them
+  std::vector<size_t> counts(outputs.size(), 0);
+  for (const auto &entry : selected)
+    ++counts[entry.first];
+  for (size_t i = 0; i < outputs.size(); ++i)
+    if (counts[i] > 0)
+      outputs[i]->reserve(outputs[i]->realSize() + counts[i]);
+  for (const auto &entry : selected)
+    outputs[entry.first]->addValue(m_values[entry.second].time(),
+                                   m_values[entry.second].value());
 }
 
 // The makeFilterByValue & expandFilterToRange methods generate a bunch of
@@ -1733,50 +1744,46 @@ void TimeSeriesProperty<TYPE>::filterWith(
     return;
   }
 
-  // 2. Construct mFilter
-  std::vector<Types::Core::DateAndTime> filtertimes = filter->timesAsVector();
-  std::vector<bool> filtervalues = filter->valuesAsVector();
-  assert(filtertimes.size() == filtervalues.size());
-  const size_t nFilterTimes(filtertimes.size());
-  m_filter.reserve(nFilterTimes + 1);
+  // 2. Construct mFilter, reading the sorted entries of the filter in place
+  filter->sortIfNecessary();
+  const auto &filterValues = filter->m_values;
+  m_filter.reserve(filterValues.size() + 1);
 
   bool lastIsTrue = false;
-  auto fend = filtertimes.end();
-  auto vit = filtervalues.begin();
-  for (auto fit = filtertimes.begin(); fit != fend; ++fit) {
-    if (*vit && !lastIsTrue) {
+  for (const auto &entry : filterValues) {
+    if (entry.value() && !lastIsTrue) {
       // Get a true in filter but last recorded value is for false
-      m_filter.emplace_back(*fit, true);
+      m_filter.emplace_back(entry.time(), true);
       lastIsTrue = true;
-    } else if (!(*vit) && lastIsTrue) {
+    } else if (!entry.value() && lastIsTrue) {
       // Get a False in filter but last recorded value is for TRUE
-      m_filter.emplace_back(*fit, false);
+      m_filter.emplace_back(entry.time(), false);
       lastIsTrue = false;
     }
-    ++vit; // move to next value
   }
 
   // 2b) Get a clean finish
-  if (filtervalues.back()) {
+  if (filterValues.back().value()) {
+    const DateAndTime lastFilterTime = filterValues.back().time();
     DateAndTime lastTime, nextLastT;
-    if (m_values.back().time() > filtertimes.back()) {
+    if (m_values.back().time() > lastFilterTime) {
       const size_t nvalues(m_values.size());
       // Last log time is later than last filter time
       lastTime = m_values.back().time();
-      if (nvalues > 1 && m_values[nvalues - 2].time() > filtertimes.back())
+      if (nvalues > 1 && m_values[nvalues - 2].time() > lastFilterTime)
         nextLastT = m_values[nvalues - 2].time();
       else
-        nextLastT = filtertimes.back();
+        nextLastT = lastFilterTime;
     } else {
       // Last log time is no later than last filter time
-      lastTime = filtertimes.back();
-      const size_t nfilterValues(filtervalues.size());
+      lastTime = lastFilterTime;
+      const size_t nfilterValues(filterValues.size());
       // If last-but-one filter time is still later than value then previous is
       // this
       // else it is the last value time
       if (nfilterValues > 1 &&
-          m_values.back().time() > filtertimes[nfilterValues - 2])
-        nextLastT = filtertimes[nfilterValues - 2];
+          m_values.back().time() > filterValues[nfilterValues - 2].time())
+        nextLastT = filterValues[nfilterValues - 2].time();
       else
         nextLastT = m_values.back().time();
     }
@@ -10,6 +10,25 @@
 namespace Mantid {
 namespace Kernel {
 
+namespace {
+/** Convert values to TOF in place with the conversion of a given unit class.
+ * The call is qualified with the class, so it is bound at compile time and
+ * can be inlined in the loop instead of being a virtual call per value.
+ */
+template <class UnitType>
+void toTOFInPlace(const UnitType &unit, double *first, double *last) {
+  for (; first != last; ++first)
+    *first = unit.UnitType::singleToTOF(*first);
+}
+
+/// Convert TOF values in place to a given unit class. @see toTOFInPlace()
+template <class UnitType>
+void fromTOFInPlace(const UnitType &unit, double *first, double *last) {
+  for (; first != last; ++first)
+    *first = unit.UnitType::singleFromTOF(*first);
+}
+} // namespace
+
 /**
  * Default constructor
  * Gives the unit an empty UnitLabel
@@ -138,9 +157,7 @@ void Unit::toTOF(std::vector<double> &xdata, std::vector<double> &ydata,
                  const double &_delta) {
   UNUSED_ARG(ydata);
   this->initialize(_l1, _l2, _twoTheta, _emode, _efixed, _delta);
-  size_t numX = xdata.size();
-  for (size_t i = 0; i < numX; i++)
-    xdata[i] = this->singleToTOF(xdata[i]);
+  this->toTOFBatch(xdata.data(), xdata.data() + xdata.size());
 }
 
 /** Convert a single value to TOF
@@ -169,9 +186,7 @@ void Unit::fromTOF(std::vector<double> &xdata, std::vector<double> &ydata,
                    const double &_efixed, const double &_delta) {
   UNUSED_ARG(ydata);
   this->initialize(_l1, _l2, _twoTheta, _emode, _efixed, _delta);
-  size_t numX = xdata.size();
-  for (size_t i = 0; i < numX; i++)
-    xdata[i] = this->singleFromTOF(xdata[i]);
+  this->fromTOFBatch(xdata.data(), xdata.data() + xdata.size());
 }
 
 /** Convert a single value from TOF
@@ -191,6 +206,18 @@ double Unit::convertSingleFromTOF(const double xvalue, const double &l1,
   return this->singleFromTOF(xvalue);
 }
 
+/// @see Unit::toTOFBatch(double *, double *)
+void Unit::toTOFBatch(double *first, double *last) const {
+  for (; first != last; ++first)
+    *first = this->singleToTOF(*first);
+}
+
+/// @see Unit::fromTOFBatch(double *, double *)
+void Unit::fromTOFBatch(double *first, double *last) const {
+  for (; first != last; ++first)
+    *first = this->singleFromTOF(*first);
+}
+
 std::pair<double, double> Unit::conversionRange() const {
   double u1 = this->singleFromTOF(this->conversionTOFMin());
   double u2 = this->singleFromTOF(this->conversionTOFMax());
@@ -288,6 +315,9 @@ double TOF::singleFromTOF(const double tof) const {
 }
 
 Unit *TOF::clone() const { return new TOF(*this); }
+// Nothing to do
+void TOF::toTOFBatch(double *, double *) const {}
+void TOF::fromTOFBatch(double *, double *) const {}
 double TOF::conversionTOFMin() const { return -DBL_MAX; }
 ///@return DBL_MAX as ToF convetanble to TOF for in any time range
 double TOF::conversionTOFMax() const { return DBL_MAX; }
@@ -416,6 +446,12 @@ double Wavelength::conversionTOFMax() const {
 }
 
 Unit *Wavelength::clone() const { return new Wavelength(*this); }
+void Wavelength::toTOFBatch(double *first, double *last) const {
+  toTOFInPlace(*this, first, last);
+}
+void Wavelength::fromTOFBatch(double *first, double *last) const {
+  fromTOFInPlace(*this, first, last);
+}
 
 // ============================================================================================
 /* ENERGY
@@ -581,6 +617,12 @@ double dSpacing::conversionTOFMin() const { return 0; }
 double dSpacing::conversionTOFMax() const { return DBL_MAX / factorTo; }
 
 Unit *dSpacing::clone() const { return new dSpacing(*this); }
+void dSpacing::toTOFBatch(double *first, double *last) const {
+  toTOFInPlace(*this, first, last);
+}
+void dSpacing::fromTOFBatch(double *first, double *last) const {
+  fromTOFInPlace(*this, first, last);
+}
 
 // ==================================================================================================
 /* D-SPACING Perpendicular
@@ -694,6 +736,12 @@ double MomentumTransfer::conversionTOFMin() const {
 double MomentumTransfer::conversionTOFMax() const { return DBL_MAX; }
 
 Unit *MomentumTransfer::clone() const { return new MomentumTransfer(*this); }
+void MomentumTransfer::toTOFBatch(double *first, double *last) const {
+  toTOFInPlace(*this, first, last);
+}
+void MomentumTransfer::fromTOFBatch(double *first, double *last) const {
+  fromTOFInPlace(*this, first, last);
+}
 
 /* ===================================================================================================
  * Q-SQUARED
@@ -878,6 +926,12 @@ double DeltaE::conversionTOFMax() const {
 }
 
 Unit *DeltaE::clone() const { return new DeltaE(*this); }
+void DeltaE::toTOFBatch(double *first, double *last) const {
+  toTOFInPlace(*this, first, last);
+}
+void DeltaE::fromTOFBatch(double *first, double *last) const {
+  fromTOFInPlace(*this, first, last);
+}
 
 // =====================================================================================================
 /* Energy Transfer in units of wavenumber
@@ -1064,6 +1118,12 @@ double Momentum::singleFromTOF(const double tof) const {
 }
 
 Unit *Momentum::clone() const { return new Momentum(*this); }
+void Momentum::toTOFBatch(double *first, double *last) const {
+  toTOFInPlace(*this, first, last);
+}
+void Momentum::fromTOFBatch(double *first, double *last) const {
+  fromTOFInPlace(*this, first, last);
+}
 
 // ============================================================================================
 /* SpinEchoLength
@@ -1115,6 +1175,12 @@ double SpinEchoLength::singleFromTOF(const double tof) const {
 }
 
 Unit *SpinEchoLength::clone() const { return new SpinEchoLength(*this); }
+void SpinEchoLength::toTOFBatch(double *first, double *last) const {
+  toTOFInPlace(*this, first, last);
+}
+void SpinEchoLength::fromTOFBatch(double *first, double *last) const {
+  fromTOFInPlace(*this, first, last);
+}
 
 // ============================================================================================
 /* SpinEchoTime
@@ -1160,6 +1226,12 @@ double SpinEchoTime::singleFromTOF(const double tof) const {
 }
 
 Unit *SpinEchoTime::clone() const { return new SpinEchoTime(*this); }
+void SpinEchoTime::toTOFBatch(double *first, double *last) const {
+  toTOFInPlace(*this, first, last);
+}
+void SpinEchoTime::fromTOFBatch(double *first, double *last) const {
+  fromTOFInPlace(*this, first, last);
+}
 
 // ================================================================================
 /* Time
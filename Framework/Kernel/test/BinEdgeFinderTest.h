@@ -0,0 +1,154 @@
+#ifndef MANTID_KERNEL_BINEDGEFINDERTEST_H_
+#define MANTID_KERNEL_BINEDGEFINDERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/BinEdgeFinder.h"
+#include "MantidKernel/VectorHelper.h"
+
+#include <algorithm>
+#include <limits>
+
+using Mantid::Kernel::BinEdgeFinder;
+
+class BinEdgeFinderTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BinEdgeFinderTest *createSuite() { return new BinEdgeFinderTest(); }
+  static void destroySuite(BinEdgeFinderTest *suite) { delete suite; }
+
+  void test_linear_edges() {
+    std::vector<double> edges;
+    Mantid::Kernel::VectorHelper::createAxisFromRebinParams({0., 2., 100.},
+                                                            edges);
+    BinEdgeFinder finder(edges);
+    TS_ASSERT(finder.spacing() == BinEdgeFinder::Spacing::Linear);
+    TS_ASSERT_EQUALS(finder.numberOfBins(), 50);
+    TS_ASSERT_EQUALS(finder.bin(-0.1), -1);
+    TS_ASSERT_EQUALS(finder.bin(100.0), -1);
+    TS_ASSERT_EQUALS(finder.bin(0.0), 0);
+    TS_ASSERT_EQUALS(finder.bin(1.999), 0);
+    TS_ASSERT_EQUALS(finder.bin(2.0), 1);
+    TS_ASSERT_EQUALS(finder.bin(99.), 49);
+  }
+
+  void test_logarithmic_edges() {
+    std::vector<double> edges;
+    Mantid::Kernel::VectorHelper::createAxisFromRebinParams({2., -1., 1024.},
+                                                            edges);
+    BinEdgeFinder finder(edges);
+    TS_ASSERT(finder.spacing() == BinEdgeFinder::Spacing::Logarithmic);
+    TS_ASSERT_EQUALS(finder.bin(1.8), -1);
+    TS_ASSERT_EQUALS(finder.bin(1025.0), -1);
+    TS_ASSERT_EQUALS(finder.bin(2.0), 0);
+    TS_ASSERT_EQUALS(finder.bin(3.999), 0);
+    TS_ASSERT_EQUALS(finder.bin(4.0), 1);
+    TS_ASSERT_EQUALS(finder.bin(512.1), 8);
+    TS_ASSERT_EQUALS(finder.bin(1023.9), 8);
+  }
+
+  void test_arbitrary_edges() {
+    const std::vector<double> edges{0., 1., 5., 6., 20.};
+    BinEdgeFinder finder(edges);
+    TS_ASSERT(finder.spacing() == BinEdgeFinder::Spacing::Arbitrary);
+    TS_ASSERT(!finder.isRegular());
+    TS_ASSERT_EQUALS(finder.bin(0.5), 0);
+    TS_ASSERT_EQUALS(finder.bin(5.0), 2);
+    TS_ASSERT_EQUALS(finder.bin(19.), 3);
+    TS_ASSERT_EQUALS(finder.bin(20.), -1);
+  }
+
+  void test_unsorted_edges_are_arbitrary() {
+    const std::vector<double> edges{0., 2., 1., 3.};
+    BinEdgeFinder finder(edges);
+    TS_ASSERT(finder.spacing() == BinEdgeFinder::Spacing::Arbitrary);
+  }
+
+  void test_no_bins() {
+    const std::vector<double> edges{1.};
+    BinEdgeFinder finder(edges);
+    TS_ASSERT_EQUALS(finder.numberOfBins(), 0);
+    TS_ASSERT_EQUALS(finder.bin(1.), -1);
+    const std::vector<double> empty;
+    BinEdgeFinder emptyFinder(empty);
+    TS_ASSERT_EQUALS(emptyFinder.bin(0.), -1);
+  }
+
+  void test_nan_is_outside() {
+    const std::vector<double> edges{0., 1., 2.};
+    BinEdgeFinder finder(edges);
+    TS_ASSERT_EQUALS(finder.bin(std::numeric_limits<double>::quiet_NaN()), -1);
+  }
+
+  void test_shorter_last_bin_from_rebin_is_linear() {
+    std::vector<double> edges;
+    Mantid::Kernel::VectorHelper::createAxisFromRebinParams({0., 3., 10.},
+                                                            edges);
+    BinEdgeFinder finder(edges);
+    TS_ASSERT(finder.isRegular());
+    TS_ASSERT_EQUALS(finder.bin(9.5), 3);
+  }
+
+  void test_bin_matches_search_for_every_spacing() {
+    std::vector<double> linear, logarithmic;
+    Mantid::Kernel::VectorHelper::createAxisFromRebinParams({-10., 0.1, 1000.},
+                                                            linear);
+    Mantid::Kernel::VectorHelper::createAxisFromRebinParams(
+        {0.5, -0.001, 20000.}, logarithmic);
+    const std::vector<double> arbitrary{-1., 0., 0.5, 7., 100., 2e4};
+    const std::vector<const std::vector<double> *> allEdges{
+        &linear, &logarithmic, &arbitrary};
+    for (const auto *edges : allEdges) {
+      BinEdgeFinder finder(*edges);
+      std::vector<double> values;
+      for (int i = 0; i < 20000; ++i)
+        values.push_back(static_cast<double>((i * 7919) % 20000) * 1.01 - 20.);
+      // Exact edges are the hardest case for a computed index
+      values.insert(values.end(), edges->begin(), edges->end());
+      std::vector<int64_t> indices(values.size());
+      finder.bins(values.data(), values.size(), indices.data());
+      for (size_t i = 0; i < values.size(); ++i) {
+        const auto expected = search(*edges, values[i]);
+        TS_ASSERT_EQUALS(finder.bin(values[i]), expected);
+        TS_ASSERT_EQUALS(indices[i], expected);
+      }
+    }
+  }
+
+private:
+  int64_t search(const std::vector<double> &edges, const double x) {
+    if (x < edges.front() || x >= edges.back())
+      return -1;
+    return std::upper_bound(edges.begin(), edges.end(), x) - edges.begin() - 1;
+  }
+};
+
+class BinEdgeFinderTestPerformance : public CxxTest::TestSuite {
+public:
+  static BinEdgeFinderTestPerformance *createSuite() {
+    return new BinEdgeFinderTestPerformance();
+  }
+  static void destroySuite(BinEdgeFinderTestPerformance *suite) {
+    delete suite;
+  }
+
+  BinEdgeFinderTestPerformance() : m_values(10000000), m_indices(10000000) {
+    Mantid::Kernel::VectorHelper::createAxisFromRebinParams({0., 10., 20000.},
+                                                            m_edges);
+    for (size_t i = 0; i < m_values.size(); ++i)
+      m_values[i] = static_cast<double>((i * 7919) % 20000);
+  }
+
+  void test_bins_linear() {
+    BinEdgeFinder finder(m_edges);
+    finder.bins(m_values.data(), m_values.size(), m_indices.data());
+  }
+
+private:
+  std::vector<double> m_edges;
+  std::vector<double> m_values;
+  std::vector<int64_t> m_indices;
+};
+
+#endif /* MANTID_KERNEL_BINEDGEFINDERTEST_H_ */
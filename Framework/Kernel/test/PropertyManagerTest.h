@@ -9,6 +9,7 @@
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/MandatoryValidator.h"
 #include "MantidKernel/TimeSeriesProperty.h"
+#include "MantidKernel/TimeSplitter.h"
 #include "MantidKernel/FilteredTimeSeriesProperty.h"
 #include "MantidKernel/OptionalBool.h"
 
@@ -16,6 +17,7 @@
 #include <json/json.h>
 
 using namespace Mantid::Kernel;
+using Mantid::Types::Core::DateAndTime;
 
 namespace {
 class MockNonSerializableProperty : public PropertyWithValue<int> {
@@ -26,6 +28,23 @@ public:
   using PropertyWithValue<int>::operator=;
 };
 
+/// A property whose filtering and splitting always fail
+class ThrowingTimeProperty : public PropertyWithValue<int> {
+public:
+  explicit ThrowingTimeProperty(const std::string &name)
+      : PropertyWithValue<int>(name, 0) {}
+  ThrowingTimeProperty *clone() const override {
+    return new ThrowingTimeProperty(*this);
+  }
+  void filterByTime(const DateAndTime &, const DateAndTime &) override {
+    throw std::runtime_error("filterByTime failed");
+  }
+  void splitByTime(std::vector<SplittingInterval> &, std::vector<Property *>,
+                   bool) const override {
+    throw std::runtime_error("splitByTime failed");
+  }
+};
+
 /// Create the test source property
 std::unique_ptr<Mantid::Kernel::TimeSeriesProperty<double>>
 createTestSeries(const std::string &name) {
@@ -109,6 +128,80 @@ public:
     delete filter;
   }
 
+  void testFilterByLogFiltersEachSeriesLikeFilterWith() {
+    PropertyManagerHelper manager;
+    manager.declareProperty(createTestSeries("log1"));
+    manager.declareProperty("aProp", 10);
+    manager.declareProperty(createTestSeries("log2"));
+
+    std::unique_ptr<TimeSeriesProperty<bool>> filter(createTestFilter());
+    manager.filterByProperty(*filter);
+
+    auto expected = createTestSeries("expected");
+    expected->filterWith(filter.get());
+    for (const std::string name : {"log1", "log2"}) {
+      auto filtered = dynamic_cast<FilteredTimeSeriesProperty<double> *>(
+          manager.getPointerToProperty(name));
+      TS_ASSERT(filtered);
+      if (!filtered)
+        continue;
+      TS_ASSERT_EQUALS(filtered->filteredValuesAsVector(),
+                       expected->filteredValuesAsVector());
+      TS_ASSERT_EQUALS(filtered->unfiltered()->valuesAsVector(),
+                       expected->valuesAsVector());
+    }
+    TS_ASSERT_EQUALS(static_cast<int>(manager.getProperty("aProp")), 10);
+  }
+
+  void testSplitByTimeSplitsEveryTimeSeries() {
+    PropertyManagerHelper manager;
+    manager.declareProperty(createTestSeries("log1"));
+    manager.declareProperty(createTestSeries("log2"));
+    std::vector<PropertyManagerHelper> outputs(2);
+    for (auto &output : outputs) {
+      output.declareProperty(
+          make_unique<TimeSeriesProperty<double>>("log1"));
+      output.declareProperty(
+          make_unique<TimeSeriesProperty<double>>("log2"));
+    }
+
+    std::vector<SplittingInterval> splitter;
+    splitter.emplace_back(DateAndTime("2007-11-30T16:17:00"),
+                          DateAndTime("2007-11-30T16:17:15"), 0);
+    splitter.emplace_back(DateAndTime("2007-11-30T16:17:15"),
+                          DateAndTime("2007-11-30T16:17:50"), 1);
+    manager.splitByTime(splitter, {&outputs[0], &outputs[1]});
+
+    for (const std::string name : {"log1", "log2"}) {
+      auto first = dynamic_cast<TimeSeriesProperty<double> *>(
+          outputs[0].getPointerToProperty(name));
+      auto second = dynamic_cast<TimeSeriesProperty<double> *>(
+          outputs[1].getPointerToProperty(name));
+      TS_ASSERT_EQUALS(first->valuesAsVector(),
+                       std::vector<double>({1., 2.}));
+      TS_ASSERT_EQUALS(second->valuesAsVector(),
+                       std::vector<double>({2., 3., 4., 5.}));
+    }
+  }
+
+  void testFilterAndSplitByTimeRethrowAfterTheParallelLoop() {
+    PropertyManagerHelper manager;
+    manager.declareProperty(createTestSeries("log1"));
+    manager.declareProperty(make_unique<ThrowingTimeProperty>("bad"));
+    manager.declareProperty(createTestSeries("log2"));
+
+    PropertyManagerHelper output;
+    std::vector<SplittingInterval> splitter;
+    splitter.emplace_back(DateAndTime("2007-11-30T16:17:00"),
+                          DateAndTime("2007-11-30T16:17:50"), 0);
+    TS_ASSERT_THROWS(manager.splitByTime(splitter, {&output}),
+                     std::runtime_error);
+    TS_ASSERT_THROWS(manager.filterByTime(DateAndTime("2007-11-30T16:17:00"),
+                                          DateAndTime("2007-11-30T16:17:50")),
+                     std::runtime_error);
+    TS_ASSERT_EQUALS(manager.propertyCount(), 3);
+  }
+
   void testCopyConstructor() {
     PropertyManagerHelper mgr1;
     mgr1.declareProperty("aProp", 10);
@@ -625,6 +718,15 @@ public:
     m_manager.filterByProperty(*m_filter);
   }
 
+  void test_Perf_Of_Splitting_Large_Number_Of_Properties() {
+    std::vector<SplittingInterval> splitter;
+    const DateAndTime start("2007-11-30T16:17:00");
+    for (int i = 0; i < 1000; ++i)
+      splitter.emplace_back(start + 0.05 * i, start + 0.05 * (i + 1), i % 2);
+    PropertyManagerHelper first(m_manager), second(m_manager);
+    m_manager.splitByTime(splitter, {&first, &second});
+  }
+
 private:
   /// Test manager
   PropertyManagerHelper m_manager;
@@ -0,0 +1,136 @@
+#ifndef MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_
+#define MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_
+
+#include <cxxtest/TestSuite.h>
+#include <boost/make_shared.hpp>
+
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+
+using namespace Mantid::Kernel;
+
+int ThreadSchedulerWorkStealingTest_timesDeleted;
+
+class ThreadSchedulerWorkStealingTest : public CxxTest::TestSuite {
+public:
+  /** A custom implementation of Task,
+   * that sets its mutex */
+  class TaskWithMutex : public Task {
+  public:
+    TaskWithMutex(boost::shared_ptr<std::mutex> mutex, double cost) {
+      m_mutex = mutex;
+      m_cost = cost;
+    }
+
+    /// Count # of times destructed in the destructor
+    ~TaskWithMutex() override {
+      ThreadSchedulerWorkStealingTest_timesDeleted++;
+    }
+
+    void run() override {}
+  };
+
+  void test_constructor() {
+    ThreadSchedulerWorkStealing sc(3);
+    TS_ASSERT_EQUALS(sc.numQueues(), 3);
+    TS_ASSERT(sc.empty());
+    ThreadSchedulerWorkStealing scDefault;
+    TS_ASSERT_LESS_THAN_EQUALS(1, scDefault.numQueues());
+  }
+
+  void test_push_from_outside_the_pool_spreads_the_tasks() {
+    ThreadSchedulerWorkStealing sc(2);
+    for (size_t i = 0; i < 4; i++)
+      sc.push(new TaskWithMutex(boost::shared_ptr<std::mutex>(), 1.0));
+    TS_ASSERT_EQUALS(sc.size(), 4);
+    TS_ASSERT(!sc.empty());
+    TS_ASSERT_EQUALS(sc.queueSize(0), 2);
+    TS_ASSERT_EQUALS(sc.queueSize(1), 2);
+    TS_ASSERT_DELTA(sc.totalCost(), 4.0, 1e-10);
+  }
+
+  void test_pop_largest_cost_then_steal() {
+    ThreadSchedulerWorkStealing sc(2);
+    TaskWithMutex *task1 = new TaskWithMutex(nullptr, 1.0);
+    TaskWithMutex *task2 = new TaskWithMutex(nullptr, 2.0);
+    TaskWithMutex *task3 = new TaskWithMutex(nullptr, 3.0);
+    TaskWithMutex *task4 = new TaskWithMutex(nullptr, 4.0);
+    // task1 and task3 go to queue 0, task2 and task4 to queue 1
+    sc.push(task1);
+    sc.push(task2);
+    sc.push(task3);
+    sc.push(task4);
+
+    // Thread 0 takes the largest of its own tasks first
+    TS_ASSERT_EQUALS(sc.pop(0), task3);
+    TS_ASSERT_EQUALS(sc.pop(0), task1);
+    // then steals from queue 1
+    TS_ASSERT_EQUALS(sc.pop(0), task4);
+    TS_ASSERT_EQUALS(sc.pop(1), task2);
+    TS_ASSERT(sc.empty());
+    TS_ASSERT(!sc.pop(1));
+    TS_ASSERT_DELTA(sc.totalCostExecuted(), 10.0, 1e-10);
+
+    delete task1;
+    delete task2;
+    delete task3;
+    delete task4;
+  }
+
+  void test_tasks_pushed_by_a_running_task_go_to_its_queue() {
+    ThreadSchedulerWorkStealing sc(4);
+    TaskWithMutex *task = new TaskWithMutex(nullptr, 1.0);
+    sc.push(task);
+    // Thread 2 steals the task and runs it
+    TS_ASSERT_EQUALS(sc.pop(2), task);
+    for (size_t i = 0; i < 3; i++)
+      sc.push(new TaskWithMutex(nullptr, 1.0));
+    TS_ASSERT_EQUALS(sc.queueSize(2), 3);
+    sc.finished(task, 2);
+    delete task;
+  }
+
+  void test_busy_mutexes_are_avoided() {
+    ThreadSchedulerWorkStealing sc(1);
+    auto mut1 = boost::make_shared<std::mutex>();
+    auto mut2 = boost::make_shared<std::mutex>();
+    TaskWithMutex *task1 = new TaskWithMutex(mut1, 10.0);
+    TaskWithMutex *task2 = new TaskWithMutex(mut1, 9.0);
+    TaskWithMutex *task3 = new TaskWithMutex(mut2, 8.0);
+    TaskWithMutex *task4 = new TaskWithMutex(mut1, 7.0);
+    sc.push(task1);
+    sc.push(task2);
+    sc.push(task3);
+    sc.push(task4);
+
+    // mut1 becomes busy, so task3 comes before task2
+    TS_ASSERT_EQUALS(sc.pop(0), task1);
+    TS_ASSERT_EQUALS(sc.pop(0), task3);
+    // Both mutexes are busy: the largest task is returned anyway
+    TS_ASSERT_EQUALS(sc.pop(0), task2);
+    sc.finished(task1, 0);
+    sc.finished(task2, 0);
+    sc.finished(task3, 0);
+    TS_ASSERT_EQUALS(sc.pop(0), task4);
+    TS_ASSERT(sc.empty());
+
+    delete task1;
+    delete task2;
+    delete task3;
+    delete task4;
+  }
+
+  void test_clear() {
+    ThreadSchedulerWorkStealing sc(3);
+    for (size_t i = 0; i < 10; i++)
+      sc.push(new TaskWithMutex(boost::make_shared<std::mutex>(), 10.0));
+    TS_ASSERT_EQUALS(sc.size(), 10);
+    ThreadSchedulerWorkStealingTest_timesDeleted = 0;
+    sc.clear();
+    TS_ASSERT_EQUALS(sc.size(), 0);
+    TS_ASSERT(sc.empty());
+    TS_ASSERT_EQUALS(ThreadSchedulerWorkStealingTest_timesDeleted, 10);
+    TS_ASSERT_EQUALS(sc.totalCost(), 0.0);
+  }
+};
+
+#endif /* MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_ */
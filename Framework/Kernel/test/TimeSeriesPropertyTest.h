@@ -712,6 +712,34 @@ public:
     delete outputs[0];
   }
 
+  //----------------------------------------------------------------------------
+  void test_splitByTime_skips_splitters_with_an_invalid_output() {
+    TimeSeriesProperty<int> *log = createIntegerTSP(12);
+    std::vector<Property *> outputs{new TimeSeriesProperty<int>("MyIntLog"),
+                                    new TimeSeriesProperty<double>("Other")};
+
+    TimeSplitterType splitter;
+    splitter.emplace_back(DateAndTime("2007-11-30T16:17:10"),
+                          DateAndTime("2007-11-30T16:17:20"), 5);
+    splitter.emplace_back(DateAndTime("2007-11-30T16:17:20"),
+                          DateAndTime("2007-11-30T16:17:30"), 1);
+    splitter.emplace_back(DateAndTime("2007-11-30T16:17:30"),
+                          DateAndTime("2007-11-30T16:17:50"), 0);
+
+    log->splitByTime(splitter, outputs, false);
+
+    auto output = dynamic_cast<TimeSeriesProperty<int> *>(outputs[0]);
+    TS_ASSERT_EQUALS(output->realSize(), 2);
+    TS_ASSERT_EQUALS(output->size(), 2);
+    TS_ASSERT_EQUALS(output->firstTime(), DateAndTime("2007-11-30T16:17:30"));
+    TS_ASSERT_EQUALS(output->lastTime(), DateAndTime("2007-11-30T16:17:40"));
+    TS_ASSERT_EQUALS(outputs[1]->size(), 0);
+
+    delete log;
+    delete outputs[0];
+    delete outputs[1];
+  }
+
   //----------------------------------------------------------------------------
   /**
    * otuput 0 has entries: 3
@@ -1384,6 +1384,32 @@ public:
     }
   }
 
+  void test_batch_conversions_match_single_conversions() {
+    std::vector<Unit *> units{&tof,  &lambda, &energy, &d,   &q,    &dE,
+                              &dEk, &dEf,    &k_i,    &delta, &tau};
+    for (auto unit : units) {
+      // Direct geometry, so that DeltaE and the sample-frame corrections of
+      // Wavelength and Momentum are exercised. Spin echo units are elastic.
+      const int emode = (unit == &delta || unit == &tau) ? 0 : 1;
+      unit->initialize(10., 2., 0.5, emode, 60., 0.);
+      std::vector<double> tofs;
+      for (int i = 0; i < 100; ++i)
+        tofs.push_back(2000. + 150. * i);
+
+      std::vector<double> x(tofs);
+      unit->fromTOFBatch(x.data(), x.data() + x.size());
+      for (size_t i = 0; i < x.size(); ++i)
+        TSM_ASSERT_DELTA(unit->unitID(), x[i], unit->singleFromTOF(tofs[i]),
+                         1e-12 * std::fabs(x[i]));
+
+      std::vector<double> back(x);
+      unit->toTOFBatch(back.data(), back.data() + back.size());
+      for (size_t i = 0; i < x.size(); ++i)
+        TSM_ASSERT_DELTA(unit->unitID(), back[i], unit->singleToTOF(x[i]),
+                         1e-12 * std::fabs(back[i]));
+    }
+  }
+
   /// Test unit Degress
   void testDegress() {
     TS_ASSERT_EQUALS(degrees.caption(), "Scattering angle");
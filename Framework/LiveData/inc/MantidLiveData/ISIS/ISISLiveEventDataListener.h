@@ -148,7 +148,8 @@ protected:
   void initEventBuffer(const TCPStreamEventDataSetup &setup);
   // Save received event data in the buffer workspace
   void saveEvents(const std::vector<TCPStreamEventNeutron> &data,
-                  const Types::Core::DateAndTime &pulseTime, size_t period);
+                  const Types::Core::DateAndTime &pulseTime, double protons,
+                  size_t period);
   // Set the spectra-detector map
   void loadSpectraMap();
   // Load the instrument
@@ -125,6 +125,13 @@ private:
   std::unique_ptr<IKafkaStreamSubscriber> m_eventStream;
   /// Local event workspace buffers
   std::vector<DataObjects::EventWorkspace_sptr> m_localEvents;
+  /// Workspace index of each event of the message being decoded
+  std::vector<size_t> m_eventWsIndices;
+  /// Indices of the events of the message being decoded, grouped by shard of
+  /// spectra
+  std::vector<size_t> m_shardEvents;
+  /// Position in m_shardEvents of the first event of each shard, and the end
+  std::vector<size_t> m_shardOffsets;
   /// Mapping of spectrum number to workspace index.
   spec2index_map m_specToIdx;
   /// Start time of the run
@@ -152,6 +159,11 @@ private:
   /// For notifying other threads of changes to conditions (the following bools)
   std::condition_variable m_cv;
   std::condition_variable m_cvRunStatus;
+  /// Notifies the extraction that the events of a message have been decoded
+  std::condition_variable m_cvDecoding;
+  /// Indicate that the events of a message are being decoded into a buffer,
+  /// without m_mutex. Protected by m_mutex.
+  bool m_decoding;
   /// Indicate that decoder has reached the last message in a run
   std::atomic<bool> m_endRun;
   /// Indicate that LoadLiveData is waiting for access to the buffer workspace
@@ -113,7 +113,7 @@ private:
   // Returns true if we've got a value for every log listed in m_requiredLogs
   bool haveRequiredLogs();
 
-  void appendEvent(const uint32_t pixelId, const double tof,
+  bool appendEvent(const uint32_t pixelId, const double tof,
                    const Mantid::Types::Core::DateAndTime pulseTime);
   // tof is "Time Of Flight" and is in units of microsecondss relative to the
   // start of the pulse
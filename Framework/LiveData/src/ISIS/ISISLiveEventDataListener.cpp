@@ -45,6 +45,8 @@ ISISLiveEventDataListener::ISISLiveEventDataListener()
     : LiveListener(), m_isConnected(false), m_stopThread(false), m_runNumber(0),
       m_daeHandle(), m_numberOfPeriods(0), m_numberOfSpectra(0) {
   m_warnings["period"] = "Period number is outside the range. Changed to 0.";
+  m_warnings["spectrum"] =
+      "Spectrum number is outside the range. Events are dropped.";
 }
 
 /**
@@ -169,31 +171,24 @@ boost::shared_ptr<API::Workspace> ISISLiveEventDataListener::extractData() {
     throw std::runtime_error("Background thread stopped.");
   }
 
-  std::lock_guard<std::mutex> scopedLock(m_mutex);
-
-  std::vector<DataObjects::EventWorkspace_sptr> outWorkspaces(
-      m_numberOfPeriods);
-  for (size_t i = 0; i < static_cast<size_t>(m_numberOfPeriods); ++i) {
-
-    // Make a brand new EventWorkspace
-    DataObjects::EventWorkspace_sptr temp =
-        boost::dynamic_pointer_cast<DataObjects::EventWorkspace>(
-            API::WorkspaceFactory::Instance().create(
-                "EventWorkspace", m_eventBuffer[i]->getNumberHistograms(), 2,
-                1));
-
-    // Copy geometry over.
-    API::WorkspaceFactory::Instance().initializeFromParent(*m_eventBuffer[i],
-                                                           *temp, false);
-
-    // Clear out the old logs
-    temp->mutableRun().clearTimeSeriesLogs();
-
-    // Swap the workspaces
-    std::swap(m_eventBuffer[i], temp);
+  // Empty buffers are prepared in the background, so that the events are
+  // extracted by swapping pointers and the network thread is barely held up
+  auto spareBuffers = takeSpareBuffers();
+  std::vector<DataObjects::EventWorkspace_sptr> outWorkspaces;
+  outWorkspaces.reserve(spareBuffers.size());
+  for (const auto &spareBuffer : spareBuffers) {
+    outWorkspaces.push_back(
+        boost::dynamic_pointer_cast<DataObjects::EventWorkspace>(spareBuffer));
+  }
 
-    outWorkspaces[i] = temp;
+  size_t numberOfEvents;
+  {
+    std::lock_guard<std::mutex> scopedLock(m_mutex);
+    std::swap(m_eventBuffer, outWorkspaces);
+    numberOfEvents = resetBufferedEvents();
   }
+  g_log.debug() << "Extracted " << numberOfEvents << " events, "
+                << droppedEvents() << " events dropped so far\n";
 
   if (m_numberOfPeriods > 1) {
     // create a workspace group in case the data are multiperiod
@@ -253,12 +248,8 @@ void ISISLiveEventDataListener::run() {
       // absolute pulse (frame) time
       Mantid::Types::Core::DateAndTime pulseTime =
           m_startTime + static_cast<double>(events.head_n.frame_time_zero);
-      // Save the pulse charge in the logs
+      // charge of the pulse, saved in the logs with the events
       double protons = static_cast<double>(events.head_n.protons);
-      m_eventBuffer[0]
-          ->mutableRun()
-          .getTimeSeriesProperty<double>(PROTON_CHARGE_PROPERTY)
-          ->addValue(pulseTime, protons);
 
       events.data.resize(events.head_n.nevents);
       uint32_t nread = 0;
@@ -283,7 +274,7 @@ void ISISLiveEventDataListener::run() {
       }
 
       // store the events
-      saveEvents(events.data, pulseTime, events.head_n.period);
+      saveEvents(events.data, pulseTime, protons, events.head_n.period);
     }
 
   } catch (std::runtime_error &e) {
@@ -370,17 +361,30 @@ void ISISLiveEventDataListener::initEventBuffer(
           *m_eventBuffer[0], *m_eventBuffer[i], false);
     }
   }
+
+  initSpareBuffers(std::vector<API::MatrixWorkspace_sptr>(
+      m_eventBuffer.begin(), m_eventBuffer.end()));
 }
 
 /**
- * Save received event data in the buffer workspace.
+ * Save received event data in the buffer workspace. Events with an invalid
+ * spectrum index are dropped.
  * @param data :: A vector with events.
+ * @param pulseTime :: The time of the pulse (frame) of the events.
+ * @param protons :: The charge of the pulse, saved in the logs.
+ * @param period :: The period of the events.
  */
 void ISISLiveEventDataListener::saveEvents(
     const std::vector<TCPStreamEventNeutron> &data,
-    const Types::Core::DateAndTime &pulseTime, size_t period) {
+    const Types::Core::DateAndTime &pulseTime, double protons, size_t period) {
   std::lock_guard<std::mutex> scopedLock(m_mutex);
 
+  // Save the pulse charge in the logs
+  m_eventBuffer[0]
+      ->mutableRun()
+      .getTimeSeriesProperty<double>(PROTON_CHARGE_PROPERTY)
+      ->addValue(pulseTime, protons);
+
   if (period >= static_cast<size_t>(m_numberOfPeriods)) {
     auto warn = m_warnings.find("period");
     if (warn != m_warnings.end()) {
@@ -390,11 +394,25 @@ void ISISLiveEventDataListener::saveEvents(
     period = 0;
   }
 
+  auto &buffer = *m_eventBuffer[period];
+  const size_t numberOfHistograms = buffer.getNumberHistograms();
+  size_t dropped(0);
   for (const auto &streamEvent : data) {
+    if (streamEvent.spectrum >= numberOfHistograms) {
+      ++dropped;
+      continue;
+    }
     Types::Event::TofEvent event(streamEvent.time_of_flight, pulseTime);
-    m_eventBuffer[period]
-        ->getSpectrum(streamEvent.spectrum)
-        .addEventQuickly(event);
+    buffer.getSpectrum(streamEvent.spectrum).addEventQuickly(event);
+  }
+  countBufferedEvents(data.size() - dropped);
+  if (dropped > 0) {
+    countDroppedEvents(dropped);
+    auto warn = m_warnings.find("spectrum");
+    if (warn != m_warnings.end()) {
+      g_log.warning() << warn->second << '\n';
+      m_warnings.erase(warn);
+    }
   }
 }
 
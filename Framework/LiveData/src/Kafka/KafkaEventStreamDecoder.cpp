@@ -6,6 +6,7 @@
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidKernel/DateAndTimeHelpers.h"
 #include "MantidKernel/Logger.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/OptionalBool.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/UnitFactory.h"
@@ -39,6 +40,9 @@ const std::string SAMPLE_MESSAGE_ID = "f142";
 
 const std::chrono::seconds MAX_LATENCY(1);
 
+/// Number of events in a message above which they are decoded in parallel
+constexpr size_t PARALLEL_DECODING_THRESHOLD = 10000;
+
 /**
  * Append sample log data to existing log or create a new log if one with
  * specified name does not already exist
@@ -84,9 +88,10 @@ KafkaEventStreamDecoder::KafkaEventStreamDecoder(
     const std::string &sampleEnvTopic)
     : m_broker(broker), m_eventTopic(eventTopic), m_runInfoTopic(runInfoTopic),
       m_spDetTopic(spDetTopic), m_sampleEnvTopic(sampleEnvTopic),
-      m_interrupt(false), m_localEvents(), m_specToIdx(), m_runStart(),
-      m_runNumber(-1), m_thread(), m_capturing(false), m_exception(),
-      m_extractWaiting(false), m_cbIterationEnd([] {}), m_cbError([] {}) {}
+      m_interrupt(false), m_localEvents(), m_eventWsIndices(), m_specToIdx(),
+      m_runStart(), m_runNumber(-1), m_thread(), m_capturing(false),
+      m_exception(), m_decoding(false), m_extractWaiting(false),
+      m_cbIterationEnd([] {}), m_cbError([] {}) {}
 
 /**
  * Destructor.
@@ -202,7 +207,10 @@ API::Workspace_sptr KafkaEventStreamDecoder::extractData() {
 // -----------------------------------------------------------------------------
 
 API::Workspace_sptr KafkaEventStreamDecoder::extractDataImpl() {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  std::unique_lock<std::mutex> lock(m_mutex);
+  // The events of a message are added to the buffers without the lock: wait
+  // for the message being decoded, if any, so the buffers are complete
+  m_cvDecoding.wait(lock, [&] { return !m_decoding; });
   if (m_localEvents.size() == 1) {
     auto temp = createBufferWorkspace(m_localEvents.front());
     std::swap(m_localEvents.front(), temp);
@@ -507,24 +515,84 @@ void KafkaEventStreamDecoder::eventDataFromMessage(const std::string &buffer) {
   const auto &detData = *(eventMsg->detector_id());
   auto nEvents = tofData.size();
 
+  // Log the proton charge under the lock, with the buffer the events go to,
+  // so that the events and proton charge of a message are extracted together
+  m_eventWsIndices.resize(nEvents);
   DataObjects::EventWorkspace_sptr periodBuffer;
-  std::lock_guard<std::mutex> lock(m_mutex);
-  if (eventMsg->facility_specific_data_type() == FacilityData_ISISData) {
-    auto ISISMsg =
-        static_cast<const ISISData *>(eventMsg->facility_specific_data());
-    periodBuffer = m_localEvents[static_cast<size_t>(ISISMsg->period_number())];
-    auto &mutableRunInfo = periodBuffer->mutableRun();
-    mutableRunInfo.getTimeSeriesProperty<double>(PROTON_CHARGE_PROPERTY)
-        ->addValue(pulseTime, ISISMsg->proton_charge());
-  } else {
-    periodBuffer = m_localEvents[0];
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (eventMsg->facility_specific_data_type() == FacilityData_ISISData) {
+      auto ISISMsg =
+          static_cast<const ISISData *>(eventMsg->facility_specific_data());
+      periodBuffer =
+          m_localEvents[static_cast<size_t>(ISISMsg->period_number())];
+      auto &mutableRunInfo = periodBuffer->mutableRun();
+      mutableRunInfo.getTimeSeriesProperty<double>(PROTON_CHARGE_PROPERTY)
+          ->addValue(pulseTime, ISISMsg->proton_charge());
+    } else {
+      periodBuffer = m_localEvents[0];
+    }
+    m_decoding = true;
+  }
+  // Clear the flag however the decoding ends, so that the extraction waiting
+  // for it is not blocked
+  struct DecodingGuard {
+    KafkaEventStreamDecoder &decoder;
+    ~DecodingGuard() {
+      std::lock_guard<std::mutex> lock(decoder.m_mutex);
+      decoder.m_decoding = false;
+      decoder.m_cvDecoding.notify_one();
+    }
+  } decodingGuard{*this};
+
+  // Decode the events without the lock, in parallel for large messages. Their
+  // spectra are looked up first, then the events are grouped by shards of
+  // contiguous spectra with a counting sort and each thread adds the events
+  // of a shard, so the events of a spectrum keep the order of the messages.
+  const bool parallel = nEvents > PARALLEL_DECODING_THRESHOLD;
+  const auto nEventsInt = static_cast<int64_t>(nEvents);
+  PARALLEL_FOR_IF(parallel)
+  for (int64_t i = 0; i < nEventsInt; ++i) {
+    const auto event = static_cast<decltype(nEvents)>(i);
+    const auto specIdx = m_specToIdx.find(static_cast<int32_t>(detData[event]));
+    m_eventWsIndices[event] =
+        specIdx != m_specToIdx.end() ? specIdx->second : 0;
   }
-  for (decltype(nEvents) i = 0; i < nEvents; ++i) {
-    auto &spectrum = periodBuffer->getSpectrum(
-        m_specToIdx[static_cast<int32_t>(detData[i])]);
-    spectrum.addEventQuickly(TofEvent(static_cast<double>(tofData[i]) *
-                                          1e-3, // nanoseconds to microseconds
-                                      pulseTime));
+  const size_t nSpectra = periodBuffer->getNumberHistograms();
+  if (nSpectra == 0)
+    return;
+  const size_t nShards =
+      parallel ? std::min(static_cast<size_t>(PARALLEL_GET_MAX_THREADS),
+                          nSpectra)
+               : 1;
+  const auto shardOf = [nShards, nSpectra](const size_t wsIdx) {
+    return wsIdx * nShards / nSpectra;
+  };
+  m_shardOffsets.assign(nShards + 1, 0);
+  m_shardEvents.resize(nEvents);
+  for (size_t i = 0; i < nEvents; ++i)
+    ++m_shardOffsets[shardOf(m_eventWsIndices[i]) + 1];
+  for (size_t shard = 0; shard < nShards; ++shard)
+    m_shardOffsets[shard + 1] += m_shardOffsets[shard];
+  // The events of each shard are placed in the order of the message
+  std::vector<size_t> next(m_shardOffsets.begin(), m_shardOffsets.end() - 1);
+  for (size_t i = 0; i < nEvents; ++i)
+    m_shardEvents[next[shardOf(m_eventWsIndices[i])]++] = i;
+
+  PARALLEL_FOR_IF(parallel)
+  for (int64_t shardInt = 0; shardInt < static_cast<int64_t>(nShards);
+       ++shardInt) {
+    const auto shard = static_cast<size_t>(shardInt);
+    for (size_t j = m_shardOffsets[shard]; j < m_shardOffsets[shard + 1];
+         ++j) {
+      const size_t i = m_shardEvents[j];
+      // nanoseconds to microseconds
+      const double tof =
+          static_cast<double>(tofData[static_cast<decltype(nEvents)>(i)]) *
+          1e-3;
+      periodBuffer->getSpectrum(m_eventWsIndices[i])
+          .addEventQuickly(TofEvent(tof, pulseTime));
+    }
   }
 }
 
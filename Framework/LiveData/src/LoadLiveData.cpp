@@ -422,8 +422,14 @@ void LoadLiveData::exec() {
   bool dataNotYetGiven = true;
   while (dataNotYetGiven) {
     try {
+      const size_t bufferedEvents = listener->bufferedEvents();
       chunkWS = listener->extractData();
       dataNotYetGiven = false;
+      if (listener->buffersEvents())
+        g_log.information() << "Extracted about " << bufferedEvents
+                            << " events from the " << listener->name() << ", "
+                            << listener->droppedEvents()
+                            << " events dropped so far.\n";
     } catch (Exception::NotYet &ex) {
       g_log.warning() << "The " << listener->name()
                       << " is not ready to return data: " << ex.what() << "\n";
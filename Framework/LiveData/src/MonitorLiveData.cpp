@@ -119,6 +119,7 @@ void MonitorLiveData::exec() {
   DateAndTime lastTime = DateAndTime::getCurrentTime();
 
   m_chunkNumber = 0;
+  size_t lastDroppedEvents = listener->droppedEvents();
   int runNumber = 0;
   int prevRunNumber = 0;
 
@@ -142,7 +143,11 @@ void MonitorLiveData::exec() {
     if (seconds > UpdateEvery) {
       lastTime = now;
       g_log.notice() << "Loading live data chunk " << m_chunkNumber << " at "
-                     << now.toFormattedString("%H:%M:%S") << '\n';
+                     << now.toFormattedString("%H:%M:%S");
+      if (listener->buffersEvents())
+        g_log.notice() << " with " << listener->bufferedEvents()
+                       << " events buffered";
+      g_log.notice() << '\n';
 
       // Time to run LoadLiveData again
       Algorithm_sptr alg = createChildAlgorithm("LoadLiveData");
@@ -168,6 +173,14 @@ void MonitorLiveData::exec() {
 
       NextAccumulationMethod = this->getPropertyValue("AccumulationMethod");
 
+      // Report the events the listener could not buffer for this chunk
+      const size_t droppedEvents = listener->droppedEvents();
+      if (droppedEvents > lastDroppedEvents)
+        g_log.warning() << droppedEvents - lastDroppedEvents
+                        << " events were dropped by the " << listener->name()
+                        << " since the last chunk.\n";
+      lastDroppedEvents = droppedEvents;
+
       if (runNumber == 0) {
         runNumber = listener->runNumber();
         g_log.debug() << "Run number set to " << runNumber << '\n';
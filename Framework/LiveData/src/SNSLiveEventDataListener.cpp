@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <ctime>
 #include <exception>
 #include <sstream> // for ostringstream
@@ -12,11 +13,14 @@
 #include "MantidGeometry/Instrument.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/DateAndTime.h"
+#include "MantidKernel/ITimeSeriesProperty.h"
 #include "MantidKernel/OptionalBool.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/WriteLock.h"
+#include "MantidKernel/make_cow.h"
+#include "MantidKernel/make_unique.h"
 #include "MantidLiveData/Exception.h"
 #include "MantidLiveData/SNSLiveEventDataListener.h"
 
@@ -74,8 +78,55 @@ DECLARE_LISTENER(SNSLiveEventDataListener)
 namespace {
 /// static logger
 Kernel::Logger g_log("SNSLiveEventDataListener");
+
+/** Add the last value of a time series log to a run
+ * @param log :: the log
+ * @param run :: the run to add it to
+ * @return false if the log is not a time series of type T
+ */
+template <typename T> bool addLastValue(const Property &log, Run &run) {
+  const auto series = dynamic_cast<const TimeSeriesProperty<T> *>(&log);
+  if (!series)
+    return false;
+  auto last = Kernel::make_unique<TimeSeriesProperty<T>>(series->name());
+  last->setUnits(series->units());
+  if (series->size() > 0)
+    last->addValue(series->lastTime(), series->lastValue());
+  run.addLogData(std::move(last));
+  return true;
 }
 
+/** Create the logs a new buffer starts with: the last value of each time
+ * series of the logs of the previous buffer and its other logs, except the
+ * monitor logs. Only one value is copied for each log, rather than copying
+ * all the values and dropping the outdated ones.
+ * @param run :: the logs of the previous buffer
+ * @param monitorLogs :: the names of the monitor logs
+ * @return the logs of the new buffer
+ */
+Kernel::cow_ptr<Run>
+carriedOverLogs(const Run &run, const std::vector<std::string> &monitorLogs) {
+  auto next = Kernel::make_cow<Run>();
+  auto &nextRun = next.access();
+  nextRun.setGoniometer(run.getGoniometer(), false);
+  for (const auto log : run.getProperties()) {
+    if (std::find(monitorLogs.cbegin(), monitorLogs.cend(), log->name()) !=
+        monitorLogs.cend())
+      continue;
+    if (addLastValue<double>(*log, nextRun) ||
+        addLastValue<int>(*log, nextRun) ||
+        addLastValue<std::string>(*log, nextRun) ||
+        addLastValue<bool>(*log, nextRun))
+      continue;
+    std::unique_ptr<Property> copy(log->clone());
+    if (auto series = dynamic_cast<ITimeSeriesProperty *>(copy.get()))
+      series->clearOutdated();
+    nextRun.addLogData(std::move(copy));
+  }
+  return next;
+}
+} // namespace
+
 /// Constructor
 SNSLiveEventDataListener::SNSLiveEventDataListener()
     : LiveListener(), ADARA::Parser(), m_socket()
@@ -416,6 +467,8 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::BankedEventPkt &pkt) {
     unsigned lastBankID = pkt.curBankId();
     // A counter that we use for logging purposes
     unsigned eventsPerBank = 0;
+    // The number of events actually added to the workspace
+    size_t appendedEvents = 0;
     while (event != nullptr) {
       eventsPerBank++;
       totalEvents++;
@@ -425,11 +478,12 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::BankedEventPkt &pkt) {
         // appendEvent needs tof to be in units of microseconds, but it comes
         // from the ADARA stream in units of 100ns.
         if (pkt.getSourceCORFlag()) {
-          appendEvent(event->pixel, event->tof / 10.0, eventTime);
+          appendedEvents +=
+              appendEvent(event->pixel, event->tof / 10.0, eventTime);
         } else {
-          appendEvent(event->pixel,
-                      (event->tof + pkt.getSourceTOFOffset()) / 10.0,
-                      eventTime);
+          appendedEvents += appendEvent(
+              event->pixel, (event->tof + pkt.getSourceTOFOffset()) / 10.0,
+              eventTime);
         }
       }
 
@@ -442,6 +496,7 @@ bool SNSLiveEventDataListener::rxPacket(const ADARA::BankedEventPkt &pkt) {
         eventsPerBank = 0;
       }
     }
+    countBufferedEvents(appendedEvents);
   } // mutex automatically unlocks here
 
   g_log.debug() << "Total Events: " << totalEvents << "\n";
@@ -1368,6 +1423,7 @@ void SNSLiveEventDataListener::initWorkspacePart2() {
   }
 
   initMonitorWorkspace();
+  initSpareBuffers({m_eventBuffer});
 
   m_workspaceInitialized = true;
 }
@@ -1413,7 +1469,9 @@ bool SNSLiveEventDataListener::haveRequiredLogs() {
 }
 
 /// Adds an event to the workspace
-void SNSLiveEventDataListener::appendEvent(
+/// @return true if the event was added, false if it was dropped because of
+/// an invalid pixel ID
+bool SNSLiveEventDataListener::appendEvent(
     const uint32_t pixelId, const double tof,
     const Mantid::Types::Core::DateAndTime pulseTime)
 // NOTE: This function does NOT lock the mutex!  Make sure you do that
@@ -1426,10 +1484,12 @@ void SNSLiveEventDataListener::appendEvent(
     const std::size_t workspaceIndex = it->second;
     Types::Event::TofEvent event(tof, pulseTime);
     m_eventBuffer->getSpectrum(workspaceIndex).addEventQuickly(event);
-  } else {
-    g_log.warning() << "Invalid pixel ID: " << pixelId << " (TofF: " << tof
-                    << " microseconds)\n";
+    return true;
   }
+  g_log.warning() << "Invalid pixel ID: " << pixelId << " (TofF: " << tof
+                  << " microseconds)\n";
+  countDroppedEvents(1);
+  return false;
 }
 
 /// Retrieve buffered data
@@ -1467,39 +1527,32 @@ boost::shared_ptr<Workspace> SNSLiveEventDataListener::extractData() {
     throw Exception::NotYet("Waiting for a run to start.");
   }
 
-  using namespace DataObjects;
-
-  // Make a brand new EventWorkspace
-  EventWorkspace_sptr temp = boost::dynamic_pointer_cast<EventWorkspace>(
-      API::WorkspaceFactory::Instance().create(
-          "EventWorkspace", m_eventBuffer->getNumberHistograms(), 2, 1));
-
-  // Copy geometry over.
-  API::WorkspaceFactory::Instance().initializeFromParent(*m_eventBuffer, *temp,
-                                                         false);
-
-  // Clear out the old logs, except for the most recent entry
-  temp->mutableRun().clearOutdatedTimeSeriesLogValues();
-
-  // Clear out old monitor logs
-  for (auto &monitorLog : m_monitorLogs) {
-    temp->mutableRun().removeProperty(monitorLog);
+  // Take an empty buffer, prepared in the background, so that the events are
+  // extracted by swapping pointers and the network thread is barely held up
+  auto spareBuffers = takeSpareBuffers();
+  auto temp = spareBuffers.empty()
+                  ? nullptr
+                  : boost::dynamic_pointer_cast<DataObjects::EventWorkspace>(
+                        spareBuffers.front());
+  if (!temp) {
+    throw std::runtime_error("Failed to create an event workspace");
   }
-  m_monitorLogs.clear();
-
-  // Create a fresh monitor workspace and insert into the new 'main' workspace
-  auto monitorBuffer = m_eventBuffer->monitorWorkspace();
-  auto newMonitorBuffer = WorkspaceFactory::Instance().create(
-      "EventWorkspace", monitorBuffer->getNumberHistograms(), 1, 1);
-  WorkspaceFactory::Instance().initializeFromParent(*monitorBuffer,
-                                                    *newMonitorBuffer, false);
-  temp->setMonitorWorkspace(newMonitorBuffer);
 
-  // Lock the mutex and swap the workspaces
+  // Lock the mutex and swap the workspaces. The extracted workspace keeps
+  // its logs without copying them. The new buffer needs the last values of
+  // the logs before the network thread adds to them, so those are copied
+  // under the lock, one value per log.
+  size_t numberOfEvents;
   {
     std::lock_guard<std::mutex> scopedLock(m_mutex);
     std::swap(m_eventBuffer, temp);
+    m_eventBuffer->setSharedRun(carriedOverLogs(temp->run(), m_monitorLogs));
+    m_monitorLogs.clear();
+
+    numberOfEvents = resetBufferedEvents();
   } // mutex automatically unlocks here
+  g_log.debug() << "Extracted " << numberOfEvents << " events, "
+                << droppedEvents() << " events dropped so far\n";
 
   return temp;
 }
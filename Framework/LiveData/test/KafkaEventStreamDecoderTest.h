@@ -132,6 +132,46 @@ public:
     }
   }
 
+  void test_Events_Are_Added_To_Each_Spectrum_In_Message_Order() {
+    using namespace ::testing;
+    using namespace KafkaTesting;
+    using Mantid::API::Workspace_sptr;
+    using Mantid::DataObjects::EventWorkspace;
+    using namespace Mantid::LiveData;
+
+    auto mockBroker = std::make_shared<MockKafkaBroker>();
+    EXPECT_CALL(*mockBroker, subscribe_(_, _))
+        .Times(Exactly(3))
+        .WillOnce(Return(new FakeISISEventSubscriber(1)))
+        .WillOnce(Return(new FakeRunInfoStreamSubscriber(1)))
+        .WillOnce(Return(new FakeISISSpDetStreamSubscriber));
+    auto decoder = createTestDecoder(mockBroker);
+    startCapturing(*decoder, 3);
+    // Events decoded since the last extraction are all in the next one
+    TS_ASSERT_THROWS_NOTHING(decoder->stopCapture());
+    Workspace_sptr workspace;
+    TS_ASSERT_THROWS_NOTHING(workspace = decoder->extractData());
+
+    auto eventWksp = boost::dynamic_pointer_cast<EventWorkspace>(workspace);
+    TS_ASSERT(eventWksp);
+    if (!eventWksp)
+      return;
+    // Each message has one event for spectra 1, 3, 4 and 5 and two events,
+    // at 8 and 6 microseconds, for spectrum 2
+    const size_t nMessages = eventWksp->getSpectrum(0).getNumberEvents();
+    TS_ASSERT_LESS_THAN_EQUALS(3, nMessages);
+    TS_ASSERT_EQUALS(eventWksp->getNumberEvents(), 6 * nMessages);
+    const auto &events = eventWksp->getSpectrum(1).getEvents();
+    TS_ASSERT_EQUALS(events.size(), 2 * nMessages);
+    for (size_t i = 0; i < events.size(); ++i)
+      TS_ASSERT_EQUALS(events[i].tof(), i % 2 == 0 ? 8. : 6.);
+    // One proton charge per message
+    TS_ASSERT_EQUALS(eventWksp->run()
+                         .getTimeSeriesProperty<double>("proton_charge")
+                         ->size(),
+                     static_cast<int>(nMessages));
+  }
+
   void test_End_Of_Run_Reported_After_Run_Stop_Reached() {
     using namespace ::testing;
     using namespace KafkaTesting;
@@ -10,6 +10,9 @@
 #include <boost/optional.hpp>
 
 namespace Mantid {
+namespace DataObjects {
+class BoxControllerMMapIO;
+}
 namespace MDAlgorithms {
 
 /** Load a .nxs file into a MDEventWorkspace.
@@ -107,6 +110,15 @@ private:
   /// Negative scaling for Q dimensions
   std::vector<double> qDimensions(API::IMDWorkspace_sptr ws);
 
+  /// Open the events of the file through a memory map
+  void openEventsForMemoryMapping(DataObjects::BoxControllerMMapIO &io,
+                                  API::BoxController *bc,
+                                  const std::string &typeName);
+  /// Copy the events to a flat file to be accessed through a memory map
+  void copyEventsForMemoryMapping(API::BoxController *bc,
+                                  const std::string &typeName,
+                                  const std::string &eventsFilename);
+
   /// Open file handle
   // clang-format off
   boost::scoped_ptr< ::NeXus::File> m_file;
@@ -1,5 +1,6 @@
 #include "MantidMDAlgorithms/ConvToMDEventsWS.h"
 
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 #include "MantidMDAlgorithms/UnitsConversionHelper.h"
 
 namespace Mantid {
@@ -125,7 +126,7 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   size_t nValidSpectra = m_NSpectra;
 
   //--->>> Thread control stuff
-  Kernel::ThreadSchedulerFIFO *ts(nullptr);
+  Kernel::ThreadSchedulerWorkStealing *ts(nullptr);
 
   int nThreads(m_NumThreads);
   if (nThreads < 0)
@@ -136,7 +137,7 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
     runMultithreaded = true;
     // Create the thread pool that will run all of these. It will be deleted by
     // the threadpool
-    ts = new Kernel::ThreadSchedulerFIFO();
+    ts = new Kernel::ThreadSchedulerWorkStealing(nThreads);
     // it will initiate thread pool with number threads or machine's cores (0 in
     // tp constructor)
     pProgress->resetNumSteps(nValidSpectra, 0, 1);
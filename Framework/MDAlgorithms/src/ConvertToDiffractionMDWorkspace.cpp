@@ -19,6 +19,7 @@
 #include "MantidKernel/FunctionTask.h"
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/ProgressText.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/Unit.h"
@@ -260,6 +261,10 @@ void ConvertToDiffractionMDWorkspace::convertEventList(
     auto it = events.begin();
     auto it_end = events.end();
 
+    // The events are added to the workspace in one batch, so that each box
+    // is only locked once
+    std::vector<MDE> mdEvents;
+    mdEvents.reserve(events.size());
     for (; it != it_end; it++) {
       // Get the wavenumber in ang^-1 using the previously calculated constant.
       coord_t wavenumber =
@@ -284,15 +289,16 @@ void ConvertToDiffractionMDWorkspace::convertEventList(
         float correct = float(sin_theta_squared * wavenumber * wavenumber *
                               wavenumber * wavenumber);
         // Push the MDLeanEvent but correct the weight.
-        box->addEvent(MDE(float(it->weight() * correct),
-                          float(it->errorSquared() * correct * correct),
-                          center));
+        mdEvents.emplace_back(float(it->weight() * correct),
+                              float(it->errorSquared() * correct * correct),
+                              center);
       } else {
         // Push the MDLeanEvent with the same weight
-        box->addEvent(
-            MDE(float(it->weight()), float(it->errorSquared()), center));
+        mdEvents.emplace_back(float(it->weight()), float(it->errorSquared()),
+                              center);
       }
     }
+    box->addEvents(mdEvents);
 
     // Clear out the EventList to save memory
     if (ClearInputWorkspace)
@@ -494,7 +500,7 @@ void ConvertToDiffractionMDWorkspace::exec() {
   prog = boost::make_shared<Progress>(this, 0.0, 1.0, totalEvents);
 
   // Create the thread pool that will run all of these.
-  ThreadScheduler *ts = new ThreadSchedulerFIFO();
+  ThreadScheduler *ts = new ThreadSchedulerWorkStealing();
   ThreadPool tp(ts, 0);
 
   // To track when to split up boxes
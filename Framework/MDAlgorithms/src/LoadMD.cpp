@@ -5,6 +5,7 @@
 #include "MantidAPI/IMDWorkspace.h"
 #include "MantidAPI/RegisterFileLoader.h"
 #include "MantidAPI/WorkspaceHistory.h"
+#include "MantidDataObjects/BoxControllerMMapIO.h"
 #include "MantidDataObjects/BoxControllerNeXusIO.h"
 #include "MantidDataObjects/CoordTransformAffine.h"
 #include "MantidDataObjects/MDBoxFlatTree.h"
@@ -25,10 +26,16 @@
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/System.h"
 #include "MantidMDAlgorithms/SetMDFrame.h"
+#include <Poco/Exception.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/Process.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/regex.hpp>
+#include <atomic>
 #include <iostream>
 #include <nexus/NeXusException.hpp>
+#include <sstream>
 #include <vector>
 
 using file_holder_type = std::unique_ptr<Mantid::API::IBoxControllerIO>;
@@ -41,6 +48,48 @@ using namespace Mantid::DataObjects;
 namespace Mantid {
 namespace MDAlgorithms {
 
+namespace {
+/**
+ * The name of the file the events of a NeXus file are copied to for memory
+ * mapping. It is in the temporary directory and depends on the path, size
+ * and modification time of the NeXus file, so a copy is only found again
+ * while the NeXus file is unchanged.
+ * @param filename :: the NeXus file
+ * @return the full path of the copy
+ */
+std::string memoryMappedCopyName(const std::string &filename) {
+  Poco::Path path(filename);
+  path.makeAbsolute();
+  const Poco::File file(path.toString());
+  std::ostringstream key;
+  key << path.toString() << '|' << file.getSize() << '|'
+      << file.getLastModified().epochMicroseconds();
+  std::ostringstream name;
+  name << path.getBaseName() << '_' << std::hex
+       << std::hash<std::string>()(key.str()) << ".mdevents";
+
+  Poco::Path copyPath(ConfigService::Instance().getTempDir());
+  copyPath.makeDirectory();
+  copyPath.setFileName(name.str());
+  return copyPath.toString();
+}
+
+/**
+ * A name for a copy of the events used by one workspace only.
+ * @param copyName :: the name of the shared copy
+ * @return the full path of a new copy
+ */
+std::string privateCopyName(const std::string &copyName) {
+  static std::atomic<unsigned int> count(0);
+  Poco::Path path(copyName);
+  std::ostringstream name;
+  name << path.getBaseName() << '_' << Poco::Process::id() << '_' << ++count
+       << ".mdevents";
+  path.setFileName(name.str());
+  return path.toString();
+}
+} // namespace
+
 DECLARE_NEXUS_FILELOADER_ALGORITHM(LoadMD)
 
 //----------------------------------------------------------------------------------------------
@@ -104,6 +153,17 @@ void LoadMD::init() {
   setPropertySettings("Memory", make_unique<EnabledWhenProperty>(
                                     "FileBackEnd", IS_EQUAL_TO, "1"));
 
+  declareProperty(
+      make_unique<PropertyWithValue<bool>>("MemoryMapped", false),
+      "For FileBackEnd only: access the events through a memory map instead "
+      "of reading them from the NeXus file. The operating system then "
+      "decides which events are kept in memory. Events stored contiguously "
+      "are mapped in place, otherwise they are copied to a file in the "
+      "temporary directory, which is reused by later loads of the same file. "
+      "The workspace cannot be saved with SaveMD afterwards.");
+  setPropertySettings("MemoryMapped", make_unique<EnabledWhenProperty>(
+                                          "FileBackEnd", IS_EQUAL_TO, "1"));
+
   declareProperty("LoadHistory", true,
                   "If true, the workspace history will be loaded");
 
@@ -543,9 +603,18 @@ void LoadMD::doLoad(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   // ---------------------------------------- DEAL WITH BOXES
   // ------------------------------------
   if (fileBackEnd) { // TODO:: call to the file format factory
-    auto loader = boost::shared_ptr<API::IBoxControllerIO>(
-        new DataObjects::BoxControllerNeXusIO(bc.get()));
-    loader->setDataType(sizeof(coord_t), MDE::getTypeName());
+    boost::shared_ptr<API::IBoxControllerIO> loader;
+    if (getProperty("MemoryMapped")) {
+      prog->report("Mapping events to memory.");
+      auto mappedLoader =
+          boost::make_shared<DataObjects::BoxControllerMMapIO>(bc.get());
+      mappedLoader->setDataType(sizeof(coord_t), MDE::getTypeName());
+      openEventsForMemoryMapping(*mappedLoader, bc.get(), MDE::getTypeName());
+      loader = mappedLoader;
+    } else {
+      loader = boost::make_shared<DataObjects::BoxControllerNeXusIO>(bc.get());
+      loader->setDataType(sizeof(coord_t), MDE::getTypeName());
+    }
     bc->setFileBacked(loader, m_filename);
     // boxes have been already made file-backed when restoring the boxTree;
     // How much memory for the cache?
@@ -794,6 +863,93 @@ std::vector<double> LoadMD::qDimensions(API::IMDWorkspace_sptr ws) {
   }
   return scaling;
 }
+
+/**
+ * Open the events of the file through a memory map. The events are mapped in
+ * place if the file allows it. Otherwise they are copied to a flat file in the
+ * temporary directory, which is removed with the workspace if its events
+ * change and kept for the next load of the same file if they do not.
+ *
+ * A workspace only ever uses a copy under a name of its own. The kept copy is
+ * claimed by renaming it, which only one process or workspace can do, and a
+ * copy is only published under the shared name once it has been closed.
+ * @param io :: the memory mapped back end of the workspace
+ * @param bc :: the box controller of the workspace
+ * @param typeName :: the name of the type of the events
+ */
+void LoadMD::openEventsForMemoryMapping(DataObjects::BoxControllerMMapIO &io,
+                                        API::BoxController *bc,
+                                        const std::string &typeName) {
+  const std::string sharedFilename = memoryMappedCopyName(m_filename);
+  const std::string eventsFilename = privateCopyName(sharedFilename);
+  if (io.openInPlace(m_filename, eventsFilename)) {
+    g_log.information() << "Mapped the events of " << m_filename
+                        << " in place.\n";
+    return;
+  }
+
+  bool claimed = false;
+  try {
+    Poco::File(sharedFilename).renameTo(eventsFilename);
+    claimed = true;
+  } catch (Poco::FileException &) {
+    // there is no copy, or another workspace has just claimed it
+  }
+  if (claimed) {
+    if (io.getFileState(eventsFilename) ==
+        BoxControllerMMapIO::FileState::Reusable) {
+      io.openFile(eventsFilename, "w");
+      io.setRemoveOnClose(true, sharedFilename);
+      g_log.information() << "Reusing the events copied to " << sharedFilename
+                          << " for memory mapping.\n";
+      return;
+    }
+    // left by a session which did not end properly, or by another version
+    Poco::File(eventsFilename).remove();
+  }
+  copyEventsForMemoryMapping(bc, typeName, eventsFilename);
+  io.openFile(eventsFilename, "w");
+  io.setRemoveOnClose(true, sharedFilename);
+}
+
+/**
+ * Copy the events in the file to a flat file, which is then used as the back
+ * end of the workspace through a memory map. The box file positions are the
+ * same in both files.
+ * @param bc :: the box controller of the workspace
+ * @param typeName :: the name of the type of the events
+ * @param eventsFilename :: the full path of the copy
+ */
+void LoadMD::copyEventsForMemoryMapping(API::BoxController *bc,
+                                        const std::string &typeName,
+                                        const std::string &eventsFilename) {
+  BoxControllerNeXusIO source(bc);
+  source.setDataType(sizeof(coord_t), typeName);
+  source.openFile(m_filename, "r");
+  BoxControllerMMapIO copy(bc);
+  copy.setDataType(sizeof(coord_t), typeName);
+  copy.openFile(eventsFilename, "w");
+
+  // Large blocks make the reading of the NeXus file sequential
+  const uint64_t eventsPerBlock = 100 * source.getDataChunk();
+  const uint64_t nEvents = source.getFileLength();
+  std::vector<coord_t> block;
+  for (uint64_t start = 0; start < nEvents; start += eventsPerBlock) {
+    const auto nPoints =
+        static_cast<size_t>(std::min(eventsPerBlock, nEvents - start));
+    source.loadBlock(block, start, nPoints);
+    copy.saveBlock(block, start);
+  }
+  std::vector<uint64_t> freeSpaceBlocks;
+  source.getFreeSpaceVector(freeSpaceBlocks);
+  copy.setFreeSpaceVector(freeSpaceBlocks);
+  copy.closeFile();
+  source.closeFile();
+
+  g_log.information() << "Copied " << nEvents << " events to "
+                      << eventsFilename << " for memory mapping.\n";
+}
+
 const std::string LoadMD::VISUAL_NORMALIZATION_KEY = "visual_normalization";
 const std::string LoadMD::VISUAL_NORMALIZATION_KEY_HISTO =
     "visual_normalization_histo";
@@ -4,6 +4,7 @@
 #include "MantidAPI/IMDEventWorkspace.h"
 #include "MantidAPI/Progress.h"
 #include "MantidAPI/WorkspaceHistory.h"
+#include "MantidDataObjects/BoxControllerMMapIO.h"
 #include "MantidDataObjects/BoxControllerNeXusIO.h"
 #include "MantidDataObjects/MDBox.h"
 #include "MantidDataObjects/MDBoxFlatTree.h"
@@ -76,6 +77,16 @@ void SaveMD::init() {
   setPropertySettings(
       "MakeFileBacked",
       make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
+
+  declareProperty("ContiguousEvents", false,
+                  "For an MDEventWorkspace that is not file backed:\n"
+                  "Store the events in one contiguous, uncompressed array, "
+                  "which LoadMD with MemoryMapped can map without copying "
+                  "it.\nA workspace file backed on such a file cannot gain "
+                  "events.");
+  setPropertySettings(
+      "ContiguousEvents",
+      make_unique<EnabledWhenProperty>("MakeFileBacked", IS_EQUAL_TO, "0"));
 }
 
 //----------------------------------------------------------------------------------------------
@@ -92,6 +103,11 @@ void SaveMD::doSaveEvents(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   if (updateFileBackend && makeFileBackend)
     throw std::invalid_argument(
         "Please choose either UpdateFileBackEnd or MakeFileBacked, not both.");
+  bool contiguousEvents = getProperty("ContiguousEvents");
+  if (contiguousEvents && (updateFileBackend || makeFileBackend ||
+                           ws->isFileBacked()))
+    throw std::invalid_argument("ContiguousEvents can only be used to save a "
+                                "workspace which is not file backed.");
 
   bool wsIsFileBacked = ws->isFileBacked();
   std::string filename = getPropertyValue("Filename");
@@ -103,6 +119,10 @@ void SaveMD::doSaveEvents(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       throw std::runtime_error(
           "MakeFileBacked selected but workspace is already file backed.");
     }
+    if (dynamic_cast<DataObjects::BoxControllerMMapIO *>(bc->getFileIO())) {
+      throw std::runtime_error("The events of the workspace are in a "
+                               "memory-mapped file, which cannot be saved.");
+    }
   } else {
     if (updateFileBackend) {
       throw std::runtime_error(
@@ -159,7 +179,7 @@ void SaveMD::doSaveEvents(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     // the boxes file positions are unknown and we need to calculate it.
     BoxFlatStruct.initFlatStructure(ws, filename);
     // create saver class
-    auto Saver = boost::shared_ptr<API::IBoxControllerIO>(
+    auto Saver = boost::shared_ptr<DataObjects::BoxControllerNeXusIO>(
         new DataObjects::BoxControllerNeXusIO(bc.get()));
     Saver->setDataType(sizeof(coord_t), MDE::getTypeName());
     if (makeFileBackend) {
@@ -196,10 +216,18 @@ void SaveMD::doSaveEvents(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       Saver->flushData();
     } else // just save data, and finish with it
     {
-      Saver->openFile(filename, "w");
       BoxFlatStruct.setBoxesFilePositions(false);
       std::vector<API::IMDNode *> &boxes = BoxFlatStruct.getBoxes();
       std::vector<uint64_t> &eventIndex = BoxFlatStruct.getEventIndex();
+      if (contiguousEvents) {
+        // the array has to be large enough for the last box on file
+        uint64_t nEvents = 0;
+        for (size_t i = 0; i < boxes.size(); i++)
+          nEvents =
+              std::max(nEvents, eventIndex[2 * i] + eventIndex[2 * i + 1]);
+        Saver->setContiguousLength(nEvents);
+      }
+      Saver->openFile(filename, "w");
       prog->resetNumSteps(boxes.size(), 0.06, 0.90);
       for (size_t i = 0; i < boxes.size(); i++) {
         if (eventIndex[2 * i + 1] == 0 || boxes[i]->getIsMasked())
@@ -64,6 +64,16 @@ void SaveMD2::init() {
   setPropertySettings(
       "MakeFileBacked",
       make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
+
+  declareProperty("ContiguousEvents", false,
+                  "For an MDEventWorkspace that is not file backed:\n"
+                  "Store the events in one contiguous, uncompressed array, "
+                  "which LoadMD with MemoryMapped can map without copying "
+                  "it.\nA workspace file backed on such a file cannot gain "
+                  "events.");
+  setPropertySettings(
+      "ContiguousEvents",
+      make_unique<EnabledWhenProperty>("MakeFileBacked", IS_EQUAL_TO, "0"));
 }
 
 //----------------------------------------------------------------------------------------------
@@ -210,6 +220,8 @@ void SaveMD2::exec() {
                                 getProperty("UpdateFileBackEnd"));
     saveMDv1->setProperty<bool>("MakeFileBacked",
                                 getProperty("MakeFileBacked"));
+    saveMDv1->setProperty<bool>("ContiguousEvents",
+                                getProperty("ContiguousEvents"));
     saveMDv1->execute();
   } else if (histoWS) {
     this->doSaveHisto(histoWS);
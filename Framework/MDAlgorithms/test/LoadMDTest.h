@@ -7,6 +7,7 @@
 #include "MantidKernel/Strings.h"
 #include "MantidAPI/IMDEventWorkspace.h"
 #include "MantidAPI/ExperimentInfo.h"
+#include "MantidAPI/FileFinder.h"
 #include "MantidAPI/WorkspaceHistory.h"
 #include "MantidDataObjects/MDBox.h"
 #include "MantidDataObjects/MDGridBox.h"
@@ -16,10 +17,12 @@
 #include "MantidGeometry/MDGeometry/QSample.h"
 #include "MantidGeometry/MDGeometry/GeneralFrame.h"
 #include "MantidGeometry/MDGeometry/HKL.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidMDAlgorithms/LoadMD.h"
 
 #include <cxxtest/TestSuite.h>
 
+#include <Poco/Path.h>
 #include <hdf5.h>
 
 using namespace Mantid;
@@ -170,7 +173,8 @@ public:
   //=================================================================================================================
   template <size_t nd>
   void do_test_exec(bool FileBackEnd, bool deleteWorkspace = true,
-                    double memory = 0, bool BoxStructureOnly = false) {
+                    double memory = 0, bool BoxStructureOnly = false,
+                    bool memoryMapped = false) {
     using MDE = MDLeanEvent<nd>;
 
     //------ Start by creating the file
@@ -222,6 +226,7 @@ public:
     TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Filename", filename));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("FileBackEnd", FileBackEnd));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("Memory", memory));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("MemoryMapped", memoryMapped));
     TS_ASSERT_THROWS_NOTHING(
         alg.setPropertyValue("OutputWorkspace", outWSName));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("MetadataOnly", false));
@@ -266,10 +271,14 @@ public:
 
     // Remove workspace from the data service.
     if (deleteWorkspace) {
+      const std::string eventsFilename =
+          ws->isFileBacked() ? ws->getBoxController()->getFilename() : "";
       ws->clearFileBacked(false);
       AnalysisDataService::Instance().remove(outWSName);
       if (Poco::File(filename).exists())
         Poco::File(filename).remove();
+      if (memoryMapped && Poco::File(eventsFilename).exists())
+        Poco::File(eventsFilename).remove();
     }
   }
 
@@ -406,6 +415,114 @@ public:
     do_test_exec<3>(true, true, 1.0);
   }
 
+  /// Keep the events in a memory-mapped copy of the file
+  void test_exec_3D_with_memory_mapped_FileBackEnd_andSmallBuffer() {
+    do_test_exec<3>(true, true, 1.0, false, true);
+  }
+
+  IMDEventWorkspace_sptr loadMemoryMapped(const std::string &filename,
+                                          const std::string &outWSName) {
+    LoadMD alg;
+    alg.initialize();
+    alg.setPropertyValue("Filename", filename);
+    alg.setProperty("FileBackEnd", true);
+    alg.setProperty("MemoryMapped", true);
+    alg.setPropertyValue("OutputWorkspace", outWSName);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    return AnalysisDataService::Instance().retrieveWS<IMDEventWorkspace>(
+        outWSName);
+  }
+
+  /// The name of the shared copy a workspace's own copy is published as
+  std::string sharedCopyName(const std::string &privateName) {
+    Poco::Path path(privateName);
+    std::string baseName = path.getBaseName();
+    // strip the process id and the counter
+    baseName.erase(baseName.rfind('_'));
+    baseName.erase(baseName.rfind('_'));
+    path.setBaseName(baseName);
+    return path.toString();
+  }
+
+  void test_memory_mapped_copy_is_kept_for_the_next_load() {
+    do_test_exec<3>(true, false, 0, false, true);
+    auto first = AnalysisDataService::Instance().retrieveWS<IMDEventWorkspace>(
+        "LoadMDTest_OutputWS");
+    const std::string filename =
+        FileFinder::Instance().getFullPath("LoadMDTest3.nxs");
+    const std::string copyName = first->getBoxController()->getFilename();
+    const std::string sharedName = sharedCopyName(copyName);
+    Poco::Path tempDir(ConfigService::Instance().getTempDir());
+    TS_ASSERT_EQUALS(Poco::Path(copyName).parent().toString(),
+                     tempDir.makeDirectory().toString());
+    TS_ASSERT_EQUALS(Poco::Path(copyName).getExtension(), "mdevents");
+    TSM_ASSERT("A copy is only shared once it is closed",
+               !Poco::File(sharedName).exists());
+
+    // a second workspace of the same file has a copy of its own
+    auto second = loadMemoryMapped(filename, "LoadMDTest_SecondWS");
+    const std::string secondCopyName =
+        second->getBoxController()->getFilename();
+    TS_ASSERT_DIFFERS(secondCopyName, copyName);
+    second->clearFileBacked(false);
+    AnalysisDataService::Instance().remove("LoadMDTest_SecondWS");
+    TSM_ASSERT("The copy of one workspace is closed with it",
+               !Poco::File(secondCopyName).exists());
+
+    first->clearFileBacked(false);
+    AnalysisDataService::Instance().remove("LoadMDTest_OutputWS");
+    TS_ASSERT(!Poco::File(copyName).exists());
+    TSM_ASSERT("The unchanged copy is kept", Poco::File(sharedName).exists());
+
+    auto third = loadMemoryMapped(filename, "LoadMDTest_ThirdWS");
+    const std::string thirdCopyName = third->getBoxController()->getFilename();
+    TS_ASSERT_EQUALS(sharedCopyName(thirdCopyName), sharedName);
+    TSM_ASSERT("The kept copy is claimed by the workspace",
+               !Poco::File(sharedName).exists());
+    TS_ASSERT(Poco::File(thirdCopyName).exists());
+    third->clearFileBacked(false);
+    AnalysisDataService::Instance().remove("LoadMDTest_ThirdWS");
+    TS_ASSERT(Poco::File(sharedName).exists());
+
+    if (Poco::File(sharedName).exists())
+      Poco::File(sharedName).remove();
+    if (Poco::File(filename).exists())
+      Poco::File(filename).remove();
+  }
+
+  void test_contiguous_events_are_memory_mapped_in_place() {
+    auto ws1 = MDEventsTestHelper::makeMDEW<3>(10, 0.0, 10.0, 0);
+    ws1->getBoxController()->setSplitThreshold(100);
+    AnalysisDataService::Instance().addOrReplace(
+        "LoadMDTest_ws", boost::dynamic_pointer_cast<IMDEventWorkspace>(ws1));
+    FrameworkManager::Instance().exec("FakeMDEventData", 6, "InputWorkspace",
+                                      "LoadMDTest_ws", "UniformParams", "10000",
+                                      "RandomizeSignal", "1");
+
+    SaveMD2 saver;
+    saver.initialize();
+    saver.setProperty("InputWorkspace", "LoadMDTest_ws");
+    saver.setPropertyValue("Filename", "LoadMDTestContiguous.nxs");
+    saver.setProperty("ContiguousEvents", true);
+    const std::string filename = saver.getPropertyValue("Filename");
+    if (Poco::File(filename).exists())
+      Poco::File(filename).remove();
+    TS_ASSERT_THROWS_NOTHING(saver.execute());
+    TS_ASSERT(saver.isExecuted());
+
+    auto iws = loadMemoryMapped(filename, "LoadMDTest_InPlaceWS");
+    TS_ASSERT_EQUALS(iws->getBoxController()->getFilename(), filename);
+    auto ws = boost::dynamic_pointer_cast<MDEventWorkspace<MDLeanEvent<3>, 3>>(
+        iws);
+    do_compare_MDEW(ws, ws1, false);
+    ws->clearFileBacked(false);
+
+    AnalysisDataService::Instance().remove("LoadMDTest_InPlaceWS");
+    AnalysisDataService::Instance().remove("LoadMDTest_ws");
+    if (Poco::File(filename).exists())
+      Poco::File(filename).remove();
+  }
+
   /** Use the file back end,
    * then change it and save to update the file at the back end.
    */
@@ -16,6 +16,8 @@
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/Unit.h"
 #include "MantidKernel/UnitFactory.h"
@@ -34,8 +36,63 @@ using namespace DataObjects;
 namespace {
 /// static logger
 Logger g_log("NexusFileIO");
+/// Size of the blocks of spectra gathered for a single NXputslab
+const size_t WRITE_BLOCK_BYTES = 64 * 1024 * 1024;
+/// Size of the chunks of the 2D datasets if the number of spectra in a chunk
+/// is not set by NexusProcessed.chunkSpectra
+const size_t CHUNK_BYTES = 1024 * 1024;
+
+/**
+ * Number of spectra in each chunk of a 2D dataset.
+ * @param nSpect :: The number of spectra of the dataset
+ * @param nBins :: The number of values of each spectrum
+ * @return the NexusProcessed.chunkSpectra key, or else the number of spectra
+ * in about CHUNK_BYTES, no more than the number of spectra
+ */
+int chunkSpectra(const size_t nSpect, const size_t nBins) {
+  int chunk(0);
+  ConfigService::Instance().getValue("NexusProcessed.chunkSpectra", chunk);
+  if (chunk <= 0) {
+    const size_t spectrumBytes = sizeof(double) * std::max(size_t(1), nBins);
+    chunk = static_cast<int>(std::max(size_t(1), CHUNK_BYTES / spectrumBytes));
+  }
+  return std::max(1, std::min(chunk, static_cast<int>(nSpect)));
 }
 
+/**
+ * Write the spectra to the open 2D dataset with one NXputslab for each block
+ * of whole chunks, rather than one per spectrum. The spectra of a block are
+ * gathered into a contiguous buffer in parallel.
+ * @param fileID :: The Nexus file handle, with the dataset open
+ * @param nSpect :: The number of spectra
+ * @param nBins :: The number of values of each spectrum
+ * @param chunk :: The number of spectra in each chunk of the dataset
+ * @param spectrum :: Function returning a pointer to the values of the i-th
+ * spectrum to write
+ */
+template <typename Spectrum>
+void writeSpectraBlocks(NXhandle fileID, const size_t nSpect,
+                        const size_t nBins, const int chunk,
+                        Spectrum spectrum) {
+  const size_t chunkBytes = chunk * nBins * sizeof(double);
+  const size_t blockSpectra =
+      chunk * std::max(size_t(1), WRITE_BLOCK_BYTES / std::max(size_t(1),
+                                                               chunkBytes));
+  std::vector<double> buffer(std::min(blockSpectra, nSpect) * nBins);
+  for (size_t first = 0; first < nSpect; first += blockSpectra) {
+    const size_t count = std::min(blockSpectra, nSpect - first);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < static_cast<int64_t>(count); ++i) {
+      const double *values = spectrum(first + i);
+      std::copy(values, values + nBins, buffer.begin() + i * nBins);
+    }
+    int start[2] = {static_cast<int>(first), 0};
+    int size[2] = {static_cast<int>(count), static_cast<int>(nBins)};
+    NXputslab(fileID, buffer.data(), start, size);
+  }
+}
+} // namespace
+
 /// Empty default constructor
 NexusFileIO::NexusFileIO()
     : fileID(), m_filehandle(), m_nexuscompression(NX_COMP_LZW),
@@ -337,8 +394,9 @@ int NexusFileIO::writeNexusProcessedData2D(
     for (size_t i = 0; i < sAxis->length(); i++)
       axis2.push_back((*sAxis)(i));
 
-  int start[2] = {0, 0};
-  int asize[2] = {1, dims_array[1]};
+  // The datasets are chunked by blocks of spectra, so that compression and
+  // writing are not done one spectrum at a time
+  int asize[2] = {chunkSpectra(nSpect, nSpectBins), dims_array[1]};
 
   // -------------- Actually write the 2D data ----------------------------
   if (write2Ddata) {
@@ -346,11 +404,9 @@ int NexusFileIO::writeNexusProcessedData2D(
     NXcompmakedata(fileID, name.c_str(), NX_FLOAT64, 2, dims_array,
                    m_nexuscompression, asize);
     NXopendata(fileID, name.c_str());
-    for (size_t i = 0; i < nSpect; i++) {
-      int s = spec[i];
-      NXputslab(fileID, localworkspace->y(s).rawData().data(), start, asize);
-      start[0]++;
-    }
+    writeSpectraBlocks(fileID, nSpect, nSpectBins, asize[0], [&](size_t i) {
+      return localworkspace->y(spec[i]).rawData().data();
+    });
     if (m_progress != nullptr)
       m_progress->reportIncrement(1, "Writing data");
     int signal = 1;
@@ -372,12 +428,10 @@ int NexusFileIO::writeNexusProcessedData2D(
     NXcompmakedata(fileID, name.c_str(), NX_FLOAT64, 2, dims_array,
                    m_nexuscompression, asize);
     NXopendata(fileID, name.c_str());
-    start[0] = 0;
-    for (size_t i = 0; i < nSpect; i++) {
-      int s = spec[i];
-      NXputslab(fileID, localworkspace->e(s).rawData().data(), start, asize);
-      start[0]++;
-    }
+    writeSpectraBlocks(fileID, nSpect, nSpectBins, asize[0], [&](size_t i) {
+      return localworkspace->e(spec[i]).rawData().data();
+    });
+    NXclosedata(fileID);
 
     if (m_progress != nullptr)
       m_progress->reportIncrement(1, "Writing data");
@@ -390,34 +444,29 @@ int NexusFileIO::writeNexusProcessedData2D(
       NXcompmakedata(fileID, name.c_str(), NX_FLOAT64, 2, dims_array,
                      m_nexuscompression, asize);
       NXopendata(fileID, name.c_str());
-      start[0] = 0;
-      for (size_t i = 0; i < nSpect; i++) {
-        int s = spec[i];
-        NXputslab(fileID, rebin_workspace->readF(s).data(), start, asize);
-        start[0]++;
-      }
+      writeSpectraBlocks(fileID, nSpect, nSpectBins, asize[0], [&](size_t i) {
+        return rebin_workspace->readF(spec[i]).data();
+      });
+      NXclosedata(fileID);
       if (m_progress != nullptr)
         m_progress->reportIncrement(1, "Writing data");
     }
 
     // Potentially x error
     if (localworkspace->hasDx(0)) {
+      const size_t nDx = localworkspace->dx(0).size();
       dims_array[0] = static_cast<int>(nSpect);
-      dims_array[1] = static_cast<int>(localworkspace->dx(0).size());
+      dims_array[1] = static_cast<int>(nDx);
+      int dxChunk[2] = {chunkSpectra(nSpect, nDx), dims_array[1]};
       std::string dxErrorName = "xerrors";
       NXcompmakedata(fileID, dxErrorName.c_str(), NX_FLOAT64, 2, dims_array,
-                     m_nexuscompression, asize);
+                     m_nexuscompression, dxChunk);
       NXopendata(fileID, dxErrorName.c_str());
-      start[0] = 0;
-      asize[1] = dims_array[1];
-      for (size_t i = 0; i < nSpect; i++) {
-        int s = spec[i];
-        NXputslab(fileID, localworkspace->dx(s).rawData().data(), start, asize);
-        start[0]++;
-      }
+      writeSpectraBlocks(fileID, nSpect, nDx, dxChunk[0], [&](size_t i) {
+        return localworkspace->dx(spec[i]).rawData().data();
+      });
+      NXclosedata(fileID);
     }
-
-    NXclosedata(fileID);
   }
 
   // write X data, as single array or all values if "ragged"
@@ -432,12 +481,11 @@ int NexusFileIO::writeNexusProcessedData2D(
     dims_array[1] = static_cast<int>(localworkspace->x(0).size());
     NXmakedata(fileID, "axis1", NX_FLOAT64, 2, dims_array);
     NXopendata(fileID, "axis1");
-    start[0] = 0;
-    asize[1] = dims_array[1];
-    for (size_t i = 0; i < nSpect; i++) {
-      NXputslab(fileID, localworkspace->x(i).rawData().data(), start, asize);
-      start[0]++;
-    }
+    const size_t nX = localworkspace->x(0).size();
+    writeSpectraBlocks(fileID, nSpect, nX, chunkSpectra(nSpect, nX),
+                       [&](size_t i) {
+                         return localworkspace->x(i).rawData().data();
+                       });
   }
 
   std::string dist = (localworkspace->isDistribution()) ? "1" : "0";
@@ -32,6 +32,9 @@ namespace Converters {
 /// Enum defining wrapping type for conversion to numpy
 enum NumpyWrapMode { ReadOnly, ReadWrite };
 
+/// Flip the writable flag of a numpy array to make it read only
+DLLExport void markReadOnly(PyObject *array);
+
 namespace Impl {
 // Forward declare a conversion function. This should be specialized for each
 // container type that is to be wrapped
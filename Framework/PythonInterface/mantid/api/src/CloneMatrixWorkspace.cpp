@@ -3,6 +3,7 @@
 //-----------------------------------------------------------------------------
 #include "MantidPythonInterface/api/CloneMatrixWorkspace.h"
 #include "MantidAPI/MatrixWorkspace.h"
+#include "MantidKernel/MultiThreaded.h"
 
 #include <boost/python/extract.hpp>
 
@@ -63,12 +64,15 @@ PyArrayObject *cloneArray(MatrixWorkspace &workspace, DataField field,
                            2,         // rank 2
                            arrayDims, // Length in each dimension
                            nullptr, nullptr, 0, nullptr));
-  double *dest = reinterpret_cast<double *>(
+  double *head = reinterpret_cast<double *>(
       PyArray_DATA(nparray)); // HEAD of the contiguous numpy data array
-  for (size_t i = start; i < endp1; ++i) {
-    const MantidVec &src = (workspace.*(dataAccesor))(i);
-    std::copy(src.begin(), src.end(), dest);
-    dest += stride; // Move the ptr to the start of the next 1D array
+  // The spectra are copied to separate rows so the copies are independent
+  const auto numHistInt = static_cast<int64_t>(numHist);
+  PARALLEL_FOR_IF(Kernel::threadSafe(workspace))
+  for (int64_t i = 0; i < numHistInt; ++i) {
+    const MantidVec &src =
+        (workspace.*(dataAccesor))(start + static_cast<size_t>(i));
+    std::copy(src.begin(), src.end(), head + i * stride);
   }
   return nparray;
 }
@@ -28,6 +28,7 @@
 using namespace Mantid::API;
 using namespace Mantid::Geometry;
 using namespace Mantid::Kernel;
+using Mantid::HistogramData::HistogramX;
 using namespace Mantid::PythonInterface::Converters;
 using namespace Mantid::PythonInterface::Policies;
 using namespace Mantid::PythonInterface::Registry;
@@ -161,6 +162,53 @@ void setDxFromPyObject(MatrixWorkspace &self, const size_t wsIndex,
   setSpectrumFromPyObject(self, &MatrixWorkspace::dataDx, wsIndex, values);
 }
 
+/**
+ * Release the X values held by a capsule used as base of a numpy array
+ * @param capsule :: The capsule holding a pointer to a cow_ptr of the values
+ */
+void releaseSharedX(PyObject *capsule) {
+  delete static_cast<Mantid::Kernel::cow_ptr<HistogramX> *>(
+      PyCapsule_GetPointer(capsule, nullptr));
+}
+
+/**
+ * Create a read-only 2D numpy array of the X values of all the spectra. If
+ * the spectra share their X values, as after a Rebin, the array is a view of
+ * them, repeated with a zero stride, so nothing is copied. The array keeps the
+ * X values alive, and any change to the X values of the workspace will not be
+ * seen by the array. Otherwise the values are copied, as by extractX.
+ * @param self :: A reference to the calling object
+ * @returns A read-only 2D numpy array
+ */
+PyObject *readAllX(MatrixWorkspace &self) {
+  const size_t numHist = self.getNumberHistograms();
+  bool sharedX = numHist > 0;
+  for (size_t i = 1; i < numHist && sharedX; ++i)
+    sharedX = &self.x(i) == &self.x(0);
+  if (!sharedX) {
+    PyObject *copy = Mantid::PythonInterface::cloneX(self);
+    markReadOnly(copy);
+    return copy;
+  }
+
+  auto *holder = new Mantid::Kernel::cow_ptr<HistogramX>(self.sharedX(0));
+  PyObject *capsule = PyCapsule_New(holder, nullptr, releaseSharedX);
+  npy_intp dims[2] = {static_cast<npy_intp>(numHist),
+                      static_cast<npy_intp>((*holder)->size())};
+  npy_intp strides[2] = {0, sizeof(double)};
+  PyArrayObject *nparray = reinterpret_cast<PyArrayObject *>(PyArray_New(
+      &PyArray_Type, 2, dims, NPY_DOUBLE, strides,
+      static_cast<void *>(const_cast<double *>((*holder)->rawData().data())),
+      0, 0, nullptr));
+  markReadOnly(reinterpret_cast<PyObject *>(nparray));
+#if NPY_API_VERSION >= 0x00000007 //(1.7)
+  PyArray_SetBaseObject(nparray, capsule);
+#else
+  nparray->base = capsule;
+#endif
+  return reinterpret_cast<PyObject *>(nparray);
+}
+
 /**
  * Adds a deprecation warning to the getNumberBins call to warn about using
  * blocksize instead
@@ -277,6 +325,10 @@ void export_MatrixWorkspace() {
            "Creates a read-only numpy wrapper "
            "around the original X data at the "
            "given index")
+      .def("readAllX", &readAllX, arg("self"),
+           "Creates a read-only 2D numpy array of the X data of all the "
+           "spectra. If the spectra share the same X data the array is a "
+           "view of it and nothing is copied.")
       .def("readY", &MatrixWorkspace::readY, return_readonly_numpy(),
            args("self", "workspaceIndex"), "Creates a read-only numpy wrapper "
                                            "around the original Y data at the "
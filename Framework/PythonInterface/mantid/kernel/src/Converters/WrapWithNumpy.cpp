@@ -25,22 +25,22 @@ extern template int NDArrayTypeIndex<unsigned long long>::typenum;
 extern template int NDArrayTypeIndex<float>::typenum;
 extern template int NDArrayTypeIndex<double>::typenum;
 
-namespace Impl {
-namespace {
 /**
  * Flip the writable flag to ensure the array is read only
  * Numpy v1.7 removed access to the flags fields directly
  * and introduced the PyClear_Flags function.
- * @param arr A pointer to a numpy array
+ * @param array A pointer to a numpy array
  */
-void markReadOnly(PyArrayObject *arr) {
+void markReadOnly(PyObject *array) {
+  PyArrayObject *arr = reinterpret_cast<PyArrayObject *>(array);
 #if NPY_API_VERSION >= 0x00000007 //(1.7)
   PyArray_CLEARFLAGS(arr, NPY_ARRAY_WRITEABLE);
 #else
   arr->flags &= ~NPY_WRITEABLE;
 #endif
 }
-}
+
+namespace Impl {
 
 /**
  * Defines the wrapWithNDArray specialization for C array types
@@ -62,7 +62,7 @@ PyObject *wrapWithNDArray(const ElementType *carray, const int ndims,
       static_cast<void *>(const_cast<ElementType *>(carray)));
 
   if (mode == ReadOnly)
-    markReadOnly(nparray);
+    markReadOnly(reinterpret_cast<PyObject *>(nparray));
   return reinterpret_cast<PyObject *>(nparray);
 }
 
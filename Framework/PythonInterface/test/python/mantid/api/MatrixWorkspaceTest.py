@@ -215,6 +215,27 @@ class MatrixWorkspaceTest(unittest.TestCase):
         self.assertTrue(len(dx), 0)
         self._do_numpy_comparison(self._test_ws, x, y, e)
 
+    def test_readAllX_gives_readonly_numpy_array_of_all_x(self):
+        x = self._test_ws.readAllX()
+        self.assertEquals(type(x), np.ndarray)
+        self.assertFalse(x.flags.writeable)
+        self.assertTrue(np.array_equal(x, self._test_ws.extractX()))
+
+    def test_readAllX_does_not_copy_shared_x(self):
+        run_algorithm('CreateWorkspace', OutputWorkspace='sharedX', DataX=[1.,2.,3.,4.],
+                      DataY=[2.,3.,4.,5.,6.,7.], DataE=[1.,1.,1.,1.,1.,1.], NSpec=2, UnitX='TOF')
+        run_algorithm('Rebin', InputWorkspace='sharedX', Params=[1.,0.5,4.], OutputWorkspace='sharedX')
+        ws = AnalysisDataService['sharedX']
+        x = ws.readAllX()
+        self.assertEquals(x.shape, (2, 7))
+        # Both rows are views of the same bin edges
+        self.assertEquals(x.strides[0], 0)
+        self.assertTrue(np.array_equal(x, ws.extractX()))
+        # The array keeps the bin edges after the workspace has gone
+        AnalysisDataService.remove('sharedX')
+        del ws
+        self.assertTrue(np.array_equal(x[1], np.arange(1., 4.5, 0.5)))
+
     def _do_numpy_comparison(self, workspace, x_np, y_np, e_np, index = None):
         if index is None:
             nhist = workspace.getNumberHistograms()
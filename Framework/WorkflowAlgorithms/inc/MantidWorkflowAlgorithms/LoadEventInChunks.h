@@ -0,0 +1,79 @@
+#ifndef MANTID_WORKFLOWALGORITHMS_LOADEVENTINCHUNKS_H_
+#define MANTID_WORKFLOWALGORITHMS_LOADEVENTINCHUNKS_H_
+
+#include "MantidKernel/System.h"
+#include "MantidAPI/DataProcessorAlgorithm.h"
+#include "MantidAPI/IMDEventWorkspace_fwd.h"
+#include "MantidAPI/ITableWorkspace_fwd.h"
+
+namespace Mantid {
+namespace WorkflowAlgorithms {
+
+/** LoadEventInChunks : load an event nexus file one chunk at a time and
+  reduce each chunk before the next one is loaded.
+
+  The chunks are the ones found by DetermineChunking. Each chunk is loaded
+  with LoadEventNexus, optionally converted with ConvertUnits and focussed
+  with DiffractionFocussing2, and then either histogrammed with Rebin and
+  added to the output Workspace2D, or added to the output MD workspace with
+  ConvertToMD. Only one chunk of events is in memory at any time, so the
+  memory needed depends on the chunk size and the size of the output
+  workspace instead of the number of events in the file.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport LoadEventInChunks : public API::DataProcessorAlgorithm {
+public:
+  const std::string name() const override;
+  int version() const override;
+  const std::vector<std::string> seeAlso() const override {
+    return {"LoadEventNexus", "LoadEventAndCompress", "DetermineChunking",
+            "Rebin", "ConvertToMD"};
+  }
+  const std::string category() const override;
+  const std::string summary() const override;
+  std::map<std::string, std::string> validateInputs() override;
+
+protected:
+  API::ITableWorkspace_sptr
+  determineChunk(const std::string &filename) override;
+  API::MatrixWorkspace_sptr loadChunk(const size_t rowIndex) override;
+  API::MatrixWorkspace_sptr processChunk(API::MatrixWorkspace_sptr &wksp);
+
+private:
+  void init() override;
+  void exec() override;
+
+  API::MatrixWorkspace_sptr
+  accumulateHistogram(const API::MatrixWorkspace_sptr &total,
+                      const API::MatrixWorkspace_sptr &chunk);
+  API::IMDEventWorkspace_sptr
+  accumulateMD(const API::IMDEventWorkspace_sptr &total,
+               const API::MatrixWorkspace_sptr &chunk);
+
+  API::ITableWorkspace_sptr m_chunkingTable;
+};
+
+} // namespace WorkflowAlgorithms
+} // namespace Mantid
+
+#endif /* MANTID_WORKFLOWALGORITHMS_LOADEVENTINCHUNKS_H_ */
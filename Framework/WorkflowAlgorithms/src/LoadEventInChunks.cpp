@@ -0,0 +1,356 @@
+#include "MantidWorkflowAlgorithms/LoadEventInChunks.h"
+#include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/Axis.h"
+#include "MantidAPI/IMDEventWorkspace.h"
+#include "MantidAPI/ITableWorkspace.h"
+#include "MantidAPI/WorkspaceProperty.h"
+#include "MantidDataObjects/GroupingWorkspace.h"
+#include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/BoundedValidator.h"
+#include "MantidKernel/DeltaEMode.h"
+#include "MantidKernel/ListValidator.h"
+#include "MantidKernel/Unit.h"
+#include "MantidKernel/UnitFactory.h"
+#include "MantidKernel/VisibleWhenProperty.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace WorkflowAlgorithms {
+
+using std::size_t;
+using std::string;
+using namespace Kernel;
+using namespace API;
+using namespace DataObjects;
+
+namespace {
+/// Values of the OutputType property
+const string HISTOGRAM("Histogram");
+const string MD("MD");
+} // namespace
+
+// Register the algorithm into the AlgorithmFactory
+DECLARE_ALGORITHM(LoadEventInChunks)
+
+//----------------------------------------------------------------------------------------------
+
+/// Algorithms name for identification. @see Algorithm::name
+const string LoadEventInChunks::name() const { return "LoadEventInChunks"; }
+
+/// Algorithm's version for identification. @see Algorithm::version
+int LoadEventInChunks::version() const { return 1; }
+
+/// Algorithm's category for identification. @see Algorithm::category
+const string LoadEventInChunks::category() const {
+  return "Workflow\\DataHandling";
+}
+
+/// Algorithm's summary for use in the GUI and help. @see Algorithm::summary
+const string LoadEventInChunks::summary() const {
+  return "Load an event file by chunks, reducing each chunk to a histogram "
+         "or MD workspace before loading the next one";
+}
+
+//----------------------------------------------------------------------------------------------
+/** Initialize the algorithm's properties.
+ */
+void LoadEventInChunks::init() {
+  // algorithms to copy properties from
+  auto algLoadEventNexus =
+      AlgorithmManager::Instance().createUnmanaged("LoadEventNexus");
+  algLoadEventNexus->initialize();
+  auto algDetermineChunking =
+      AlgorithmManager::Instance().createUnmanaged("DetermineChunking");
+  algDetermineChunking->initialize();
+
+  // declare properties
+  copyProperty(algLoadEventNexus, "Filename");
+  declareProperty(make_unique<WorkspaceProperty<Workspace>>(
+                      "OutputWorkspace", "", Direction::Output),
+                  "The name of the output Workspace2D or MD workspace");
+  copyProperty(algDetermineChunking, "MaxChunkSize");
+
+  copyProperty(algLoadEventNexus, "FilterByTofMin");
+  copyProperty(algLoadEventNexus, "FilterByTofMax");
+  copyProperty(algLoadEventNexus, "FilterByTimeStart");
+  copyProperty(algLoadEventNexus, "FilterByTimeStop");
+  copyProperty(algLoadEventNexus, "NXentryName");
+
+  auto range = boost::make_shared<BoundedValidator<double>>();
+  range->setBounds(0., 100.);
+  declareProperty("FilterBadPulses", 0., range,
+                  "Remove the events of the pulses with a proton charge "
+                  "lower than this percentage of the average. 0 keeps all "
+                  "the pulses.");
+
+  std::string grp1 = "Filter Events";
+  setPropertyGroup("FilterByTofMin", grp1);
+  setPropertyGroup("FilterByTofMax", grp1);
+  setPropertyGroup("FilterByTimeStart", grp1);
+  setPropertyGroup("FilterByTimeStop", grp1);
+  setPropertyGroup("FilterBadPulses", grp1);
+
+  declareProperty("OutputType", HISTOGRAM,
+                  boost::make_shared<StringListValidator>(
+                      std::vector<string>{HISTOGRAM, MD}),
+                  "Histogram: rebin each chunk and sum the histograms. "
+                  "MD: add the events of each chunk to an MD workspace.");
+
+  declareProperty("Target", "TOF",
+                  boost::make_shared<StringListValidator>(
+                      UnitFactory::Instance().getKeys()),
+                  "The unit the events of each chunk are converted to "
+                  "before they are focussed and rebinned");
+  declareProperty(make_unique<WorkspaceProperty<GroupingWorkspace>>(
+                      "GroupingWorkspace", "", Direction::Input,
+                      PropertyMode::Optional),
+                  "Optional: focus each chunk with this grouping");
+  declareProperty(
+      make_unique<ArrayProperty<double>>("Params"),
+      "The binning of the output histograms, as in Rebin: "
+      "x1, dx1, x2, ...");
+
+  std::string grp2 = "Histogram";
+  setPropertyGroup("Target", grp2);
+  setPropertyGroup("GroupingWorkspace", grp2);
+  setPropertyGroup("Params", grp2);
+  for (const auto &name : {"Target", "GroupingWorkspace", "Params"})
+    setPropertySettings(name, make_unique<VisibleWhenProperty>(
+                                  "OutputType", IS_EQUAL_TO, HISTOGRAM));
+
+  declareProperty("QDimensions", "Q3D",
+                  boost::make_shared<StringListValidator>(
+                      std::vector<string>{"|Q|", "Q3D"}),
+                  "The Q dimensions of the MD workspace, as in ConvertToMD");
+  declareProperty("dEAnalysisMode",
+                  DeltaEMode::asString(DeltaEMode::Elastic),
+                  boost::make_shared<StringListValidator>(
+                      DeltaEMode::availableTypes()),
+                  "The energy analysis mode, as in ConvertToMD");
+  declareProperty("Q3DFrames", "AutoSelect",
+                  "The frame of the Q dimensions, as in ConvertToMD");
+  declareProperty(make_unique<ArrayProperty<double>>("MinValues"),
+                  "The lower limits of the MD dimensions. All the chunks "
+                  "are added to a workspace of these extents.");
+  declareProperty(make_unique<ArrayProperty<double>>("MaxValues"),
+                  "The upper limits of the MD dimensions");
+
+  std::string grp3 = "MD";
+  for (const auto &name : {"QDimensions", "dEAnalysisMode", "Q3DFrames",
+                           "MinValues", "MaxValues"}) {
+    setPropertyGroup(name, grp3);
+    setPropertySettings(
+        name, make_unique<VisibleWhenProperty>("OutputType", IS_EQUAL_TO, MD));
+  }
+}
+
+/// @see Algorithm::validateInputs()
+std::map<std::string, std::string> LoadEventInChunks::validateInputs() {
+  std::map<std::string, std::string> result;
+
+  const string outputType = getProperty("OutputType");
+  if (outputType == HISTOGRAM) {
+    const std::vector<double> params = getProperty("Params");
+    if (params.empty())
+      result["Params"] = "The binning is needed to histogram the chunks";
+  } else {
+    // Each chunk would otherwise get its own extents
+    const std::vector<double> minValues = getProperty("MinValues");
+    const std::vector<double> maxValues = getProperty("MaxValues");
+    if (minValues.empty())
+      result["MinValues"] = "The extents are needed to add up the chunks";
+    if (maxValues.size() != minValues.size())
+      result["MaxValues"] = "MaxValues must be as long as MinValues";
+  }
+
+  return result;
+}
+
+/// @see DataProcessorAlgorithm::determineChunk(const std::string &)
+ITableWorkspace_sptr
+LoadEventInChunks::determineChunk(const std::string &filename) {
+  double maxChunkSize = getProperty("MaxChunkSize");
+
+  auto alg = createChildAlgorithm("DetermineChunking");
+  alg->setProperty("Filename", filename);
+  alg->setProperty("MaxChunkSize", maxChunkSize);
+  alg->executeAsChildAlg();
+  ITableWorkspace_sptr chunkingTable = alg->getProperty("OutputWorkspace");
+
+  if (chunkingTable->rowCount() > 1)
+    g_log.information() << "Will load data in " << chunkingTable->rowCount()
+                        << " chunks\n";
+  else
+    g_log.information("Not chunking");
+
+  return chunkingTable;
+}
+
+/// @see DataProcessorAlgorithm::loadChunk(const size_t)
+MatrixWorkspace_sptr LoadEventInChunks::loadChunk(const size_t rowIndex) {
+  g_log.debug() << "loadChunk(" << rowIndex << ")\n";
+
+  const size_t rowCount = m_chunkingTable->rowCount();
+  // without chunks the whole file is loaded as one
+  double numChunks = static_cast<double>(std::max(rowCount, size_t{1}));
+  double progStart = static_cast<double>(rowIndex) / numChunks;
+  double progStop = static_cast<double>(rowIndex + 1) / numChunks;
+
+  auto alg = createChildAlgorithm("LoadEventNexus", progStart, progStop, true);
+  alg->setProperty<string>("Filename", getProperty("Filename"));
+  alg->setProperty<double>("FilterByTofMin", getProperty("FilterByTofMin"));
+  alg->setProperty<double>("FilterByTofMax", getProperty("FilterByTofMax"));
+  alg->setProperty<double>("FilterByTimeStart",
+                           getProperty("FilterByTimeStart"));
+  alg->setProperty<double>("FilterByTimeStop", getProperty("FilterByTimeStop"));
+  alg->setProperty<string>("NXentryName", getProperty("NXentryName"));
+  alg->setProperty<bool>("LoadMonitors", false);
+
+  // set chunking information
+  if (rowCount > 0) {
+    const std::vector<string> COL_NAMES = m_chunkingTable->getColumnNames();
+    for (const auto &name : COL_NAMES) {
+      alg->setProperty(name, m_chunkingTable->getRef<int>(name, rowIndex));
+    }
+  }
+
+  alg->executeAsChildAlg();
+  Workspace_sptr wksp = alg->getProperty("OutputWorkspace");
+  return boost::dynamic_pointer_cast<MatrixWorkspace>(wksp);
+}
+
+/**
+ * Filter, convert and focus the events of a chunk. In the histogram mode the
+ * events are then binned and dropped.
+ *
+ * @param wksp :: the events of the chunk
+ * @return the processed chunk
+ */
+MatrixWorkspace_sptr
+LoadEventInChunks::processChunk(MatrixWorkspace_sptr &wksp) {
+  const double filterBadPulses = getProperty("FilterBadPulses");
+  if (filterBadPulses > 0.) {
+    auto alg = createChildAlgorithm("FilterBadPulses");
+    alg->setProperty("InputWorkspace", wksp);
+    alg->setProperty("OutputWorkspace", wksp);
+    alg->setProperty("LowerCutoff", filterBadPulses);
+    alg->executeAsChildAlg();
+    wksp = alg->getProperty("OutputWorkspace");
+  }
+
+  const string outputType = getProperty("OutputType");
+  if (outputType == MD)
+    return wksp; // ConvertToMD does its own unit conversion
+
+  const string target = getProperty("Target");
+  if (wksp->getAxis(0)->unit()->unitID() != target) {
+    auto alg = createChildAlgorithm("ConvertUnits");
+    alg->setProperty("InputWorkspace", wksp);
+    alg->setProperty("OutputWorkspace", wksp);
+    alg->setProperty("Target", target);
+    alg->executeAsChildAlg();
+    wksp = alg->getProperty("OutputWorkspace");
+  }
+
+  GroupingWorkspace_sptr grouping = getProperty("GroupingWorkspace");
+  if (grouping) {
+    auto alg = createChildAlgorithm("DiffractionFocussing2");
+    alg->setProperty("InputWorkspace", wksp);
+    alg->setProperty("OutputWorkspace", wksp);
+    alg->setProperty("GroupingWorkspace", grouping);
+    alg->setProperty("PreserveEvents", true);
+    alg->executeAsChildAlg();
+    wksp = alg->getProperty("OutputWorkspace");
+  }
+
+  auto alg = createChildAlgorithm("Rebin");
+  alg->setProperty("InputWorkspace", wksp);
+  alg->setProperty<std::vector<double>>("Params", getProperty("Params"));
+  alg->setProperty("PreserveEvents", false);
+  alg->executeAsChildAlg();
+  return alg->getProperty("OutputWorkspace");
+}
+
+/**
+ * Add the histograms of a chunk to the sum of the previous chunks.
+ *
+ * @param total :: the sum of the previous chunks, or NULL for the first one
+ * @param chunk :: the histograms of the chunk
+ * @return the new sum
+ */
+MatrixWorkspace_sptr
+LoadEventInChunks::accumulateHistogram(const MatrixWorkspace_sptr &total,
+                                       const MatrixWorkspace_sptr &chunk) {
+  if (!total)
+    return chunk;
+
+  auto alg = createChildAlgorithm("Plus");
+  alg->setProperty("LHSWorkspace", total);
+  alg->setProperty("RHSWorkspace", chunk);
+  alg->setProperty("OutputWorkspace", total);
+  alg->executeAsChildAlg();
+  return alg->getProperty("OutputWorkspace");
+}
+
+/**
+ * Add the events of a chunk to the MD workspace.
+ *
+ * @param total :: the MD workspace of the previous chunks, or NULL for the
+ *        first one
+ * @param chunk :: the events of the chunk
+ * @return the MD workspace holding the events of all the chunks so far
+ */
+IMDEventWorkspace_sptr
+LoadEventInChunks::accumulateMD(const IMDEventWorkspace_sptr &total,
+                                const MatrixWorkspace_sptr &chunk) {
+  auto alg = createChildAlgorithm("ConvertToMD");
+  alg->setProperty("InputWorkspace", chunk);
+  if (total)
+    alg->setProperty("OutputWorkspace", total);
+  alg->setProperty("OverwriteExisting", !total);
+  alg->setProperty<string>("QDimensions", getProperty("QDimensions"));
+  alg->setProperty<string>("dEAnalysisMode", getProperty("dEAnalysisMode"));
+  alg->setProperty<string>("Q3DFrames", getProperty("Q3DFrames"));
+  alg->setProperty<std::vector<double>>("MinValues", getProperty("MinValues"));
+  alg->setProperty<std::vector<double>>("MaxValues", getProperty("MaxValues"));
+  alg->executeAsChildAlg();
+  return alg->getProperty("OutputWorkspace");
+}
+
+//----------------------------------------------------------------------------------------------
+/** Execute the algorithm.
+ */
+void LoadEventInChunks::exec() {
+  std::string filename = getPropertyValue("Filename");
+  const bool toMD = getPropertyValue("OutputType") == MD;
+
+  m_chunkingTable = determineChunk(filename);
+  const size_t numRows = std::max(m_chunkingTable->rowCount(), size_t{1});
+
+  Progress progress(this, 0.0, 1.0, numRows);
+
+  MatrixWorkspace_sptr histograms;
+  IMDEventWorkspace_sptr events;
+  for (size_t i = 0; i < numRows; ++i) {
+    // Only one chunk is alive at a time: it is released at the end of the
+    // iteration, before the next one is loaded.
+    MatrixWorkspace_sptr chunk = loadChunk(i);
+    chunk = processChunk(chunk);
+    if (toMD)
+      events = accumulateMD(events, chunk);
+    else
+      histograms = accumulateHistogram(histograms, chunk);
+
+    progress.report();
+  }
+
+  if (toMD)
+    setProperty("OutputWorkspace",
+                boost::static_pointer_cast<Workspace>(events));
+  else
+    setProperty("OutputWorkspace", assemble(histograms));
+}
+
+} // namespace WorkflowAlgorithms
+} // namespace Mantid
@@ -0,0 +1,195 @@
+#ifndef MANTID_WORKFLOWALGORITHMS_LOADEVENTINCHUNKSTEST_H_
+#define MANTID_WORKFLOWALGORITHMS_LOADEVENTINCHUNKSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/FrameworkManager.h"
+#include "MantidAPI/IMDEventWorkspace.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidWorkflowAlgorithms/LoadEventInChunks.h"
+
+using Mantid::WorkflowAlgorithms::LoadEventInChunks;
+using namespace Mantid::API;
+
+class LoadEventInChunksTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LoadEventInChunksTest *createSuite() {
+    return new LoadEventInChunksTest();
+  }
+  static void destroySuite(LoadEventInChunksTest *suite) { delete suite; }
+
+  // ConvertToMD and the MD comparisons are in a plugin
+  LoadEventInChunksTest() { FrameworkManager::Instance(); }
+
+  void test_Init() {
+    LoadEventInChunks alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize());
+    TS_ASSERT(alg.isInitialized());
+  }
+
+  void test_validateInputs() {
+    LoadEventInChunks alg;
+    alg.initialize();
+    auto errors = alg.validateInputs();
+    TS_ASSERT_EQUALS(errors.size(), 1);
+    TS_ASSERT_EQUALS(errors.count("Params"), 1);
+
+    alg.setPropertyValue("OutputType", "MD");
+    alg.setPropertyValue("MinValues", "-10,-10,-10");
+    alg.setPropertyValue("MaxValues", "10,10");
+    errors = alg.validateInputs();
+    TS_ASSERT_EQUALS(errors.size(), 1);
+    TS_ASSERT_EQUALS(errors.count("MaxValues"), 1);
+  }
+
+  void test_exec_histogram() {
+    const std::string FILENAME("ARCS_sim_event.nxs");
+    const std::string PARAMS("1000,10,20000");
+
+    // run without chunks
+    const std::string WS_NAME_NO_CHUNKS("LoadEventInChunks_no_chunks");
+    LoadEventInChunks algWithoutChunks;
+    TS_ASSERT_THROWS_NOTHING(algWithoutChunks.initialize());
+    TS_ASSERT_THROWS_NOTHING(
+        algWithoutChunks.setPropertyValue("Filename", FILENAME));
+    TS_ASSERT_THROWS_NOTHING(
+        algWithoutChunks.setPropertyValue("Params", PARAMS));
+    TS_ASSERT_THROWS_NOTHING(algWithoutChunks.setPropertyValue(
+        "OutputWorkspace", WS_NAME_NO_CHUNKS));
+    TS_ASSERT_THROWS_NOTHING(algWithoutChunks.execute(););
+    TS_ASSERT(algWithoutChunks.isExecuted());
+
+    // run with chunks
+    const std::string WS_NAME_CHUNKS("LoadEventInChunks_chunks");
+    LoadEventInChunks algWithChunks;
+    TS_ASSERT_THROWS_NOTHING(algWithChunks.initialize());
+    TS_ASSERT_THROWS_NOTHING(
+        algWithChunks.setPropertyValue("Filename", FILENAME));
+    TS_ASSERT_THROWS_NOTHING(algWithChunks.setPropertyValue("Params", PARAMS));
+    TS_ASSERT_THROWS_NOTHING(
+        algWithChunks.setPropertyValue("OutputWorkspace", WS_NAME_CHUNKS));
+    TS_ASSERT_THROWS_NOTHING(
+        algWithChunks.setProperty("MaxChunkSize", .005)); // REALLY small file
+    TS_ASSERT_THROWS_NOTHING(algWithChunks.execute(););
+    TS_ASSERT(algWithChunks.isExecuted());
+
+    MatrixWorkspace_sptr wsWithChunks;
+    TS_ASSERT_THROWS_NOTHING(
+        wsWithChunks =
+            AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>(
+                WS_NAME_CHUNKS));
+    TS_ASSERT(wsWithChunks);
+    if (!wsWithChunks)
+      return;
+    // the events are histogrammed chunk by chunk
+    TS_ASSERT_EQUALS(wsWithChunks->id(), "Workspace2D");
+    TS_ASSERT_EQUALS(wsWithChunks->blocksize(), 1900);
+
+    // compare the two workspaces
+    auto checkAlg = AlgorithmManager::Instance().create("CompareWorkspaces");
+    checkAlg->setPropertyValue("Workspace1", WS_NAME_NO_CHUNKS);
+    checkAlg->setPropertyValue("Workspace2", WS_NAME_CHUNKS);
+    checkAlg->setProperty("Tolerance", 1e-8);
+    checkAlg->execute();
+    TS_ASSERT(checkAlg->getProperty("Result"));
+
+    // Remove workspace from the data service.
+    AnalysisDataService::Instance().remove(WS_NAME_NO_CHUNKS);
+    AnalysisDataService::Instance().remove(WS_NAME_CHUNKS);
+  }
+
+  void test_exec_MD() {
+    const std::string FILENAME("ARCS_sim_event.nxs");
+    const std::string QDIMENSIONS("|Q|");
+    const std::string MIN_VALUES("0");
+    const std::string MAX_VALUES("15");
+
+    // convert the whole file at once
+    const std::string WS_NAME_EVENTS("LoadEventInChunks_events");
+    auto load = AlgorithmManager::Instance().create("LoadEventNexus");
+    load->setPropertyValue("Filename", FILENAME);
+    load->setPropertyValue("OutputWorkspace", WS_NAME_EVENTS);
+    TS_ASSERT_THROWS_NOTHING(load->execute());
+    const std::string WS_NAME_NO_CHUNKS("LoadEventInChunks_MD_no_chunks");
+    auto convert = AlgorithmManager::Instance().create("ConvertToMD");
+    convert->setPropertyValue("InputWorkspace", WS_NAME_EVENTS);
+    convert->setPropertyValue("OutputWorkspace", WS_NAME_NO_CHUNKS);
+    convert->setPropertyValue("QDimensions", QDIMENSIONS);
+    convert->setPropertyValue("dEAnalysisMode", "Elastic");
+    convert->setPropertyValue("MinValues", MIN_VALUES);
+    convert->setPropertyValue("MaxValues", MAX_VALUES);
+    TS_ASSERT_THROWS_NOTHING(convert->execute());
+    TS_ASSERT(convert->isExecuted());
+
+    // convert chunk by chunk
+    const std::string WS_NAME_CHUNKS("LoadEventInChunks_MD_chunks");
+    LoadEventInChunks algWithChunks;
+    TS_ASSERT_THROWS_NOTHING(algWithChunks.initialize());
+    TS_ASSERT_THROWS_NOTHING(
+        algWithChunks.setPropertyValue("Filename", FILENAME));
+    TS_ASSERT_THROWS_NOTHING(
+        algWithChunks.setPropertyValue("OutputWorkspace", WS_NAME_CHUNKS));
+    TS_ASSERT_THROWS_NOTHING(
+        algWithChunks.setProperty("MaxChunkSize", .005)); // REALLY small file
+    TS_ASSERT_THROWS_NOTHING(
+        algWithChunks.setPropertyValue("OutputType", "MD"));
+    TS_ASSERT_THROWS_NOTHING(
+        algWithChunks.setPropertyValue("QDimensions", QDIMENSIONS));
+    TS_ASSERT_THROWS_NOTHING(
+        algWithChunks.setPropertyValue("MinValues", MIN_VALUES));
+    TS_ASSERT_THROWS_NOTHING(
+        algWithChunks.setPropertyValue("MaxValues", MAX_VALUES));
+    TS_ASSERT_THROWS_NOTHING(algWithChunks.execute(););
+    TS_ASSERT(algWithChunks.isExecuted());
+
+    IMDEventWorkspace_sptr wsNoChunks, wsWithChunks;
+    TS_ASSERT_THROWS_NOTHING(
+        wsNoChunks =
+            AnalysisDataService::Instance().retrieveWS<IMDEventWorkspace>(
+                WS_NAME_NO_CHUNKS));
+    TS_ASSERT_THROWS_NOTHING(
+        wsWithChunks =
+            AnalysisDataService::Instance().retrieveWS<IMDEventWorkspace>(
+                WS_NAME_CHUNKS));
+    TS_ASSERT(wsNoChunks);
+    TS_ASSERT(wsWithChunks);
+    if (!wsNoChunks || !wsWithChunks)
+      return;
+    // the chunks hold all the events of the file
+    TS_ASSERT_LESS_THAN(0, wsNoChunks->getNPoints());
+    TS_ASSERT_EQUALS(wsWithChunks->getNPoints(), wsNoChunks->getNPoints());
+    TS_ASSERT_EQUALS(wsWithChunks->getNumDims(), 1);
+
+    // The boxes depend on the order the events were added in, so compare the
+    // events binned the same way
+    const std::string BINNED_NO_CHUNKS("LoadEventInChunks_binned_no_chunks");
+    const std::string BINNED_CHUNKS("LoadEventInChunks_binned_chunks");
+    for (const auto &names :
+         {std::make_pair(WS_NAME_NO_CHUNKS, BINNED_NO_CHUNKS),
+          std::make_pair(WS_NAME_CHUNKS, BINNED_CHUNKS)}) {
+      auto bin = AlgorithmManager::Instance().create("BinMD");
+      bin->setPropertyValue("InputWorkspace", names.first);
+      bin->setPropertyValue("AlignedDim0", "|Q|,0,15,150");
+      bin->setPropertyValue("OutputWorkspace", names.second);
+      TS_ASSERT_THROWS_NOTHING(bin->execute());
+      TS_ASSERT(bin->isExecuted());
+    }
+    auto checkAlg = AlgorithmManager::Instance().create("CompareMDWorkspaces");
+    checkAlg->setPropertyValue("Workspace1", BINNED_NO_CHUNKS);
+    checkAlg->setPropertyValue("Workspace2", BINNED_CHUNKS);
+    checkAlg->setProperty("Tolerance", 1e-8);
+    checkAlg->execute();
+    TS_ASSERT(checkAlg->getProperty("Equals"));
+
+    // Remove workspace from the data service.
+    for (const auto &name : {WS_NAME_EVENTS, WS_NAME_NO_CHUNKS, WS_NAME_CHUNKS,
+                             BINNED_NO_CHUNKS, BINNED_CHUNKS})
+      AnalysisDataService::Instance().remove(name);
+  }
+};
+
+#endif /* MANTID_WORKFLOWALGORITHMS_LOADEVENTINCHUNKSTEST_H_ */